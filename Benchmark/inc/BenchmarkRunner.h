@@ -0,0 +1,211 @@
+#pragma once
+
+/**
+ * @file BenchmarkRunner.h
+ * @brief Runs benchmarks over a set of Actor counts and densities.
+ *
+ * @author Michael Albers
+ */
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace QS
+{
+  class BenchmarkState;
+
+  /**
+   * Collection of named benchmarks. Each benchmark is run once for every
+   * combination of the requested Actor counts and densities, and the
+   * results can be written as text (for people) or JSON/CSV (for tools).
+   */
+  class BenchmarkRunner
+  {
+    public:
+
+    /** Benchmark body, see BenchmarkState. */
+    using Function = std::function<void(BenchmarkState&)>;
+
+    /** Result of one run of one benchmark. */
+    class Result
+    {
+      public:
+
+      /** Benchmark specific values. */
+      std::map<std::string, double> myCounters;
+
+      /** Actor density (Actors per square meter). */
+      float myDensity;
+
+      /** Items processed per iteration. */
+      std::uint64_t myItemsPerIteration;
+
+      /** Number of iterations run. */
+      std::uint64_t myIterations;
+
+      /** Benchmark name. */
+      std::string myName;
+
+      /** Average nanoseconds per item. */
+      double myNsPerItem;
+
+      /** Average nanoseconds per iteration. */
+      double myNsPerIteration;
+
+      /** Number of Actors. */
+      std::size_t myNumberActors;
+
+      /** Reason the run was skipped, empty if it wasn't. */
+      std::string mySkipReason;
+
+      /** Total measured time, in seconds. */
+      double myTime_s;
+    };
+
+    /**
+     * Default constructor.
+     */
+    BenchmarkRunner() = default;
+
+    /**
+     * Copy constructor.
+     */
+    BenchmarkRunner(const BenchmarkRunner&) = default;
+
+    /**
+     * Move constructor.
+     */
+    BenchmarkRunner(BenchmarkRunner&&) = default;
+
+    /**
+     * Destructor.
+     */
+    ~BenchmarkRunner() = default;
+
+    /**
+     * Adds a benchmark.
+     *
+     * @param theName
+     *          unique benchmark name
+     * @param theFunction
+     *          benchmark body
+     * @param theMaximumActors
+     *          largest Actor count this benchmark runs with, larger counts
+     *          are skipped (i.e., for algorithms quadratic in Actors) unless
+     *          setIgnoreMaximumActors is used
+     * @throws std::invalid_argument
+     *          if the name is already used
+     */
+    void addBenchmark(const std::string &theName, Function theFunction,
+                      std::size_t theMaximumActors);
+
+    /**
+     * Returns the names of all benchmarks, in the order they were added.
+     *
+     * @return benchmark names
+     */
+    std::vector<std::string> getNames() const;
+
+    /**
+     * Copy assignment operator.
+     */
+    BenchmarkRunner& operator=(const BenchmarkRunner&) = default;
+
+    /**
+     * Move assignment operator.
+     */
+    BenchmarkRunner& operator=(BenchmarkRunner&&) = default;
+
+    /**
+     * Runs the benchmarks.
+     *
+     * @param theNumberActors
+     *          Actor counts to run each benchmark with
+     * @param theDensities
+     *          Actor densities to run each benchmark with
+     * @param theFilter
+     *          only benchmarks whose name contains this are run
+     * @param theMinimumTime_s
+     *          minimum measured time for each run, in seconds
+     * @param theProgress
+     *          stream to which progress is written as each run completes
+     * @return results of each run
+     */
+    std::vector<Result> run(const std::vector<std::size_t> &theNumberActors,
+                            const std::vector<float> &theDensities,
+                            const std::string &theFilter,
+                            double theMinimumTime_s,
+                            std::ostream &theProgress) const;
+
+    /**
+     * Sets whether benchmarks are run with more Actors than their maximum
+     * (see addBenchmark), for scaling runs which can afford the time.
+     *
+     * @param theIgnore
+     *          true to run every benchmark with every Actor count
+     */
+    void setIgnoreMaximumActors(bool theIgnore) noexcept;
+
+    /**
+     * Writes results as CSV, one row per run. Benchmark specific values are
+     * written as "name=value" pairs in the last column.
+     *
+     * @param theOutput
+     *          output stream
+     * @param theResults
+     *          results to write
+     */
+    static void writeCSV(std::ostream &theOutput,
+                         const std::vector<Result> &theResults);
+
+    /**
+     * Writes results as a JSON object with a "benchmarks" array.
+     *
+     * @param theOutput
+     *          output stream
+     * @param theResults
+     *          results to write
+     */
+    static void writeJSON(std::ostream &theOutput,
+                          const std::vector<Result> &theResults);
+
+    /**
+     * Writes a single result as a human readable line.
+     *
+     * @param theOutput
+     *          output stream
+     * @param theResult
+     *          result to write
+     */
+    static void writeText(std::ostream &theOutput, const Result &theResult);
+
+    protected:
+
+    private:
+
+    /** A registered benchmark. */
+    class Benchmark
+    {
+      public:
+
+      /** Benchmark body. */
+      Function myFunction;
+
+      /** Largest Actor count to run with. */
+      std::size_t myMaximumActors;
+
+      /** Benchmark name. */
+      std::string myName;
+    };
+
+    /** Registered benchmarks, in the order added. */
+    std::vector<Benchmark> myBenchmarks;
+
+    /** Whether Benchmark::myMaximumActors is ignored. */
+    bool myIgnoreMaximumActors = false;
+  };
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+/**
+ * @file BenchmarkScenario.h
+ * @brief Synthetic set of Actors used by the benchmarks.
+ *
+ * @author Michael Albers
+ */
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Metrics.h"
+#include "World.h"
+
+namespace QS
+{
+  class Actor;
+  class BehaviorSet;
+  class NearestN;
+  class Separation;
+
+  /**
+   * A square world holding the requested number of Actors at the requested
+   * density. Actors are placed on a jittered grid so that none overlap, and
+   * positions are deterministic for a given seed.
+   *
+   * Optionally each Actor gets its own NearestN sensor, Separation behavior
+   * and BehaviorSet (making it usable with World::update), and the Actors
+   * can be added to the World.
+   */
+  class BenchmarkScenario
+  {
+    public:
+
+    /** Radius of every Actor, in meters. */
+    static constexpr float ACTOR_RADIUS_M = 0.2;
+
+    /**
+     * Default constructor.
+     */
+    BenchmarkScenario() = delete;
+
+    /**
+     * Constructor. Creates the Actors.
+     *
+     * @param theNumberActors
+     *          number of Actors
+     * @param theDensity
+     *          Actors per square meter
+     * @param theSeed
+     *          seed for the position jitter
+     * @throws std::invalid_argument
+     *          if the density is too high for Actors to not overlap
+     */
+    BenchmarkScenario(std::size_t theNumberActors, float theDensity,
+                      std::uint32_t theSeed = 1);
+
+    /**
+     * Copy constructor.
+     */
+    BenchmarkScenario(const BenchmarkScenario&) = delete;
+
+    /**
+     * Move constructor.
+     */
+    BenchmarkScenario(BenchmarkScenario&&) = delete;
+
+    /**
+     * Destructor.
+     */
+    ~BenchmarkScenario();
+
+    /**
+     * Adds every Actor to the World and initializes the Actor metrics.
+     */
+    void addActorsToWorld();
+
+    /**
+     * Gives every Actor its own NearestN -> Separation -> BehaviorSet chain.
+     */
+    void createBehaviors();
+
+    /**
+     * Returns the Actors.
+     *
+     * @return Actors
+     */
+    const std::vector<const Actor*>& getActors() const noexcept;
+
+    /**
+     * Returns the Metrics of the World.
+     *
+     * @return Metrics
+     */
+    Metrics& getMetrics() noexcept;
+
+    /**
+     * Returns the width (and length) of the world.
+     *
+     * @return world size, in meters
+     */
+    float getWorldSize() const noexcept;
+
+    /**
+     * Returns the World.
+     *
+     * @return World
+     */
+    World& getWorld() noexcept;
+
+    /**
+     * Copy assignment operator.
+     */
+    BenchmarkScenario& operator=(const BenchmarkScenario&) = delete;
+
+    /**
+     * Move assignment operator.
+     */
+    BenchmarkScenario& operator=(BenchmarkScenario&&) = delete;
+
+    protected:
+
+    private:
+
+    /** Actors (non-owning view of myOwnedActors). */
+    std::vector<const Actor*> myActors;
+
+    /** BehaviorSets, one per Actor. */
+    std::vector<std::unique_ptr<BehaviorSet>> myBehaviorSets;
+
+    /** Metrics for myWorld. */
+    Metrics myMetrics;
+
+    /** NearestN sensors, one per Actor. */
+    std::vector<std::unique_ptr<NearestN>> myNearestNs;
+
+    /** Actors. */
+    std::vector<std::unique_ptr<Actor>> myOwnedActors;
+
+    /** Separation behaviors, one per Actor. */
+    std::vector<std::unique_ptr<Separation>> mySeparations;
+
+    /** World containing the Actors (if addActorsToWorld was called). */
+    World myWorld;
+
+    /** Width (and length) of the world, in meters. */
+    float myWorldSize_m;
+  };
+}
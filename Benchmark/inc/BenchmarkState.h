@@ -0,0 +1,229 @@
+#pragma once
+
+/**
+ * @file BenchmarkState.h
+ * @brief Timing state passed to a single benchmark run.
+ *
+ * @author Michael Albers
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace QS
+{
+  /**
+   * State for one run of one benchmark (i.e., one actor count/density
+   * combination). A benchmark does any setup, then loops on keepRunning,
+   * executing one iteration of the measured code each time through the
+   * loop:
+   *
+   *   (setup)
+   *   while (theState.keepRunning())
+   *   {
+   *     (measured code)
+   *   }
+   *
+   * The loop runs at least once, and until the minimum time has elapsed.
+   * Only time within the loop, excluding paused time, is measured.
+   */
+  class BenchmarkState
+  {
+    public:
+
+    /** Clock used for timing. */
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Default constructor.
+     */
+    BenchmarkState() = delete;
+
+    /**
+     * Constructor.
+     *
+     * @param theNumberActors
+     *          number of Actors to benchmark with
+     * @param theDensity
+     *          Actor density (Actors per square meter)
+     * @param theMinimumTime_s
+     *          minimum measured time, in seconds
+     */
+    BenchmarkState(std::size_t theNumberActors, float theDensity,
+                   double theMinimumTime_s) noexcept;
+
+    /**
+     * Copy constructor.
+     */
+    BenchmarkState(const BenchmarkState&) = default;
+
+    /**
+     * Move constructor.
+     */
+    BenchmarkState(BenchmarkState&&) = default;
+
+    /**
+     * Destructor.
+     */
+    ~BenchmarkState() = default;
+
+    /**
+     * Uses the given time for the current iteration instead of the measured
+     * wall time. Once called, only manually added time is reported. Used when
+     * the code of interest is timed internally (i.e., an update phase).
+     *
+     * @param theTime_s
+     *          time, in seconds
+     */
+    void addManualTime(double theTime_s) noexcept;
+
+    /**
+     * Returns the Actor density.
+     *
+     * @return Actors per square meter
+     */
+    float getDensity() const noexcept;
+
+    /**
+     * Returns the named, benchmark specific, result values.
+     *
+     * @return extra result values
+     */
+    const std::map<std::string, double>& getCounters() const noexcept;
+
+    /**
+     * Returns the number of items processed by each iteration.
+     *
+     * @return items per iteration
+     */
+    std::uint64_t getItemsPerIteration() const noexcept;
+
+    /**
+     * Returns the number of completed iterations.
+     *
+     * @return number of iterations
+     */
+    std::uint64_t getIterations() const noexcept;
+
+    /**
+     * Returns the measured time of all iterations.
+     *
+     * @return measured time, in seconds
+     */
+    double getMeasuredTime() const noexcept;
+
+    /**
+     * Returns the number of Actors to benchmark with.
+     *
+     * @return number of Actors
+     */
+    std::size_t getNumberActors() const noexcept;
+
+    /**
+     * Returns the reason the benchmark was skipped.
+     *
+     * @return skip reason, empty if not skipped
+     */
+    std::string getSkipReason() const noexcept;
+
+    /**
+     * Drives the benchmark loop, see the class description.
+     *
+     * @return true if another iteration should be run
+     */
+    bool keepRunning() noexcept;
+
+    /**
+     * Copy assignment operator.
+     */
+    BenchmarkState& operator=(const BenchmarkState&) = default;
+
+    /**
+     * Move assignment operator.
+     */
+    BenchmarkState& operator=(BenchmarkState&&) = default;
+
+    /**
+     * Stops the timer (i.e., for per-iteration setup).
+     */
+    void pauseTiming() noexcept;
+
+    /**
+     * Restarts the timer after pauseTiming.
+     */
+    void resumeTiming() noexcept;
+
+    /**
+     * Sets a named, benchmark specific, result value.
+     *
+     * @param theName
+     *          value name
+     * @param theValue
+     *          value
+     */
+    void setCounter(const std::string &theName, double theValue);
+
+    /**
+     * Sets the number of items (usually Actors) processed by each iteration,
+     * used to report time per item. Defaults to 1.
+     *
+     * @param theItems
+     *          items per iteration
+     */
+    void setItemsPerIteration(std::uint64_t theItems) noexcept;
+
+    /**
+     * Marks the benchmark as skipped for this run. Must be called before
+     * keepRunning.
+     *
+     * @param theReason
+     *          reason for skipping
+     */
+    void skip(const std::string &theReason);
+
+    protected:
+
+    private:
+
+    /** Benchmark specific result values. */
+    std::map<std::string, double> myCounters;
+
+    /** Actor density (Actors per square meter). */
+    float myDensity;
+
+    /** Items processed per iteration. */
+    std::uint64_t myItemsPerIteration = 1;
+
+    /** Number of completed iterations. */
+    std::uint64_t myIterations = 0;
+
+    /** Manually added time, in seconds. */
+    double myManualTime_s = 0.0;
+
+    /** Measured time. */
+    Clock::duration myMeasuredTime{0};
+
+    /** Minimum time to run, in seconds. */
+    double myMinimumTime_s;
+
+    /** Number of Actors. */
+    std::size_t myNumberActors;
+
+    /** Whether the timer is running. */
+    bool myRunning = false;
+
+    /** Reason for skipping the benchmark. */
+    std::string mySkipReason;
+
+    /** Start time of the current timed interval. */
+    Clock::time_point myStart;
+
+    /** Whether the loop has started. */
+    bool myStarted = false;
+
+    /** Whether addManualTime has been called. */
+    bool myUseManualTime = false;
+  };
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+/**
+ * @file EngineBenchmarks.h
+ * @brief Microbenchmarks of the simulation engine hot paths.
+ *
+ * @author Michael Albers
+ */
+
+namespace QS
+{
+  class BenchmarkRunner;
+  class BenchmarkState;
+
+  /**
+   * Benchmarks of the code run for every Actor on every update. Times are
+   * reported per Actor (per item), so for whole-update benchmarks the result
+   * is nanoseconds per Actor per frame.
+   */
+  class EngineBenchmarks
+  {
+    public:
+
+    /**
+     * Adds all of the engine benchmarks to the runner.
+     *
+     * @param theRunner
+     *          runner to add to
+     */
+    static void addBenchmarks(BenchmarkRunner &theRunner);
+
+    protected:
+
+    private:
+
+    /**
+     * BasicBehaviors::separation for every Actor, using the Actors' spatial
+     * hash neighbors.
+     *
+     * @param theState
+     *          benchmark state
+     */
+    static void basicBehaviorsSeparation(BenchmarkState &theState);
+
+    /**
+     * BasicBehaviors::separation for every Actor, with the positions of its
+     * spatial hash neighbors in arrays (as Separation does when
+     * BasicBehaviors::isSimdSeparationEnabled).
+     *
+     * @param theState
+     *          benchmark state
+     */
+    static void basicBehaviorsSeparationArrays(BenchmarkState &theState);
+
+    /**
+     * NearestN::sense for a sample of Actors.
+     *
+     * @param theState
+     *          benchmark state
+     */
+    static void nearestNSense(BenchmarkState &theState);
+
+    /**
+     * PropertyGenerator::generateProperty, once per Actor.
+     *
+     * @param theState
+     *          benchmark state
+     */
+    static void propertyGeneratorGenerateProperty(BenchmarkState &theState);
+
+    /**
+     * SpatialHash::hashActor for every Actor into an empty hash.
+     *
+     * @param theState
+     *          benchmark state
+     */
+    static void spatialHashBuild(BenchmarkState &theState);
+
+    /**
+     * SpatialHash::getActors around every Actor.
+     *
+     * @param theState
+     *          benchmark state
+     */
+    static void spatialHashQuery(BenchmarkState &theState);
+
+    /**
+     * SpatialHash::removeActor for every Actor from a full hash.
+     *
+     * @param theState
+     *          benchmark state
+     */
+    static void spatialHashRemove(BenchmarkState &theState);
+
+    /**
+     * SweptCircles::clip for every Actor against its spatial hash neighbors,
+     * including gathering them from the set the hash gives, as
+     * World::collisionDetection does.
+     *
+     * @param theState
+     *          benchmark state
+     */
+    static void sweptCirclesClip(BenchmarkState &theState);
+
+    /**
+     * SweptCircles::clipSequential for every Actor against its spatial hash
+     * neighbors, for comparison with sweptCirclesClip.
+     *
+     * @param theState
+     *          benchmark state
+     */
+    static void sweptCirclesClipSequential(BenchmarkState &theState);
+
+    /**
+     * World::collisionDetection for every Actor, against the Actors where
+     * they are (without the rest of World::update).
+     *
+     * @param theState
+     *          benchmark state
+     */
+    static void worldCollisionDetection(BenchmarkState &theState);
+
+    /**
+     * A full World::update.
+     *
+     * @param theState
+     *          benchmark state
+     */
+    static void worldUpdate(BenchmarkState &theState);
+  };
+}
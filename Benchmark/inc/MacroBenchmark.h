@@ -0,0 +1,156 @@
+#pragma once
+
+/**
+ * @file MacroBenchmark.h
+ * @brief Runs whole simulations headless for a fixed number of steps.
+ *
+ * @author Michael Albers
+ */
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace QS
+{
+  /**
+   * End-to-end benchmark of a simulation file: the simulation is loaded
+   * (plugins, XML, entity creation and placement checks) and the World is
+   * then updated a fixed number of times with a fixed interval, with no
+   * visualization.
+   *
+   * Each simulation can be run in its own process so that the peak resident
+   * set size is that of the one simulation, and so that a simulation which
+   * crashes doesn't take the other results with it.
+   */
+  class MacroBenchmark
+  {
+    public:
+
+    /** Result of running one simulation. */
+    class Result
+    {
+      public:
+
+      /** Actor updates per wall clock second. */
+      double myActorUpdatesPerSecond = 0.0;
+
+      /** Why the simulation couldn't be run, empty if it ran. */
+      std::string myError;
+
+      /** Time taken to load the simulation, in seconds. */
+      double myLoadTime_s = 0.0;
+
+      /** Simulation name (file name without directory). */
+      std::string myName;
+
+      /** Total number of Actor updates. */
+      std::uint64_t myNumberActorUpdates = 0;
+
+      /** Number of Actors in the simulation. */
+      std::uint64_t myNumberActors = 0;
+
+      /** Peak resident set size, in kilobytes. */
+      std::uint64_t myPeakRSS_kB = 0;
+
+      /** Simulated seconds per wall clock second. */
+      double myRealTimeFactor = 0.0;
+
+      /** Simulated time, in seconds. */
+      double mySimulatedTime_s = 0.0;
+
+      /**
+       * Number of steps run. Fewer than requested if every Actor exited
+       * first.
+       */
+      std::uint64_t mySteps = 0;
+
+      /** Steps per wall clock second. */
+      double myStepsPerSecond = 0.0;
+
+      /** Wall clock time of the steps (not including loading), in seconds. */
+      double myWallTime_s = 0.0;
+    };
+
+    /**
+     * Compares results to a baseline (a file previously written with
+     * writeJSON). Each regression is written as a line of text.
+     *
+     * @param theResults
+     *          results to check
+     * @param theBaseline
+     *          baseline JSON
+     * @param theTolerance
+     *          allowed fractional drop in steps per second (i.e., 0.1 for
+     *          10%)
+     * @param theReport
+     *          stream regressions are written to
+     * @return true if no simulation in the baseline is slower by more than
+     *         the tolerance, failed or is missing from theResults
+     */
+    static bool compare(const std::vector<Result> &theResults,
+                        std::istream &theBaseline, double theTolerance,
+                        std::ostream &theReport);
+
+    /**
+     * Loads and runs a simulation in this process. The peak RSS is that of
+     * the process so far.
+     *
+     * @param theBaseDir
+     *          QS base directory (installation directory)
+     * @param theSimulationFile
+     *          simulation configuration file
+     * @param theSteps
+     *          number of World updates
+     * @param theInterval_s
+     *          simulated time per update, in seconds
+     * @return result, with the error set if the simulation couldn't be
+     *         loaded or run
+     */
+    static Result run(const std::string &theBaseDir,
+                      const std::string &theSimulationFile,
+                      std::uint64_t theSteps, float theInterval_s);
+
+    /**
+     * Same as run, but in a child process.
+     *
+     * @see run
+     */
+    static Result runIsolated(const std::string &theBaseDir,
+                              const std::string &theSimulationFile,
+                              std::uint64_t theSteps, float theInterval_s);
+
+    /**
+     * Writes results as a JSON object with a "simulations" array, one
+     * simulation per line.
+     *
+     * @param theOutput
+     *          output stream
+     * @param theResults
+     *          results to write
+     * @param theSteps
+     *          number of steps requested
+     * @param theInterval_s
+     *          simulated time per step, in seconds
+     */
+    static void writeJSON(std::ostream &theOutput,
+                          const std::vector<Result> &theResults,
+                          std::uint64_t theSteps, float theInterval_s);
+
+    /**
+     * Writes a single result as a human readable line.
+     *
+     * @param theOutput
+     *          output stream
+     * @param theResult
+     *          result to write
+     */
+    static void writeText(std::ostream &theOutput, const Result &theResult);
+
+    protected:
+
+    private:
+  };
+}
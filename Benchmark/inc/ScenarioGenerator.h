@@ -0,0 +1,246 @@
+#pragma once
+
+/**
+ * @file ScenarioGenerator.h
+ * @brief Generates large simulation files for scaling runs.
+ *
+ * @author Michael Albers
+ */
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace QS
+{
+  /**
+   * Writes a simulation file (see Simulations/SimulationConfig.xsd) of
+   * QueueingPlugin Actors and OrderedExits.
+   *
+   * Actors are placed in the cells of a uniform grid, one Actor per cell,
+   * with the cells used chosen at random. Each Actor is placed at a random
+   * spot fully inside its cell, so no two Actors overlap and every Actor is
+   * within the world, whatever the radius distribution. Cells near an Exit
+   * are not used. Ranks are a random permutation of 0 to N-1.
+   *
+   * Everything random comes from engines seeded with the given seed, so the
+   * same parameters always give the same file. The file is streamed as it is
+   * generated, only the ranks are held in memory.
+   */
+  class ScenarioGenerator
+  {
+    public:
+
+    /** Where Exits are placed. */
+    enum class ExitPlacement
+    {
+      /** In the corners of the world (at most four Exits). */
+      Corners,
+      /** Evenly spaced around the edges of the world. */
+      Perimeter,
+      /** Anywhere in the world. */
+      Random
+    };
+
+    /** Generator parameters. */
+    class Parameters
+    {
+      public:
+
+      /**
+       * Number of Actors. If 0 the number is the density times the area of
+       * the world.
+       */
+      std::size_t myNumberActors = 0;
+
+      /**
+       * Actors per square meter. Only used if either the world size or the
+       * number of Actors is 0.
+       */
+      float myDensity = 0.5;
+
+      /** Exit placement. */
+      ExitPlacement myExitPlacement = ExitPlacement::Perimeter;
+
+      /** Radius of each Exit, in meters. */
+      float myExitRadius_m = 1.0;
+
+      /** Relative weight of GreedyOrderedActors. */
+      float myGreedyWeight = 1.0;
+
+      /** Relative weight of LooseOrderedActors. */
+      float myLooseWeight = 1.0;
+
+      /** Largest Actor radius, in meters. */
+      float myMaximumRadius_m = 0.25;
+
+      /**
+       * Smallest Actor radius, in meters. Radii are uniformly distributed
+       * between the smallest and largest.
+       */
+      float myMinimumRadius_m = 0.25;
+
+      /** Number of OrderedExits. */
+      std::size_t myNumberExits = 1;
+
+      /** Relative weight of (plain) OrderedActors. */
+      float myOrderedWeight = 0.0;
+
+      /** Seed for both the generator and the simulation. */
+      std::uint32_t mySeed = 1;
+
+      /**
+       * Length of the world, in meters. If either this or the width is 0 the
+       * world is square, sized by the number of Actors and density.
+       */
+      float myWorldLength_m = 0.0;
+
+      /** Width of the world, in meters. */
+      float myWorldWidth_m = 0.0;
+    };
+
+    /**
+     * Default constructor.
+     */
+    ScenarioGenerator() = delete;
+
+    /**
+     * Constructor. Validates the parameters and works out the world size,
+     * number of Actors and placement grid.
+     *
+     * @param theParameters
+     *          generator parameters
+     * @throws std::invalid_argument
+     *          if any parameter is invalid, or if the Actors cannot all be
+     *          placed without overlapping
+     */
+    explicit ScenarioGenerator(const Parameters &theParameters);
+
+    /**
+     * Copy constructor.
+     */
+    ScenarioGenerator(const ScenarioGenerator&) = default;
+
+    /**
+     * Move constructor.
+     */
+    ScenarioGenerator(ScenarioGenerator&&) = default;
+
+    /**
+     * Destructor.
+     */
+    ~ScenarioGenerator() = default;
+
+    /**
+     * Writes the simulation file.
+     *
+     * @param theOutput
+     *          output stream
+     */
+    void generate(std::ostream &theOutput) const;
+
+    /**
+     * Returns the number of Actors generated.
+     *
+     * @return number of Actors
+     */
+    std::size_t getNumberActors() const noexcept;
+
+    /**
+     * Returns the length of the world.
+     *
+     * @return world length, in meters
+     */
+    float getWorldLength() const noexcept;
+
+    /**
+     * Returns the width of the world.
+     *
+     * @return world width, in meters
+     */
+    float getWorldWidth() const noexcept;
+
+    /**
+     * Copy assignment operator.
+     */
+    ScenarioGenerator& operator=(const ScenarioGenerator&) = default;
+
+    /**
+     * Move assignment operator.
+     */
+    ScenarioGenerator& operator=(ScenarioGenerator&&) = default;
+
+    /**
+     * Converts the name of an Exit placement ("corners", "perimeter" or
+     * "random") to the enum.
+     *
+     * @param theName
+     *          placement name
+     * @return Exit placement
+     * @throws std::invalid_argument
+     *          if the name is unknown
+     */
+    static ExitPlacement toExitPlacement(const std::string &theName);
+
+    protected:
+
+    private:
+
+    /**
+     * Returns true if the grid cell is too close to an Exit to be used.
+     *
+     * @param theColumn
+     *          cell column
+     * @param theRow
+     *          cell row
+     * @param theNumberExits
+     *          only the first this many Exits are checked
+     * @return true if the cell isn't to be used
+     */
+    bool isBlocked(std::size_t theColumn, std::size_t theRow,
+                   std::size_t theNumberExits) const noexcept;
+
+    /**
+     * Works out the position of each Exit.
+     *
+     * @throws std::invalid_argument
+     *          if the Exits don't fit the placement
+     */
+    void placeExits();
+
+    /**
+     * Sizes the placement grid so there are at least as many usable cells as
+     * Actors.
+     *
+     * @throws std::invalid_argument
+     *          if the cells would be too small for the largest Actor
+     */
+    void sizeGrid();
+
+    /** Width (and length) of a grid cell, in meters. */
+    float myCellSize_m;
+
+    /** Number of grid columns. */
+    std::size_t myNumberColumns;
+
+    /** Number of grid rows. */
+    std::size_t myNumberRows;
+
+    /** Number of grid cells not blocked by an Exit. */
+    std::size_t myNumberUsableCells;
+
+    /** Exit (x, y) positions, in meters. */
+    std::vector<std::pair<float, float>> myExitPositions;
+
+    /** Parameters, with the world size and number of Actors resolved. */
+    Parameters myParameters;
+
+    /** Offset of the grid from the world origin, in meters. */
+    float myXOffset_m;
+
+    /** Offset of the grid from the world origin, in meters. */
+    float myYOffset_m;
+  };
+}
@@ -0,0 +1,184 @@
+/**
+ * @file BenchmarkRunner.cpp
+ * @brief Definition of BenchmarkRunner
+ *
+ * @author Michael Albers
+ */
+
+#include <iomanip>
+#include <stdexcept>
+#include "BenchmarkRunner.h"
+#include "BenchmarkState.h"
+
+void QS::BenchmarkRunner::addBenchmark(const std::string &theName,
+                                       Function theFunction,
+                                       std::size_t theMaximumActors)
+{
+  for (const auto &benchmark : myBenchmarks)
+  {
+    if (benchmark.myName == theName)
+    {
+      throw std::invalid_argument("Duplicate benchmark name \"" + theName +
+                                  "\".");
+    }
+  }
+  myBenchmarks.push_back({theFunction, theMaximumActors, theName});
+}
+
+std::vector<std::string> QS::BenchmarkRunner::getNames() const
+{
+  std::vector<std::string> names;
+  for (const auto &benchmark : myBenchmarks)
+  {
+    names.push_back(benchmark.myName);
+  }
+  return names;
+}
+
+std::vector<QS::BenchmarkRunner::Result> QS::BenchmarkRunner::run(
+  const std::vector<std::size_t> &theNumberActors,
+  const std::vector<float> &theDensities,
+  const std::string &theFilter,
+  double theMinimumTime_s,
+  std::ostream &theProgress) const
+{
+  std::vector<Result> results;
+  for (const auto &benchmark : myBenchmarks)
+  {
+    if (benchmark.myName.find(theFilter) == std::string::npos)
+    {
+      continue;
+    }
+
+    for (auto numberActors : theNumberActors)
+    {
+      for (auto density : theDensities)
+      {
+        BenchmarkState state(numberActors, density, theMinimumTime_s);
+        if (numberActors > benchmark.myMaximumActors &&
+            ! myIgnoreMaximumActors)
+        {
+          state.skip("more than " + std::to_string(benchmark.myMaximumActors) +
+                     " Actors");
+        }
+        else
+        {
+          benchmark.myFunction(state);
+        }
+
+        Result result;
+        result.myCounters = state.getCounters();
+        result.myDensity = density;
+        result.myItemsPerIteration = state.getItemsPerIteration();
+        result.myIterations = state.getIterations();
+        result.myName = benchmark.myName;
+        result.myNumberActors = numberActors;
+        result.mySkipReason = state.getSkipReason();
+        result.myTime_s = state.getMeasuredTime();
+        result.myNsPerIteration = 0.0;
+        result.myNsPerItem = 0.0;
+        if (result.myIterations > 0)
+        {
+          result.myNsPerIteration =
+            result.myTime_s * 1.0e9 / result.myIterations;
+          result.myNsPerItem =
+            result.myNsPerIteration / result.myItemsPerIteration;
+        }
+
+        writeText(theProgress, result);
+        results.push_back(result);
+      }
+    }
+  }
+  return results;
+}
+
+void QS::BenchmarkRunner::setIgnoreMaximumActors(bool theIgnore) noexcept
+{
+  myIgnoreMaximumActors = theIgnore;
+}
+
+void QS::BenchmarkRunner::writeCSV(std::ostream &theOutput,
+                                   const std::vector<Result> &theResults)
+{
+  theOutput << "name,actors,density,iterations,items_per_iteration,time_s,"
+            << "ns_per_iteration,ns_per_item,skipped,counters" << std::endl;
+  for (const auto &result : theResults)
+  {
+    theOutput << result.myName << "," << result.myNumberActors << ","
+              << result.myDensity << "," << result.myIterations << ","
+              << result.myItemsPerIteration << ","
+              << std::setprecision(9) << result.myTime_s << ","
+              << result.myNsPerIteration << "," << result.myNsPerItem << ","
+              << result.mySkipReason << ",";
+    bool first = true;
+    for (const auto &counter : result.myCounters)
+    {
+      theOutput << (first ? "" : " ") << counter.first << "="
+                << counter.second;
+      first = false;
+    }
+    theOutput << std::setprecision(6) << std::endl;
+  }
+}
+
+void QS::BenchmarkRunner::writeJSON(std::ostream &theOutput,
+                                    const std::vector<Result> &theResults)
+{
+  // Benchmark and counter names are plain identifiers (no characters needing
+  // escaping).
+  theOutput << "{" << std::endl << "  \"benchmarks\": [";
+  bool firstResult = true;
+  for (const auto &result : theResults)
+  {
+    theOutput << (firstResult ? "" : ",") << std::endl
+              << "    {\"name\": \"" << result.myName << "\""
+              << ", \"actors\": " << result.myNumberActors
+              << ", \"density\": " << result.myDensity
+              << ", \"iterations\": " << result.myIterations
+              << ", \"items_per_iteration\": " << result.myItemsPerIteration
+              << std::setprecision(9)
+              << ", \"time_s\": " << result.myTime_s
+              << ", \"ns_per_iteration\": " << result.myNsPerIteration
+              << ", \"ns_per_item\": " << result.myNsPerItem;
+    if (! result.mySkipReason.empty())
+    {
+      theOutput << ", \"skipped\": \"" << result.mySkipReason << "\"";
+    }
+    theOutput << ", \"counters\": {";
+    bool firstCounter = true;
+    for (const auto &counter : result.myCounters)
+    {
+      theOutput << (firstCounter ? "" : ", ") << "\"" << counter.first
+                << "\": " << counter.second;
+      firstCounter = false;
+    }
+    theOutput << "}}" << std::setprecision(6);
+    firstResult = false;
+  }
+  theOutput << std::endl << "  ]" << std::endl << "}" << std::endl;
+}
+
+void QS::BenchmarkRunner::writeText(std::ostream &theOutput,
+                                    const Result &theResult)
+{
+  theOutput << std::left << std::setw(32) << theResult.myName << std::right
+            << " actors " << std::setw(8) << theResult.myNumberActors
+            << " density " << std::setw(5) << theResult.myDensity;
+  if (! theResult.mySkipReason.empty())
+  {
+    theOutput << "  skipped (" << theResult.mySkipReason << ")" << std::endl;
+    return;
+  }
+
+  theOutput << std::fixed << std::setprecision(1)
+            << "  " << std::setw(12) << theResult.myNsPerItem << " ns/item"
+            << "  " << std::setw(14) << theResult.myNsPerIteration
+            << " ns/iteration  " << theResult.myIterations << " iterations";
+  for (const auto &counter : theResult.myCounters)
+  {
+    theOutput << "  " << counter.first << " " << counter.second;
+  }
+  theOutput.unsetf(std::ios_base::floatfield);
+  theOutput << std::setprecision(6) << std::endl;
+}
@@ -0,0 +1,164 @@
+/**
+ * @file BenchmarkScenario.cpp
+ * @brief Definition of BenchmarkScenario
+ *
+ * @author Michael Albers
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include "Actor.h"
+#include "BehaviorSet.h"
+#include "BenchmarkScenario.h"
+#include "NearestN.h"
+#include "Sensable.h"
+#include "Separation.h"
+
+namespace
+{
+  /**
+   * BehaviorSet which senses before evaluating (as the QueueingPlugin
+   * BehaviorSets do), so sensing is part of the benchmarked update.
+   */
+  class SensingBehaviorSet : public QS::BehaviorSet
+  {
+    public:
+
+    /**
+     * Constructor.
+     */
+    SensingBehaviorSet() :
+      BehaviorSet({}, "")
+    {
+    }
+
+    /**
+     * Populates the sensors then evaluates the behaviors.
+     *
+     * @param theActor
+     *          Actor being evaluated
+     * @param theSensable
+     *          sensable data from the World
+     * @return combined steering force vector
+     */
+    virtual Eigen::Vector2f evaluate(const QS::Actor *theActor,
+                                     const QS::Sensable &theSensable) override
+    {
+      populateSensors(theSensable);
+      return BehaviorSet::evaluate(theActor, theSensable);
+    }
+  };
+}
+
+constexpr float QS::BenchmarkScenario::ACTOR_RADIUS_M;
+
+QS::BenchmarkScenario::BenchmarkScenario(std::size_t theNumberActors,
+                                         float theDensity,
+                                         std::uint32_t theSeed) :
+  myWorld(myMetrics)
+{
+  if (theDensity <= 0.0)
+  {
+    throw std::invalid_argument("Benchmark density must be greater than 0.");
+  }
+
+  // One Actor per grid cell, with a little room to spare.
+  float spacing = 1.0 / std::sqrt(theDensity);
+  float diameter = 2 * ACTOR_RADIUS_M;
+  if (spacing <= diameter * 1.05)
+  {
+    throw std::invalid_argument(
+      "Benchmark density " + std::to_string(theDensity) + " is too high, "
+      "Actors would overlap.");
+  }
+
+  auto numberColumns = static_cast<std::size_t>(
+    std::ceil(std::sqrt(static_cast<double>(theNumberActors))));
+  numberColumns = std::max(numberColumns, static_cast<std::size_t>(1));
+  myWorldSize_m = numberColumns * spacing;
+  myWorld.setDimensions(myWorldSize_m, myWorldSize_m);
+
+  std::mt19937 engine(theSeed);
+  float maximumJitter = (spacing - diameter * 1.05) / 2;
+  std::uniform_real_distribution<float> jitter(-maximumJitter, maximumJitter);
+
+  PluginEntity::Properties properties{
+    {"radius", std::to_string(ACTOR_RADIUS_M)},
+    {"mass", "70.0"},
+    {"x", "0.0"},
+    {"y", "0.0"},
+    {"max force", "100.0"},
+    {"max speed", "1.4"}};
+
+  myOwnedActors.reserve(theNumberActors);
+  myActors.reserve(theNumberActors);
+  for (auto actorIndex = 0u; actorIndex < theNumberActors; ++actorIndex)
+  {
+    auto column = actorIndex % numberColumns;
+    auto row = actorIndex / numberColumns;
+    Eigen::Vector2f position{(column + 0.5f) * spacing + jitter(engine),
+                             (row + 0.5f) * spacing + jitter(engine)};
+
+    std::unique_ptr<Actor> actor{new Actor(properties, "")};
+    actor->setPosition(position);
+    myActors.push_back(actor.get());
+    myOwnedActors.push_back(std::move(actor));
+  }
+}
+
+QS::BenchmarkScenario::~BenchmarkScenario() = default;
+
+void QS::BenchmarkScenario::addActorsToWorld()
+{
+  for (auto &actor : myOwnedActors)
+  {
+    myWorld.addActor(actor.get());
+  }
+  myWorld.initializeActorMetrics();
+}
+
+void QS::BenchmarkScenario::createBehaviors()
+{
+  PluginEntity::Properties nearestNProperties{
+    {"N", "4"},
+    {"radius", "2.0"}};
+
+  for (auto &actor : myOwnedActors)
+  {
+    std::unique_ptr<NearestN> nearestN{new NearestN(nearestNProperties, "")};
+    std::unique_ptr<Separation> separation{new Separation({}, "")};
+    std::unique_ptr<BehaviorSet> behaviorSet{new SensingBehaviorSet()};
+
+    separation->setDependencies({{"NearestN", nearestN.get(), ""}});
+    behaviorSet->setDependencies({{"Separation", separation.get(), ""}});
+    actor->setDependencies({{"BehaviorSet", behaviorSet.get(), ""}});
+
+    myNearestNs.push_back(std::move(nearestN));
+    mySeparations.push_back(std::move(separation));
+    myBehaviorSets.push_back(std::move(behaviorSet));
+  }
+}
+
+const std::vector<const QS::Actor*>& QS::BenchmarkScenario::getActors() const
+  noexcept
+{
+  return myActors;
+}
+
+QS::Metrics& QS::BenchmarkScenario::getMetrics() noexcept
+{
+  return myMetrics;
+}
+
+float QS::BenchmarkScenario::getWorldSize() const noexcept
+{
+  return myWorldSize_m;
+}
+
+QS::World& QS::BenchmarkScenario::getWorld() noexcept
+{
+  return myWorld;
+}
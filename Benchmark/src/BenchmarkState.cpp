@@ -0,0 +1,127 @@
+/**
+ * @file BenchmarkState.cpp
+ * @brief Definition of BenchmarkState
+ *
+ * @author Michael Albers
+ */
+
+#include "BenchmarkState.h"
+
+QS::BenchmarkState::BenchmarkState(std::size_t theNumberActors,
+                                   float theDensity,
+                                   double theMinimumTime_s) noexcept :
+  myDensity(theDensity),
+  myMinimumTime_s(theMinimumTime_s),
+  myNumberActors(theNumberActors)
+{
+}
+
+void QS::BenchmarkState::addManualTime(double theTime_s) noexcept
+{
+  myUseManualTime = true;
+  myManualTime_s += theTime_s;
+}
+
+float QS::BenchmarkState::getDensity() const noexcept
+{
+  return myDensity;
+}
+
+const std::map<std::string, double>& QS::BenchmarkState::getCounters() const
+  noexcept
+{
+  return myCounters;
+}
+
+std::uint64_t QS::BenchmarkState::getItemsPerIteration() const noexcept
+{
+  return myItemsPerIteration;
+}
+
+std::uint64_t QS::BenchmarkState::getIterations() const noexcept
+{
+  return myIterations;
+}
+
+double QS::BenchmarkState::getMeasuredTime() const noexcept
+{
+  if (myUseManualTime)
+  {
+    return myManualTime_s;
+  }
+  return std::chrono::duration<double>(myMeasuredTime).count();
+}
+
+std::size_t QS::BenchmarkState::getNumberActors() const noexcept
+{
+  return myNumberActors;
+}
+
+std::string QS::BenchmarkState::getSkipReason() const noexcept
+{
+  return mySkipReason;
+}
+
+bool QS::BenchmarkState::keepRunning() noexcept
+{
+  if (! mySkipReason.empty())
+  {
+    return false;
+  }
+
+  if (! myStarted)
+  {
+    myStarted = true;
+    resumeTiming();
+    return true;
+  }
+
+  ++myIterations;
+
+  // Checking the clock while paused is fine, the paused time isn't counted.
+  bool wasRunning = myRunning;
+  pauseTiming();
+  if (getMeasuredTime() >= myMinimumTime_s)
+  {
+    return false;
+  }
+  if (wasRunning)
+  {
+    resumeTiming();
+  }
+  return true;
+}
+
+void QS::BenchmarkState::pauseTiming() noexcept
+{
+  if (myRunning)
+  {
+    myMeasuredTime += Clock::now() - myStart;
+    myRunning = false;
+  }
+}
+
+void QS::BenchmarkState::resumeTiming() noexcept
+{
+  if (! myRunning)
+  {
+    myStart = Clock::now();
+    myRunning = true;
+  }
+}
+
+void QS::BenchmarkState::setCounter(const std::string &theName,
+                                    double theValue)
+{
+  myCounters[theName] = theValue;
+}
+
+void QS::BenchmarkState::setItemsPerIteration(std::uint64_t theItems) noexcept
+{
+  myItemsPerIteration = theItems;
+}
+
+void QS::BenchmarkState::skip(const std::string &theReason)
+{
+  mySkipReason = theReason;
+}
@@ -0,0 +1,516 @@
+/**
+ * @file EngineBenchmarks.cpp
+ * @brief Definition of EngineBenchmarks
+ *
+ * @author Michael Albers
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Actor.h"
+#include "ActorUpdateCallback.h"
+#include "BasicBehaviors.h"
+#include "BenchmarkRunner.h"
+#include "BenchmarkScenario.h"
+#include "BenchmarkState.h"
+#include "EngineBenchmarks.h"
+#include "FrameProfiler.h"
+#include "Metrics.h"
+#include "NearestN.h"
+#include "PropertyGenerator.h"
+#include "Sensable.h"
+#include "SimdLanes.h"
+#include "SimulationEntityConfiguration.h"
+#include "SpatialHash.h"
+#include "SweptCircles.h"
+#include "World.h"
+
+namespace
+{
+  /**
+   * Results are written here so the compiler can't optimize away the
+   * benchmarked code.
+   */
+  volatile float glbSink;
+
+  /** Search radius for neighbor queries, matches the scenario NearestN. */
+  constexpr float NEIGHBOR_RADIUS_M = 2.0;
+
+  /** Number of Actors sensed per NearestN iteration. */
+  constexpr std::size_t NEARESTN_SAMPLE_SIZE = 256;
+
+  /** Update interval, in seconds, for the World benchmarks. */
+  constexpr float UPDATE_INTERVAL_S = 1.0 / 24.0;
+
+  /**
+   * Actor update callback which does nothing.
+   */
+  class NullActorUpdateCallback : public QS::ActorUpdateCallback
+  {
+    public:
+
+    /**
+     * Does nothing.
+     *
+     * @param theActor
+     *          updated Actor
+     */
+    virtual void actorUpdate(const QS::Actor *theActor) noexcept override
+    {
+    }
+  };
+
+  /**
+   * Makes a JSON friendly counter name from a phase name (i.e., "Update
+   * (other)" becomes "update_other").
+   *
+   * @param thePhase
+   *          phase
+   * @return counter name prefix
+   */
+  std::string getCounterName(QS::FrameProfiler::Phase thePhase)
+  {
+    std::string name;
+    for (auto character = QS::FrameProfiler::getPhaseName(thePhase);
+         *character;
+         ++character)
+    {
+      if (std::isalnum(*character))
+      {
+        name += std::tolower(*character);
+      }
+      else if (' ' == *character)
+      {
+        name += '_';
+      }
+    }
+    return name;
+  }
+
+  /**
+   * Builds a spatial hash of all of the scenario's Actors.
+   *
+   * @param theScenario
+   *          scenario
+   * @return populated spatial hash
+   */
+  QS::SpatialHash buildHash(const QS::BenchmarkScenario &theScenario)
+  {
+    QS::SpatialHash hash(theScenario.getWorldSize(),
+                         theScenario.getWorldSize(),
+                         QS::BenchmarkScenario::ACTOR_RADIUS_M * 2);
+    for (auto actor : theScenario.getActors())
+    {
+      hash.hashActor(actor);
+    }
+    return hash;
+  }
+
+  /**
+   * Finds the spatial hash neighbors of every Actor, for the separation
+   * benchmarks, and sets the neighbors_per_actor counter.
+   *
+   * @param theScenario
+   *          scenario
+   * @param theState
+   *          benchmark state
+   * @return indexes (in the scenario's Actors) of the neighbors of each
+   *         Actor, not including itself
+   */
+  std::vector<std::vector<std::size_t>> getNeighbors(
+    const QS::BenchmarkScenario &theScenario, QS::BenchmarkState &theState)
+  {
+    auto hash = buildHash(theScenario);
+
+    const auto &actors = theScenario.getActors();
+    std::unordered_map<const QS::Actor*, std::size_t> indexes;
+    for (auto actorIndex = 0u; actorIndex < actors.size(); ++actorIndex)
+    {
+      indexes[actors[actorIndex]] = actorIndex;
+    }
+
+    std::vector<std::vector<std::size_t>> neighbors(actors.size());
+    std::size_t numberNeighbors = 0;
+    for (auto actorIndex = 0u; actorIndex < actors.size(); ++actorIndex)
+    {
+      auto actor = actors[actorIndex];
+      for (auto neighbor : hash.getActors(actor->getPosition(),
+                                          NEIGHBOR_RADIUS_M))
+      {
+        if (neighbor != actor)
+        {
+          neighbors[actorIndex].push_back(indexes[neighbor]);
+        }
+      }
+      numberNeighbors += neighbors[actorIndex].size();
+    }
+    theState.setCounter("neighbors_per_actor",
+                        static_cast<double>(numberNeighbors) / actors.size());
+    return neighbors;
+  }
+
+  /**
+   * Clips a motion vector for every Actor against its spatial hash
+   * neighbors, either with SweptCircles::clip or the sequential version.
+   * As in World::collisionDetection, the circles are gathered from the set
+   * of neighbors each time, which is timed too.
+   *
+   * @param theState
+   *          benchmark state
+   * @param theSequential
+   *          use SweptCircles::clipSequential
+   */
+  void sweptCirclesClip(QS::BenchmarkState &theState, bool theSequential)
+  {
+    QS::BenchmarkScenario scenario(theState.getNumberActors(),
+                                   theState.getDensity());
+    auto hash = buildHash(scenario);
+
+    const auto &actors = scenario.getActors();
+    std::vector<std::set<const QS::Actor*>> neighbors;
+    std::vector<Eigen::Vector2f> motions;
+    std::size_t numberNeighbors = 0;
+    for (auto actorIndex = 0u; actorIndex < actors.size(); ++actorIndex)
+    {
+      auto actor = actors[actorIndex];
+      neighbors.push_back(hash.getActors(actor->getPosition(),
+                                         NEIGHBOR_RADIUS_M));
+      numberNeighbors += neighbors.back().size() - 1;
+
+      // Spread the directions around the circle (golden angle steps), long
+      // enough to reach the neighbors.
+      float angle = actorIndex * 2.39996323;
+      motions.emplace_back(NEIGHBOR_RADIUS_M * std::cos(angle),
+                           NEIGHBOR_RADIUS_M * std::sin(angle));
+    }
+    theState.setCounter("neighbors_per_actor",
+                        static_cast<double>(numberNeighbors) / actors.size());
+
+    QS::SweptCircles circles;
+    theState.setItemsPerIteration(actors.size());
+    while (theState.keepRunning())
+    {
+      float sum = 0.0;
+      for (auto actorIndex = 0u; actorIndex < actors.size(); ++actorIndex)
+      {
+        auto actor = actors[actorIndex];
+        circles.clear();
+        for (auto neighbor : neighbors[actorIndex])
+        {
+          if (neighbor != actor)
+          {
+            circles.add(neighbor->getPosition(), neighbor->getRadius());
+          }
+        }
+        if (theSequential)
+        {
+          sum += circles.clipSequential(actor->getPosition(),
+                                        actor->getRadius(),
+                                        motions[actorIndex]).x();
+        }
+        else
+        {
+          sum += circles.clip(actor->getPosition(), actor->getRadius(),
+                              motions[actorIndex]).x();
+        }
+      }
+      glbSink = sum;
+    }
+  }
+}
+
+void QS::EngineBenchmarks::addBenchmarks(BenchmarkRunner &theRunner)
+{
+  // Some benchmarks are limited to fewer Actors by the cost of the current
+  // algorithms: SpatialHash removal scans every bucket, and sensing (and so
+  // a World update) looks at every Actor in the world. World/update takes
+  // about 30 s per update with 10000 Actors, run with --no-limits.
+  theRunner.addBenchmark("SpatialHash/build", spatialHashBuild, 1000000);
+  theRunner.addBenchmark("SpatialHash/query", spatialHashQuery, 1000000);
+  theRunner.addBenchmark("SpatialHash/remove", spatialHashRemove, 100000);
+  theRunner.addBenchmark("NearestN/sense", nearestNSense, 100000);
+  theRunner.addBenchmark("World/collisionDetection", worldCollisionDetection,
+                         1000000);
+  theRunner.addBenchmark("BasicBehaviors/separation", basicBehaviorsSeparation,
+                         1000000);
+  theRunner.addBenchmark("BasicBehaviors/separationArrays",
+                         basicBehaviorsSeparationArrays, 1000000);
+  theRunner.addBenchmark("SweptCircles/clip", sweptCirclesClip, 1000000);
+  theRunner.addBenchmark("SweptCircles/clipSequential",
+                         sweptCirclesClipSequential, 1000000);
+  theRunner.addBenchmark("PropertyGenerator/generateProperty",
+                         propertyGeneratorGenerateProperty, 1000000);
+  theRunner.addBenchmark("World/update", worldUpdate, 2000);
+}
+
+void QS::EngineBenchmarks::basicBehaviorsSeparation(BenchmarkState &theState)
+{
+  BenchmarkScenario scenario(theState.getNumberActors(),
+                             theState.getDensity());
+  const auto &actors = scenario.getActors();
+  std::vector<std::vector<const Actor*>> neighbors;
+  for (const auto &actorNeighbors : getNeighbors(scenario, theState))
+  {
+    neighbors.emplace_back();
+    for (auto neighbor : actorNeighbors)
+    {
+      neighbors.back().push_back(actors[neighbor]);
+    }
+  }
+
+  theState.setItemsPerIteration(actors.size());
+  while (theState.keepRunning())
+  {
+    float sum = 0.0;
+    for (auto actorIndex = 0u; actorIndex < actors.size(); ++actorIndex)
+    {
+      auto actor = actors[actorIndex];
+      sum += BasicBehaviors::separation(actor, neighbors[actorIndex],
+                                        actor->getRadius() * 2).x();
+    }
+    glbSink = sum;
+  }
+}
+
+void QS::EngineBenchmarks::basicBehaviorsSeparationArrays(
+  BenchmarkState &theState)
+{
+  BenchmarkScenario scenario(theState.getNumberActors(),
+                             theState.getDensity());
+  const auto &actors = scenario.getActors();
+
+  // As NearestN keeps them for the SIMD separation.
+  std::vector<std::vector<float>> neighborsX;
+  std::vector<std::vector<float>> neighborsY;
+  for (const auto &actorNeighbors : getNeighbors(scenario, theState))
+  {
+    neighborsX.emplace_back();
+    neighborsY.emplace_back();
+    for (auto neighbor : actorNeighbors)
+    {
+      neighborsX.back().push_back(actors[neighbor]->getPosition().x());
+      neighborsY.back().push_back(actors[neighbor]->getPosition().y());
+    }
+  }
+  theState.setCounter("lanes", SimdLanes::LANES);
+
+  theState.setItemsPerIteration(actors.size());
+  while (theState.keepRunning())
+  {
+    float sum = 0.0;
+    for (auto actorIndex = 0u; actorIndex < actors.size(); ++actorIndex)
+    {
+      auto actor = actors[actorIndex];
+      sum += BasicBehaviors::separation(
+        actor->getPosition(), actor->getMass(),
+        neighborsX[actorIndex].data(), neighborsY[actorIndex].data(),
+        neighborsX[actorIndex].size(), actor->getRadius() * 2).x();
+    }
+    glbSink = sum;
+  }
+}
+
+void QS::EngineBenchmarks::nearestNSense(BenchmarkState &theState)
+{
+  BenchmarkScenario scenario(theState.getNumberActors(),
+                             theState.getDensity());
+  const auto &actors = scenario.getActors();
+  std::vector<const Exit*> exits;
+
+  NearestN nearestN({{"N", "4"}, {"radius", "2.0"}}, "");
+
+  // Sensing is currently done against all Actors in the world, so the cost
+  // per Actor grows with the number of Actors. A spread out sample of
+  // Actors is sensed each iteration.
+  auto sampleSize = std::min(actors.size(), NEARESTN_SAMPLE_SIZE);
+  auto stride = actors.size() / sampleSize;
+  theState.setItemsPerIteration(sampleSize);
+  while (theState.keepRunning())
+  {
+    std::size_t sum = 0;
+    for (auto sample = 0u; sample < sampleSize; ++sample)
+    {
+      Sensable sensable(actors[sample * stride], actors, exits,
+                        UPDATE_INTERVAL_S);
+      nearestN.sense(sensable);
+      sum += nearestN.getActors().size();
+    }
+    glbSink = sum;
+  }
+}
+
+void QS::EngineBenchmarks::propertyGeneratorGenerateProperty(
+  BenchmarkState &theState)
+{
+  Metrics metrics;
+  World world(metrics);
+  world.setDimensions(100.0, 100.0);
+  world.setSeed(1);
+  PropertyGenerator generator(world);
+
+  SimulationEntityConfiguration configuration("Actor", "", "");
+  configuration.addProperty("radius", "0.2");
+
+  // A mix of typical generated properties.
+  const std::vector<std::string> expressions{
+    ":rand(0.5, 99.5)",
+    ":this.radius * 2.0 + 1.5",
+    ":(world.width - this.radius) / 2",
+    ":PI * this.radius * this.radius"
+  };
+
+  auto numberProperties = theState.getNumberActors();
+  theState.setItemsPerIteration(numberProperties);
+  while (theState.keepRunning())
+  {
+    std::size_t sum = 0;
+    for (auto ii = 0u; ii < numberProperties; ++ii)
+    {
+      sum += generator.generateProperty(
+        expressions[ii % expressions.size()], configuration).size();
+    }
+    glbSink = sum;
+  }
+}
+
+void QS::EngineBenchmarks::spatialHashBuild(BenchmarkState &theState)
+{
+  BenchmarkScenario scenario(theState.getNumberActors(),
+                             theState.getDensity());
+
+  theState.setItemsPerIteration(scenario.getActors().size());
+  while (theState.keepRunning())
+  {
+    auto hash = buildHash(scenario);
+    glbSink = hash.getNumberCells();
+  }
+}
+
+void QS::EngineBenchmarks::spatialHashQuery(BenchmarkState &theState)
+{
+  BenchmarkScenario scenario(theState.getNumberActors(),
+                             theState.getDensity());
+  auto hash = buildHash(scenario);
+  const auto &actors = scenario.getActors();
+
+  theState.setItemsPerIteration(actors.size());
+  while (theState.keepRunning())
+  {
+    std::size_t sum = 0;
+    for (auto actor : actors)
+    {
+      sum += hash.getActors(actor->getPosition(), NEIGHBOR_RADIUS_M).size();
+    }
+    glbSink = sum;
+  }
+}
+
+void QS::EngineBenchmarks::spatialHashRemove(BenchmarkState &theState)
+{
+  BenchmarkScenario scenario(theState.getNumberActors(),
+                             theState.getDensity());
+  const auto &actors = scenario.getActors();
+
+  theState.setItemsPerIteration(actors.size());
+  while (theState.keepRunning())
+  {
+    theState.pauseTiming();
+    auto hash = buildHash(scenario);
+    theState.resumeTiming();
+
+    for (auto actor : actors)
+    {
+      hash.removeActor(actor);
+    }
+    glbSink = hash.getNumberCells();
+  }
+}
+
+void QS::EngineBenchmarks::sweptCirclesClip(BenchmarkState &theState)
+{
+  ::sweptCirclesClip(theState, false);
+}
+
+void QS::EngineBenchmarks::sweptCirclesClipSequential(
+  BenchmarkState &theState)
+{
+  ::sweptCirclesClip(theState, true);
+}
+
+void QS::EngineBenchmarks::worldCollisionDetection(BenchmarkState &theState)
+{
+  BenchmarkScenario scenario(theState.getNumberActors(),
+                             theState.getDensity());
+  scenario.addActorsToWorld();
+  auto hash = buildHash(scenario);
+  const auto &actors = scenario.getActors();
+
+  // Each Actor moves as far as it can in one update, in directions spread
+  // around the circle (golden angle steps).
+  std::vector<Eigen::Vector2f> motions;
+  for (auto actorIndex = 0u; actorIndex < actors.size(); ++actorIndex)
+  {
+    float angle = actorIndex * 2.39996323;
+    float distance = actors[actorIndex]->getMaximumSpeed() *
+      UPDATE_INTERVAL_S;
+    motions.emplace_back(distance * std::cos(angle),
+                         distance * std::sin(angle));
+  }
+
+  // Every Actor is timed, rather than the frame profiler's sample.
+  const World &world = scenario.getWorld();
+  SweptCircles neighbors;
+  theState.setItemsPerIteration(actors.size());
+  while (theState.keepRunning())
+  {
+    float sum = 0.0;
+    for (auto actorIndex = 0u; actorIndex < actors.size(); ++actorIndex)
+    {
+      sum += world.collisionDetection(actors[actorIndex], motions[actorIndex],
+                                      hash, neighbors).x();
+    }
+    glbSink = sum;
+  }
+}
+
+void QS::EngineBenchmarks::worldUpdate(BenchmarkState &theState)
+{
+  BenchmarkScenario scenario(theState.getNumberActors(),
+                             theState.getDensity());
+  scenario.createBehaviors();
+  scenario.addActorsToWorld();
+  NullActorUpdateCallback callback;
+
+  FrameProfiler::PhaseTimes phaseTotals{};
+  theState.setItemsPerIteration(scenario.getActors().size());
+  while (theState.keepRunning())
+  {
+    scenario.getWorld().update(UPDATE_INTERVAL_S, callback);
+
+    theState.pauseTiming();
+    auto phaseTimes = scenario.getMetrics().getSnapshot().myPhaseTimes;
+    for (auto phase = 0u; phase < FrameProfiler::NUMBER_PHASES; ++phase)
+    {
+      phaseTotals[phase] += phaseTimes[phase];
+    }
+    theState.resumeTiming();
+  }
+
+#ifdef QS_PROFILER_ENABLED
+  // Per phase breakdown, in nanoseconds per Actor per frame.
+  double actorFrames = static_cast<double>(theState.getIterations()) *
+    scenario.getActors().size();
+  for (auto phase = 0u; phase < FrameProfiler::NUMBER_PHASES; ++phase)
+  {
+    theState.setCounter(
+      getCounterName(static_cast<FrameProfiler::Phase>(phase)) +
+      "_ns_per_actor",
+      phaseTotals[phase] * 1.0e9 / actorFrames);
+  }
+#endif
+}
@@ -0,0 +1,379 @@
+/**
+ * @file MacroBenchmark.cpp
+ * @brief Definition of MacroBenchmark
+ *
+ * @author Michael Albers
+ */
+
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include "ActorUpdateCallback.h"
+#include "MacroBenchmark.h"
+#include "Simulation.h"
+
+namespace
+{
+  /**
+   * Actor update callback which does nothing.
+   */
+  class NullActorUpdateCallback : public QS::ActorUpdateCallback
+  {
+    public:
+
+    /**
+     * Does nothing.
+     *
+     * @param theActor
+     *          updated Actor
+     */
+    virtual void actorUpdate(const QS::Actor *theActor) noexcept override
+    {
+    }
+  };
+
+  /**
+   * Returns the peak resident set size of this process.
+   *
+   * @return peak RSS, in kilobytes
+   */
+  std::uint64_t getPeakRSS()
+  {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+      return 0;
+    }
+    return usage.ru_maxrss;
+  }
+
+  /**
+   * Escapes a string for use as a JSON string value.
+   *
+   * @param theString
+   *          string to escape
+   * @return escaped string (without quotes)
+   */
+  std::string escape(const std::string &theString)
+  {
+    std::string escaped;
+    for (auto character : theString)
+    {
+      if ('"' == character || '\\' == character)
+      {
+        escaped += '\\';
+        escaped += character;
+      }
+      else if (static_cast<unsigned char>(character) < 0x20)
+      {
+        char code[8];
+        std::snprintf(code, sizeof(code), "\\u%04x", character);
+        escaped += code;
+      }
+      else
+      {
+        escaped += character;
+      }
+    }
+    return escaped;
+  }
+
+  /**
+   * Sets the per second values of a result from its totals.
+   *
+   * @param theResult
+   *          result to update
+   */
+  void setRates(QS::MacroBenchmark::Result &theResult)
+  {
+    if (theResult.myWallTime_s > 0.0)
+    {
+      theResult.myStepsPerSecond = theResult.mySteps / theResult.myWallTime_s;
+      theResult.myActorUpdatesPerSecond =
+        theResult.myNumberActorUpdates / theResult.myWallTime_s;
+      theResult.myRealTimeFactor =
+        theResult.mySimulatedTime_s / theResult.myWallTime_s;
+    }
+  }
+}
+
+bool QS::MacroBenchmark::compare(const std::vector<Result> &theResults,
+                                 std::istream &theBaseline,
+                                 double theTolerance, std::ostream &theReport)
+{
+  std::map<std::string, const Result*> results;
+  for (const auto &result : theResults)
+  {
+    results[result.myName] = &result;
+  }
+
+  // The baseline is read back from writeJSON's output, which has one
+  // simulation per line, rather than with a general JSON parser.
+  const std::string nameKey{"\"name\": \""};
+  const std::string stepsKey{"\"steps_per_second\": "};
+  bool passed = true;
+  std::string line;
+  while (std::getline(theBaseline, line))
+  {
+    auto nameStart = line.find(nameKey);
+    auto stepsStart = line.find(stepsKey);
+    if (std::string::npos == nameStart || std::string::npos == stepsStart ||
+        line.find("\"error\"") != std::string::npos)
+    {
+      continue;
+    }
+    nameStart += nameKey.size();
+    auto name = line.substr(nameStart, line.find('"', nameStart) - nameStart);
+    auto baselineStepsPerSecond =
+      std::stod(line.substr(stepsStart + stepsKey.size()));
+
+    auto result = results.find(name);
+    if (result == results.end())
+    {
+      // Renamed or dropped simulations mustn't pass unnoticed.
+      theReport << name << ": no result" << std::endl;
+      passed = false;
+    }
+    else if (! result->second->myError.empty())
+    {
+      theReport << name << ": failed: " << result->second->myError
+                << std::endl;
+      passed = false;
+    }
+    else if (result->second->myStepsPerSecond <
+             baselineStepsPerSecond * (1.0 - theTolerance))
+    {
+      theReport << name << ": " << result->second->myStepsPerSecond
+                << " steps/s, baseline " << baselineStepsPerSecond
+                << " steps/s (" << std::fixed << std::setprecision(1)
+                << (1.0 - result->second->myStepsPerSecond /
+                    baselineStepsPerSecond) * 100.0
+                << "% slower)" << std::endl;
+      theReport.unsetf(std::ios_base::floatfield);
+      theReport << std::setprecision(6);
+      passed = false;
+    }
+  }
+  return passed;
+}
+
+QS::MacroBenchmark::Result QS::MacroBenchmark::run(
+  const std::string &theBaseDir,
+  const std::string &theSimulationFile,
+  std::uint64_t theSteps, float theInterval_s)
+{
+  Result result;
+  result.myName = theSimulationFile.substr(
+    theSimulationFile.find_last_of('/') + 1);
+
+  try
+  {
+    auto loadStart = std::chrono::steady_clock::now();
+    Simulation simulation(theBaseDir, theSimulationFile);
+    std::chrono::duration<double> loadTime =
+      std::chrono::steady_clock::now() - loadStart;
+    result.myLoadTime_s = loadTime.count();
+
+    auto &world = simulation.getWorld();
+    result.myNumberActors = world.getActors().size();
+
+    NullActorUpdateCallback callback;
+    auto runStart = std::chrono::steady_clock::now();
+    bool allExited = false;
+    while (result.mySteps < theSteps && ! allExited)
+    {
+      result.myNumberActorUpdates += world.getActorsInWorld().size();
+      allExited = world.update(theInterval_s, callback);
+      ++result.mySteps;
+    }
+    std::chrono::duration<double> runTime =
+      std::chrono::steady_clock::now() - runStart;
+    result.myWallTime_s = runTime.count();
+    result.mySimulatedTime_s = result.mySteps * theInterval_s;
+    setRates(result);
+  }
+  catch (const std::exception &exception)
+  {
+    result.myError = exception.what();
+  }
+
+  result.myPeakRSS_kB = getPeakRSS();
+  return result;
+}
+
+QS::MacroBenchmark::Result QS::MacroBenchmark::runIsolated(
+  const std::string &theBaseDir,
+  const std::string &theSimulationFile,
+  std::uint64_t theSteps, float theInterval_s)
+{
+  int pipeDescriptors[2];
+  if (pipe(pipeDescriptors) != 0)
+  {
+    throw std::runtime_error(std::string{"Failed to create pipe: "} +
+                             std::strerror(errno));
+  }
+
+  auto child = fork();
+  if (child < 0)
+  {
+    auto thisErrno = errno;
+    close(pipeDescriptors[0]);
+    close(pipeDescriptors[1]);
+    throw std::runtime_error(std::string{"Failed to fork: "} +
+                             std::strerror(thisErrno));
+  }
+
+  if (0 == child)
+  {
+    close(pipeDescriptors[0]);
+    auto result = run(theBaseDir, theSimulationFile, theSteps, theInterval_s);
+
+    // Totals only, the parent works out the rates. The error is last as it
+    // can contain anything.
+    std::ostringstream message;
+    message << std::setprecision(17) << result.myLoadTime_s << " "
+            << result.myNumberActorUpdates << " " << result.myNumberActors
+            << " " << result.mySimulatedTime_s << " " << result.mySteps << " "
+            << result.myWallTime_s << " " << result.myError;
+    auto data = message.str();
+    std::size_t written = 0;
+    while (written < data.size())
+    {
+      auto count = write(pipeDescriptors[1], data.data() + written,
+                         data.size() - written);
+      if (count <= 0)
+      {
+        break;
+      }
+      written += count;
+    }
+    close(pipeDescriptors[1]);
+    _exit(0);
+  }
+
+  close(pipeDescriptors[1]);
+  std::string data;
+  char buffer[4096];
+  ssize_t count;
+  while ((count = read(pipeDescriptors[0], buffer, sizeof(buffer))) != 0)
+  {
+    if (count < 0)
+    {
+      if (EINTR == errno)
+      {
+        continue;
+      }
+      break;
+    }
+    data.append(buffer, count);
+  }
+  close(pipeDescriptors[0]);
+
+  int status = 0;
+  struct rusage usage;
+  while (wait4(child, &status, 0, &usage) < 0 && EINTR == errno)
+  {
+  }
+
+  Result result;
+  result.myName = theSimulationFile.substr(
+    theSimulationFile.find_last_of('/') + 1);
+  result.myPeakRSS_kB = usage.ru_maxrss;
+
+  std::istringstream message(data);
+  message >> result.myLoadTime_s >> result.myNumberActorUpdates
+          >> result.myNumberActors >> result.mySimulatedTime_s
+          >> result.mySteps >> result.myWallTime_s;
+  if (! message)
+  {
+    std::ostringstream error;
+    error << "Benchmark process ";
+    if (WIFSIGNALED(status))
+    {
+      error << "killed by signal " << WTERMSIG(status);
+    }
+    else
+    {
+      error << "exited with status " << WEXITSTATUS(status)
+            << " without a result";
+    }
+    Result failed;
+    failed.myError = error.str();
+    failed.myName = result.myName;
+    failed.myPeakRSS_kB = result.myPeakRSS_kB;
+    return failed;
+  }
+
+  message.get();
+  std::getline(message, result.myError, '\0');
+  setRates(result);
+  return result;
+}
+
+void QS::MacroBenchmark::writeJSON(std::ostream &theOutput,
+                                   const std::vector<Result> &theResults,
+                                   std::uint64_t theSteps,
+                                   float theInterval_s)
+{
+  theOutput << "{" << std::endl
+            << "  \"steps\": " << theSteps << "," << std::endl
+            << "  \"interval_s\": " << std::setprecision(9) << theInterval_s
+            << "," << std::endl
+            << "  \"simulations\": [";
+  bool first = true;
+  for (const auto &result : theResults)
+  {
+    theOutput << (first ? "" : ",") << std::endl
+              << "    {\"name\": \"" << escape(result.myName) << "\""
+              << ", \"actors\": " << result.myNumberActors
+              << ", \"steps\": " << result.mySteps
+              << ", \"load_time_s\": " << result.myLoadTime_s
+              << ", \"wall_time_s\": " << result.myWallTime_s
+              << ", \"simulated_time_s\": " << result.mySimulatedTime_s
+              << ", \"steps_per_second\": " << result.myStepsPerSecond
+              << ", \"actor_updates\": " << result.myNumberActorUpdates
+              << ", \"actor_updates_per_second\": "
+              << result.myActorUpdatesPerSecond
+              << ", \"real_time_factor\": " << result.myRealTimeFactor
+              << ", \"peak_rss_kb\": " << result.myPeakRSS_kB;
+    if (! result.myError.empty())
+    {
+      theOutput << ", \"error\": \"" << escape(result.myError) << "\"";
+    }
+    theOutput << "}";
+    first = false;
+  }
+  theOutput << std::endl << "  ]" << std::endl << "}" << std::endl
+            << std::setprecision(6);
+}
+
+void QS::MacroBenchmark::writeText(std::ostream &theOutput,
+                                   const Result &theResult)
+{
+  theOutput << std::left << std::setw(36) << theResult.myName << std::right
+            << " actors " << std::setw(8) << theResult.myNumberActors;
+  if (! theResult.myError.empty())
+  {
+    theOutput << "  failed (" << theResult.myError << ")" << std::endl;
+    return;
+  }
+
+  theOutput << std::fixed << std::setprecision(2)
+            << "  load " << std::setw(8) << theResult.myLoadTime_s << " s"
+            << "  " << std::setw(10) << theResult.myStepsPerSecond
+            << " steps/s  " << std::setw(12)
+            << theResult.myActorUpdatesPerSecond << " updates/s  RTF "
+            << std::setw(8) << theResult.myRealTimeFactor << "  peak RSS "
+            << theResult.myPeakRSS_kB << " kB" << std::endl;
+  theOutput.unsetf(std::ios_base::floatfield);
+  theOutput << std::setprecision(6);
+}
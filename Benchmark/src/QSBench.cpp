@@ -0,0 +1,214 @@
+/**
+ * @file QSBench.cpp
+ * @brief Contains 'main' for the engine microbenchmarks
+ *
+ * @author Michael Albers
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "BenchmarkRunner.h"
+#include "EngineBenchmarks.h"
+
+namespace
+{
+  /**
+   * Prints usage information.
+   *
+   * @param theProgram
+   *          program name
+   */
+  void usage(const char *theProgram)
+  {
+    std::cerr
+      << "Usage: " << theProgram << " [options]" << std::endl
+      << "  --actors=N[,N...]     Actor counts "
+      << "(default 1000,10000,100000,1000000)" << std::endl
+      << "  --densities=D[,D...]  Actors per square meter (default 0.5,2)"
+      << std::endl
+      << "  --filter=TEXT         only run benchmarks whose name contains TEXT"
+      << std::endl
+      << "  --min-time=SECONDS    minimum time per run (default 0.5)"
+      << std::endl
+      << "  --format=FORMAT       output format: json, csv or text "
+      << "(default text)" << std::endl
+      << "  --output=FILE         write results to FILE (default stdout)"
+      << std::endl
+      << "  --list                list benchmark names and exit" << std::endl
+      << "  --no-limits           run every benchmark with every Actor count,"
+      << std::endl
+      << "                        even those limited for their run time"
+      << std::endl;
+  }
+
+  /**
+   * Parses a comma separated list of values.
+   *
+   * @param theList
+   *          comma separated list
+   * @param theConvert
+   *          converts a single value
+   * @return values
+   * @throws std::invalid_argument
+   *          if a value is invalid
+   */
+  template<class T, class Convert>
+  std::vector<T> parseList(const std::string &theList, Convert theConvert)
+  {
+    std::vector<T> values;
+    std::istringstream list(theList);
+    std::string value;
+    while (std::getline(list, value, ','))
+    {
+      std::size_t end = 0;
+      T number = theConvert(value, &end);
+      if (end != value.size() || number <= 0)
+      {
+        throw std::invalid_argument("Invalid value \"" + value + "\".");
+      }
+      values.push_back(number);
+    }
+    if (values.empty())
+    {
+      throw std::invalid_argument("Empty list \"" + theList + "\".");
+    }
+    return values;
+  }
+}
+
+int main(int argc, char **argv)
+{
+  int status = 1;
+  try
+  {
+    std::vector<std::size_t> numberActors{1000, 10000, 100000, 1000000};
+    std::vector<float> densities{0.5, 2.0};
+    std::string filter;
+    double minimumTime_s = 0.5;
+    std::string format{"text"};
+    std::string outputFileName;
+    bool list = false;
+    bool noLimits = false;
+
+    auto toSize = [](const std::string &theValue, std::size_t *theEnd)
+    {
+      return static_cast<std::size_t>(std::stoull(theValue, theEnd));
+    };
+    auto toFloat = [](const std::string &theValue, std::size_t *theEnd)
+    {
+      return std::stof(theValue, theEnd);
+    };
+
+    for (auto ii = 1; ii < argc; ++ii)
+    {
+      std::string argument{argv[ii]};
+      auto equals = argument.find('=');
+      std::string option = argument.substr(0, equals);
+      std::string value = (std::string::npos == equals) ?
+        "" : argument.substr(equals + 1);
+
+      if ("--actors" == option)
+      {
+        numberActors = parseList<std::size_t>(value, toSize);
+      }
+      else if ("--densities" == option)
+      {
+        densities = parseList<float>(value, toFloat);
+      }
+      else if ("--filter" == option)
+      {
+        filter = value;
+      }
+      else if ("--min-time" == option)
+      {
+        minimumTime_s = std::stod(value);
+      }
+      else if ("--format" == option)
+      {
+        format = value;
+        if (format != "json" && format != "csv" && format != "text")
+        {
+          throw std::invalid_argument("Unknown format \"" + format + "\".");
+        }
+      }
+      else if ("--output" == option)
+      {
+        outputFileName = value;
+      }
+      else if ("--list" == option)
+      {
+        list = true;
+      }
+      else if ("--no-limits" == option)
+      {
+        noLimits = true;
+      }
+      else
+      {
+        usage(argv[0]);
+        return 1;
+      }
+    }
+
+    QS::BenchmarkRunner runner;
+    QS::EngineBenchmarks::addBenchmarks(runner);
+    runner.setIgnoreMaximumActors(noLimits);
+
+    if (list)
+    {
+      for (const auto &name : runner.getNames())
+      {
+        std::cout << name << std::endl;
+      }
+      return 0;
+    }
+
+    std::ofstream outputFile;
+    if (! outputFileName.empty())
+    {
+      outputFile.open(outputFileName);
+      if (! outputFile.is_open())
+      {
+        throw std::runtime_error("Failed to open output file \"" +
+                                 outputFileName + "\".");
+      }
+    }
+    std::ostream &output = outputFile.is_open() ? outputFile : std::cout;
+
+    // Progress goes to stderr unless the results are text to stdout, in
+    // which case the progress is the output.
+    bool textToStdout = ("text" == format && ! outputFile.is_open());
+    std::ostream &progress = textToStdout ? std::cout : std::cerr;
+
+    auto results = runner.run(numberActors, densities, filter, minimumTime_s,
+                              progress);
+
+    if ("json" == format)
+    {
+      QS::BenchmarkRunner::writeJSON(output, results);
+    }
+    else if ("csv" == format)
+    {
+      QS::BenchmarkRunner::writeCSV(output, results);
+    }
+    else if (! textToStdout)
+    {
+      for (const auto &result : results)
+      {
+        QS::BenchmarkRunner::writeText(output, result);
+      }
+    }
+    status = 0;
+  }
+  catch (const std::exception &exception)
+  {
+    std::cerr << argv[0] << ": Fatal error: " << exception.what() << std::endl;
+  }
+
+  return status;
+}
@@ -0,0 +1,342 @@
+/**
+ * @file QSMacroBench.cpp
+ * @brief Contains 'main' for the end-to-end simulation benchmarks
+ *
+ * @author Michael Albers
+ */
+
+#include <dirent.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "xercesc/util/PlatformUtils.hpp"
+#include "xercesc/util/XMLString.hpp"
+#include "EngineOptions.h"
+#include "MacroBenchmark.h"
+#include "ScenarioGenerator.h"
+#include "XMLParser.h"
+
+XERCES_CPP_NAMESPACE_USE
+
+namespace
+{
+  /**
+   * Generated simulations with more Actors than this are run for
+   * proportionally fewer steps.
+   */
+  constexpr std::size_t GENERATED_STEP_ACTORS = 1000;
+
+  /**
+   * Prints usage information.
+   *
+   * @param theProgram
+   *          program name
+   */
+  void usage(const char *theProgram)
+  {
+    std::cerr
+      << "Usage: " << theProgram << " [options]" << std::endl
+      << "  --steps=N             World updates per simulation (default 240)"
+      << std::endl
+      << "  --interval=SECONDS    simulated time per update (default 1/24)"
+      << std::endl
+      << "  --simulations=DIR     directory of simulation files to run "
+      << "(default" << std::endl
+      << "                        $QS_BASE_DIR/simulations)" << std::endl
+      << "  --generated=N[,N...]  Actor counts of generated simulations "
+      << "(default" << std::endl
+      << "                        1000,10000, empty for none). Those over "
+      << "1000 Actors" << std::endl
+      << "                        run for proportionally fewer steps"
+      << std::endl
+      << "  --filter=TEXT         only run simulations whose name contains "
+      << "TEXT" << std::endl
+      << "  --output=FILE         write JSON results to FILE (default stdout)"
+      << std::endl
+      << "  --baseline=FILE       fail if any simulation in FILE is slower, "
+      << "or not run" << std::endl
+      << "  --tolerance=FRACTION  allowed slow down from the baseline "
+      << "(default 0.1)" << std::endl
+      << "  --in-process          run simulations in this process (peak RSS "
+      << "is then" << std::endl
+      << "                        cumulative)" << std::endl;
+  }
+
+  /**
+   * Returns the simulation files (*.xml) in a directory, sorted by name.
+   *
+   * @param theDirectory
+   *          directory to search
+   * @return full paths of the files
+   * @throws std::runtime_error
+   *          if the directory can't be read
+   */
+  std::vector<std::string> findSimulations(const std::string &theDirectory)
+  {
+    auto directory = opendir(theDirectory.c_str());
+    if (nullptr == directory)
+    {
+      throw std::runtime_error("Failed to open simulation directory \"" +
+                               theDirectory + "\": " + std::strerror(errno));
+    }
+
+    std::vector<std::string> files;
+    while (auto entry = readdir(directory))
+    {
+      std::string name{entry->d_name};
+      if (name.size() > 4 && name.compare(name.size() - 4, 4, ".xml") == 0)
+      {
+        files.push_back(theDirectory + "/" + name);
+      }
+    }
+    closedir(directory);
+    std::sort(files.begin(), files.end());
+    return files;
+  }
+
+  /**
+   * Parses a comma separated list of Actor counts.
+   *
+   * @param theList
+   *          comma separated list, may be empty
+   * @return Actor counts
+   * @throws std::invalid_argument
+   *          if a count is invalid
+   */
+  std::vector<std::size_t> parseCounts(const std::string &theList)
+  {
+    std::vector<std::size_t> counts;
+    std::istringstream list(theList);
+    std::string value;
+    while (std::getline(list, value, ','))
+    {
+      std::size_t end = 0;
+      auto count = std::stoull(value, &end);
+      if (end != value.size() || 0 == count)
+      {
+        throw std::invalid_argument("Invalid Actor count \"" + value + "\".");
+      }
+      counts.push_back(count);
+    }
+    return counts;
+  }
+}
+
+int main(int argc, char **argv)
+{
+  int status = 1;
+  std::string generatedDirectory;
+  std::vector<std::string> generatedFiles;
+  try
+  {
+    XMLPlatformUtils::Initialize();
+
+    auto baseDirEnvVar = std::getenv("QS_BASE_DIR");
+    if (NULL == baseDirEnvVar)
+    {
+      throw std::runtime_error("QS_BASE_DIR environment variable is not set.");
+    }
+    std::string baseDir{baseDirEnvVar};
+
+    // Opt-in engine features are enabled as by the simulator (i.e., so load
+    // times with a warm scenario cache can be measured).
+    QS::EngineOptions::enableFromEnvironment();
+
+    std::uint64_t steps = 240;
+    float interval_s = 1.0 / 24.0;
+    std::string simulationsDirectory{baseDir + "/simulations"};
+    std::vector<std::size_t> generatedActors{1000, 10000};
+    std::string filter;
+    std::string outputFileName;
+    std::string baselineFileName;
+    double tolerance = 0.1;
+    bool inProcess = false;
+
+    for (auto ii = 1; ii < argc; ++ii)
+    {
+      std::string argument{argv[ii]};
+      auto equals = argument.find('=');
+      std::string option = argument.substr(0, equals);
+      std::string value = (std::string::npos == equals) ?
+        "" : argument.substr(equals + 1);
+
+      if ("--steps" == option)
+      {
+        steps = std::stoull(value);
+      }
+      else if ("--interval" == option)
+      {
+        interval_s = std::stof(value);
+        if (interval_s <= 0.0)
+        {
+          throw std::invalid_argument("Interval must be greater than 0.");
+        }
+      }
+      else if ("--simulations" == option)
+      {
+        simulationsDirectory = value;
+      }
+      else if ("--generated" == option)
+      {
+        generatedActors = parseCounts(value);
+      }
+      else if ("--filter" == option)
+      {
+        filter = value;
+      }
+      else if ("--output" == option)
+      {
+        outputFileName = value;
+      }
+      else if ("--baseline" == option)
+      {
+        baselineFileName = value;
+      }
+      else if ("--tolerance" == option)
+      {
+        tolerance = std::stod(value);
+      }
+      else if ("--in-process" == option)
+      {
+        inProcess = true;
+      }
+      else
+      {
+        usage(argv[0]);
+        return 1;
+      }
+    }
+
+    std::vector<std::string> simulationFiles;
+    if (! simulationsDirectory.empty())
+    {
+      simulationFiles = findSimulations(simulationsDirectory);
+    }
+    std::vector<std::uint64_t> simulationSteps(simulationFiles.size(), steps);
+
+    // Generated simulations go in a temporary directory, removed at exit.
+    if (! generatedActors.empty())
+    {
+      char directoryTemplate[] = "/tmp/qs-macro-bench-XXXXXX";
+      if (nullptr == mkdtemp(directoryTemplate))
+      {
+        throw std::runtime_error(
+          std::string{"Failed to create temporary directory: "} +
+          std::strerror(errno));
+      }
+      generatedDirectory = directoryTemplate;
+
+      for (auto numberActors : generatedActors)
+      {
+        QS::ScenarioGenerator::Parameters parameters;
+        parameters.myNumberActors = numberActors;
+        parameters.myNumberExits = 4;
+        std::string fileName{generatedDirectory + "/Generated" +
+                             std::to_string(numberActors) + ".xml"};
+        generatedFiles.push_back(fileName);
+        std::ofstream file(fileName);
+        QS::ScenarioGenerator(parameters).generate(file);
+        file.close();
+        if (! file)
+        {
+          throw std::runtime_error("Failed to write \"" + fileName + "\".");
+        }
+        simulationFiles.push_back(fileName);
+
+        // Sensing is quadratic in Actors, so large simulations are run for
+        // the same number of Actor updates as a 1000 Actor one, rather than
+        // the same number of steps.
+        simulationSteps.push_back(
+          std::max<std::uint64_t>(steps * GENERATED_STEP_ACTORS /
+                                  std::max(numberActors,
+                                           GENERATED_STEP_ACTORS), 1));
+      }
+    }
+
+    std::vector<QS::MacroBenchmark::Result> results;
+    for (auto ii = 0u; ii < simulationFiles.size(); ++ii)
+    {
+      const auto &simulationFile = simulationFiles[ii];
+      auto name = simulationFile.substr(simulationFile.find_last_of('/') + 1);
+      if (name.find(filter) == std::string::npos)
+      {
+        continue;
+      }
+
+      auto result = inProcess ?
+        QS::MacroBenchmark::run(baseDir, simulationFile, simulationSteps[ii],
+                                interval_s) :
+        QS::MacroBenchmark::runIsolated(baseDir, simulationFile,
+                                        simulationSteps[ii], interval_s);
+      QS::MacroBenchmark::writeText(std::cerr, result);
+      results.push_back(result);
+    }
+
+    std::ofstream outputFile;
+    if (! outputFileName.empty())
+    {
+      outputFile.open(outputFileName);
+      if (! outputFile.is_open())
+      {
+        throw std::runtime_error("Failed to open output file \"" +
+                                 outputFileName + "\".");
+      }
+    }
+    std::ostream &output = outputFile.is_open() ? outputFile : std::cout;
+    QS::MacroBenchmark::writeJSON(output, results, steps, interval_s);
+
+    status = 0;
+    if (! baselineFileName.empty())
+    {
+      std::ifstream baseline(baselineFileName);
+      if (! baseline.is_open())
+      {
+        throw std::runtime_error("Failed to open baseline file \"" +
+                                 baselineFileName + "\".");
+      }
+      if (! QS::MacroBenchmark::compare(results, baseline, tolerance,
+                                        std::cerr))
+      {
+        std::cerr << argv[0] << ": Slower than the baseline, or a "
+                  << "simulation in it wasn't run." << std::endl;
+        status = 1;
+      }
+    }
+
+    QS::XMLParser::releaseGrammars();
+    XMLPlatformUtils::Terminate();
+  }
+  catch (const std::exception &exception)
+  {
+    std::cerr << argv[0] << ": Fatal error: " << exception.what() << std::endl;
+    status = 1;
+  }
+  catch (const XMLException &exception)
+  {
+    char *transcodedError = XMLString::transcode(exception.getMessage());
+    std::cerr << argv[0] << ": Fatal error initializing xerces: "
+              << transcodedError << std::endl;
+    XMLString::release(&transcodedError);
+    status = 1;
+  }
+
+  for (const auto &file : generatedFiles)
+  {
+    unlink(file.c_str());
+  }
+  if (! generatedDirectory.empty())
+  {
+    rmdir(generatedDirectory.c_str());
+  }
+
+  return status;
+}
@@ -0,0 +1,208 @@
+/**
+ * @file QSScenarioGen.cpp
+ * @brief Contains 'main' for the scenario generator
+ *
+ * @author Michael Albers
+ */
+
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "ScenarioGenerator.h"
+
+namespace
+{
+  /**
+   * Prints usage information.
+   *
+   * @param theProgram
+   *          program name
+   */
+  void usage(const char *theProgram)
+  {
+    std::cerr
+      << "Usage: " << theProgram << " [options]" << std::endl
+      << "  --actors=N            number of Actors (default from world size "
+      << "and density)" << std::endl
+      << "  --width=METERS        world width" << std::endl
+      << "  --length=METERS       world length (default width)" << std::endl
+      << "  --density=D           Actors per square meter, used when either "
+      << "the" << std::endl
+      << "                        world size or Actor count isn't given "
+      << "(default 0.5)" << std::endl
+      << "  --radius=MIN[,MAX]    Actor radius range (default 0.25)"
+      << std::endl
+      << "  --exits=N             number of OrderedExits (default 1)"
+      << std::endl
+      << "  --exit-radius=METERS  Exit radius (default 1)" << std::endl
+      << "  --exit-placement=P    corners, perimeter or random "
+      << "(default perimeter)" << std::endl
+      << "  --mix=G,L,O           relative weights of GreedyOrderedActor, "
+      << "LooseOrderedActor" << std::endl
+      << "                        and OrderedActor (default 1,1,0)"
+      << std::endl
+      << "  --seed=N              random seed (default 1)" << std::endl
+      << "  --output=FILE         write to FILE (default stdout)"
+      << std::endl;
+  }
+
+  /**
+   * Converts a string to a float, the whole string must be used.
+   *
+   * @param theValue
+   *          string to convert
+   * @return value
+   * @throws std::invalid_argument
+   *          if the string isn't a number
+   */
+  float toFloat(const std::string &theValue)
+  {
+    std::size_t end = 0;
+    auto value = std::stof(theValue, &end);
+    if (end != theValue.size())
+    {
+      throw std::invalid_argument("Invalid number \"" + theValue + "\".");
+    }
+    return value;
+  }
+
+  /**
+   * Converts a string to an unsigned integer, the whole string must be used.
+   *
+   * @param theValue
+   *          string to convert
+   * @return value
+   * @throws std::invalid_argument
+   *          if the string isn't a non-negative integer
+   */
+  unsigned long long toUnsigned(const std::string &theValue)
+  {
+    std::size_t end = 0;
+    auto value = std::stoull(theValue, &end);
+    if (end != theValue.size() || theValue.find('-') != std::string::npos)
+    {
+      throw std::invalid_argument("Invalid integer \"" + theValue + "\".");
+    }
+    return value;
+  }
+}
+
+int main(int argc, char **argv)
+{
+  int status = 1;
+  try
+  {
+    QS::ScenarioGenerator::Parameters parameters;
+    std::string outputFileName;
+
+    for (auto ii = 1; ii < argc; ++ii)
+    {
+      std::string argument{argv[ii]};
+      auto equals = argument.find('=');
+      std::string option = argument.substr(0, equals);
+      std::string value = (std::string::npos == equals) ?
+        "" : argument.substr(equals + 1);
+
+      if ("--actors" == option)
+      {
+        parameters.myNumberActors = toUnsigned(value);
+      }
+      else if ("--width" == option)
+      {
+        parameters.myWorldWidth_m = toFloat(value);
+      }
+      else if ("--length" == option)
+      {
+        parameters.myWorldLength_m = toFloat(value);
+      }
+      else if ("--density" == option)
+      {
+        parameters.myDensity = toFloat(value);
+      }
+      else if ("--radius" == option)
+      {
+        auto comma = value.find(',');
+        parameters.myMinimumRadius_m = toFloat(value.substr(0, comma));
+        parameters.myMaximumRadius_m = (std::string::npos == comma) ?
+          parameters.myMinimumRadius_m : toFloat(value.substr(comma + 1));
+      }
+      else if ("--exits" == option)
+      {
+        parameters.myNumberExits = toUnsigned(value);
+      }
+      else if ("--exit-radius" == option)
+      {
+        parameters.myExitRadius_m = toFloat(value);
+      }
+      else if ("--exit-placement" == option)
+      {
+        parameters.myExitPlacement =
+          QS::ScenarioGenerator::toExitPlacement(value);
+      }
+      else if ("--mix" == option)
+      {
+        auto first = value.find(',');
+        auto second = value.find(',', first + 1);
+        if (std::string::npos == first || std::string::npos == second)
+        {
+          throw std::invalid_argument("Invalid mix \"" + value + "\".");
+        }
+        parameters.myGreedyWeight = toFloat(value.substr(0, first));
+        parameters.myLooseWeight =
+          toFloat(value.substr(first + 1, second - first - 1));
+        parameters.myOrderedWeight = toFloat(value.substr(second + 1));
+      }
+      else if ("--seed" == option)
+      {
+        parameters.mySeed = toUnsigned(value);
+      }
+      else if ("--output" == option)
+      {
+        outputFileName = value;
+      }
+      else
+      {
+        usage(argv[0]);
+        return 1;
+      }
+    }
+
+    if (parameters.myWorldLength_m <= 0.0)
+    {
+      parameters.myWorldLength_m = parameters.myWorldWidth_m;
+    }
+
+    QS::ScenarioGenerator generator(parameters);
+
+    std::ofstream outputFile;
+    if (! outputFileName.empty())
+    {
+      outputFile.open(outputFileName);
+      if (! outputFile.is_open())
+      {
+        throw std::runtime_error("Failed to open output file \"" +
+                                 outputFileName + "\".");
+      }
+    }
+    std::ostream &output = outputFile.is_open() ? outputFile : std::cout;
+
+    generator.generate(output);
+    output.flush();
+    if (! output)
+    {
+      throw std::runtime_error("Failed writing the simulation file.");
+    }
+
+    std::cerr << "Generated " << generator.getNumberActors() << " Actors in a "
+              << generator.getWorldWidth() << " x "
+              << generator.getWorldLength() << " m world." << std::endl;
+    status = 0;
+  }
+  catch (const std::exception &exception)
+  {
+    std::cerr << argv[0] << ": Fatal error: " << exception.what() << std::endl;
+  }
+
+  return status;
+}
@@ -0,0 +1,567 @@
+/**
+ * @file ScenarioGenerator.cpp
+ * @brief Definition of ScenarioGenerator
+ *
+ * @author Michael Albers
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include "ScenarioGenerator.h"
+
+namespace
+{
+  /** Gap kept between Exits and the world edges, in meters. */
+  constexpr float EXIT_MARGIN_M = 0.01;
+
+  /** Number of bytes buffered before writing to the output stream. */
+  constexpr std::size_t OUTPUT_BUFFER_SIZE = 1 << 20;
+
+  /** Actor type names, indexed by the type distribution. */
+  const char* const glbActorTypes[] = {
+    "GreedyOrderedActor",
+    "LooseOrderedActor",
+    "OrderedActor"
+  };
+
+  /** Actor colors, by type. */
+  const char* const glbActorColors[] = {
+    "0.0 0.0 1.0",
+    "0.0 0.6 0.0",
+    "0.6 0.0 0.0"
+  };
+
+  /**
+   * BehaviorSet configuration, by type. These match the hand written
+   * QueueingPlugin simulations.
+   */
+  const char* const glbBehaviorSets[] = {
+    // GreedyOrderedActor
+    "        <BehaviorSet type=\"GreedyOrdering\" source=\"QueueingPlugin\">\n"
+    "          <Behavior type=\"CollisionAvoidance\""
+    " source=\"QueueingPlugin\">\n"
+    "            <Sensor type=\"NearestN\" source=\"QueueingPlugin\">\n"
+    "              <Property key=\"N\" value=\"1000\" />\n"
+    "              <Property key=\"radius\" value=\"5.0\" />\n"
+    "            </Sensor>\n"
+    "          </Behavior>\n"
+    "        </BehaviorSet>\n"
+    "        <BehaviorSet type=\"SemiRationalOrdering\""
+    " source=\"QueueingPlugin\">\n"
+    "          <Behavior type=\"CollisionAvoidance\""
+    " source=\"QueueingPlugin\">\n"
+    "            <Sensor type=\"NearestN\" source=\"QueueingPlugin\">\n"
+    "              <Property key=\"N\" value=\"3\" />\n"
+    "              <Property key=\"radius\" value=\"5.0\" />\n"
+    "            </Sensor>\n"
+    "          </Behavior>\n"
+    "          <Behavior type=\"Separation\" source=\"QueueingPlugin\">\n"
+    "            <Sensor type=\"NearestN\" source=\"QueueingPlugin\">\n"
+    "              <Property key=\"N\" value=\"10\" />\n"
+    "              <Property key=\"radius\" value=\"3.0\" />\n"
+    "            </Sensor>\n"
+    "          </Behavior>\n"
+    "        </BehaviorSet>\n",
+
+    // LooseOrderedActor and OrderedActor
+    "        <BehaviorSet type=\"LooseOrdering\" source=\"QueueingPlugin\">\n"
+    "          <Behavior type=\"CollisionAvoidance\""
+    " source=\"QueueingPlugin\">\n"
+    "            <Sensor type=\"NearestN\" source=\"QueueingPlugin\">\n"
+    "              <Property key=\"N\" value=\"1000\" />\n"
+    "              <Property key=\"radius\" value=\"5.0\" />\n"
+    "            </Sensor>\n"
+    "          </Behavior>\n"
+    "          <Behavior type=\"OrderedLeaderFollow\""
+    " source=\"QueueingPlugin\">\n"
+    "            <Sensor type=\"NearestN\" source=\"QueueingPlugin\">\n"
+    "              <Property key=\"N\" value=\"15\" />\n"
+    "              <Property key=\"radius\" value=\"50.0\" />\n"
+    "            </Sensor>\n"
+    "          </Behavior>\n"
+    "        </BehaviorSet>\n"
+  };
+
+  /**
+   * Buffers output so millions of Actors can be written quickly.
+   */
+  class OutputBuffer
+  {
+    public:
+
+    /**
+     * Constructor.
+     *
+     * @param theOutput
+     *          stream written to
+     */
+    explicit OutputBuffer(std::ostream &theOutput) :
+      myOutput(theOutput)
+    {
+      myBuffer.reserve(OUTPUT_BUFFER_SIZE + 4096);
+    }
+
+    /**
+     * Destructor. Writes anything still buffered.
+     */
+    ~OutputBuffer()
+    {
+      flush();
+    }
+
+    /**
+     * Appends a string.
+     *
+     * @param theString
+     *          string to append
+     * @return this
+     */
+    OutputBuffer& operator<<(const char *theString)
+    {
+      myBuffer += theString;
+      return *this;
+    }
+
+    /**
+     * Appends a number with up to four decimal places.
+     *
+     * @param theNumber
+     *          number to append
+     * @return this
+     */
+    OutputBuffer& operator<<(double theNumber)
+    {
+      char number[32];
+      auto length = std::snprintf(number, sizeof(number), "%.4f", theNumber);
+      myBuffer.append(number, length);
+      return *this;
+    }
+
+    /**
+     * Appends an integer.
+     *
+     * @param theNumber
+     *          number to append
+     * @return this
+     */
+    OutputBuffer& operator<<(unsigned long long theNumber)
+    {
+      char number[32];
+      auto length = std::snprintf(number, sizeof(number), "%llu", theNumber);
+      myBuffer.append(number, length);
+      return *this;
+    }
+
+    /**
+     * Writes the buffer to the stream if it is full.
+     */
+    void flushIfFull()
+    {
+      if (myBuffer.size() >= OUTPUT_BUFFER_SIZE)
+      {
+        flush();
+      }
+    }
+
+    /**
+     * Writes the buffer to the stream.
+     */
+    void flush()
+    {
+      myOutput.write(myBuffer.data(), myBuffer.size());
+      myBuffer.clear();
+    }
+
+    private:
+
+    /** Buffered output. */
+    std::string myBuffer;
+
+    /** Stream written to. */
+    std::ostream &myOutput;
+  };
+}
+
+QS::ScenarioGenerator::ScenarioGenerator(const Parameters &theParameters) :
+  myParameters(theParameters)
+{
+  auto &parameters = myParameters;
+
+  if (parameters.myMinimumRadius_m <= 0.0 ||
+      parameters.myMaximumRadius_m < parameters.myMinimumRadius_m)
+  {
+    throw std::invalid_argument(
+      "Actor radii must be greater than 0, with the maximum no smaller than "
+      "the minimum.");
+  }
+
+  if (parameters.myGreedyWeight < 0.0 || parameters.myLooseWeight < 0.0 ||
+      parameters.myOrderedWeight < 0.0 ||
+      (parameters.myGreedyWeight + parameters.myLooseWeight +
+       parameters.myOrderedWeight) <= 0.0)
+  {
+    throw std::invalid_argument(
+      "Actor type weights must not be negative, and at least one must be "
+      "greater than 0.");
+  }
+
+  if (parameters.myNumberExits > 0 && parameters.myExitRadius_m <= 0.0)
+  {
+    throw std::invalid_argument("Exit radius must be greater than 0.");
+  }
+
+  bool haveWorldSize = (parameters.myWorldWidth_m > 0.0 &&
+                        parameters.myWorldLength_m > 0.0);
+  if (! haveWorldSize || 0 == parameters.myNumberActors)
+  {
+    if (parameters.myDensity <= 0.0)
+    {
+      throw std::invalid_argument("Density must be greater than 0.");
+    }
+  }
+
+  if (! haveWorldSize)
+  {
+    if (0 == parameters.myNumberActors)
+    {
+      throw std::invalid_argument(
+        "Either the world size or the number of Actors must be given.");
+    }
+    float size = std::sqrt(parameters.myNumberActors / parameters.myDensity);
+    parameters.myWorldWidth_m = size;
+    parameters.myWorldLength_m = size;
+  }
+  else if (0 == parameters.myNumberActors)
+  {
+    parameters.myNumberActors = static_cast<std::size_t>(
+      static_cast<double>(parameters.myWorldWidth_m) *
+      parameters.myWorldLength_m * parameters.myDensity);
+    if (0 == parameters.myNumberActors)
+    {
+      throw std::invalid_argument("World is too small for even one Actor.");
+    }
+  }
+
+  placeExits();
+  sizeGrid();
+}
+
+void QS::ScenarioGenerator::generate(std::ostream &theOutput) const
+{
+  const auto &parameters = myParameters;
+  auto numberActors = parameters.myNumberActors;
+
+  std::mt19937 engine(parameters.mySeed);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  std::uniform_real_distribution<float> radius(parameters.myMinimumRadius_m,
+                                               parameters.myMaximumRadius_m);
+  std::uniform_real_distribution<float> maximumSpeed(1.0, 5.0);
+  std::uniform_real_distribution<float> orientation(0.0, 2 * M_PI);
+  std::discrete_distribution<int> type{parameters.myGreedyWeight,
+                                       parameters.myLooseWeight,
+                                       parameters.myOrderedWeight};
+
+  std::vector<std::uint32_t> ranks(numberActors);
+  std::iota(ranks.begin(), ranks.end(), 0);
+  std::shuffle(ranks.begin(), ranks.end(), engine);
+
+  OutputBuffer output(theOutput);
+  output << "<?xml version='1.0' encoding='UTF-8'?>\n\n"
+         << "<!--\n  Generated by qs-scenario-gen: "
+         << static_cast<unsigned long long>(numberActors) << " Actors, "
+         << static_cast<unsigned long long>(parameters.myNumberExits)
+         << " OrderedExits, seed "
+         << static_cast<unsigned long long>(parameters.mySeed) << ".\n-->\n\n"
+         << "<Simulation>\n  <Seed value=\""
+         << static_cast<unsigned long long>(parameters.mySeed) << "\" />\n"
+         << "  <World width=\"" << parameters.myWorldWidth_m
+         << "\" length=\"" << parameters.myWorldLength_m << "\">\n"
+         << "    <Actors>\n";
+
+  // Selection sampling: each usable cell is picked with probability
+  // (Actors left to place) / (usable cells left), which uses exactly the
+  // needed number of cells, uniformly at random, in a single pass.
+  std::size_t actorsLeft = numberActors;
+  std::size_t cellsLeft = myNumberUsableCells;
+  auto numberExits = myExitPositions.size();
+  for (auto row = 0u; row < myNumberRows && actorsLeft > 0; ++row)
+  {
+    for (auto column = 0u; column < myNumberColumns && actorsLeft > 0;
+         ++column)
+    {
+      if (isBlocked(column, row, numberExits))
+      {
+        continue;
+      }
+
+      if (unit(engine) * cellsLeft-- >= actorsLeft)
+      {
+        continue;
+      }
+
+      auto actorRadius = radius(engine);
+      auto play = myCellSize_m - 2 * actorRadius;
+      auto x = myXOffset_m + column * myCellSize_m + actorRadius +
+        unit(engine) * play;
+      auto y = myYOffset_m + row * myCellSize_m + actorRadius +
+        unit(engine) * play;
+      auto actorType = type(engine);
+      auto rank = ranks[numberActors - actorsLeft];
+      --actorsLeft;
+
+      output << "      <Actor type=\"" << glbActorTypes[actorType]
+             << "\" source=\"QueueingPlugin\">\n"
+             << "        <Property key=\"mass\" value=\"1.0\" />\n"
+             << "        <Property key=\"radius\" value=\"" << actorRadius
+             << "\" />\n"
+             << "        <Property key=\"x\" value=\"" << x << "\" />\n"
+             << "        <Property key=\"y\" value=\"" << y << "\" />\n"
+             << "        <Property key=\"max speed\" value=\""
+             << maximumSpeed(engine) << "\" />\n"
+             << "        <Property key=\"max force\" value=\"10000.0\" />\n"
+             << "        <Property key=\"orientation\" value=\""
+             << orientation(engine) << "\" />\n"
+             << "        <Property key=\"color\" value=\""
+             << glbActorColors[actorType] << "\" />\n"
+             << "        <Property key=\"rank\" value=\""
+             << static_cast<unsigned long long>(rank) << "\" />\n"
+             << glbBehaviorSets[std::min(actorType, 1)]
+             << "      </Actor>\n";
+      output.flushIfFull();
+    }
+  }
+
+  output << "    </Actors>\n";
+  if (numberExits > 0)
+  {
+    output << "    <Exits>\n";
+    for (const auto &exit : myExitPositions)
+    {
+      output << "      <Exit type=\"OrderedExit\" source=\"QueueingPlugin\">\n"
+             << "        <Property key=\"radius\" value=\""
+             << parameters.myExitRadius_m << "\" />\n"
+             << "        <Property key=\"x\" value=\"" << exit.first
+             << "\" />\n"
+             << "        <Property key=\"y\" value=\"" << exit.second
+             << "\" />\n"
+             << "        <Property key=\"color\" value=\"0.35 0.6 0.1\" />\n"
+             << "      </Exit>\n";
+    }
+    output << "    </Exits>\n";
+  }
+  output << "  </World>\n</Simulation>\n";
+}
+
+std::size_t QS::ScenarioGenerator::getNumberActors() const noexcept
+{
+  return myParameters.myNumberActors;
+}
+
+float QS::ScenarioGenerator::getWorldLength() const noexcept
+{
+  return myParameters.myWorldLength_m;
+}
+
+float QS::ScenarioGenerator::getWorldWidth() const noexcept
+{
+  return myParameters.myWorldWidth_m;
+}
+
+bool QS::ScenarioGenerator::isBlocked(std::size_t theColumn, std::size_t theRow,
+                                      std::size_t theNumberExits) const
+  noexcept
+{
+  // Any point of the cell is within half a diagonal of its center.
+  float cellX = myXOffset_m + (theColumn + 0.5f) * myCellSize_m;
+  float cellY = myYOffset_m + (theRow + 0.5f) * myCellSize_m;
+  float clearance = myParameters.myExitRadius_m +
+    myCellSize_m * static_cast<float>(M_SQRT1_2);
+  for (auto exit = 0u; exit < theNumberExits; ++exit)
+  {
+    float deltaX = cellX - myExitPositions[exit].first;
+    float deltaY = cellY - myExitPositions[exit].second;
+    if (deltaX * deltaX + deltaY * deltaY < clearance * clearance)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+void QS::ScenarioGenerator::placeExits()
+{
+  const auto &parameters = myParameters;
+  auto numberExits = parameters.myNumberExits;
+  float width = parameters.myWorldWidth_m;
+  float length = parameters.myWorldLength_m;
+  float inset = parameters.myExitRadius_m + EXIT_MARGIN_M;
+  if (numberExits > 0 && (width < 2 * inset || length < 2 * inset))
+  {
+    throw std::invalid_argument("Exit radius is too large for the world.");
+  }
+
+  myExitPositions.clear();
+  switch (parameters.myExitPlacement)
+  {
+    case ExitPlacement::Corners:
+    {
+      if (numberExits > 4)
+      {
+        throw std::invalid_argument(
+          "At most 4 Exits can be placed in the corners.");
+      }
+      const std::pair<float, float> corners[] = {
+        {inset, inset},
+        {width - inset, length - inset},
+        {width - inset, inset},
+        {inset, length - inset}};
+      myExitPositions.assign(corners, corners + numberExits);
+      break;
+    }
+
+    case ExitPlacement::Perimeter:
+    {
+      // Evenly spaced along the rectangle the Exit centers can be on, going
+      // around counter clockwise from the origin corner.
+      float innerWidth = width - 2 * inset;
+      float innerLength = length - 2 * inset;
+      float perimeter = 2 * (innerWidth + innerLength);
+      for (auto exit = 0u; exit < numberExits; ++exit)
+      {
+        float distance = (exit + 0.5f) * perimeter / numberExits;
+        std::pair<float, float> position;
+        if (distance < innerWidth)
+        {
+          position = {inset + distance, inset};
+        }
+        else if ((distance -= innerWidth) < innerLength)
+        {
+          position = {width - inset, inset + distance};
+        }
+        else if ((distance -= innerLength) < innerWidth)
+        {
+          position = {width - inset - distance, length - inset};
+        }
+        else
+        {
+          distance -= innerWidth;
+          position = {inset, length - inset - distance};
+        }
+        myExitPositions.push_back(position);
+      }
+      break;
+    }
+
+    case ExitPlacement::Random:
+    {
+      // A separate engine so Actor placement doesn't depend on the number
+      // of Exits.
+      std::seed_seq seed{parameters.mySeed, 1u};
+      std::mt19937 engine(seed);
+      std::uniform_real_distribution<float> x(inset, width - inset);
+      std::uniform_real_distribution<float> y(inset, length - inset);
+      for (auto exit = 0u; exit < numberExits; ++exit)
+      {
+        myExitPositions.push_back({x(engine), y(engine)});
+      }
+      break;
+    }
+  }
+}
+
+void QS::ScenarioGenerator::sizeGrid()
+{
+  const auto &parameters = myParameters;
+  auto numberActors = parameters.myNumberActors;
+  float width = parameters.myWorldWidth_m;
+  float length = parameters.myWorldLength_m;
+
+  // Start with a cell per Actor over the whole world, and shrink the cells
+  // until, after rounding to whole cells and removing those near Exits,
+  // there are enough.
+  myCellSize_m = std::sqrt(static_cast<double>(width) * length /
+                           numberActors);
+  float minimumCellSize = 2 * parameters.myMaximumRadius_m * 1.001f;
+  while (true)
+  {
+    if (myCellSize_m < minimumCellSize)
+    {
+      throw std::invalid_argument(
+        "Cannot place " + std::to_string(numberActors) + " Actors with a "
+        "maximum radius of " + std::to_string(parameters.myMaximumRadius_m) +
+        " without overlap, lower the density or Actor radius.");
+    }
+
+    myNumberColumns = static_cast<std::size_t>(width / myCellSize_m);
+    myNumberRows = static_cast<std::size_t>(length / myCellSize_m);
+    myXOffset_m = (width - myNumberColumns * myCellSize_m) / 2;
+    myYOffset_m = (length - myNumberRows * myCellSize_m) / 2;
+
+    // Only the cells around each Exit need checking. A cell blocked by more
+    // than one Exit is counted against the first.
+    std::size_t numberBlocked = 0;
+    float clearance = parameters.myExitRadius_m + myCellSize_m;
+    for (auto exit = 0u; exit < myExitPositions.size(); ++exit)
+    {
+      const auto &position = myExitPositions[exit];
+      auto toCell = [=](float theCoordinate, float theOffset,
+                        std::size_t theNumberCells)
+      {
+        float cell = std::floor((theCoordinate - theOffset) / myCellSize_m);
+        cell = std::max(0.0f, std::min(cell, theNumberCells - 1.0f));
+        return static_cast<std::size_t>(cell);
+      };
+      auto firstColumn = toCell(position.first - clearance, myXOffset_m,
+                                myNumberColumns);
+      auto lastColumn = toCell(position.first + clearance, myXOffset_m,
+                               myNumberColumns);
+      auto firstRow = toCell(position.second - clearance, myYOffset_m,
+                             myNumberRows);
+      auto lastRow = toCell(position.second + clearance, myYOffset_m,
+                            myNumberRows);
+      for (auto row = firstRow; row <= lastRow && myNumberRows > 0; ++row)
+      {
+        for (auto column = firstColumn;
+             column <= lastColumn && myNumberColumns > 0; ++column)
+        {
+          if (isBlocked(column, row, exit + 1) &&
+              ! isBlocked(column, row, exit))
+          {
+            ++numberBlocked;
+          }
+        }
+      }
+    }
+
+    myNumberUsableCells = myNumberColumns * myNumberRows - numberBlocked;
+    if (myNumberUsableCells >= numberActors)
+    {
+      break;
+    }
+    myCellSize_m *= 0.99;
+  }
+}
+
+QS::ScenarioGenerator::ExitPlacement QS::ScenarioGenerator::toExitPlacement(
+  const std::string &theName)
+{
+  if ("corners" == theName)
+  {
+    return ExitPlacement::Corners;
+  }
+  else if ("perimeter" == theName)
+  {
+    return ExitPlacement::Perimeter;
+  }
+  else if ("random" == theName)
+  {
+    return ExitPlacement::Random;
+  }
+  throw std::invalid_argument("Unknown Exit placement \"" + theName +
+                              "\", valid placements are \"corners\", "
+                              "\"perimeter\" and \"random\".");
+}
@@ -0,0 +1,108 @@
+/**
+ * @file BenchmarkRunnerTest.cpp
+ * @brief Unit tests for BenchmarkRunner class
+ *
+ * @author Michael Albers
+ */
+
+#include <sstream>
+#include <stdexcept>
+#include "gtest/gtest.h"
+#include "BenchmarkRunner.h"
+#include "BenchmarkState.h"
+
+namespace
+{
+  void countActors(QS::BenchmarkState &theState)
+  {
+    theState.setItemsPerIteration(theState.getNumberActors());
+    theState.setCounter("density", theState.getDensity());
+    while (theState.keepRunning())
+    {
+      theState.addManualTime(theState.getNumberActors() * 1.0e-9);
+    }
+  }
+}
+
+GTEST_TEST(BenchmarkRunnerTest, addBenchmark)
+{
+  QS::BenchmarkRunner runner;
+  runner.addBenchmark("A/one", countActors, 10);
+  runner.addBenchmark("B/two", countActors, 10);
+  EXPECT_THROW(runner.addBenchmark("A/one", countActors, 10),
+               std::invalid_argument);
+
+  std::vector<std::string> expected{"A/one", "B/two"};
+  EXPECT_EQ(expected, runner.getNames());
+}
+
+GTEST_TEST(BenchmarkRunnerTest, run)
+{
+  QS::BenchmarkRunner runner;
+  runner.addBenchmark("A/one", countActors, 100);
+  runner.addBenchmark("B/two", countActors, 1000);
+
+  std::ostringstream progress;
+  auto results = runner.run({100, 1000}, {0.5, 2.0}, "", 0.0, progress);
+  ASSERT_EQ(8u, results.size());
+
+  // Benchmark, then Actors, then density order.
+  EXPECT_EQ("A/one", results[0].myName);
+  EXPECT_EQ(100u, results[0].myNumberActors);
+  EXPECT_FLOAT_EQ(0.5, results[0].myDensity);
+  EXPECT_FLOAT_EQ(2.0, results[1].myDensity);
+  EXPECT_EQ(1000u, results[2].myNumberActors);
+  EXPECT_EQ("B/two", results[4].myName);
+
+  EXPECT_EQ(1u, results[0].myIterations);
+  EXPECT_EQ(100u, results[0].myItemsPerIteration);
+  EXPECT_DOUBLE_EQ(100.0, results[0].myNsPerIteration);
+  EXPECT_DOUBLE_EQ(1.0, results[0].myNsPerItem);
+  EXPECT_DOUBLE_EQ(2.0, results[1].myCounters.at("density"));
+
+  // Too many Actors for A/one.
+  EXPECT_FALSE(results[2].mySkipReason.empty());
+  EXPECT_EQ(0u, results[2].myIterations);
+  EXPECT_TRUE(results[6].mySkipReason.empty());
+
+  EXPECT_NE(std::string::npos, progress.str().find("skipped"));
+
+  results = runner.run({100}, {1.0}, "two", 0.0, progress);
+  ASSERT_EQ(1u, results.size());
+  EXPECT_EQ("B/two", results[0].myName);
+
+  runner.setIgnoreMaximumActors(true);
+  results = runner.run({1000}, {1.0}, "one", 0.0, progress);
+  ASSERT_EQ(1u, results.size());
+  EXPECT_TRUE(results[0].mySkipReason.empty());
+  EXPECT_EQ(1000u, results[0].myItemsPerIteration);
+}
+
+GTEST_TEST(BenchmarkRunnerTest, output)
+{
+  QS::BenchmarkRunner runner;
+  runner.addBenchmark("A/one", countActors, 100);
+
+  std::ostringstream progress;
+  auto results = runner.run({100, 1000}, {1.0}, "", 0.0, progress);
+
+  std::ostringstream json;
+  QS::BenchmarkRunner::writeJSON(json, results);
+  EXPECT_NE(std::string::npos, json.str().find(
+              "{\"name\": \"A/one\", \"actors\": 100, \"density\": 1, "
+              "\"iterations\": 1, \"items_per_iteration\": 100"));
+  EXPECT_NE(std::string::npos, json.str().find("\"ns_per_item\": 1,"));
+  EXPECT_NE(std::string::npos, json.str().find("\"skipped\": "));
+  EXPECT_NE(std::string::npos,
+            json.str().find("\"counters\": {\"density\": 1}"));
+
+  std::ostringstream csv;
+  QS::BenchmarkRunner::writeCSV(csv, results);
+  std::istringstream csvLines(csv.str());
+  std::string line;
+  std::getline(csvLines, line);
+  EXPECT_EQ("name,actors,density,iterations,items_per_iteration,time_s,"
+            "ns_per_iteration,ns_per_item,skipped,counters", line);
+  std::getline(csvLines, line);
+  EXPECT_EQ("A/one,100,1,1,100,1e-07,100,1,,density=1", line);
+}
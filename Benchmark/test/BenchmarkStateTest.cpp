@@ -0,0 +1,76 @@
+/**
+ * @file BenchmarkStateTest.cpp
+ * @brief Unit tests for BenchmarkState class
+ *
+ * @author Michael Albers
+ */
+
+#include <chrono>
+#include <thread>
+#include "gtest/gtest.h"
+#include "BenchmarkState.h"
+
+GTEST_TEST(BenchmarkStateTest, construction)
+{
+  QS::BenchmarkState state(100, 0.5, 0.0);
+  EXPECT_EQ(100u, state.getNumberActors());
+  EXPECT_FLOAT_EQ(0.5, state.getDensity());
+  EXPECT_EQ(1u, state.getItemsPerIteration());
+  EXPECT_EQ(0u, state.getIterations());
+  EXPECT_EQ(0.0, state.getMeasuredTime());
+  EXPECT_TRUE(state.getSkipReason().empty());
+}
+
+GTEST_TEST(BenchmarkStateTest, loop)
+{
+  // Always at least one iteration.
+  QS::BenchmarkState state(1, 1.0, 0.0);
+  auto iterations = 0u;
+  while (state.keepRunning())
+  {
+    ++iterations;
+  }
+  EXPECT_EQ(1u, iterations);
+  EXPECT_EQ(1u, state.getIterations());
+
+  // Runs until the minimum time.
+  QS::BenchmarkState timedState(1, 1.0, 0.02);
+  while (timedState.keepRunning())
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  EXPECT_GE(timedState.getMeasuredTime(), 0.02);
+  EXPECT_GE(timedState.getIterations(), 4u);
+}
+
+GTEST_TEST(BenchmarkStateTest, pause)
+{
+  QS::BenchmarkState state(1, 1.0, 0.0);
+  while (state.keepRunning())
+  {
+    state.pauseTiming();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    state.resumeTiming();
+  }
+  EXPECT_LT(state.getMeasuredTime(), 0.02);
+}
+
+GTEST_TEST(BenchmarkStateTest, manualTime)
+{
+  QS::BenchmarkState state(1, 1.0, 1.0);
+  while (state.keepRunning())
+  {
+    state.addManualTime(0.25);
+  }
+  EXPECT_EQ(4u, state.getIterations());
+  EXPECT_DOUBLE_EQ(1.0, state.getMeasuredTime());
+}
+
+GTEST_TEST(BenchmarkStateTest, skip)
+{
+  QS::BenchmarkState state(1, 1.0, 0.0);
+  state.skip("not today");
+  EXPECT_FALSE(state.keepRunning());
+  EXPECT_EQ(0u, state.getIterations());
+  EXPECT_EQ("not today", state.getSkipReason());
+}
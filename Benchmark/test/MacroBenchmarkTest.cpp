@@ -0,0 +1,96 @@
+/**
+ * @file MacroBenchmarkTest.cpp
+ * @brief Unit tests for MacroBenchmark class
+ *
+ * @author Michael Albers
+ */
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "MacroBenchmark.h"
+
+namespace
+{
+  QS::MacroBenchmark::Result makeResult(const std::string &theName,
+                                        double theStepsPerSecond)
+  {
+    QS::MacroBenchmark::Result result;
+    result.myName = theName;
+    result.myNumberActors = 10;
+    result.mySteps = 100;
+    result.myNumberActorUpdates = 1000;
+    result.myWallTime_s = 100 / theStepsPerSecond;
+    result.mySimulatedTime_s = 4.0;
+    result.myStepsPerSecond = theStepsPerSecond;
+    result.myActorUpdatesPerSecond = theStepsPerSecond * 10;
+    result.myRealTimeFactor = 4.0 / result.myWallTime_s;
+    return result;
+  }
+}
+
+GTEST_TEST(MacroBenchmarkTest, writeJSON)
+{
+  auto failed = makeResult("Bad.xml", 0.0);
+  failed.myError = "Error \"here\"\n";
+  std::vector<QS::MacroBenchmark::Result> results{
+    makeResult("A.xml", 200.0), failed};
+
+  std::ostringstream output;
+  QS::MacroBenchmark::writeJSON(output, results, 100, 0.04);
+  auto json = output.str();
+  EXPECT_NE(std::string::npos, json.find("\"steps\": 100,"));
+  EXPECT_NE(std::string::npos,
+            json.find("{\"name\": \"A.xml\", \"actors\": 10, \"steps\": 100"));
+  EXPECT_NE(std::string::npos, json.find("\"steps_per_second\": 200,"));
+  EXPECT_NE(std::string::npos,
+            json.find("\"actor_updates_per_second\": 2000,"));
+  EXPECT_NE(std::string::npos, json.find("\"real_time_factor\": 8,"));
+  EXPECT_NE(std::string::npos,
+            json.find("\"error\": \"Error \\\"here\\\"\\u000a\"}"));
+}
+
+GTEST_TEST(MacroBenchmarkTest, compare)
+{
+  std::vector<QS::MacroBenchmark::Result> baselineResults{
+    makeResult("A.xml", 200.0), makeResult("B.xml", 100.0),
+    makeResult("C.xml", 50.0)};
+  std::ostringstream baseline;
+  QS::MacroBenchmark::writeJSON(baseline, baselineResults, 100, 0.04);
+
+  std::ostringstream report;
+  std::istringstream same(baseline.str());
+  EXPECT_TRUE(QS::MacroBenchmark::compare(baselineResults, same, 0.1,
+                                          report));
+  EXPECT_TRUE(report.str().empty());
+
+  // Within tolerance, and a simulation not in the baseline.
+  std::vector<QS::MacroBenchmark::Result> results{
+    makeResult("A.xml", 185.0), makeResult("B.xml", 100.0),
+    makeResult("C.xml", 50.0), makeResult("D.xml", 1.0)};
+  std::istringstream withinTolerance(baseline.str());
+  EXPECT_TRUE(QS::MacroBenchmark::compare(results, withinTolerance, 0.1,
+                                          report));
+  EXPECT_TRUE(report.str().empty());
+
+  // A simulation in the baseline with no result.
+  std::vector<QS::MacroBenchmark::Result> missing(results.begin() + 1,
+                                                  results.end());
+  std::istringstream notRun(baseline.str());
+  EXPECT_FALSE(QS::MacroBenchmark::compare(missing, notRun, 0.1, report));
+  EXPECT_NE(std::string::npos, report.str().find("A.xml: no result"));
+
+  report.str("");
+  results[0].myStepsPerSecond = 170.0;
+  std::istringstream slower(baseline.str());
+  EXPECT_FALSE(QS::MacroBenchmark::compare(results, slower, 0.1, report));
+  EXPECT_NE(std::string::npos, report.str().find("A.xml"));
+
+  report.str("");
+  results[0].myStepsPerSecond = 200.0;
+  results[1].myError = "failed to load";
+  std::istringstream failed(baseline.str());
+  EXPECT_FALSE(QS::MacroBenchmark::compare(results, failed, 0.1, report));
+  EXPECT_NE(std::string::npos, report.str().find("B.xml: failed"));
+}
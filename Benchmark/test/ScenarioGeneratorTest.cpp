@@ -0,0 +1,223 @@
+/**
+ * @file ScenarioGeneratorTest.cpp
+ * @brief Unit tests for ScenarioGenerator class
+ *
+ * @author Michael Albers
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "ScenarioGenerator.h"
+
+namespace
+{
+  /** Values read back from a generated Actor or Exit. */
+  class Entity
+  {
+    public:
+    std::map<std::string, std::string> myProperties;
+    std::string myType;
+
+    float get(const std::string &theKey) const
+    {
+      return std::stof(myProperties.at(theKey));
+    }
+  };
+
+  /**
+   * Reads the top level properties of each Actor and Exit back from a
+   * generated file.
+   */
+  void parse(const std::string &theFile, std::vector<Entity> &theActors,
+             std::vector<Entity> &theExits)
+  {
+    std::istringstream input(theFile);
+    std::string line;
+    Entity *entity = nullptr;
+    auto attribute = [&](const std::string &theName)
+    {
+      auto start = line.find(theName + "=\"") + theName.size() + 2;
+      return line.substr(start, line.find('"', start) - start);
+    };
+    while (std::getline(input, line))
+    {
+      if (line.find("<Actor ") != std::string::npos)
+      {
+        theActors.emplace_back();
+        entity = &theActors.back();
+        entity->myType = attribute("type");
+      }
+      else if (line.find("<Exit ") != std::string::npos)
+      {
+        theExits.emplace_back();
+        entity = &theExits.back();
+        entity->myType = attribute("type");
+      }
+      else if (line.find("<BehaviorSet ") != std::string::npos)
+      {
+        entity = nullptr;
+      }
+      else if (entity && line.find("<Property ") != std::string::npos)
+      {
+        entity->myProperties[attribute("key")] = attribute("value");
+      }
+    }
+  }
+
+  std::string generate(const QS::ScenarioGenerator::Parameters &theParameters)
+  {
+    QS::ScenarioGenerator generator(theParameters);
+    std::ostringstream output;
+    generator.generate(output);
+    return output.str();
+  }
+}
+
+GTEST_TEST(ScenarioGeneratorTest, errors)
+{
+  QS::ScenarioGenerator::Parameters parameters;
+  EXPECT_THROW(QS::ScenarioGenerator{parameters}, std::invalid_argument);
+
+  parameters.myNumberActors = 100;
+  EXPECT_NO_THROW(QS::ScenarioGenerator{parameters});
+
+  auto badParameters = parameters;
+  badParameters.myMinimumRadius_m = 0.5;
+  badParameters.myMaximumRadius_m = 0.4;
+  EXPECT_THROW(QS::ScenarioGenerator{badParameters}, std::invalid_argument);
+
+  badParameters = parameters;
+  badParameters.myGreedyWeight = 0.0;
+  badParameters.myLooseWeight = 0.0;
+  EXPECT_THROW(QS::ScenarioGenerator{badParameters}, std::invalid_argument);
+
+  badParameters = parameters;
+  badParameters.myDensity = 5.0;
+  EXPECT_THROW(QS::ScenarioGenerator{badParameters}, std::invalid_argument);
+
+  badParameters = parameters;
+  badParameters.myNumberExits = 5;
+  badParameters.myExitPlacement =
+    QS::ScenarioGenerator::ExitPlacement::Corners;
+  EXPECT_THROW(QS::ScenarioGenerator{badParameters}, std::invalid_argument);
+
+  EXPECT_THROW(QS::ScenarioGenerator::toExitPlacement("middle"),
+               std::invalid_argument);
+}
+
+GTEST_TEST(ScenarioGeneratorTest, worldSize)
+{
+  QS::ScenarioGenerator::Parameters parameters;
+  parameters.myNumberActors = 800;
+  parameters.myDensity = 2.0;
+  QS::ScenarioGenerator fromCount(parameters);
+  EXPECT_FLOAT_EQ(20.0, fromCount.getWorldWidth());
+  EXPECT_FLOAT_EQ(20.0, fromCount.getWorldLength());
+
+  parameters.myNumberActors = 0;
+  parameters.myWorldWidth_m = 10.0;
+  parameters.myWorldLength_m = 30.0;
+  QS::ScenarioGenerator fromSize(parameters);
+  EXPECT_EQ(600u, fromSize.getNumberActors());
+  EXPECT_FLOAT_EQ(10.0, fromSize.getWorldWidth());
+  EXPECT_FLOAT_EQ(30.0, fromSize.getWorldLength());
+}
+
+GTEST_TEST(ScenarioGeneratorTest, generate)
+{
+  QS::ScenarioGenerator::Parameters parameters;
+  parameters.myNumberActors = 2000;
+  parameters.myDensity = 1.5;
+  parameters.myMinimumRadius_m = 0.2;
+  parameters.myMaximumRadius_m = 0.35;
+  parameters.myNumberExits = 3;
+  parameters.myExitRadius_m = 2.0;
+  parameters.myGreedyWeight = 1.0;
+  parameters.myLooseWeight = 1.0;
+  parameters.myOrderedWeight = 1.0;
+  QS::ScenarioGenerator generator(parameters);
+  float width = generator.getWorldWidth();
+  float length = generator.getWorldLength();
+
+  std::vector<Entity> actors;
+  std::vector<Entity> exits;
+  parse(generate(parameters), actors, exits);
+  ASSERT_EQ(2000u, actors.size());
+  ASSERT_EQ(3u, exits.size());
+
+  std::map<std::string, int> types;
+  std::vector<unsigned> ranks;
+  for (const auto &actor : actors)
+  {
+    ++types[actor.myType];
+    ranks.push_back(std::stoul(actor.myProperties.at("rank")));
+    float radius = actor.get("radius");
+    EXPECT_GE(radius, 0.2);
+    EXPECT_LE(radius, 0.35);
+    EXPECT_GE(actor.get("x") - radius, 0.0);
+    EXPECT_LE(actor.get("x") + radius, width);
+    EXPECT_GE(actor.get("y") - radius, 0.0);
+    EXPECT_LE(actor.get("y") + radius, length);
+  }
+  EXPECT_EQ(3u, types.size());
+
+  std::sort(ranks.begin(), ranks.end());
+  for (auto rank = 0u; rank < ranks.size(); ++rank)
+  {
+    ASSERT_EQ(rank, ranks[rank]);
+  }
+
+  // No Actor overlaps another Actor or an Exit.
+  std::vector<float> x, y, radius;
+  for (const auto &entity : actors)
+  {
+    x.push_back(entity.get("x"));
+    y.push_back(entity.get("y"));
+    radius.push_back(entity.get("radius"));
+  }
+  for (const auto &entity : exits)
+  {
+    x.push_back(entity.get("x"));
+    y.push_back(entity.get("y"));
+    radius.push_back(entity.get("radius"));
+  }
+  for (auto ii = 0u; ii < actors.size(); ++ii)
+  {
+    for (auto jj = ii + 1; jj < x.size(); ++jj)
+    {
+      ASSERT_GE(std::hypot(x[ii] - x[jj], y[ii] - y[jj]),
+                radius[ii] + radius[jj]) << ii << " " << jj;
+    }
+  }
+
+  for (const auto &exit : exits)
+  {
+    EXPECT_EQ("OrderedExit", exit.myType);
+    // Perimeter placement, touching an edge.
+    float exitX = exit.get("x");
+    float exitY = exit.get("y");
+    float edgeDistance = std::min(std::min(exitX, width - exitX),
+                                  std::min(exitY, length - exitY));
+    EXPECT_NEAR(2.0, edgeDistance, 0.02);
+  }
+}
+
+GTEST_TEST(ScenarioGeneratorTest, deterministic)
+{
+  QS::ScenarioGenerator::Parameters parameters;
+  parameters.myNumberActors = 500;
+  parameters.myNumberExits = 2;
+  parameters.myExitPlacement = QS::ScenarioGenerator::ExitPlacement::Random;
+
+  auto first = generate(parameters);
+  EXPECT_EQ(first, generate(parameters));
+
+  parameters.mySeed = 2;
+  EXPECT_NE(first, generate(parameters));
+}
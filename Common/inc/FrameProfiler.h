@@ -0,0 +1,202 @@
+#pragma once
+
+/**
+ * @file FrameProfiler.h
+ * @brief Low overhead, scoped timing of the phases of a simulation update.
+ *
+ * @author Michael Albers
+ */
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include "PerfCounters.h"
+#include "QSConfig.h"
+#include "Tracer.h"
+
+/**
+ * Times the remainder of the enclosing scope as the given
+ * FrameProfiler::Phase (i.e., QS_PROFILE_PHASE(Hash)). Expands to nothing if
+ * the profiler is disabled at build time (QS_PROFILER_ENABLED CMake option).
+ */
+#ifdef QS_PROFILER_ENABLED
+#define QS_PROFILE_CONCAT_INNER(a, b) a ## b
+#define QS_PROFILE_CONCAT(a, b) QS_PROFILE_CONCAT_INNER(a, b)
+#define QS_PROFILE_PHASE(thePhase)                                      \
+  QS::FrameProfiler::ScopedTimer QS_PROFILE_CONCAT(qsPhaseTimer, __LINE__)( \
+    QS::FrameProfiler::Phase::thePhase)
+#else
+#define QS_PROFILE_PHASE(thePhase)
+#endif
+
+namespace QS
+{
+  /**
+   * Accumulates time spent in each phase of a simulation update. Timers are
+   * scoped (see ScopedTimer and QS_PROFILE_PHASE) and may be nested; a
+   * phase's time excludes that of any timers nested in it. Times accumulate
+   * per thread until endFrame is called on that thread. Each timed phase is
+   * also recorded as a Tracer event.
+   *
+   * Reading the clock for every pass through a tight loop (i.e., once per
+   * Actor) costs more than the work being timed, so such loops should time
+   * a sample of their passes (see setSampleWeight).
+   *
+   * If PerfCounters are enabled, hardware counters are accumulated per phase
+   * in the same way (see endFrameCounters). Reading the counters is a system
+   * call, so this inflates the phase times.
+   */
+  class FrameProfiler
+  {
+    public:
+
+    /** Phases of an update. */
+    enum class Phase : std::uint32_t
+    {
+      /**
+       * Update time not in any other phase. Not timed directly, the owner
+       * of the update loop calculates it from the total update time.
+       */
+      Update,
+      /** Building/maintaining the spatial hash. */
+      Hash,
+      /** Sensors sensing the world. */
+      Sense,
+      /** Evaluating behaviors (excluding sensing). */
+      Evaluate,
+      /** Collision detection. */
+      Collision,
+      /** Checking Exits. */
+      Exit,
+      /** Actor update callback (i.e., visualization). */
+      Callback
+    };
+
+    /** Number of values in Phase. */
+    static constexpr std::size_t NUMBER_PHASES = 7;
+
+    /** Time, in seconds, spent in each phase (indexed by Phase). */
+    using PhaseTimes = std::array<float, NUMBER_PHASES>;
+
+    /** Hardware counter values for each phase (indexed by Phase). */
+    using PhaseCounters = std::array<PerfCounters::Values, NUMBER_PHASES>;
+
+    /**
+     * Times its own lifetime as a single phase.
+     */
+    class ScopedTimer
+    {
+      public:
+
+      /**
+       * Default constructor.
+       */
+      ScopedTimer() = delete;
+
+      /**
+       * Constructor. Starts the timer.
+       *
+       * @param thePhase
+       *          phase being timed
+       */
+      ScopedTimer(Phase thePhase) noexcept;
+
+      /**
+       * Copy constructor.
+       */
+      ScopedTimer(const ScopedTimer&) = delete;
+
+      /**
+       * Move constructor.
+       */
+      ScopedTimer(ScopedTimer&&) = delete;
+
+      /**
+       * Destructor. Stops the timer and adds its time to the phase.
+       */
+      ~ScopedTimer();
+
+      /**
+       * Copy assignment operator.
+       */
+      ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+      /**
+       * Move assignment operator.
+       */
+      ScopedTimer& operator=(ScopedTimer&&) = delete;
+
+      private:
+
+      /** Counter values for timers nested within this one. */
+      PerfCounters::Values myChildCounters{};
+
+      /** Time spent in timers nested within this one. */
+      std::chrono::steady_clock::duration myChildTime{0};
+
+      /** Whether hardware counters are being read. */
+      bool myCounting;
+
+      /** Enclosing timer on this thread, if any. */
+      ScopedTimer *myParent;
+
+      /** Phase being timed. */
+      const Phase myPhase;
+
+      /** Start time. */
+      const std::chrono::steady_clock::time_point myStart;
+
+      /** Counter values at the start. */
+      PerfCounters::Values myStartCounters;
+
+      /** Records the phase in the trace, if tracing is enabled. */
+      Tracer::Scope myTraceScope;
+
+      /** Sample weight at the start, 0 if the timer isn't running. */
+      const std::uint32_t myWeight;
+    };
+
+    /**
+     * Returns the time accumulated in each phase on the calling thread since
+     * the previous call, and resets the accumulated times.
+     *
+     * @return time spent in each phase
+     */
+    static PhaseTimes endFrame() noexcept;
+
+    /**
+     * Returns the hardware counter values accumulated in each phase on the
+     * calling thread since the previous call, and resets them. All values
+     * are 0 if PerfCounters aren't enabled/available.
+     *
+     * @return counter values for each phase
+     */
+    static PhaseCounters endFrameCounters() noexcept;
+
+    /**
+     * Returns the display name of the given phase.
+     *
+     * @param thePhase
+     *          phase
+     * @return display name
+     */
+    static const char* getPhaseName(Phase thePhase) noexcept;
+
+    /**
+     * Sets the weight of timers subsequently started on the calling thread.
+     * A timer's time and counter values are multiplied by its weight, and a
+     * timer with a weight of 0 doesn't read the clock or the counters at
+     * all. So a loop timing one in N passes, with a weight of N, costs
+     * 1/N of timing every pass and estimates the same totals. The weight is
+     * 1 until this is called.
+     *
+     * @param theWeight
+     *          weight of subsequent timers
+     */
+    static void setSampleWeight(std::uint32_t theWeight) noexcept;
+
+    protected:
+
+    private:
+  };
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+/**
+ * @file PerfCounters.h
+ * @brief Per-thread hardware performance counters (Linux perf_event_open).
+ *
+ * @author Michael Albers
+ */
+
+#include <array>
+#include <cstdint>
+
+namespace QS
+{
+  /**
+   * Reads hardware performance counters (cycles, instructions, cache misses
+   * and branch misses) for the calling thread. The counters count user space
+   * events only and are opened lazily, per thread, on the first read after
+   * enable is called.
+   *
+   * Counters are only available on Linux, when built with the
+   * QS_PERF_COUNTERS_ENABLED CMake option, and when the kernel allows it
+   * (see /proc/sys/kernel/perf_event_paranoid). Otherwise read always fails.
+   */
+  class PerfCounters
+  {
+    public:
+
+    /** Counted events. */
+    enum class Counter : std::uint32_t
+    {
+      /** CPU cycles. */
+      Cycles,
+      /** Retired instructions. */
+      Instructions,
+      /** Last level cache misses. */
+      CacheMisses,
+      /** Mispredicted branches. */
+      BranchMisses
+    };
+
+    /** Number of values in Counter. */
+    static constexpr std::size_t NUMBER_COUNTERS = 4;
+
+    /** Value of each counter (indexed by Counter). */
+    using Values = std::array<std::uint64_t, NUMBER_COUNTERS>;
+
+    /**
+     * Stops counting. Counters already opened stay open, but are no longer
+     * read.
+     */
+    static void disable() noexcept;
+
+    /**
+     * Starts counting and opens the calling thread's counters.
+     *
+     * @return true if the counters could be opened on the calling thread
+     */
+    static bool enable() noexcept;
+
+    /**
+     * Returns the display name of the given counter.
+     *
+     * @param theCounter
+     *          counter
+     * @return display name
+     */
+    static const char* getCounterName(Counter theCounter) noexcept;
+
+    /**
+     * Returns whether counting is enabled. Being enabled doesn't guarantee
+     * the counters are available.
+     *
+     * @return true if enabled
+     */
+    static bool isEnabled() noexcept;
+
+    /**
+     * Reads the calling thread's counters. The values are running totals
+     * from when the counters were opened; callers take differences.
+     *
+     * @param theValues
+     *          [out] counter values, unchanged on failure
+     * @return true if the counters were read
+     */
+    static bool read(Values &theValues) noexcept;
+
+    protected:
+
+    private:
+  };
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+/**
+ * @file SeqLock.h
+ * @brief Single writer, multiple reader sequence lock for small values.
+ *
+ * @author Michael Albers
+ */
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace QS
+{
+  /**
+   * Sequence lock protecting a small, trivially copyable value. One thread
+   * (and only one) may write the value. Any number of threads may read it
+   * without blocking the writer; a reader simply retries if the writer was
+   * mid-update, so readers never see a torn value.
+   *
+   * The value is stored as an array of atomic words so that concurrent
+   * reads/writes are not data races.
+   */
+  template<class T>
+  class SeqLock
+  {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "SeqLock requires a trivially copyable type.");
+
+    public:
+
+    /**
+     * Default constructor. The stored value is a value initialized T.
+     */
+    SeqLock() noexcept
+    {
+      store(T());
+    }
+
+    /**
+     * Copy constructor.
+     */
+    SeqLock(const SeqLock&) = delete;
+
+    /**
+     * Move constructor.
+     */
+    SeqLock(SeqLock&&) = delete;
+
+    /**
+     * Destructor.
+     */
+    ~SeqLock() = default;
+
+    /**
+     * Returns a consistent copy of the stored value. Spins while the writer
+     * is in the middle of an update.
+     *
+     * @return stored value
+     */
+    T load() const noexcept
+    {
+      std::array<std::uint64_t, NUMBER_WORDS> words;
+      std::uint64_t startSequence;
+      std::uint64_t endSequence;
+      do
+      {
+        startSequence = mySequence.load(std::memory_order_acquire);
+        for (auto ii = 0u; ii < NUMBER_WORDS; ++ii)
+        {
+          words[ii] = myWords[ii].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        endSequence = mySequence.load(std::memory_order_relaxed);
+      } while ((startSequence & 1) != 0 || startSequence != endSequence);
+
+      T value;
+      std::memcpy(static_cast<void*>(&value), words.data(), sizeof(T));
+      return value;
+    }
+
+    /**
+     * Copy assignment operator.
+     */
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    /**
+     * Move assignment operator.
+     */
+    SeqLock& operator=(SeqLock&&) = delete;
+
+    /**
+     * Stores the given value. Must only be called from a single thread.
+     *
+     * @param theValue
+     *          value to store
+     */
+    void store(const T &theValue) noexcept
+    {
+      std::array<std::uint64_t, NUMBER_WORDS> words{};
+      std::memcpy(words.data(), &theValue, sizeof(T));
+
+      auto sequence = mySequence.load(std::memory_order_relaxed);
+      mySequence.store(sequence + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      for (auto ii = 0u; ii < NUMBER_WORDS; ++ii)
+      {
+        myWords[ii].store(words[ii], std::memory_order_relaxed);
+      }
+      mySequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    protected:
+
+    private:
+
+    /** Number of 64 bit words needed to hold a T. */
+    static constexpr std::size_t NUMBER_WORDS =
+      (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    /** Sequence number, odd while a write is in progress. */
+    std::atomic<std::uint64_t> mySequence{0};
+
+    /** Storage for the value. */
+    std::array<std::atomic<std::uint64_t>, NUMBER_WORDS> myWords;
+  };
+}
@@ -0,0 +1,359 @@
+#pragma once
+
+/**
+ * @file SimdLanes.h
+ * @brief Lane-wise float operations with whichever SIMD instructions the build
+ *        targets.
+ *
+ * @author Michael Albers
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace QS
+{
+  /**
+   * Vector of LANES floats (Floats) and the operations kernels working on
+   * several values at once are written against: 8 lanes with AVX, 4 with
+   * SSE2 or NEON (aarch64), otherwise 1, a plain float. A kernel written
+   * with these builds for every target, with a scalar loop for whatever
+   * doesn't fill a whole vector.
+   *
+   * Comparisons give a Mask, which is only good for select.
+   */
+  class SimdLanes
+  {
+    public:
+
+#if defined(__AVX__)
+    /** LANES floats. */
+    using Floats = __m256;
+
+    /** Result of a comparison, per lane. */
+    using Mask = __m256;
+
+    /** Number of lanes. */
+    static constexpr std::size_t LANES = 8;
+#elif defined(__SSE2__)
+    /** LANES floats. */
+    using Floats = __m128;
+
+    /** Result of a comparison, per lane. */
+    using Mask = __m128;
+
+    /** Number of lanes. */
+    static constexpr std::size_t LANES = 4;
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    /** LANES floats. */
+    using Floats = float32x4_t;
+
+    /** Result of a comparison, per lane. */
+    using Mask = uint32x4_t;
+
+    /** Number of lanes. */
+    static constexpr std::size_t LANES = 4;
+#else
+    /** LANES floats. */
+    using Floats = float;
+
+    /** Result of a comparison, per lane. */
+    using Mask = bool;
+
+    /** Number of lanes. */
+    static constexpr std::size_t LANES = 1;
+#endif
+
+    /**
+     * Default constructor.
+     */
+    SimdLanes() = delete;
+
+    /**
+     * Copy constructor.
+     */
+    SimdLanes(const SimdLanes&) = delete;
+
+    /**
+     * Move constructor.
+     */
+    SimdLanes(SimdLanes&&) = delete;
+
+    /**
+     * Destructor.
+     */
+    ~SimdLanes() = delete;
+
+    /**
+     * Returns theA + theB.
+     */
+    static Floats add(Floats theA, Floats theB) noexcept
+    {
+#if defined(__AVX__)
+      return _mm256_add_ps(theA, theB);
+#elif defined(__SSE2__)
+      return _mm_add_ps(theA, theB);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+      return vaddq_f32(theA, theB);
+#else
+      return theA + theB;
+#endif
+    }
+
+    /**
+     * Returns theA / theB.
+     */
+    static Floats div(Floats theA, Floats theB) noexcept
+    {
+#if defined(__AVX__)
+      return _mm256_div_ps(theA, theB);
+#elif defined(__SSE2__)
+      return _mm_div_ps(theA, theB);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+      return vdivq_f32(theA, theB);
+#else
+      return theA / theB;
+#endif
+    }
+
+    /**
+     * Returns the lanes where theA > theB (false if either is not a number).
+     */
+    static Mask greater(Floats theA, Floats theB) noexcept
+    {
+#if defined(__AVX__)
+      return _mm256_cmp_ps(theA, theB, _CMP_GT_OQ);
+#elif defined(__SSE2__)
+      return _mm_cmpgt_ps(theA, theB);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+      return vcgtq_f32(theA, theB);
+#else
+      return theA > theB;
+#endif
+    }
+
+    /**
+     * Returns LANES values from an array, which needn't be aligned.
+     *
+     * @param theValues
+     *          at least LANES values
+     */
+    static Floats load(const float *theValues) noexcept
+    {
+#if defined(__AVX__)
+      return _mm256_loadu_ps(theValues);
+#elif defined(__SSE2__)
+      return _mm_loadu_ps(theValues);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+      return vld1q_f32(theValues);
+#else
+      return *theValues;
+#endif
+    }
+
+    /**
+     * Returns theValue(lane) in each lane.
+     *
+     * @param theValue
+     *          function of the lane number returning a float
+     */
+    template<typename Value>
+    static Floats make(Value theValue) noexcept
+    {
+#if defined(__AVX__)
+      return _mm256_set_ps(theValue(7), theValue(6), theValue(5), theValue(4),
+                           theValue(3), theValue(2), theValue(1), theValue(0));
+#elif defined(__SSE2__)
+      return _mm_set_ps(theValue(3), theValue(2), theValue(1), theValue(0));
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+      Floats values = vdupq_n_f32(theValue(0));
+      values = vsetq_lane_f32(theValue(1), values, 1);
+      values = vsetq_lane_f32(theValue(2), values, 2);
+      return vsetq_lane_f32(theValue(3), values, 3);
+#else
+      return theValue(0);
+#endif
+    }
+
+    /**
+     * Returns the larger of theA and theB.
+     */
+    static Floats max(Floats theA, Floats theB) noexcept
+    {
+#if defined(__AVX__)
+      return _mm256_max_ps(theA, theB);
+#elif defined(__SSE2__)
+      return _mm_max_ps(theA, theB);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+      return vmaxq_f32(theA, theB);
+#else
+      return theA > theB ? theA : theB;
+#endif
+    }
+
+    /**
+     * Returns the smaller of theA and theB.
+     */
+    static Floats min(Floats theA, Floats theB) noexcept
+    {
+#if defined(__AVX__)
+      return _mm256_min_ps(theA, theB);
+#elif defined(__SSE2__)
+      return _mm_min_ps(theA, theB);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+      return vminq_f32(theA, theB);
+#else
+      return theA < theB ? theA : theB;
+#endif
+    }
+
+    /**
+     * Returns the smallest of the lanes of theA.
+     */
+    static float minimum(Floats theA) noexcept
+    {
+#if defined(__AVX__) || defined(__SSE2__)
+      alignas(32) float lanes[LANES];
+      store(lanes, theA);
+      return *std::min_element(lanes, lanes + LANES);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+      return vminvq_f32(theA);
+#else
+      return theA;
+#endif
+    }
+
+    /**
+     * Returns theA * theB.
+     */
+    static Floats mul(Floats theA, Floats theB) noexcept
+    {
+#if defined(__AVX__)
+      return _mm256_mul_ps(theA, theB);
+#elif defined(__SSE2__)
+      return _mm_mul_ps(theA, theB);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+      return vmulq_f32(theA, theB);
+#else
+      return theA * theB;
+#endif
+    }
+
+    /**
+     * Returns theA in the lanes of theMask, otherwise theB.
+     */
+    static Floats select(Mask theMask, Floats theA, Floats theB) noexcept
+    {
+#if defined(__AVX__)
+      return _mm256_blendv_ps(theB, theA, theMask);
+#elif defined(__SSE2__)
+      return _mm_or_ps(_mm_and_ps(theMask, theA),
+                       _mm_andnot_ps(theMask, theB));
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+      return vbslq_f32(theMask, theA, theB);
+#else
+      return theMask ? theA : theB;
+#endif
+    }
+
+    /**
+     * Returns theValue in every lane.
+     */
+    static Floats set(float theValue) noexcept
+    {
+#if defined(__AVX__)
+      return _mm256_set1_ps(theValue);
+#elif defined(__SSE2__)
+      return _mm_set1_ps(theValue);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+      return vdupq_n_f32(theValue);
+#else
+      return theValue;
+#endif
+    }
+
+    /**
+     * Returns the square root of theA.
+     */
+    static Floats sqrt(Floats theA) noexcept
+    {
+#if defined(__AVX__)
+      return _mm256_sqrt_ps(theA);
+#elif defined(__SSE2__)
+      return _mm_sqrt_ps(theA);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+      return vsqrtq_f32(theA);
+#else
+      return std::sqrt(theA);
+#endif
+    }
+
+    /**
+     * Stores the lanes of theA to an array, which needn't be aligned.
+     *
+     * @param theValues
+     *          OUT parameter, room for at least LANES values
+     * @param theA
+     *          values
+     */
+    static void store(float *theValues, Floats theA) noexcept
+    {
+#if defined(__AVX__)
+      _mm256_storeu_ps(theValues, theA);
+#elif defined(__SSE2__)
+      _mm_storeu_ps(theValues, theA);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+      vst1q_f32(theValues, theA);
+#else
+      *theValues = theA;
+#endif
+    }
+
+    /**
+     * Returns theA - theB.
+     */
+    static Floats sub(Floats theA, Floats theB) noexcept
+    {
+#if defined(__AVX__)
+      return _mm256_sub_ps(theA, theB);
+#elif defined(__SSE2__)
+      return _mm_sub_ps(theA, theB);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+      return vsubq_f32(theA, theB);
+#else
+      return theA - theB;
+#endif
+    }
+
+    /**
+     * Returns the sum of the lanes of theA, added in lane order.
+     */
+    static float sum(Floats theA) noexcept
+    {
+      alignas(32) float lanes[LANES];
+      store(lanes, theA);
+      float total = 0.0;
+      for (std::size_t lane = 0; lane < LANES; ++lane)
+      {
+        total += lanes[lane];
+      }
+      return total;
+    }
+
+    /**
+     * Copy assignment operator.
+     */
+    SimdLanes& operator=(const SimdLanes&) = delete;
+
+    /**
+     * Move assignment operator.
+     */
+    SimdLanes& operator=(SimdLanes&&) = delete;
+  };
+}
@@ -0,0 +1,173 @@
+#pragma once
+
+/**
+ * @file Tracer.h
+ * @brief Records timeline events for export in Chrome trace-event format.
+ *
+ * @author Michael Albers
+ */
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+/**
+ * Traces the remainder of the enclosing scope as an event with the given
+ * name (i.e., QS_TRACE_SCOPE("World::update")). The name must have static
+ * storage duration (a string literal).
+ */
+#define QS_TRACE_CONCAT_INNER(a, b) a ## b
+#define QS_TRACE_CONCAT(a, b) QS_TRACE_CONCAT_INNER(a, b)
+#define QS_TRACE_SCOPE(theName)                                         \
+  QS::Tracer::Scope QS_TRACE_CONCAT(qsTraceScope, __LINE__)(theName)
+
+namespace QS
+{
+  /**
+   * Opt-in recorder of begin/end events on every thread. Each thread records
+   * into its own fixed size ring buffer (no locking after a thread's first
+   * event), so when a buffer fills the oldest events are overwritten. The
+   * buffers are kept after their threads exit and can be written out, in
+   * Chrome trace-event JSON, for viewing in chrome://tracing or Perfetto.
+   *
+   * Tracing is off until enable is called. While off, recording an event is
+   * a single atomic load.
+   */
+  class Tracer
+  {
+    public:
+
+    /**
+     * Records a begin event on construction and the matching end event on
+     * destruction.
+     */
+    class Scope
+    {
+      public:
+
+      /**
+       * Default constructor.
+       */
+      Scope() = delete;
+
+      /**
+       * Constructor. Records the begin event if tracing is enabled.
+       *
+       * @param theName
+       *          event name, must have static storage duration
+       */
+      Scope(const char *theName) noexcept;
+
+      /**
+       * Copy constructor.
+       */
+      Scope(const Scope&) = delete;
+
+      /**
+       * Move constructor.
+       */
+      Scope(Scope&&) = delete;
+
+      /**
+       * Destructor. Records the end event if the begin event was recorded.
+       */
+      ~Scope();
+
+      /**
+       * Copy assignment operator.
+       */
+      Scope& operator=(const Scope&) = delete;
+
+      /**
+       * Move assignment operator.
+       */
+      Scope& operator=(Scope&&) = delete;
+
+      private:
+
+      /** Event name. */
+      const char *myName;
+
+      /** Whether the begin event was recorded. */
+      bool myRecorded;
+    };
+
+    /** Default number of events held per thread. */
+    static constexpr std::size_t DEFAULT_EVENTS_PER_THREAD = 1 << 18;
+
+    /**
+     * Records the start of an event on the calling thread. Does nothing if
+     * tracing is disabled.
+     *
+     * @param theName
+     *          event name, must have static storage duration
+     */
+    static void begin(const char *theName) noexcept;
+
+    /**
+     * Stops tracing. Recorded events are kept.
+     */
+    static void disable() noexcept;
+
+    /**
+     * Discards any recorded events and starts tracing. Must not be called
+     * while other threads are recording events.
+     *
+     * @param theEventsPerThread
+     *          capacity of each thread's ring buffer
+     * @throws std::invalid_argument
+     *          if theEventsPerThread is 0
+     */
+    static void enable(
+      std::size_t theEventsPerThread = DEFAULT_EVENTS_PER_THREAD);
+
+    /**
+     * Records the end of the innermost event on the calling thread. Does
+     * nothing if tracing is disabled.
+     *
+     * @param theName
+     *          event name, must have static storage duration
+     */
+    static void end(const char *theName) noexcept;
+
+    /**
+     * Returns whether tracing is enabled.
+     *
+     * @return true if events are being recorded
+     */
+    static bool isEnabled() noexcept;
+
+    /**
+     * Names the calling thread in the trace output. Does nothing if tracing
+     * is disabled.
+     *
+     * @param theName
+     *          thread name
+     */
+    static void setThreadName(const std::string &theName);
+
+    /**
+     * Writes all recorded events as a Chrome trace-event JSON object. Must
+     * only be called once no other thread is recording events (i.e., at
+     * shutdown).
+     *
+     * @param theOutput
+     *          output stream
+     */
+    static void write(std::ostream &theOutput);
+
+    /**
+     * Writes all recorded events to the given file. See write.
+     *
+     * @param theFileName
+     *          full path and file name of the output file
+     * @throws std::runtime_error
+     *          on file open/write error
+     */
+    static void writeFile(const std::string &theFileName);
+
+    protected:
+
+    private:
+  };
+}
@@ -0,0 +1,113 @@
+/**
+ * @file FrameProfiler.cpp
+ * @brief Definition of FrameProfiler
+ *
+ * @author Michael Albers
+ */
+
+#include "FrameProfiler.h"
+
+namespace
+{
+  using Duration = std::chrono::steady_clock::duration;
+
+  /** Innermost running timer on this thread. */
+  thread_local QS::FrameProfiler::ScopedTimer *glbCurrentTimer = nullptr;
+
+  /** Time accumulated in each phase on this thread. */
+  thread_local std::array<Duration, QS::FrameProfiler::NUMBER_PHASES>
+    glbPhaseTimes{};
+
+  /** Hardware counter values accumulated in each phase on this thread. */
+  thread_local QS::FrameProfiler::PhaseCounters glbPhaseCounters{};
+
+  /** Weight of timers started on this thread. */
+  thread_local std::uint32_t glbSampleWeight = 1;
+}
+
+constexpr std::size_t QS::FrameProfiler::NUMBER_PHASES;
+
+QS::FrameProfiler::ScopedTimer::ScopedTimer(Phase thePhase) noexcept :
+  myParent(glbCurrentTimer),
+  myPhase(thePhase),
+  myStart(glbSampleWeight > 0 ? std::chrono::steady_clock::now() :
+          std::chrono::steady_clock::time_point()),
+  myTraceScope(getPhaseName(thePhase)),
+  myWeight(glbSampleWeight)
+{
+  myCounting = myWeight > 0 && PerfCounters::isEnabled() &&
+    PerfCounters::read(myStartCounters);
+  glbCurrentTimer = this;
+}
+
+QS::FrameProfiler::ScopedTimer::~ScopedTimer()
+{
+  glbCurrentTimer = myParent;
+  if (myWeight == 0)
+  {
+    return;
+  }
+
+  // Parents subtract the weighted time, as that is what this timer adds to
+  // its phase.
+  Duration elapsed = (std::chrono::steady_clock::now() - myStart) * myWeight;
+  glbPhaseTimes[static_cast<std::size_t>(myPhase)] += elapsed - myChildTime;
+  if (myParent)
+  {
+    myParent->myChildTime += elapsed;
+  }
+
+  PerfCounters::Values endCounters;
+  if (myCounting && PerfCounters::read(endCounters))
+  {
+    auto &phaseCounters = glbPhaseCounters[static_cast<std::size_t>(myPhase)];
+    for (auto ii = 0u; ii < PerfCounters::NUMBER_COUNTERS; ++ii)
+    {
+      auto counted = (endCounters[ii] - myStartCounters[ii]) * myWeight;
+      // Guard against underflow should the counts ever be inconsistent.
+      phaseCounters[ii] += counted > myChildCounters[ii] ?
+        counted - myChildCounters[ii] : 0;
+      if (myParent)
+      {
+        myParent->myChildCounters[ii] += counted;
+      }
+    }
+  }
+}
+
+QS::FrameProfiler::PhaseTimes QS::FrameProfiler::endFrame() noexcept
+{
+  PhaseTimes times;
+  for (auto ii = 0u; ii < NUMBER_PHASES; ++ii)
+  {
+    times[ii] = std::chrono::duration<float>(glbPhaseTimes[ii]).count();
+    glbPhaseTimes[ii] = Duration::zero();
+  }
+  return times;
+}
+
+QS::FrameProfiler::PhaseCounters QS::FrameProfiler::endFrameCounters() noexcept
+{
+  PhaseCounters counters = glbPhaseCounters;
+  glbPhaseCounters = PhaseCounters{};
+  return counters;
+}
+
+const char* QS::FrameProfiler::getPhaseName(Phase thePhase) noexcept
+{
+  static const char *names[NUMBER_PHASES] = {
+    "Update (other)",
+    "Hash",
+    "Sense",
+    "Evaluate",
+    "Collision",
+    "Exit",
+    "Callback"
+  };
+  return names[static_cast<std::size_t>(thePhase)];
+}
+
+void QS::FrameProfiler::setSampleWeight(std::uint32_t theWeight) noexcept
+{
+  glbSampleWeight = theWeight;
+}
@@ -0,0 +1,188 @@
+/**
+ * @file PerfCounters.cpp
+ * @brief Definition of PerfCounters
+ *
+ * @author Michael Albers
+ */
+
+#include <atomic>
+#include "PerfCounters.h"
+#include "QSConfig.h"
+
+#ifdef QS_PERF_COUNTERS_ENABLED
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+  /** Whether counting is enabled. */
+  std::atomic<bool> glbEnabled{false};
+
+#ifdef QS_PERF_COUNTERS_ENABLED
+  /**
+   * A thread's counters, opened as a single group so they are all scheduled
+   * onto the PMU together and read with one system call.
+   */
+  class ThreadCounters
+  {
+    public:
+
+    /**
+     * Destructor. Closes the counters.
+     */
+    ~ThreadCounters()
+    {
+      for (auto fd : myFds)
+      {
+        if (fd >= 0)
+        {
+          close(fd);
+        }
+      }
+    }
+
+    /**
+     * Returns whether the counters are open, opening them on the first call.
+     *
+     * @return true if open
+     */
+    bool open() noexcept
+    {
+      if (! myOpenAttempted)
+      {
+        myOpenAttempted = true;
+        myOpen = openCounters();
+      }
+      return myOpen;
+    }
+
+    /**
+     * Reads the counters.
+     *
+     * @param theValues
+     *          [out] counter values
+     * @return true on success
+     */
+    bool read(QS::PerfCounters::Values &theValues) noexcept
+    {
+      // Layout for PERF_FORMAT_GROUP: number of values, then the values in
+      // the order the counters were added to the group.
+      std::uint64_t data[1 + QS::PerfCounters::NUMBER_COUNTERS];
+      auto bytes = ::read(myFds[0], data, sizeof(data));
+      if (bytes != static_cast<ssize_t>(sizeof(data)) ||
+          data[0] != QS::PerfCounters::NUMBER_COUNTERS)
+      {
+        return false;
+      }
+      for (auto ii = 0u; ii < QS::PerfCounters::NUMBER_COUNTERS; ++ii)
+      {
+        theValues[ii] = data[ii + 1];
+      }
+      return true;
+    }
+
+    private:
+
+    /**
+     * Opens all of the counters.
+     *
+     * @return true if every counter was opened
+     */
+    bool openCounters() noexcept
+    {
+      static const std::uint64_t configs[QS::PerfCounters::NUMBER_COUNTERS] =
+      {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES
+      };
+
+      for (auto ii = 0u; ii < QS::PerfCounters::NUMBER_COUNTERS; ++ii)
+      {
+        perf_event_attr attributes;
+        std::memset(&attributes, 0, sizeof(attributes));
+        attributes.size = sizeof(attributes);
+        attributes.type = PERF_TYPE_HARDWARE;
+        attributes.config = configs[ii];
+        attributes.read_format = PERF_FORMAT_GROUP;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+        // The group leader starts disabled so all counters start together.
+        attributes.disabled = (0 == ii) ? 1 : 0;
+
+        // Calling thread, any CPU.
+        auto fd = syscall(__NR_perf_event_open, &attributes, 0, -1,
+                          myFds[0], 0);
+        if (fd < 0)
+        {
+          return false;
+        }
+        myFds[ii] = static_cast<int>(fd);
+      }
+
+      return 0 == ioctl(myFds[0], PERF_EVENT_IOC_ENABLE,
+                        PERF_IOC_FLAG_GROUP);
+    }
+
+    /** Counter file descriptors, the first is the group leader. */
+    int myFds[QS::PerfCounters::NUMBER_COUNTERS] = {-1, -1, -1, -1};
+
+    /** Whether the counters are open. */
+    bool myOpen = false;
+
+    /** Whether opening the counters has been tried. */
+    bool myOpenAttempted = false;
+  };
+
+  /** Counters of the calling thread. */
+  thread_local ThreadCounters glbThreadCounters;
+#endif
+}
+
+constexpr std::size_t QS::PerfCounters::NUMBER_COUNTERS;
+
+void QS::PerfCounters::disable() noexcept
+{
+  glbEnabled.store(false, std::memory_order_relaxed);
+}
+
+bool QS::PerfCounters::enable() noexcept
+{
+  glbEnabled.store(true, std::memory_order_relaxed);
+#ifdef QS_PERF_COUNTERS_ENABLED
+  return glbThreadCounters.open();
+#else
+  return false;
+#endif
+}
+
+const char* QS::PerfCounters::getCounterName(Counter theCounter) noexcept
+{
+  static const char *names[NUMBER_COUNTERS] = {
+    "Cycles",
+    "Instructions",
+    "Cache Misses",
+    "Branch Misses"
+  };
+  return names[static_cast<std::size_t>(theCounter)];
+}
+
+bool QS::PerfCounters::isEnabled() noexcept
+{
+  return glbEnabled.load(std::memory_order_relaxed);
+}
+
+bool QS::PerfCounters::read(Values &theValues) noexcept
+{
+#ifdef QS_PERF_COUNTERS_ENABLED
+  return isEnabled() && glbThreadCounters.open() &&
+    glbThreadCounters.read(theValues);
+#else
+  return false;
+#endif
+}
@@ -0,0 +1,319 @@
+/**
+ * @file Tracer.cpp
+ * @brief Definition of Tracer
+ *
+ * @author Michael Albers
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+#include "Tracer.h"
+
+namespace
+{
+  /** A single begin or end event. */
+  struct Event
+  {
+    /** Event name. */
+    const char *myName;
+
+    /** Nanoseconds since tracing was enabled. */
+    std::int64_t myTime_ns;
+
+    /** Chrome trace-event phase, 'B' (begin) or 'E' (end). */
+    char myType;
+  };
+
+  /** Ring buffer of the events from one thread. */
+  struct ThreadBuffer
+  {
+    /** Total number of events recorded (including overwritten ones). */
+    std::atomic<std::uint64_t> myCount{0};
+
+    /** Event storage. */
+    std::vector<Event> myEvents;
+
+    /** Thread identifier used in the output. */
+    std::uint32_t myId;
+
+    /** Thread name, empty if none was given. */
+    std::string myName;
+  };
+
+  /** Whether tracing is enabled. */
+  std::atomic<bool> glbEnabled{false};
+
+  /** Time at which tracing was enabled. */
+  std::chrono::steady_clock::time_point glbEpoch;
+
+  /** Capacity of each thread buffer. */
+  std::size_t glbEventsPerThread = QS::Tracer::DEFAULT_EVENTS_PER_THREAD;
+
+  /** Guards glbBuffers and thread names. */
+  std::mutex glbMutex;
+
+  /** Buffers of every thread which has recorded an event. */
+  std::vector<std::unique_ptr<ThreadBuffer>> glbBuffers;
+
+  /** The calling thread's buffer, owned by glbBuffers. */
+  thread_local ThreadBuffer *glbThreadBuffer = nullptr;
+
+  /**
+   * Returns the calling thread's buffer, creating it if needed.
+   *
+   * @return thread buffer
+   */
+  ThreadBuffer* getThreadBuffer()
+  {
+    if (! glbThreadBuffer)
+    {
+      std::unique_ptr<ThreadBuffer> buffer{new ThreadBuffer};
+      std::lock_guard<std::mutex> lock(glbMutex);
+      buffer->myEvents.resize(glbEventsPerThread);
+      buffer->myId = static_cast<std::uint32_t>(glbBuffers.size() + 1);
+      glbThreadBuffer = buffer.get();
+      glbBuffers.push_back(std::move(buffer));
+    }
+    return glbThreadBuffer;
+  }
+
+  /**
+   * Records an event on the calling thread.
+   *
+   * @param theName
+   *          event name
+   * @param theType
+   *          'B' or 'E'
+   */
+  void record(const char *theName, char theType) noexcept
+  {
+    auto now = std::chrono::steady_clock::now();
+    ThreadBuffer *buffer;
+    try
+    {
+      buffer = getThreadBuffer();
+    }
+    catch (...)
+    {
+      // Out of memory, drop the event.
+      return;
+    }
+
+    auto count = buffer->myCount.load(std::memory_order_relaxed);
+    Event &event = buffer->myEvents[count % buffer->myEvents.size()];
+    event.myName = theName;
+    event.myTime_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        now - glbEpoch).count();
+    event.myType = theType;
+    buffer->myCount.store(count + 1, std::memory_order_release);
+  }
+
+  /**
+   * Writes the given string as a JSON string literal.
+   *
+   * @param theOutput
+   *          output stream
+   * @param theString
+   *          string to write
+   */
+  void writeJSONString(std::ostream &theOutput, const char *theString)
+  {
+    theOutput << '"';
+    for (auto character = theString; *character; ++character)
+    {
+      auto value = static_cast<unsigned char>(*character);
+      if ('"' == value || '\\' == value)
+      {
+        theOutput << '\\' << *character;
+      }
+      else if (value < 0x20)
+      {
+        char escaped[8];
+        std::snprintf(escaped, sizeof(escaped), "\\u%04x", value);
+        theOutput << escaped;
+      }
+      else
+      {
+        theOutput << *character;
+      }
+    }
+    theOutput << '"';
+  }
+}
+
+constexpr std::size_t QS::Tracer::DEFAULT_EVENTS_PER_THREAD;
+
+QS::Tracer::Scope::Scope(const char *theName) noexcept :
+  myName(theName),
+  myRecorded(glbEnabled.load(std::memory_order_relaxed))
+{
+  if (myRecorded)
+  {
+    record(myName, 'B');
+  }
+}
+
+QS::Tracer::Scope::~Scope()
+{
+  // Always close a recorded event, even if tracing has since been disabled,
+  // so begin/end pairs stay balanced.
+  if (myRecorded)
+  {
+    record(myName, 'E');
+  }
+}
+
+void QS::Tracer::begin(const char *theName) noexcept
+{
+  if (isEnabled())
+  {
+    record(theName, 'B');
+  }
+}
+
+void QS::Tracer::disable() noexcept
+{
+  glbEnabled.store(false, std::memory_order_relaxed);
+}
+
+void QS::Tracer::enable(std::size_t theEventsPerThread)
+{
+  if (0 == theEventsPerThread)
+  {
+    throw std::invalid_argument("Trace events per thread must be greater "
+                                "than 0.");
+  }
+
+  std::lock_guard<std::mutex> lock(glbMutex);
+  glbEventsPerThread = theEventsPerThread;
+  for (auto &buffer : glbBuffers)
+  {
+    buffer->myEvents.assign(glbEventsPerThread, Event());
+    buffer->myCount.store(0, std::memory_order_relaxed);
+  }
+  glbEpoch = std::chrono::steady_clock::now();
+  glbEnabled.store(true, std::memory_order_release);
+}
+
+void QS::Tracer::end(const char *theName) noexcept
+{
+  if (isEnabled())
+  {
+    record(theName, 'E');
+  }
+}
+
+bool QS::Tracer::isEnabled() noexcept
+{
+  return glbEnabled.load(std::memory_order_relaxed);
+}
+
+void QS::Tracer::setThreadName(const std::string &theName)
+{
+  if (isEnabled())
+  {
+    auto buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(glbMutex);
+    buffer->myName = theName;
+  }
+}
+
+void QS::Tracer::write(std::ostream &theOutput)
+{
+  std::lock_guard<std::mutex> lock(glbMutex);
+
+  // All events are reported under one process.
+  constexpr auto processId = 1;
+
+  theOutput << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  auto separator = [&]()
+  {
+    theOutput << (first ? "\n" : ",\n");
+    first = false;
+  };
+
+  auto oldFlags = theOutput.flags();
+  auto oldPrecision = theOutput.precision();
+  theOutput.setf(std::ios_base::fixed, std::ios_base::floatfield);
+  theOutput.precision(3);
+
+  for (auto &buffer : glbBuffers)
+  {
+    if (! buffer->myName.empty())
+    {
+      separator();
+      theOutput << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":"
+                << processId << ",\"tid\":" << buffer->myId
+                << ",\"args\":{\"name\":";
+      writeJSONString(theOutput, buffer->myName.c_str());
+      theOutput << "}}";
+    }
+
+    auto count = buffer->myCount.load(std::memory_order_acquire);
+    auto capacity = buffer->myEvents.size();
+    auto firstEvent = count > capacity ? count - capacity : 0;
+
+    // Overwritten begin events leave unmatched end events at the start of
+    // the buffer. These are skipped.
+    std::uint64_t depth = 0;
+    for (auto ii = firstEvent; ii < count; ++ii)
+    {
+      const Event &event = buffer->myEvents[ii % capacity];
+      if ('E' == event.myType)
+      {
+        if (0 == depth)
+        {
+          continue;
+        }
+        --depth;
+      }
+      else
+      {
+        ++depth;
+      }
+
+      separator();
+      theOutput << "{\"name\":";
+      writeJSONString(theOutput, event.myName);
+      theOutput << ",\"ph\":\"" << event.myType << "\",\"ts\":"
+                << event.myTime_ns / 1000.0 << ",\"pid\":" << processId
+                << ",\"tid\":" << buffer->myId << "}";
+    }
+  }
+
+  theOutput.flags(oldFlags);
+  theOutput.precision(oldPrecision);
+  theOutput << "\n]}\n";
+}
+
+void QS::Tracer::writeFile(const std::string &theFileName)
+{
+  std::ofstream output(theFileName);
+  if (! output.is_open())
+  {
+    auto thisErrno = errno;
+    std::string error{"Failed to open trace file \""};
+    error += theFileName + "\": " + std::strerror(thisErrno);
+    throw std::runtime_error(error);
+  }
+
+  write(output);
+  output.close();
+  if (! output)
+  {
+    throw std::runtime_error("Failed to write trace file \"" + theFileName +
+                             "\".");
+  }
+}
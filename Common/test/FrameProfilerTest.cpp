@@ -0,0 +1,116 @@
+/**
+ * @file FrameProfilerTest.cpp
+ * @brief Unit tests for FrameProfiler class
+ *
+ * @author Michael Albers
+ */
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include "gtest/gtest.h"
+#include "FrameProfiler.h"
+
+using Phase = QS::FrameProfiler::Phase;
+
+static std::size_t index(Phase thePhase)
+{
+  return static_cast<std::size_t>(thePhase);
+}
+
+GTEST_TEST(FrameProfilerTest, phaseNames)
+{
+  EXPECT_EQ(std::string("Hash"), QS::FrameProfiler::getPhaseName(Phase::Hash));
+  EXPECT_EQ(std::string("Callback"),
+            QS::FrameProfiler::getPhaseName(Phase::Callback));
+}
+
+GTEST_TEST(FrameProfilerTest, nestedTimers)
+{
+  // Clear anything left by other tests.
+  QS::FrameProfiler::endFrame();
+
+  {
+    QS::FrameProfiler::ScopedTimer evaluate(Phase::Evaluate);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    {
+      QS::FrameProfiler::ScopedTimer sense(Phase::Sense);
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+  }
+  {
+    QS::FrameProfiler::ScopedTimer sense(Phase::Sense);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+
+  auto times = QS::FrameProfiler::endFrame();
+  // Nested time is excluded from the enclosing phase.
+  EXPECT_GE(times[index(Phase::Evaluate)], 0.005);
+  EXPECT_LT(times[index(Phase::Evaluate)], 0.020);
+  EXPECT_GE(times[index(Phase::Sense)], 0.025);
+  EXPECT_EQ(0.0, times[index(Phase::Hash)]);
+
+  // Times are reset by endFrame.
+  times = QS::FrameProfiler::endFrame();
+  for (auto time : times)
+  {
+    EXPECT_EQ(0.0, time);
+  }
+}
+
+GTEST_TEST(FrameProfilerTest, perThread)
+{
+  QS::FrameProfiler::endFrame();
+
+  QS::FrameProfiler::PhaseTimes otherThreadTimes;
+  std::thread other([&]()
+  {
+    {
+      QS::FrameProfiler::ScopedTimer hash(Phase::Hash);
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    otherThreadTimes = QS::FrameProfiler::endFrame();
+  });
+  other.join();
+
+  EXPECT_GT(otherThreadTimes[index(Phase::Hash)], 0.0);
+  EXPECT_EQ(0.0, QS::FrameProfiler::endFrame()[index(Phase::Hash)]);
+}
+
+GTEST_TEST(FrameProfilerTest, sampleWeight)
+{
+  QS::FrameProfiler::endFrame();
+
+  QS::FrameProfiler::setSampleWeight(0);
+  {
+    QS::FrameProfiler::ScopedTimer hash(Phase::Hash);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  QS::FrameProfiler::setSampleWeight(4);
+  {
+    QS::FrameProfiler::ScopedTimer evaluate(Phase::Evaluate);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  QS::FrameProfiler::setSampleWeight(1);
+
+  auto times = QS::FrameProfiler::endFrame();
+  EXPECT_EQ(0.0, times[index(Phase::Hash)]);
+  EXPECT_GE(times[index(Phase::Evaluate)], 0.020);
+
+  // A weighted timer's time is excluded from an unweighted enclosing one.
+  {
+    QS::FrameProfiler::ScopedTimer evaluate(Phase::Evaluate);
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    QS::FrameProfiler::setSampleWeight(2);
+    {
+      QS::FrameProfiler::ScopedTimer sense(Phase::Sense);
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    QS::FrameProfiler::setSampleWeight(1);
+  }
+
+  times = QS::FrameProfiler::endFrame();
+  EXPECT_GE(times[index(Phase::Sense)], 0.020);
+  EXPECT_GE(times[index(Phase::Evaluate)], 0.025);
+  EXPECT_LT(times[index(Phase::Evaluate)], 0.040);
+}
@@ -0,0 +1,49 @@
+/**
+ * @file PerfCountersTest.cpp
+ * @brief Unit tests for PerfCounters class
+ *
+ * @author Michael Albers
+ */
+
+#include <string>
+#include "gtest/gtest.h"
+#include "PerfCounters.h"
+
+using Counter = QS::PerfCounters::Counter;
+
+GTEST_TEST(PerfCountersTest, counterNames)
+{
+  EXPECT_EQ(std::string("Cycles"),
+            QS::PerfCounters::getCounterName(Counter::Cycles));
+  EXPECT_EQ(std::string("Branch Misses"),
+            QS::PerfCounters::getCounterName(Counter::BranchMisses));
+}
+
+GTEST_TEST(PerfCountersTest, read)
+{
+  QS::PerfCounters::Values values{};
+  QS::PerfCounters::disable();
+  EXPECT_FALSE(QS::PerfCounters::isEnabled());
+  EXPECT_FALSE(QS::PerfCounters::read(values));
+
+  bool available = QS::PerfCounters::enable();
+  EXPECT_TRUE(QS::PerfCounters::isEnabled());
+  EXPECT_EQ(available, QS::PerfCounters::read(values));
+
+  // Counters may not be available (permissions, virtual machine, non-Linux
+  // build), which isn't an error.
+  if (available)
+  {
+    volatile std::uint64_t sum = 0;
+    for (auto ii = 0u; ii < 100000; ++ii)
+    {
+      sum += ii;
+    }
+
+    QS::PerfCounters::Values after{};
+    EXPECT_TRUE(QS::PerfCounters::read(after));
+    auto instructions = static_cast<std::size_t>(Counter::Instructions);
+    EXPECT_GT(after[instructions], values[instructions] + 100000);
+  }
+  QS::PerfCounters::disable();
+}
@@ -0,0 +1,67 @@
+/**
+ * @file SeqLockTest.cpp
+ * @brief Unit tests for SeqLock class
+ *
+ * @author Michael Albers
+ */
+
+#include <thread>
+#include "gtest/gtest.h"
+#include "SeqLock.h"
+
+namespace
+{
+  struct TestValue
+  {
+    std::uint32_t myA;
+    std::uint32_t myB;
+    std::uint64_t myC;
+    float myD;
+  };
+}
+
+GTEST_TEST(SeqLockTest, storeLoad)
+{
+  QS::SeqLock<TestValue> lock;
+  TestValue value = lock.load();
+  EXPECT_EQ(0u, value.myA);
+  EXPECT_EQ(0u, value.myB);
+  EXPECT_EQ(0u, value.myC);
+  EXPECT_EQ(0.0, value.myD);
+
+  lock.store(TestValue{1, 2, 3, 4.5});
+  value = lock.load();
+  EXPECT_EQ(1u, value.myA);
+  EXPECT_EQ(2u, value.myB);
+  EXPECT_EQ(3u, value.myC);
+  EXPECT_EQ(4.5, value.myD);
+}
+
+GTEST_TEST(SeqLockTest, noTearing)
+{
+  // Writer stores values where every field is the same, so any torn read
+  // will have mismatched fields.
+  QS::SeqLock<TestValue> lock;
+  constexpr std::uint32_t numberWrites = 200000;
+
+  std::thread writer([&]()
+  {
+    for (std::uint32_t ii = 1; ii <= numberWrites; ++ii)
+    {
+      lock.store(TestValue{ii, ii, ii, static_cast<float>(ii)});
+    }
+  });
+
+  std::uint32_t lastA = 0;
+  while (lastA < numberWrites)
+  {
+    TestValue value = lock.load();
+    ASSERT_EQ(value.myA, value.myB);
+    ASSERT_EQ(value.myA, value.myC);
+    ASSERT_EQ(static_cast<float>(value.myA), value.myD);
+    ASSERT_GE(value.myA, lastA);
+    lastA = value.myA;
+  }
+
+  writer.join();
+}
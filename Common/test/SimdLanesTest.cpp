@@ -0,0 +1,97 @@
+/**
+ * @file SimdLanesTest.cpp
+ * @brief Unit tests for SimdLanes class
+ *
+ * @author Michael Albers
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "gtest/gtest.h"
+#include "SimdLanes.h"
+
+namespace
+{
+  using L = QS::SimdLanes;
+
+  /**
+   * Returns the lanes of a vector.
+   */
+  std::vector<float> lanes(L::Floats theA)
+  {
+    std::vector<float> values(L::LANES);
+    L::store(values.data(), theA);
+    return values;
+  }
+}
+
+GTEST_TEST(SimdLanesTest, arithmetic)
+{
+  // Lane n of a is n + 2, of b 2 * n + 4.
+  std::vector<float> values(L::LANES + 1);
+  for (auto ii = 0u; ii < values.size(); ++ii)
+  {
+    values[ii] = ii + 1;
+  }
+  // Loads needn't be aligned.
+  L::Floats a = L::load(values.data() + 1);
+  L::Floats b = L::make([](std::size_t theLane)
+                        {
+                          return 2.0f * theLane + 4.0f;
+                        });
+
+  auto sum = lanes(L::add(a, b));
+  auto difference = lanes(L::sub(b, a));
+  auto product = lanes(L::mul(a, b));
+  auto quotient = lanes(L::div(b, a));
+  auto minimum = lanes(L::min(a, L::set(2.5)));
+  auto maximum = lanes(L::max(a, L::set(2.5)));
+  auto root = lanes(L::sqrt(a));
+  for (auto lane = 0u; lane < L::LANES; ++lane)
+  {
+    float valueA = lane + 2.0f;
+    float valueB = 2.0f * lane + 4.0f;
+    EXPECT_EQ(valueA + valueB, sum[lane]) << lane;
+    EXPECT_EQ(valueB - valueA, difference[lane]) << lane;
+    EXPECT_EQ(valueA * valueB, product[lane]) << lane;
+    EXPECT_EQ(valueB / valueA, quotient[lane]) << lane;
+    EXPECT_EQ(std::min(valueA, 2.5f), minimum[lane]) << lane;
+    EXPECT_EQ(std::max(valueA, 2.5f), maximum[lane]) << lane;
+    EXPECT_EQ(std::sqrt(valueA), root[lane]) << lane;
+  }
+
+  // Lanes are added in order.
+  float total = 0.0;
+  for (auto lane = 0u; lane < L::LANES; ++lane)
+  {
+    total += lane + 2.0f;
+  }
+  EXPECT_EQ(total, L::sum(a));
+  EXPECT_EQ(2.0, L::minimum(a));
+  EXPECT_EQ(-3.0, L::minimum(L::min(a, L::set(-3.0))));
+}
+
+GTEST_TEST(SimdLanesTest, select)
+{
+  L::Floats a = L::make([](std::size_t theLane)
+                        {
+                          return theLane % 2 ? 1.0f : -1.0f;
+                        });
+  auto selected = lanes(L::select(L::greater(a, L::set(0.0)), L::set(10.0),
+                                  L::set(20.0)));
+  for (auto lane = 0u; lane < L::LANES; ++lane)
+  {
+    EXPECT_EQ(lane % 2 ? 10.0 : 20.0, selected[lane]) << lane;
+  }
+
+  // Not a number is never greater.
+  float notANumber = std::numeric_limits<float>::quiet_NaN();
+  for (auto value : lanes(L::select(L::greater(L::set(notANumber),
+                                               L::set(0.0)),
+                                    L::set(10.0), L::set(20.0))))
+  {
+    EXPECT_EQ(20.0, value);
+  }
+}
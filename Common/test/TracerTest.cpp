@@ -0,0 +1,108 @@
+/**
+ * @file TracerTest.cpp
+ * @brief Unit tests for Tracer class
+ *
+ * @author Michael Albers
+ */
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include "gtest/gtest.h"
+#include "Tracer.h"
+
+namespace
+{
+  /**
+   * Counts the occurrences of the given string.
+   */
+  std::size_t count(const std::string &theString, const std::string &theFind)
+  {
+    std::size_t number = 0;
+    for (auto position = theString.find(theFind);
+         position != std::string::npos;
+         position = theString.find(theFind, position + 1))
+    {
+      ++number;
+    }
+    return number;
+  }
+}
+
+GTEST_TEST(TracerTest, disabled)
+{
+  QS::Tracer::enable();
+  QS::Tracer::disable();
+  EXPECT_FALSE(QS::Tracer::isEnabled());
+  {
+    QS_TRACE_SCOPE("ignored");
+  }
+
+  std::ostringstream output;
+  QS::Tracer::write(output);
+  EXPECT_EQ(std::string::npos, output.str().find("ignored"));
+}
+
+GTEST_TEST(TracerTest, events)
+{
+  EXPECT_THROW(QS::Tracer::enable(0), std::invalid_argument);
+
+  QS::Tracer::enable();
+  EXPECT_TRUE(QS::Tracer::isEnabled());
+  QS::Tracer::setThreadName("Main \"test\"");
+  {
+    QS_TRACE_SCOPE("outer");
+    QS::Tracer::begin("inner");
+    QS::Tracer::end("inner");
+  }
+
+  std::thread other([]()
+  {
+    QS::Tracer::setThreadName("Other");
+    QS_TRACE_SCOPE("other");
+  });
+  other.join();
+  QS::Tracer::disable();
+
+  std::ostringstream output;
+  QS::Tracer::write(output);
+  auto trace = output.str();
+
+  EXPECT_EQ(0u, trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+  EXPECT_NE(std::string::npos, trace.find("\"Main \\\"test\\\"\""));
+  EXPECT_NE(std::string::npos, trace.find("\"Other\""));
+  EXPECT_EQ(2u, count(trace, "\"name\":\"thread_name\""));
+  EXPECT_EQ(3u, count(trace, "\"ph\":\"B\""));
+  EXPECT_EQ(3u, count(trace, "\"ph\":\"E\""));
+
+  // Begin/end events of a thread are in order.
+  auto outerBegin = trace.find("\"name\":\"outer\",\"ph\":\"B\"");
+  auto innerBegin = trace.find("\"name\":\"inner\",\"ph\":\"B\"");
+  auto innerEnd = trace.find("\"name\":\"inner\",\"ph\":\"E\"");
+  auto outerEnd = trace.find("\"name\":\"outer\",\"ph\":\"E\"");
+  EXPECT_LT(outerBegin, innerBegin);
+  EXPECT_LT(innerBegin, innerEnd);
+  EXPECT_LT(innerEnd, outerEnd);
+  EXPECT_NE(std::string::npos, outerEnd);
+}
+
+GTEST_TEST(TracerTest, ringBuffer)
+{
+  QS::Tracer::enable(5);
+  {
+    QS_TRACE_SCOPE("first");
+  }
+  for (auto ii = 0; ii < 2; ++ii)
+  {
+    QS_TRACE_SCOPE("second");
+  }
+  QS::Tracer::disable();
+
+  // Only the last 5 events remain, the first is an orphaned end event.
+  std::ostringstream output;
+  QS::Tracer::write(output);
+  auto trace = output.str();
+  EXPECT_EQ(std::string::npos, trace.find("\"first\""));
+  EXPECT_EQ(2u, count(trace, "\"name\":\"second\",\"ph\":\"B\""));
+  EXPECT_EQ(2u, count(trace, "\"name\":\"second\",\"ph\":\"E\""));
+}
@@ -9,13 +9,12 @@
 
 #include <gtkmm.h>
 #include <memory>
+#include "Metrics.h"
 #include "SimulationPackage.h"
 #include "Visualization.h"
 
 namespace QS
 {
-  class Metrics;
-
   /**
    * This class manages the entire control GUI for Queueing Simulator. This is
    * the primary user interface. From this GUI the user can select the
@@ -277,13 +276,13 @@ namespace QS
                            const std::string &theDescription);
 
     /**
-     * Updates the elapsed time widget with the elapsed time from the provided
-     * Metrics object.
+     * Updates the simulation status widgets (elapsed time, progress) from the
+     * provided Metrics snapshot.
      *
-     * @param theMetrics
-     *          container with elapsed time
+     * @param theSnapshot
+     *          snapshot of the running simulation metrics
      */
-    void setElapsedTime(const Metrics &theMetrics);
+    void setSimulationStatus(const Metrics::Snapshot &theSnapshot);
 
     /**
      * Starts a new simulation.
@@ -358,6 +357,8 @@ namespace QS
     Gtk::Entry mySimulationStatusStopTimeEntry;
     Gtk::Label mySimulationStatusProgressLabel;
     Gtk::ProgressBar mySimulationStatusProgressBar;
+    Gtk::Label mySimulationStatusPhasesLabel;
+    Gtk::Label mySimulationStatusPhasesValueLabel;
 
     Gtk::Frame myBatchFrame;
     Gtk::Box myBatchBox;
@@ -365,6 +365,10 @@ void QS::ControlGUI::buildSimulationStatusFrame(Gtk::Container &theContainer)
   mySimulationStatusProgressLabel.set_halign(Gtk::Align::ALIGN_START);
   mySimulationStatusProgressBar.set_show_text(true);
 
+  mySimulationStatusPhasesLabel.set_text("Update Phases (ms)");
+  mySimulationStatusPhasesLabel.set_halign(Gtk::Align::ALIGN_START);
+  mySimulationStatusPhasesValueLabel.set_halign(Gtk::Align::ALIGN_START);
+
   mySimulationStatusFrame.add(mySimulationStatusBox);
 
   mySimulationStatusBox.add(mySimulationStatusStartTimeLabel);
@@ -378,6 +382,11 @@ void QS::ControlGUI::buildSimulationStatusFrame(Gtk::Container &theContainer)
 
   mySimulationStatusBox.add(mySimulationStatusProgressLabel);
   mySimulationStatusBox.add(mySimulationStatusProgressBar);
+
+#ifdef QS_PROFILER_ENABLED
+  mySimulationStatusBox.add(mySimulationStatusPhasesLabel);
+  mySimulationStatusBox.add(mySimulationStatusPhasesValueLabel);
+#endif
 }
 
 void QS::ControlGUI::cameraMoveHandler(
@@ -635,12 +644,39 @@ void QS::ControlGUI::setControlButtonSensitivities(bool thePlayButton,
   mySimulationControlStopButton.set_sensitive(theStopButton);
 }
 
-void QS::ControlGUI::setElapsedTime(const Metrics &theMetrics)
+void QS::ControlGUI::setSimulationStatus(const Metrics::Snapshot &theSnapshot)
 {
-  float elapsedTime = theMetrics.getElapsedTimeInSeconds();
   std::ostringstream elapsedTimeStr;
-  elapsedTimeStr << std::fixed << std::setprecision(2) << elapsedTime;
+  elapsedTimeStr << std::fixed << std::setprecision(2)
+                 << theSnapshot.myElapsedTime;
   mySimulationStatusElapsedTimeEntry.set_text(elapsedTimeStr.str());
+
+  double fraction = 0.0;
+  if (theSnapshot.myNumberActors > 0)
+  {
+    fraction = static_cast<double>(theSnapshot.myNumberActorsExited) /
+      theSnapshot.myNumberActors;
+  }
+  mySimulationStatusProgressBar.set_fraction(fraction);
+  mySimulationStatusProgressBar.set_text(
+    std::to_string(theSnapshot.myNumberActorsExited) + " of " +
+    std::to_string(theSnapshot.myNumberActors) + " Actors exited");
+
+#ifdef QS_PROFILER_ENABLED
+  std::ostringstream phasesStr;
+  for (auto phase = 0u; phase < FrameProfiler::NUMBER_PHASES; ++phase)
+  {
+    if (phase > 0)
+    {
+      phasesStr << std::endl;
+    }
+    phasesStr << FrameProfiler::getPhaseName(
+      static_cast<FrameProfiler::Phase>(phase)) << ": "
+              << std::fixed << std::setprecision(3)
+              << theSnapshot.myPhaseTimes[phase] * 1000.0;
+  }
+  mySimulationStatusPhasesValueLabel.set_text(phasesStr.str());
+#endif
 }
 
 void QS::ControlGUI::setMenuSensitivities(bool theOpen,
@@ -694,6 +730,9 @@ void QS::ControlGUI::startSimulation()
     mySimulationStatusStartTimeEntry.set_text(startTime);
     mySimulationStatusStopTimeEntry.set_text("");
     mySimulationStatusElapsedTimeEntry.set_text("");
+    mySimulationStatusProgressBar.set_fraction(0.0);
+    mySimulationStatusProgressBar.set_text("");
+    mySimulationStatusPhasesValueLabel.set_text("");
 
     // Timeout to update simulation times
     sigc::slot<bool> slot = sigc::mem_fun(
@@ -749,7 +788,7 @@ void QS::ControlGUI::stopButtonHandler()
 
   // Need to set elapsed time as the last timeout callback probably won't have
   // caught the last updates in the simulation.
-  setElapsedTime(metrics);
+  setSimulationStatus(metrics.getSnapshot());
 
   std::ostringstream metricsResults;
   metricsResults << metrics;
@@ -764,8 +803,10 @@ bool QS::ControlGUI::updateSimulationData()
 {
   if (mySimulation)
   {
+    // The simulation runs on another thread, only read the snapshot it
+    // publishes.
     auto &metrics = mySimulation->getSimulation()->getMetrics();
-    setElapsedTime(metrics);
+    setSimulationStatus(metrics.getSnapshot());
   }
   return true;
 }
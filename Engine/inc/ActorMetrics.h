@@ -87,6 +87,14 @@ namespace QS
      */
     float getGrossDistanceMeters() const noexcept;
 
+    /**
+     * Returns the net distance traveled, in meters, as of the last call to
+     * calculateNetDistance.
+     *
+     * @return the net distance traveled, in meters.
+     */
+    float getNetDistanceMeters() const noexcept;
+
     /**
      * Copy assignment operator
      */
@@ -0,0 +1,120 @@
+#pragma once
+
+/**
+ * @file BinaryMetricsSink.h
+ * @brief Writes time series metrics in a compact binary format.
+ *
+ * @author Michael Albers
+ */
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "MetricsSink.h"
+
+namespace QS
+{
+  /**
+   * Metrics sink which writes a compact binary file. All values are 4 bytes
+   * (uint32_t or IEEE 754 float) in host byte order.
+   *
+   * Header (written with the first sample):
+   *   char[4] magic ("QSTS"), uint32_t version, uint32_t number of Exits (E),
+   *   uint32_t number of density percentiles (P)
+   *
+   * Each record:
+   *   float time, uint32_t Actors remaining, float mean speed,
+   *   float density[P], float mean frame wall time,
+   *   float max frame wall time, E * (uint32_t exit count, float throughput)
+   */
+  class BinaryMetricsSink : public MetricsSink
+  {
+    public:
+
+    /** File magic number. */
+    static constexpr auto MAGIC = "QSTS";
+
+    /** File format version. */
+    static constexpr std::uint32_t VERSION = 1;
+
+    /**
+     * Default constructor.
+     */
+    BinaryMetricsSink() = delete;
+
+    /**
+     * Constructor.
+     *
+     * @param theFileName
+     *          full path and name of the file to write (overwritten if it
+     *          exists)
+     * @throws std::runtime_error
+     *           if the file cannot be opened
+     */
+    BinaryMetricsSink(const std::string &theFileName);
+
+    /**
+     * Copy constructor.
+     */
+    BinaryMetricsSink(const BinaryMetricsSink&) = delete;
+
+    /**
+     * Move constructor.
+     */
+    BinaryMetricsSink(BinaryMetricsSink&&) = delete;
+
+    /**
+     * Destructor.
+     */
+    virtual ~BinaryMetricsSink() = default;
+
+    /**
+     * @see MetricsSink::flush
+     */
+    virtual void flush() override;
+
+    /**
+     * Copy assignment operator
+     */
+    BinaryMetricsSink& operator=(const BinaryMetricsSink&) = delete;
+
+    /**
+     * Move assignment operator
+     */
+    BinaryMetricsSink& operator=(BinaryMetricsSink&&) = delete;
+
+    /**
+     * @see MetricsSink::write
+     */
+    virtual void write(const TimeSeriesSample &theSample) override;
+
+    protected:
+
+    private:
+
+    /**
+     * Appends the given value to the record buffer.
+     *
+     * @param theValue
+     *          value to append
+     */
+    template<class T>
+    void append(T theValue);
+
+    /** Output file name. */
+    const std::string myFileName;
+
+    /** Has the header been written? */
+    bool myHeaderWritten = false;
+
+    /** Number of Exits in each sample, set by the first sample. */
+    std::size_t myNumberExits = 0;
+
+    /** Output file. */
+    std::ofstream myOutputFile;
+
+    /** Buffer for a single record, to write it in one call. */
+    std::vector<char> myRecord;
+  };
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+/**
+ * @file CSVMetricsSink.h
+ * @brief Writes time series metrics as comma separated values.
+ *
+ * @author Michael Albers
+ */
+
+#include <fstream>
+#include <string>
+#include "MetricsSink.h"
+
+namespace QS
+{
+  /**
+   * Metrics sink which writes one line of comma separated values per sample.
+   * The first line is a header naming each column. Each Exit gets a count and
+   * a throughput column, numbered in the order the Exits were added to the
+   * world.
+   */
+  class CSVMetricsSink : public MetricsSink
+  {
+    public:
+
+    /**
+     * Default constructor.
+     */
+    CSVMetricsSink() = delete;
+
+    /**
+     * Constructor.
+     *
+     * @param theFileName
+     *          full path and name of the file to write (overwritten if it
+     *          exists)
+     * @throws std::runtime_error
+     *           if the file cannot be opened
+     */
+    CSVMetricsSink(const std::string &theFileName);
+
+    /**
+     * Copy constructor.
+     */
+    CSVMetricsSink(const CSVMetricsSink&) = delete;
+
+    /**
+     * Move constructor.
+     */
+    CSVMetricsSink(CSVMetricsSink&&) = delete;
+
+    /**
+     * Destructor.
+     */
+    virtual ~CSVMetricsSink() = default;
+
+    /**
+     * @see MetricsSink::flush
+     */
+    virtual void flush() override;
+
+    /**
+     * Copy assignment operator
+     */
+    CSVMetricsSink& operator=(const CSVMetricsSink&) = delete;
+
+    /**
+     * Move assignment operator
+     */
+    CSVMetricsSink& operator=(CSVMetricsSink&&) = delete;
+
+    /**
+     * @see MetricsSink::write
+     */
+    virtual void write(const TimeSeriesSample &theSample) override;
+
+    protected:
+
+    private:
+
+    /**
+     * Throws if the output file is in a failed state.
+     *
+     * @throws std::runtime_error
+     *           if the output file is in a failed state
+     */
+    void checkStream() const;
+
+    /** Output file name. */
+    const std::string myFileName;
+
+    /** Has the header line been written? */
+    bool myHeaderWritten = false;
+
+    /** Number of Exits in each sample, set by the first sample. */
+    std::size_t myNumberExits = 0;
+
+    /** Output file. */
+    std::ofstream myOutputFile;
+  };
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+/**
+ * @file EngineOptions.h
+ * @brief Enables opt-in engine features from environment variables.
+ *
+ * @author Michael Albers
+ */
+
+namespace QS
+{
+  /**
+   * Enables the opt-in engine features named by environment variables, so
+   * the simulator and the benchmarks turn them on the same way:
+   *
+   * - QS_SCENARIO_CACHE: directory of compiled simulations (ScenarioCache)
+   * - QS_TRUSTED_INPUT: file of hashes of validated files (XMLParser)
+   * - QS_SHARED_BEHAVIORS: share identical BehaviorSets (EntityManager)
+   * - QS_BATCH_EVALUATION: evaluate Actors in batches (World)
+   * - QS_PARALLEL_COLLISIONS: resolve collisions in parallel (World)
+   * - QS_SIMD_SEPARATION: use the SIMD separation (BasicBehaviors, which
+   *   reads it itself as the engine doesn't link the plugin libraries)
+   */
+  class EngineOptions
+  {
+    public:
+
+    /**
+     * Default constructor.
+     */
+    EngineOptions() = delete;
+
+    /**
+     * Copy constructor.
+     */
+    EngineOptions(const EngineOptions&) = delete;
+
+    /**
+     * Move constructor.
+     */
+    EngineOptions(EngineOptions&&) = delete;
+
+    /**
+     * Destructor.
+     */
+    ~EngineOptions() = delete;
+
+    /**
+     * Enables each feature whose environment variable is set.
+     *
+     * @throws std::runtime_error
+     *          if a feature can't be enabled (i.e., the trusted input hash
+     *          file can't be read)
+     */
+    static void enableFromEnvironment();
+
+    /**
+     * Copy assignment operator.
+     */
+    EngineOptions& operator=(const EngineOptions&) = delete;
+
+    /**
+     * Move assignment operator.
+     */
+    EngineOptions& operator=(EngineOptions&&) = delete;
+
+    protected:
+
+    private:
+  };
+}
@@ -23,6 +23,7 @@ namespace QS
   class Exit;
   class Plugin;
   class PluginCollection;
+  class PluginDependencySet;
   class SimulationEntityConfiguration;
   class Sensor;
 
@@ -35,6 +36,17 @@ namespace QS
    *
    * This class owns all created entities and will destroy them all upon
    * destruction.
+   *
+   * Normally every Actor gets its own BehaviorSet, Behaviors and Sensors.
+   * With shared BehaviorSets enabled, Actors whose BehaviorSet configurations
+   * (including the configurations of all of its dependencies) are the same
+   * share one BehaviorSet, and so its Behaviors and Sensors, if they are all
+   * declared shareable (see enableSharedBehaviorSets). For large
+   * simulations this avoids creating hundreds of thousands of identical
+   * objects. Any state a Behavior keeps between updates must then be kept
+   * in the Actor (see Actor::getBehaviorState), and Actors sharing a
+   * BehaviorSet must be evaluated one at a time since a Sensor holds the
+   * results for the Actor being evaluated.
    */
   class EntityManager
   {
@@ -132,6 +144,21 @@ namespace QS
     Sensor* createSensor(
       const SimulationEntityConfiguration &theSensorConfiguration);
 
+    /**
+     * Disables shared BehaviorSets for Actors created afterwards.
+     */
+    static void disableSharedBehaviorSets() noexcept;
+
+    /**
+     * Enables shared BehaviorSets for Actors created afterwards. Only
+     * BehaviorSets whose Behaviors and Sensors are all declared shareable
+     * (see EntityCapabilities::myShareable) are shared, others are still
+     * created per Actor. A shared Sensor holds the results for the Actor
+     * last sensed, so Actors sharing a BehaviorSet must not be evaluated
+     * concurrently.
+     */
+    static void enableSharedBehaviorSets() noexcept;
+
     /**
      * Copy assignment operator
      */
@@ -146,6 +173,53 @@ namespace QS
 
     private:
 
+    /**
+     * Finds the configuration of a dependency: one with the same type and tag
+     * or, failing that, one with the same type.
+     *
+     * @param theConfigurations
+     *          dependency configurations of an entity
+     * @param theDependency
+     *          dependency to find
+     * @return configuration, nullptr if none matched
+     */
+    static const SimulationEntityConfiguration* findDependencyConfiguration(
+      const std::vector<SimulationEntityConfiguration> &theConfigurations,
+      const PluginDependencySet &theDependency) noexcept;
+
+    /**
+     * Returns the BehaviorSet for an Actor, either a new one or, if shared
+     * BehaviorSets are enabled and it is shareable (see isShareable), one
+     * with the same configuration created earlier.
+     *
+     * @param theBehaviorSetConfiguration
+     *          configuration of the BehaviorSet and its dependencies
+     * @return BehaviorSet
+     */
+    BehaviorSet* getBehaviorSet(
+      const SimulationEntityConfiguration &theBehaviorSetConfiguration);
+
+    /**
+     * Returns a string uniquely identifying a configuration and all of its
+     * dependency configurations.
+     *
+     * @param theConfiguration
+     *          configuration
+     * @return key
+     */
+    static std::string getKey(
+      const SimulationEntityConfiguration &theConfiguration);
+
+    /**
+     * Returns whether a BehaviorSet, its Behaviors and their Sensors are all
+     * declared shareable.
+     *
+     * @param theBehaviorSet
+     *          BehaviorSet to check
+     * @return true if it can be shared between Actors
+     */
+    static bool isShareable(const BehaviorSet *theBehaviorSet) noexcept;
+
     /** All created behaviors and the plugins which created them. */
     std::vector<std::pair<Actor*, std::shared_ptr<Plugin>>> myActors;
 
@@ -162,6 +236,12 @@ namespace QS
     /** Collection of loaded plugins for creation/destruction of entities. */
     std::shared_ptr<PluginCollection> myPlugins;
 
+    /**
+     * Shared BehaviorSets, by configuration key (see getKey); nullptr for
+     * configurations which aren't shareable.
+     */
+    std::map<std::string, BehaviorSet*> mySharedBehaviorSets;
+
     /** All created sensors and the plugins which created them. */
     std::vector<std::pair<Sensor*, std::shared_ptr<Plugin>>> mySensors;
 
@@ -7,17 +7,26 @@
  * @author Michael Albers
  */
 
+#include <array>
 #include <chrono>
 #include <cfloat>
+#include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <map>
 #include <memory>
 #include <vector>
+#include "ActorMetrics.h"
+#include "FrameProfiler.h"
+#include "PerfCounters.h"
+#include "SeqLock.h"
+#include "TimeSeriesSample.h"
 
 namespace QS
 {
   class Actor;
-  class ActorMetrics;
+  class MetricsSink;
+  class MetricsSinkWriter;
 
   /**
    * This class is used for all Metrics gathering in a simulation. It provides
@@ -50,6 +59,49 @@ namespace QS
       }
     };
 
+    /**
+     * Point-in-time copy of the metrics which change while the simulation
+     * runs. Published by the simulation thread once per update and safe to
+     * read from any other thread (see getSnapshot).
+     */
+    class Snapshot
+    {
+      public:
+      /** Amount of time the simulation has run, in seconds. */
+      float myElapsedTime = 0.0;
+
+      /** Interval of the most recent update, in seconds. */
+      float myLastUpdateInterval = 0.0;
+
+      /** Total number of Actors in the simulation. */
+      std::uint32_t myNumberActors = 0;
+
+      /** Number of Actors which have exited the world. */
+      std::uint32_t myNumberActorsExited = 0;
+
+      /** Number of Actors still in the world. */
+      std::uint32_t myNumberActorsRemaining = 0;
+
+      /** Number of updates performed. */
+      std::uint64_t myNumberUpdates = 0;
+
+      /**
+       * Time spent in each phase of the most recent update, in seconds. All
+       * zero if the profiler is disabled.
+       */
+      FrameProfiler::PhaseTimes myPhaseTimes{};
+    };
+
+    /** Number of buckets in each phase time histogram. */
+    static constexpr std::size_t NUMBER_HISTOGRAM_BUCKETS = 24;
+
+    /**
+     * Histogram of phase times. Bucket 0 counts times under 1 microsecond,
+     * bucket N (N > 0) counts times in [2^(N-1), 2^N) microseconds. The last
+     * bucket also counts all larger times.
+     */
+    using Histogram = std::array<std::uint64_t, NUMBER_HISTOGRAM_BUCKETS>;
+
     /** Shortcut to reduce typing. */
     using TimePoint = std::chrono::time_point<Clock>;
 
@@ -67,18 +119,59 @@ namespace QS
     /**
      * Copy constructor.
      */
-    Metrics(const Metrics&) = default;
+    Metrics(const Metrics&) = delete;
 
     /**
      * Move constructor.
      */
-    Metrics(Metrics&&) = default;
+    Metrics(Metrics&&) = delete;
 
     /**
      * Destructor
      */
     virtual ~Metrics() = default;
 
+    /**
+     * Adds the wall time taken by a single update. Only used for time series
+     * metrics.
+     *
+     * @param theNumberSeconds
+     *          wall time of the update, in seconds
+     */
+    void addFrameWallTime(float theNumberSeconds) noexcept;
+
+    /**
+     * Completes the given time series sample with the values tracked here
+     * (simulated time, frame wall times, Exit throughputs) and queues it for
+     * writing to the time series sink. Throughputs are computed from the
+     * change in the sample's Exit counts since the previous sample.
+     *
+     * @param theSample
+     *          sample with the world-derived values filled in
+     * @throws std::logic_error
+     *           if no time series sink has been set
+     */
+    void addTimeSeriesSample(TimeSeriesSample theSample);
+
+    /**
+     * Adds the time spent in each phase of a single update.
+     *
+     * @param theTimes
+     *          time spent in each phase, in seconds
+     */
+    void addPhaseTimes(const FrameProfiler::PhaseTimes &theTimes) noexcept;
+
+    /**
+     * Adds the hardware counter values for each phase of a single update.
+     *
+     * @param theCounters
+     *          counter values for each phase
+     * @param theNumberActors
+     *          number of Actors updated
+     */
+    void addPhaseCounters(const FrameProfiler::PhaseCounters &theCounters,
+                          std::size_t theNumberActors) noexcept;
+
     /**
      * Adds the given number of seconds to the elapsed time.
      *
@@ -98,6 +191,21 @@ namespace QS
      */
     static std::string asISO8601(const TimePoint &theTime) noexcept;
 
+    /**
+     * Adds the provided number of meters to the gross distance traveled by the
+     * Actor with the given index. This is the per-update path and avoids the
+     * Actor pointer lookup of getActorMetrics.
+     *
+     * @param theActorIndex
+     *          index of the Actor (see getActorIndex)
+     * @param theDistanceMeters
+     *          distance to add
+     * @throws std::invalid_argument
+     *           if theDistanceMeters is negative
+     */
+    void addActorGrossDistance(std::size_t theActorIndex,
+                               float theDistanceMeters);
+
     /**
      * Finalizes all Actor metrics. Calculates net distances and computes
      * basic statistics for Actor metrics. It is expected that the provided
@@ -107,13 +215,28 @@ namespace QS
      * @param theActors
      *          actors to gather metrics for
      */
-    void finalizeActorMetrics(const std::vector<Actor*> theActors) noexcept;
+    void finalizeActorMetrics(const std::vector<Actor*> &theActors) noexcept;
 
     /**
-     * Finalizes all simulation metrics.
+     * Finalizes all simulation metrics. This also closes the time series sink,
+     * if there is one, waiting for all queued samples to be written.
      */
     void finalizeSimulationMetrics() noexcept;
 
+    /**
+     * Returns the index of the given Actor. This index is the position of the
+     * Actor in the list given to initializeActorMetrics and does not change
+     * for the life of the simulation.
+     *
+     * @param theActor
+     *          Actor to retrieve the index of
+     * @return index of the Actor
+     * @throws std::out_of_range
+     *           if the Actor was not included in the list passed to
+     *           initializeActorMetrics
+     */
+    std::size_t getActorIndex(const Actor *theActor) const;
+
     /**
      * Returns the metrics for the given Actor.
      *
@@ -132,6 +255,22 @@ namespace QS
      */
     ActorMetrics& getActorMetrics(const Actor *theActor);
 
+    /**
+     * Returns the metrics for the Actor with the given index.
+     *
+     * @param theActorIndex
+     *          index of the Actor (see getActorIndex)
+     * @return metrics for the Actor
+     * @throws std::out_of_range
+     *           if the index is not valid
+     */
+    const ActorMetrics& getActorMetrics(std::size_t theActorIndex) const;
+
+    /**
+     * @see Const version
+     */
+    ActorMetrics& getActorMetrics(std::size_t theActorIndex);
+
     /**
      * Returns the number of seconds the simulation has run.
      *
@@ -139,6 +278,53 @@ namespace QS
      */
     float getElapsedTimeInSeconds() const noexcept;
 
+    /**
+     * Returns the histogram of times for the given update phase.
+     *
+     * @param thePhase
+     *          update phase
+     * @return histogram of times (see Histogram)
+     */
+    Histogram getPhaseHistogram(FrameProfiler::Phase thePhase) const noexcept;
+
+    /**
+     * Returns the total hardware counter values for the given update phase.
+     *
+     * @param thePhase
+     *          update phase
+     * @return counter totals
+     */
+    PerfCounters::Values getPhaseCounters(FrameProfiler::Phase thePhase) const
+      noexcept;
+
+    /**
+     * Returns the number of Actor updates (Actors times updates) covered by
+     * the hardware counters.
+     *
+     * @return number of Actor updates
+     */
+    std::uint64_t getNumberCountedActorUpdates() const noexcept;
+
+    /**
+     * Returns statistics, in seconds, of the time spent in the given update
+     * phase. The average is only valid after finalizeSimulationMetrics.
+     *
+     * @param thePhase
+     *          update phase
+     * @return phase time statistics
+     */
+    MinMaxAvg<float> getPhaseMetrics(FrameProfiler::Phase thePhase)
+      const noexcept;
+
+    /**
+     * Returns the most recently published snapshot of the running metrics.
+     * This never blocks the simulation thread and is safe to call from any
+     * thread at any time.
+     *
+     * @return latest snapshot
+     */
+    Snapshot getSnapshot() const noexcept;
+
     /**
      * Returns the start time of the simulation.
      *
@@ -161,23 +347,64 @@ namespace QS
     MinMaxAvg<float> getUpdateMetrics() const noexcept;
 
     /**
-     * Initializes all actor metrics from the given list of Actors
+     * Returns true if a time series sink has been set.
+     *
+     * @return true if a time series sink has been set
+     */
+    bool hasTimeSeriesSink() const noexcept;
+
+    /**
+     * Returns true if a time series sink is set and enough simulated time has
+     * passed since the previous sample to take another.
+     *
+     * @return true if a time series sample should be taken
+     */
+    bool isTimeSeriesSampleDue() const noexcept;
+
+    /**
+     * Initializes all actor metrics from the given list of Actors. The
+     * position of each Actor in the list becomes its index (see
+     * getActorIndex).
      *
      * @param theActors
      *          actors to gather metrics for
      */
-    void initializeActorMetrics(const std::vector<Actor*> theActors)
+    void initializeActorMetrics(const std::vector<Actor*> &theActors)
       noexcept;
 
     /**
      * Copy assignment operator
      */
-    Metrics& operator=(const Metrics&) = default;
+    Metrics& operator=(const Metrics&) = delete;
 
     /**
      * Move assignment operator
      */
-    Metrics& operator=(Metrics&&) = default;
+    Metrics& operator=(Metrics&&) = delete;
+
+    /**
+     * Publishes a new snapshot of the running metrics for readers on other
+     * threads. This should be called once per update, and only from the
+     * thread performing the updates.
+     *
+     * @param theNumberActorsRemaining
+     *          number of Actors still in the world
+     */
+    void publishSnapshot(std::size_t theNumberActorsRemaining) noexcept;
+
+    /**
+     * Sets the destination of time series metrics. Samples are written on a
+     * separate thread.
+     *
+     * @param theSink
+     *          destination of time series samples
+     * @param theSampleInterval_s
+     *          simulated time between samples, in seconds
+     * @throws std::invalid_argument
+     *           if theSink is null or theSampleInterval_s is &le; 0
+     */
+    void setTimeSeriesSink(std::shared_ptr<MetricsSink> theSink,
+                           float theSampleInterval_s);
 
     /**
      * Sets the stop time to the current time;
@@ -202,8 +429,11 @@ namespace QS
     /** Statistics for Actor net distance */
     MinMaxAvg<float> myActorNetStats;
 
-    /** Per-Actor metrics */
-    std::map<const Actor*, std::shared_ptr<ActorMetrics>> myActorMetrics;
+    /** Index of each Actor into myActorMetrics. */
+    std::map<const Actor*, std::size_t> myActorIndexes;
+
+    /** Per-Actor metrics, indexed by Actor index. */
+    std::vector<ActorMetrics> myActorMetrics;
 
     /** Amount of time the simulation has run. */
     float myElapsedTime = 0.0;
@@ -211,12 +441,60 @@ namespace QS
     /** World length (y dimension), in meters.*/
     float myLength_m = 0.0;
 
+    /** Snapshot of running metrics for other threads. */
+    SeqLock<Snapshot> mySnapshot;
+
     /** Start time of the simulation. */
     TimePoint myStartTime;
 
     /** Stop time of the simulation. */
     TimePoint myStopTime;
 
+    /** Number of updates since the previous time series sample. */
+    std::uint32_t myFrameCount = 0;
+
+    /** Max update wall time since the previous time series sample. */
+    float myFrameWallTimeMax = 0.0;
+
+    /** Total update wall time since the previous time series sample. */
+    float myFrameWallTimeSum = 0.0;
+
+    /** Number of Actor updates covered by myPhaseCounters. */
+    std::uint64_t myNumberCountedActorUpdates = 0;
+
+    /** Total hardware counter values for each update phase. */
+    FrameProfiler::PhaseCounters myPhaseCounters{};
+
+    /** Most recent time spent in each update phase. */
+    FrameProfiler::PhaseTimes myLastPhaseTimes{};
+
+    /** Histograms of the time spent in each update phase. */
+    std::array<Histogram, FrameProfiler::NUMBER_PHASES> myPhaseHistograms{};
+
+    /** Statistics for the time spent in each update phase. */
+    std::array<MinMaxAvg<float>, FrameProfiler::NUMBER_PHASES> myPhaseMetrics;
+
+    /** Most recent update interval. */
+    float myLastUpdateInterval = 0.0;
+
+    /** Number of updates performed. */
+    std::uint64_t myNumberUpdates = 0;
+
+    /** Exit counts of the previous time series sample. */
+    std::vector<std::uint32_t> myTimeSeriesExitCounts;
+
+    /** Simulated time of the previous time series sample. */
+    float myTimeSeriesLastSampleTime = 0.0;
+
+    /** Simulated time at which the next time series sample is due. */
+    float myTimeSeriesNextSampleTime = 0.0;
+
+    /** Simulated time between time series samples. */
+    float myTimeSeriesSampleInterval = 0.0;
+
+    /** Writer of time series samples, null if there is no sink. */
+    std::shared_ptr<MetricsSinkWriter> myTimeSeriesWriter;
+
     /** Metrics for update intervals. */
     MinMaxAvg<float> myUpdateMetrics;
 
@@ -225,6 +503,8 @@ namespace QS
 
     private:
 
+    /** Maximum number of time series samples waiting to be written. */
+    static constexpr std::size_t TIME_SERIES_QUEUE_CAPACITY = 64;
   };
 }
 
@@ -0,0 +1,76 @@
+#pragma once
+
+/**
+ * @file MetricsSink.h
+ * @brief Interface for consumers of time series metrics.
+ *
+ * @author Michael Albers
+ */
+
+namespace QS
+{
+  class TimeSeriesSample;
+
+  /**
+   * Abstract destination of time series metrics samples (i.e., a file in some
+   * format). Sinks are only ever used by one thread at a time, see
+   * MetricsSinkWriter.
+   */
+  class MetricsSink
+  {
+    public:
+
+    /**
+     * Default constructor.
+     */
+    MetricsSink() = default;
+
+    /**
+     * Copy constructor.
+     */
+    MetricsSink(const MetricsSink&) = delete;
+
+    /**
+     * Move constructor.
+     */
+    MetricsSink(MetricsSink&&) = delete;
+
+    /**
+     * Destructor.
+     */
+    virtual ~MetricsSink() = default;
+
+    /**
+     * Flushes any buffered samples to the underlying destination.
+     *
+     * @throws std::runtime_error
+     *           on any I/O error
+     */
+    virtual void flush() = 0;
+
+    /**
+     * Copy assignment operator
+     */
+    MetricsSink& operator=(const MetricsSink&) = delete;
+
+    /**
+     * Move assignment operator
+     */
+    MetricsSink& operator=(MetricsSink&&) = delete;
+
+    /**
+     * Writes the given sample. All samples written to a sink must have the
+     * same number of Exits.
+     *
+     * @param theSample
+     *          sample to write
+     * @throws std::runtime_error
+     *           on any I/O error
+     */
+    virtual void write(const TimeSeriesSample &theSample) = 0;
+
+    protected:
+
+    private:
+  };
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+/**
+ * @file MetricsSinkWriter.h
+ * @brief Feeds time series samples to a MetricsSink on its own thread.
+ *
+ * @author Michael Albers
+ */
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "TimeSeriesSample.h"
+
+namespace QS
+{
+  class MetricsSink;
+
+  /**
+   * Moves writing of time series samples off of the simulation thread.
+   * Samples are pushed onto a bounded queue which a dedicated thread drains
+   * into the MetricsSink. If the queue is full, push blocks until there is
+   * room (samples are never dropped).
+   *
+   * If the sink throws, the error is saved (see getErrorMessage) and all
+   * further samples are discarded.
+   */
+  class MetricsSinkWriter
+  {
+    public:
+
+    /**
+     * Default constructor.
+     */
+    MetricsSinkWriter() = delete;
+
+    /**
+     * Constructor. Starts the writer thread.
+     *
+     * @param theSink
+     *          destination of the samples
+     * @param theQueueCapacity
+     *          maximum number of samples waiting to be written
+     * @throws std::invalid_argument
+     *           if theSink is null or theQueueCapacity is 0
+     */
+    MetricsSinkWriter(std::shared_ptr<MetricsSink> theSink,
+                      std::size_t theQueueCapacity);
+
+    /**
+     * Copy constructor.
+     */
+    MetricsSinkWriter(const MetricsSinkWriter&) = delete;
+
+    /**
+     * Move constructor.
+     */
+    MetricsSinkWriter(MetricsSinkWriter&&) = delete;
+
+    /**
+     * Destructor. Closes the writer (see close).
+     */
+    ~MetricsSinkWriter();
+
+    /**
+     * Writes all queued samples, flushes the sink and stops the writer
+     * thread. Calling this more than once has no effect.
+     */
+    void close() noexcept;
+
+    /**
+     * Returns the error raised by the sink, if any.
+     *
+     * @return error message, empty if there have been no errors
+     */
+    std::string getErrorMessage() const;
+
+    /**
+     * Returns the number of samples successfully written to the sink.
+     *
+     * @return number of samples written
+     */
+    std::uint64_t getNumberSamplesWritten() const;
+
+    /**
+     * Copy assignment operator
+     */
+    MetricsSinkWriter& operator=(const MetricsSinkWriter&) = delete;
+
+    /**
+     * Move assignment operator
+     */
+    MetricsSinkWriter& operator=(MetricsSinkWriter&&) = delete;
+
+    /**
+     * Queues the given sample for writing. Blocks while the queue is full.
+     *
+     * @param theSample
+     *          sample to write
+     * @throws std::logic_error
+     *           if the writer has been closed
+     */
+    void push(TimeSeriesSample theSample);
+
+    protected:
+
+    private:
+
+    /**
+     * Writer thread function.
+     */
+    void run() noexcept;
+
+    /** Has close been called? */
+    bool myClosed = false;
+
+    /** Signaled when a sample is queued or the writer is closed. */
+    std::condition_variable myConsumerCondition;
+
+    /** Error from the sink, if any. */
+    std::string myErrorMessage;
+
+    /** Guards all members used by both threads. */
+    mutable std::mutex myMutex;
+
+    /** Number of samples written to the sink. */
+    std::uint64_t myNumberSamplesWritten = 0;
+
+    /** Signaled when a sample is removed from the queue. */
+    std::condition_variable myProducerCondition;
+
+    /** Samples waiting to be written. */
+    std::deque<TimeSeriesSample> myQueue;
+
+    /** Maximum size of myQueue. */
+    const std::size_t myQueueCapacity;
+
+    /** Destination of the samples. */
+    std::shared_ptr<MetricsSink> mySink;
+
+    /** Writer thread. */
+    std::thread myThread;
+  };
+}
@@ -0,0 +1,220 @@
+#pragma once
+
+/**
+ * @file PlacementIndex.h
+ * @brief Defines the index used to validate initial Actor placement.
+ *
+ * @author Michael Albers
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "Eigen/Core"
+
+namespace QS
+{
+  class Actor;
+
+  /**
+   * Index of the initial positions of the Actors added to the world, used to
+   * check new Actors for duplicates and overlaps without comparing against
+   * every Actor already added.
+   *
+   * Circles are bucketed into a sparse uniform grid which is built up as
+   * circles are added, so the world size and Actor sizes don't need to be
+   * known in advance. Cells are twice the size of the largest circle when
+   * they were last sized, and the grid is rebuilt when a larger circle is
+   * added. Queries cover every cell within the query radius plus the largest
+   * radius added.
+   *
+   * Positions are those at the time the circle is added; the index doesn't
+   * follow Actors as they move.
+   */
+  class PlacementIndex
+  {
+    public:
+
+    /**
+     * Default constructor.
+     */
+    PlacementIndex() = default;
+
+    /**
+     * Copy constructor.
+     */
+    PlacementIndex(const PlacementIndex&) = default;
+
+    /**
+     * Move constructor.
+     */
+    PlacementIndex(PlacementIndex&&) = default;
+
+    /**
+     * Destructor.
+     */
+    ~PlacementIndex() = default;
+
+    /**
+     * Adds an Actor at its current position. The index of the Actor is the
+     * number of Actors added before it.
+     *
+     * @param theActor
+     *          Actor to add
+     */
+    void addActor(const Actor *theActor);
+
+    /**
+     * Adds a circle with no Actor. It is given an index the same as addActor.
+     *
+     * @param thePosition
+     *          circle center
+     * @param theRadius
+     *          circle radius
+     */
+    void addCircle(Eigen::Vector2f thePosition, float theRadius);
+
+    /**
+     * Clears the index.
+     */
+    void clear() noexcept;
+
+    /**
+     * Checks if the Actor has been added.
+     *
+     * @param theActor
+     *          Actor to look for
+     * @return true if the Actor has been added
+     */
+    bool contains(const Actor *theActor) const noexcept;
+
+    /**
+     * Returns the indexes (in order added) of all circles which overlap the
+     * given circle. Circles which touch are considered overlapping.
+     *
+     * @param thePosition
+     *          circle center
+     * @param theRadius
+     *          circle radius
+     * @return indexes of overlapping circles, in ascending order
+     */
+    std::vector<std::size_t> getOverlaps(Eigen::Vector2f thePosition,
+                                         float theRadius) const;
+
+    /**
+     * Checks if the given circle overlaps any circle in the index. Same as
+     * getOverlaps, but stops at the first overlap.
+     *
+     * @param thePosition
+     *          circle center
+     * @param theRadius
+     *          circle radius
+     * @return true if there is at least one overlap
+     */
+    bool overlaps(Eigen::Vector2f thePosition, float theRadius) const noexcept;
+
+    /**
+     * Returns the number of circles in the index.
+     *
+     * @return number of circles
+     */
+    std::size_t size() const noexcept;
+
+    /**
+     * Copy assignment operator.
+     */
+    PlacementIndex& operator=(const PlacementIndex&) = default;
+
+    /**
+     * Move assignment operator.
+     */
+    PlacementIndex& operator=(PlacementIndex&&) = default;
+
+    protected:
+
+    private:
+
+    /**
+     * Circle stored in a cell.
+     */
+    class Circle
+    {
+      public:
+      /** Index (order added). */
+      std::size_t myIndex;
+      /** Center. */
+      Eigen::Vector2f myPosition;
+      /** Radius. */
+      float myRadius;
+    };
+
+    /**
+     * Adds a circle to the cell its center is in.
+     *
+     * @param theCircle
+     *          circle to add
+     */
+    void insert(const Circle &theCircle);
+
+    /**
+     * Calls the function with the index of each circle which overlaps the
+     * given circle, stopping early if the function returns false.
+     *
+     * @param thePosition
+     *          circle center
+     * @param theRadius
+     *          circle radius
+     * @param theFunction
+     *          function called as bool(std::size_t)
+     */
+    template<class Function>
+    void forEachOverlap(Eigen::Vector2f thePosition, float theRadius,
+                        Function theFunction) const;
+
+    /**
+     * Returns the grid coordinate of a single axis value.
+     *
+     * @param theValue
+     *          x or y value
+     * @return cell column or row
+     */
+    std::int32_t getCell(float theValue) const noexcept;
+
+    /**
+     * Combines a cell column and row into a key for myCells.
+     *
+     * @param theColumn
+     *          cell column
+     * @param theRow
+     *          cell row
+     * @return cell key
+     */
+    static std::uint64_t getKey(std::int32_t theColumn,
+                                std::int32_t theRow) noexcept;
+
+    /**
+     * Re-buckets every circle, after the cell size changes.
+     */
+    void rebuild();
+
+    /** Actors added, for duplicate detection. */
+    std::unordered_set<const Actor*> myActors;
+
+    /**
+     * Circles in each non-empty cell. The circles are kept in the cells
+     * (rather than indexes to them) so a query reads memory close together.
+     */
+    std::unordered_map<std::uint64_t, std::vector<Circle>> myCells;
+
+    /** Size of each (square) cell, 0 until the first circle is added. */
+    float myCellSize = 0.0;
+
+    /** Largest radius of any circle added. */
+    float myMaximumRadius = 0.0;
+
+    /** Number of circles added. */
+    std::size_t myNumberCircles = 0;
+  };
+}
@@ -7,11 +7,15 @@
  * @author Michael Albers
  */
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
+#include "EntityCapabilities.h"
 #include "PluginDefinition.h"
 
 namespace QS
@@ -21,11 +25,23 @@ namespace QS
   class BehaviorSet;
   class Exit;
   class Sensor;
+  class StaticPlugin;
 
   /**
    * Run-time interface for a single plugin. This function manages loading the
    * plugin's shared object library and provides functions for creation and
    * destruction of the pieces of the plugin.
+   *
+   * Libraries may describe themselves with a PluginABI, giving the
+   * capabilities of their entity types. Those which don't are treated as
+   * ABI version 1, with no capabilities.
+   *
+   * Plugins linked into the executable (see StaticPlugin) take their
+   * functions from it rather than from a library.
+   *
+   * The dependencies of each Actor, BehaviorSet and Behavior type are indexed
+   * by type name when the plugin is loaded, so creating entities doesn't
+   * search (or copy) the definitions.
    */
   class Plugin
   {
@@ -53,6 +69,12 @@ namespace QS
     using CreatorDestructor = std::pair<CreatorFunction<T>,
                                         DestructorFunction<T>>;
 
+    /**
+     * Dependencies of an entity type, in the order they are given to the
+     * entity.
+     */
+    using Dependencies = std::vector<PluginDependencySet>;
+
     /**
      * Default constructor.
      */
@@ -74,10 +96,25 @@ namespace QS
      *
      * @param theDefinition
      *           populated plugin definition
-     * @throw std::runtime_error On problems loading the shared library.
+     * @throw std::runtime_error On problems loading the shared library, or if
+     *        it has an unsupported PluginABI version.
      */
     Plugin(std::shared_ptr<PluginDefinition> theDefinition);
 
+    /**
+     * Constructor. Constructs a plugin linked into the executable from the
+     * given definition, no library is loaded.
+     *
+     * @param theDefinition
+     *           populated plugin definition
+     * @param theStaticPlugin
+     *           functions of the plugin, must outlive this object
+     * @throw std::runtime_error If a function named in the definition isn't
+     *        given, or the plugin has an unsupported PluginABI version.
+     */
+    Plugin(std::shared_ptr<PluginDefinition> theDefinition,
+           const StaticPlugin &theStaticPlugin);
+
     /**
      * Destructor.
      */
@@ -248,6 +285,61 @@ namespace QS
      */
     void destroySensor(Sensor *theSensor) const;
 
+    /**
+     * Returns the ABI version of the plugin's library.
+     *
+     * @return PluginABI version, 1 if the library has no PluginABI
+     */
+    std::uint32_t getABIVersion() const noexcept;
+
+    /**
+     * Returns the BehaviorSets needed by an Actor type.
+     *
+     * @param theType
+     *          Actor type
+     * @return BehaviorSets
+     * @throw std::invalid_argument
+     *          if the plugin has no such Actor type
+     */
+    const Dependencies& getActorDependencies(const std::string &theType) const;
+
+    /**
+     * Returns the Sensors needed by a Behavior type.
+     *
+     * @param theType
+     *          Behavior type
+     * @return Sensors
+     * @throw std::invalid_argument
+     *          if the plugin has no such Behavior type
+     */
+    const Dependencies& getBehaviorDependencies(
+      const std::string &theType) const;
+
+    /**
+     * Returns the Behaviors needed by a BehaviorSet type.
+     *
+     * @param theType
+     *          BehaviorSet type
+     * @return Behaviors
+     * @throw std::invalid_argument
+     *          if the plugin has no such BehaviorSet type
+     */
+    const Dependencies& getBehaviorSetDependencies(
+      const std::string &theType) const;
+
+    /**
+     * Returns the capabilities of an entity type.
+     *
+     * @param theKind
+     *          kind of entity
+     * @param theType
+     *          entity type
+     * @return capabilities, none if the plugin didn't declare any
+     */
+    const EntityCapabilities& getCapabilities(EntityCapabilities::Kind theKind,
+                                              const std::string &theType)
+      const noexcept;
+
     /**
      * Returns the definition of this plugin.
      *
@@ -274,6 +366,23 @@ namespace QS
 
     private:
 
+    /** Dependencies of each type, by type name. */
+    using DependencyIndex = std::unordered_map<std::string, Dependencies>;
+
+    /**
+     * Constructor.
+     *
+     * @param theDefinition
+     *           populated plugin definition
+     * @param theStaticPlugin
+     *           functions of the plugin if linked in, otherwise null to load
+     *           its library
+     * @throw std::runtime_error On problems loading the functions, or if the
+     *        plugin has an unsupported PluginABI version.
+     */
+    Plugin(std::shared_ptr<PluginDefinition> theDefinition,
+           const StaticPlugin *theStaticPlugin);
+
     /**
      * Generic creator function.
      *
@@ -319,6 +428,31 @@ namespace QS
                  CreatorDestructor<T> theCreatorDestructor,
                  const std::string &theName) const;
 
+    /**
+     * Generic dependency look up.
+     *
+     * @param theIndex
+     *          index to search
+     * @param theType
+     *          type name
+     * @param theName
+     *          description of the kind of type
+     * @return dependencies
+     * @throw std::invalid_argument
+     *          if the type isn't in the index
+     */
+    const Dependencies& getDependencies(const DependencyIndex &theIndex,
+                                        const std::string &theType,
+                                        const std::string &theName) const;
+
+    /**
+     * Loads the library's PluginABI, if it has one.
+     *
+     * @throw std::runtime_error
+     *          if the version isn't supported
+     */
+    void loadABI();
+
     /**
      * Generic function for loading creator/destructor functions.
      *
@@ -334,6 +468,20 @@ namespace QS
       PluginDefinition::CreatorDestructorPair theCreatorDestructor,
       const std::string &theType);
 
+    /**
+     * Finds a function of the plugin, in its library or StaticPlugin.
+     *
+     * @param theName
+     *          name of the function
+     * @param theDescription
+     *          description of the function
+     * @return function
+     * @throw std::runtime_error
+     *          if the plugin has no such function
+     */
+    void* loadFunction(const std::string &theName,
+                       const std::string &theDescription);
+
     /**
      * Opens the library.
      *
@@ -342,6 +490,22 @@ namespace QS
      */
     void openLibrary();
 
+    /** ABI version of the library. */
+    std::uint32_t myABIVersion = 1;
+
+    /** BehaviorSets needed by each Actor type. */
+    DependencyIndex myActorDependencies;
+
+    /** Sensors needed by each Behavior type. */
+    DependencyIndex myBehaviorDependencies;
+
+    /** Behaviors needed by each BehaviorSet type. */
+    DependencyIndex myBehaviorSetDependencies;
+
+    /** Capabilities of each entity type which has any, by kind and type. */
+    std::map<std::pair<EntityCapabilities::Kind, std::string>,
+             EntityCapabilities> myCapabilities;
+
     /** Definition of the plugin. */
     std::shared_ptr<PluginDefinition> myDefinition;
 
@@ -361,7 +525,10 @@ namespace QS
     /** Creator/destructor functions for Sensors. */
     CreatorDestructor<Sensor> mySensorCreatorDestructor{nullptr, nullptr};
 
-    /** Library handle from dlopen. */
-    void *myLibraryHandle;
+    /** Library handle from dlopen, null if linked in. */
+    void *myLibraryHandle = nullptr;
+
+    /** Functions of the plugin if linked in, otherwise null. */
+    const StaticPlugin *myStaticPlugin = nullptr;
   };
 }
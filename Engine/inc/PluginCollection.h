@@ -10,15 +10,21 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace QS
 {
   class Plugin;
+  class StaticPlugin;
 
   /**
    * The PluginCollection class provides a repository for all Plugins for the
    * simulator. It discovers and reads them in on construction then provides
    * accessors for retrieval.
+   *
+   * Plugins linked into the executable (QS_STATIC_PLUGINS) are listed at
+   * compile time and read first. Their directories in the plugin base
+   * directory, if any, are skipped; other plugins are loaded from theirs.
    */
   class PluginCollection
   {
@@ -56,6 +62,23 @@ namespace QS
      */
     ~PluginCollection() = default;
 
+    /**
+     * Returns the configuration (definition) file of every plugin, sorted.
+     * Plugins linked into the executable have none.
+     *
+     * @return full paths of the plugin configuration files
+     */
+    std::vector<std::string> getConfigFiles() const;
+
+    /**
+     * Returns the definition of every plugin linked into the executable, in
+     * the order they were read. These have no configuration file, so are
+     * needed along with getConfigFiles to tell if any plugin changed.
+     *
+     * @return plugin definitions (XML)
+     */
+    std::vector<std::string> getEmbeddedDefinitions() const;
+
     /**
      * Returns the plugin with the given name. If none is found, an exception
      * is thrown.
@@ -103,8 +126,22 @@ namespace QS
                     const std::string &theConfigFile,
                     const std::string &thePluginSchemaDirectory);
 
+    /**
+     * Reads a plugin linked into the executable.
+     *
+     * @param thePlugin
+     *          plugin definition and functions
+     */
+    void readStaticPlugin(const StaticPlugin &thePlugin);
+
     private:
 
+    /** Configuration file of every plugin read. */
+    std::vector<std::string> myConfigFiles;
+
+    /** Definition of every plugin linked into the executable. */
+    std::vector<std::string> myEmbeddedDefinitions;
+
     /** All plugins, keyed by name. */
     std::map<std::string, std::shared_ptr<Plugin>> myPlugins;
   };
@@ -52,6 +52,18 @@ namespace QS
                  const std::string &theConfigFile,
                  const std::string &thePluginSchemaDirectory);
 
+    /**
+     * Constructor, for a plugin configuration file compiled into the
+     * executable (see StaticPlugin). It isn't validated.
+     *
+     * @param theConfigFile
+     *          name of the plugin configuration file, for error messages
+     * @param theDefinition
+     *          contents of the plugin configuration file
+     */
+    PluginReader(const std::string &theConfigFile,
+                 const std::string &theDefinition);
+
     /**
      * Destructor.
      */
@@ -117,6 +129,9 @@ namespace QS
     /** Plugin config file */
     const std::string myConfigFile;
 
+    /** Contents of the plugin config file if compiled in, otherwise empty. */
+    const std::string myDefinition;
+
     /** Current Exit definition */
     std::shared_ptr<ExitDefinition> myExitDefinition;
 
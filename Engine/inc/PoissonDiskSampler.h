@@ -0,0 +1,199 @@
+#pragma once
+
+/**
+ * @file PoissonDiskSampler.h
+ * @brief Generates non-overlapping random Actor positions in bulk.
+ *
+ * @author Michael Albers
+ */
+
+#include <cstdint>
+#include <map>
+#include <vector>
+#include "Eigen/Core"
+#include "PlacementIndex.h"
+#include "RandomStream.h"
+
+namespace QS
+{
+  class World;
+
+  /**
+   * Generates random, non-overlapping Actor positions using Bridson's
+   * Poisson-disk sampling ("Fast Poisson Disk Sampling in Arbitrary
+   * Dimensions", R. Bridson), extended for circles of differing radii.
+   *
+   * Each new position is tried around a random previously generated
+   * ("active") position, at a distance of one to two times the sum of the
+   * two radii. An active position is retired once it has failed a number of
+   * tries in a row. Radii are grouped into classes (see RADIUS_CLASS_RATIO),
+   * each with its own active positions, so a position retired by a large
+   * Actor can still be grown from by smaller ones. This fills a region in
+   * time roughly linear in the number of positions (per radius class),
+   * where World::getRandomActorPosition has to find an empty spot by chance
+   * and slows down (and eventually fails) as the region fills.
+   *
+   * Positions avoid each other and any Actor already added to the World.
+   * Random numbers come from one CounterRNG::POISSON stream of the World's
+   * generator, so positions are deterministic given the World's seed and
+   * the entity number the sampler is created with.
+   */
+  class PoissonDiskSampler
+  {
+    public:
+
+    /** Tries around an active position before it is retired. */
+    static constexpr uint32_t ATTEMPTS_PER_POSITION = 30;
+
+    /**
+     * Radii in the same class (sharing active positions) differ by less
+     * than this factor.
+     */
+    static constexpr float RADIUS_CLASS_RATIO = 1.25;
+
+    /**
+     * Default constructor.
+     */
+    PoissonDiskSampler() = delete;
+
+    /**
+     * Constructor. Positions are generated anywhere in the world.
+     *
+     * @param theWorld
+     *          world to place Actors in, its dimensions must already be set
+     * @param theEntity
+     *          entity number keying the random numbers (see World::getRNG)
+     */
+    PoissonDiskSampler(World &theWorld, std::uint32_t theEntity);
+
+    /**
+     * Constructor. Positions are restricted to a rectangular region of the
+     * world. Actors are placed wholly within the region.
+     *
+     * @param theWorld
+     *          world to place Actors in
+     * @param theMinimum
+     *          corner of the region with the smallest x and y, in meters
+     * @param theMaximum
+     *          corner of the region with the largest x and y, in meters
+     * @param theEntity
+     *          entity number keying the random numbers (see World::getRNG)
+     * @throws std::invalid_argument
+     *          if the region is empty or not within the world
+     */
+    PoissonDiskSampler(World &theWorld, Eigen::Vector2f theMinimum,
+                       Eigen::Vector2f theMaximum, std::uint32_t theEntity);
+
+    /**
+     * Copy constructor.
+     */
+    PoissonDiskSampler(const PoissonDiskSampler&) = delete;
+
+    /**
+     * Move constructor.
+     */
+    PoissonDiskSampler(PoissonDiskSampler&&) = default;
+
+    /**
+     * Destructor.
+     */
+    ~PoissonDiskSampler() = default;
+
+    /**
+     * Generates the position of the next Actor.
+     *
+     * @param theRadius
+     *          Actor radius
+     * @return position
+     * @throws std::invalid_argument
+     *          if the Actor can't fit in the region
+     * @throws std::logic_error
+     *          if there is no room left for the Actor
+     */
+    Eigen::Vector2f getPosition(float theRadius);
+
+    /**
+     * Generates positions for several Actors in one pass.
+     *
+     * @param theRadii
+     *          radius of each Actor
+     * @return position of each Actor
+     * @throws std::invalid_argument
+     *          if an Actor can't fit in the region
+     * @throws std::logic_error
+     *          if there is no room left for an Actor
+     */
+    std::vector<Eigen::Vector2f> getPositions(
+      const std::vector<float> &theRadii);
+
+    /**
+     * Copy assignment operator.
+     */
+    PoissonDiskSampler& operator=(const PoissonDiskSampler&) = delete;
+
+    /**
+     * Move assignment operator.
+     */
+    PoissonDiskSampler& operator=(PoissonDiskSampler&&) = delete;
+
+    protected:
+
+    private:
+
+    /**
+     * Returns the class of a radius, radii are retired from active positions
+     * by class.
+     *
+     * @param theRadius
+     *          Actor radius
+     * @return radius class
+     */
+    static int getRadiusClass(float theRadius) noexcept;
+
+    /**
+     * Checks if an Actor at the position would be within the region and not
+     * overlap any other Actor or generated position.
+     *
+     * @param thePosition
+     *          Actor position
+     * @param theRadius
+     *          Actor radius
+     * @return true if the position can be used
+     */
+    bool isFree(Eigen::Vector2f thePosition, float theRadius) const noexcept;
+
+    /**
+     * Returns the next random number in [0, 1).
+     *
+     * @return random number
+     */
+    float random() noexcept;
+
+    /**
+     * Indexes (into myPositions) of the positions new positions are still
+     * tried around, by radius class.
+     */
+    std::map<int, std::vector<std::size_t>> myActive;
+
+    /** Positions generated so far. */
+    PlacementIndex myGenerated;
+
+    /** Corner of the region with the largest x and y. */
+    Eigen::Vector2f myMaximum;
+
+    /** Corner of the region with the smallest x and y. */
+    Eigen::Vector2f myMinimum;
+
+    /** Position of each generated Actor. */
+    std::vector<Eigen::Vector2f> myPositions;
+
+    /** Radius of each generated Actor. */
+    std::vector<float> myRadii;
+
+    /** Random numbers. */
+    RandomStream myRandom;
+
+    /** World positions are generated for. */
+    World &myWorld;
+  };
+}
@@ -7,12 +7,15 @@
  * @author Michael Albers
  */
 
+#include <cstdint>
 #include <memory>
 #include <set>
-#include <stack>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include "PropertyGeneratorScanner.h"
 #include "PropertyGeneratorToken.h"
+#include "RandomStream.h"
 
 namespace QS
 {
@@ -69,6 +72,9 @@ namespace QS
      *     respectively.
      *   this.* - References any already defined property for the current
      *     simulation entity being processed
+     *   group.index - Instance number (from 0) of the Actor being created by
+     *     an ActorGroup, 0 for anything else. See setIndex. (Not under this.*
+     *     so it can't hide a property named "index".)
      *   PI - PI
      *
      * Random numbers can be generated. To do so, use a simulated function
@@ -81,6 +87,11 @@ namespace QS
      * suitable for an RGB color spec (0.0-0.1). This cannot be part of an
      * expression: it must be used standalone.
      *
+     * Each distinct value is parsed only once, into a compiled form which is
+     * cached and evaluated for every later use of the same value. Random
+     * numbers are drawn in the same order either way, from the stream of the
+     * current entity (see setEntity).
+     *
      * @param theValue
      *          initial property value
      * @param theCurrentEntity
@@ -102,6 +113,24 @@ namespace QS
      */
     PropertyGenerator& operator=(PropertyGenerator&&) = default;
 
+    /**
+     * Sets the entity whose properties are generated next. Random numbers
+     * are drawn from the entity's CounterRNG::PROPERTIES stream (starting
+     * from its beginning), so they don't depend on those of other entities.
+     *
+     * @param theEntity
+     *          number of the entity (see World::getRNG)
+     */
+    void setEntity(std::uint32_t theEntity) noexcept;
+
+    /**
+     * Sets the value of group.index for subsequent properties.
+     *
+     * @param theIndex
+     *          instance index
+     */
+    void setIndex(std::size_t theIndex) noexcept;
+
     protected:
 
     private:
@@ -120,6 +149,76 @@ namespace QS
     void error(const PropertyGeneratorToken &theToken,
                const std::string &theError);
 
+    /**
+     * One step of a compiled property. Compiled properties are evaluated in
+     * order using a stack of floats.
+     */
+    class Instruction
+    {
+      public:
+
+      enum class OpCode
+      {
+        Add,       // Pops right then left, pushes left + right
+        Divide,    // Pops right then left, pushes left / right
+        Index,     // Pushes group.index
+        Length,    // Pushes the world length
+        Multiply,  // Pops right then left, pushes left * right
+        Property,  // Pushes entity property myName
+        Push,      // Pushes myValue
+        Rand,      // Pops high then low, pushes a random number in range
+        RandColor, // Result is a random color (always the only instruction)
+        Subtract,  // Pops right then left, pushes left - right
+        Width      // Pushes the world width
+      };
+
+      /** Operation. */
+      OpCode myOpCode;
+
+      /** Value for Push. */
+      float myValue;
+
+      /** Name for Property. */
+      std::string myName;
+    };
+
+    /** Compiled property. */
+    using Program = std::vector<Instruction>;
+
+    /**
+     * Adds an instruction to the program being compiled.
+     *
+     * @param theOpCode
+     *          operation
+     * @param theValue
+     *          value for Push
+     * @param theName
+     *          name for Property
+     */
+    void emit(Instruction::OpCode theOpCode, float theValue = 0.0,
+              const std::string &theName = "");
+
+    /**
+     * Evaluates a compiled property.
+     *
+     * @param theProgram
+     *          compiled property
+     * @param theEntity
+     *          current simulation entity, for property retrieval
+     * @return property value
+     * @throws std::runtime_error
+     *          on invalid entity property or random bounds
+     */
+    std::string evaluate(const Program &theProgram,
+                         const SimulationEntityConfiguration &theEntity);
+
+    /**
+     * Removes and returns the top of the evaluation stack.
+     *
+     * @return top value
+     */
+    float pop() noexcept;
+
     /** This class tracks which operator is used. */
     class OperatorRecord : public PropertyGeneratorToken
     {
@@ -147,7 +246,7 @@ namespace QS
     };
 
     /**
-     * Parse/execute the value.
+     * Parse the value into myProgram.
      *
      * @throws std::runtime_error
      *           syntax error
@@ -195,63 +294,24 @@ namespace QS
      */
     void match(const PropertyGeneratorToken::Type &theToken);
 
-    class StackItem
-    {
-      public:
-      enum class Type
-      {
-        String,
-        Float
-      };
-
-      StackItem() = default;
-      StackItem(float theFloat) : myType(Type::Float), myFloat(theFloat) {};
-      StackItem(const std::string theString) : myType(Type::String),
-                                           myString(theString) {};
-      ~StackItem() = default;
-      StackItem(const StackItem&) = default;
-      StackItem(StackItem&&) = default;
-      StackItem& operator=(const StackItem&) = default;
-      StackItem& operator=(StackItem&&) = default;
-
-      operator float()
-      {
-        if (myType != Type::Float)
-        {
-          std::string error{"Internal property generation error, "};
-          error += "expecting float when stack object is a string (" +
-            myString + ").";
-          throw std::logic_error(error);
-        }
-        return myFloat;
-      };
-      operator std::string()
-      {
-        if (myType != Type::String)
-        {
-          std::string error{"Internal property generation error, "};
-          error += "expecting string when stack object is a float (" +
-            std::to_string(myFloat) + ").";
-          throw std::logic_error(error);
-        }
-
-        return myString;
-      };
-
-      Type myType = Type::Float;
-      float myFloat = 0.0;
-      std::string myString;
-    };
-
-    /** Current entity from which to get attributes. */
-    const SimulationEntityConfiguration *myEntity;
+    /** Value of group.index. */
+    std::size_t myIndex;
 
     /** Evaluation stack. */
-    std::stack<StackItem> myEvaluationStack;
+    std::vector<float> myEvaluationStack;
 
     /** Original property passed in for processing. */
     std::string myOriginalProperty;
 
+    /** Program being compiled. */
+    Program myProgram;
+
+    /** Compiled form of each generated property, by original value. */
+    std::unordered_map<std::string, Program> myPrograms;
+
+    /** Random numbers of the current entity. */
+    RandomStream myRandom;
+
     /** Scanner */
     std::unique_ptr<PropertyGeneratorScanner> myScanner;
 
@@ -0,0 +1,301 @@
+#pragma once
+
+/**
+ * @file ScenarioCache.h
+ * @brief Compiled (binary) form of a fully resolved simulation file.
+ *
+ * @author Michael Albers
+ */
+
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace QS
+{
+  class SimulationEntityConfiguration;
+  class World;
+
+  /**
+   * Binary cache of a simulation after it has been read: the seed, world
+   * size, time series settings, the configuration of every Actor and Exit
+   * with all property values already generated (random positions, etc.)
+   * and their dependencies, and the random number generator state at the end
+   * of reading. Loading it repopulates the World exactly as reading the
+   * simulation file would have, without the XML parsing, schema validation
+   * and property generation.
+   *
+   * A cache is written by recording a simulation as it is read (see
+   * SimulationReader::setScenarioCache) and calling finish. Entity types,
+   * sources, tags and property names are stored once in a string table and
+   * referred to by ID. Caches are read by mapping the file into memory.
+   *
+   * Each cache is keyed by a hash of the files the simulation depends on
+   * (the simulation file, its schema and the plugin definitions) and records
+   * the build of the engine which wrote it (see getBuildId). A cache with a
+   * different key, build or format version is ignored, as is one which is
+   * corrupt; the simulation is then read and the cache rewritten.
+   *
+   * Caching is off until enable is called.
+   */
+  class ScenarioCache
+  {
+    public:
+
+    /** Function given each Actor or Exit configuration loaded. */
+    using EntityFunction =
+      std::function<void(const SimulationEntityConfiguration&)>;
+
+    /** File format version. Bump when the format changes. */
+    static constexpr std::uint32_t VERSION = 3;
+
+    /**
+     * Default constructor.
+     */
+    ScenarioCache() = delete;
+
+    /**
+     * Constructor. Starts writing a new cache. It is written to a temporary
+     * file which replaces theFileName only when finish is called.
+     *
+     * @param theFileName
+     *          cache file
+     * @param theKey
+     *          key of the simulation (see getKey)
+     * @throws std::runtime_error
+     *          if the file can't be opened
+     */
+    ScenarioCache(const std::string &theFileName, std::uint64_t theKey);
+
+    /**
+     * Copy constructor.
+     */
+    ScenarioCache(const ScenarioCache&) = delete;
+
+    /**
+     * Move constructor.
+     */
+    ScenarioCache(ScenarioCache&&) = delete;
+
+    /**
+     * Destructor. Removes the temporary file if finish wasn't called.
+     */
+    ~ScenarioCache();
+
+    /**
+     * Records an Actor, in the order created.
+     *
+     * @param theConfiguration
+     *          Actor configuration, with generated property values
+     */
+    void addActor(const SimulationEntityConfiguration &theConfiguration);
+
+    /**
+     * Records an Exit, in the order created.
+     *
+     * @param theConfiguration
+     *          Exit configuration, with generated property values
+     */
+    void addExit(const SimulationEntityConfiguration &theConfiguration);
+
+    /**
+     * Disables caching.
+     */
+    static void disable() noexcept;
+
+    /**
+     * Enables caching, cache files are kept in the given directory.
+     *
+     * @param theDirectory
+     *          cache directory (nothing is cached if it doesn't exist)
+     */
+    static void enable(const std::string &theDirectory);
+
+    /**
+     * Completes the cache and moves it into place.
+     *
+     * @param theWorld
+     *          world the simulation was read into, for its random number
+     *          generator state
+     * @throws std::runtime_error
+     *          on write error
+     */
+    void finish(const World &theWorld);
+
+    /**
+     * Returns an ID of the engine build: a hash of the binary containing the
+     * engine (the engine library if it is shared, otherwise the executable),
+     * so that code changes which alter how simulations are read invalidate
+     * existing caches. Calculated on first use.
+     *
+     * @return build ID, 0 if the binary can't be read
+     */
+    static std::uint64_t getBuildId();
+
+    /**
+     * Returns the cache directory.
+     *
+     * @return cache directory, empty if caching is disabled
+     */
+    static std::string getDirectory();
+
+    /**
+     * Returns the cache file name for a simulation file.
+     *
+     * @param theSimulationFile
+     *          simulation configuration file
+     * @param theKey
+     *          key of the simulation
+     * @return full path of the cache file in the cache directory
+     */
+    static std::string getFileName(const std::string &theSimulationFile,
+                                   std::uint64_t theKey);
+
+    /**
+     * Calculates a key from the names and contents of files, and of any
+     * other text the simulation depends on.
+     *
+     * @param theFiles
+     *          files to hash, in order
+     * @param theTexts
+     *          text to hash after the files, in order
+     * @return key (64-bit FNV-1a hash)
+     * @throws std::runtime_error
+     *          if a file can't be read
+     */
+    static std::uint64_t getKey(const std::vector<std::string> &theFiles,
+                                const std::vector<std::string> &theTexts = {});
+
+    /**
+     * Loads a cache into the World. Actors and Exits aren't added directly,
+     * each configuration is given to the appropriate function, in the order
+     * they were originally created.
+     *
+     * @param theFileName
+     *          cache file
+     * @param theKey
+     *          expected key
+     * @param theWorld
+     *          world to set up
+     * @param theActorFunction
+     *          called for each Actor
+     * @param theExitFunction
+     *          called for each Exit
+     * @return false (having changed nothing) if there is no cache file, it
+     *         has a different key, build or version, or it is corrupt; true
+     *         if it was loaded
+     * @throws std::runtime_error
+     *          if the World can't be set up from the loaded values (i.e., the
+     *          time series file can't be opened)
+     */
+    static bool load(const std::string &theFileName, std::uint64_t theKey,
+                     World &theWorld, const EntityFunction &theActorFunction,
+                     const EntityFunction &theExitFunction);
+
+    /**
+     * Records the world dimensions.
+     *
+     * @param theWidth_m
+     *          width of the world, in meters
+     * @param theLength_m
+     *          length of the world, in meters
+     */
+    void setDimensions(float theWidth_m, float theLength_m);
+
+    /**
+     * Records the seed.
+     *
+     * @param theSeed
+     *          random number generator seed
+     */
+    void setSeed(std::uint64_t theSeed);
+
+    /**
+     * Records the time series settings.
+     *
+     * @param theFile
+     *          output file
+     * @param theFormat
+     *          "csv" or "binary"
+     * @param theInterval_s
+     *          simulated time between samples, in seconds
+     * @param theDensityRadius_m
+     *          local density radius, in meters
+     */
+    void setTimeSeries(const std::string &theFile,
+                       const std::string &theFormat, float theInterval_s,
+                       float theDensityRadius_m);
+
+    /**
+     * Copy assignment operator.
+     */
+    ScenarioCache& operator=(const ScenarioCache&) = delete;
+
+    /**
+     * Move assignment operator.
+     */
+    ScenarioCache& operator=(ScenarioCache&&) = delete;
+
+    protected:
+
+    private:
+
+    /**
+     * Returns the ID of a string in the string table, adding it if needed.
+     *
+     * @param theString
+     *          string
+     * @return ID
+     */
+    std::uint32_t getStringId(const std::string &theString);
+
+    /**
+     * Writes a value.
+     *
+     * @param theValue
+     *          value to write
+     */
+    template<class T>
+    void write(T theValue);
+
+    /**
+     * Writes an entity configuration and, recursively, its dependencies.
+     *
+     * @param theConfiguration
+     *          configuration to write
+     */
+    void writeEntity(const SimulationEntityConfiguration &theConfiguration);
+
+    /**
+     * Writes a string (length and characters).
+     *
+     * @param theString
+     *          string to write
+     */
+    void writeString(const std::string &theString);
+
+    /** Final cache file name. */
+    const std::string myFileName;
+
+    /** Whether finish has been called. */
+    bool myFinished = false;
+
+    /** Key of the simulation. */
+    const std::uint64_t myKey;
+
+    /** Output (temporary) file. */
+    std::ofstream myOutput;
+
+    /** ID of each string in the string table. */
+    std::unordered_map<std::string, std::uint32_t> myStringIds;
+
+    /** String table, in ID order. */
+    std::vector<std::string> myStrings;
+
+    /** Temporary file name. */
+    const std::string myTemporaryFileName;
+  };
+}
@@ -96,36 +96,36 @@ namespace QS
      *
      * @return dependencies
      */
-    std::vector<SimulationEntityConfiguration> getDependencyConfigurations()
-      const noexcept;
+    const std::vector<SimulationEntityConfiguration>&
+      getDependencyConfigurations() const noexcept;
 
     /**
      * Returns the properties for this entity.
      *
      * @return properties for this entity
      */
-    PluginEntity::Properties getProperties() const noexcept;
+    const PluginEntity::Properties& getProperties() const noexcept;
 
     /**
      * Returns the source of the entity.
      *
      * @return entity source
      */
-    std::string getSource() const noexcept;
+    const std::string& getSource() const noexcept;
 
     /**
      * Returns the entity's tag
      *
      * @return entity tag
      */
-    std::string getTag() const noexcept;
+    const std::string& getTag() const noexcept;
 
     /**
      * Returns the type of the entity.
      *
      * @return entity type
      */
-    std::string getType() const noexcept;
+    const std::string& getType() const noexcept;
 
     /**
      * Copy assignment operator
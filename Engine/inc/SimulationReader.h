@@ -7,12 +7,16 @@
  * @author Michael Albers
  */
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <stack>
 #include <string>
+#include <utility>
+#include <vector>
 #include "xercesc/sax2/DefaultHandler.hpp"
 #include "PluginEntity.h"
+#include "PoissonDiskSampler.h"
 #include "PropertyGenerator.h"
 #include "SimulationEntityConfiguration.h"
 
@@ -21,6 +25,7 @@ XERCES_CPP_NAMESPACE_USE
 namespace QS
 {
   class EntityManager;
+  class ScenarioCache;
   class World;
 
   /**
@@ -89,6 +94,15 @@ namespace QS
      */
     void read();
 
+    /**
+     * Records the simulation into the given cache as it is read. The cache
+     * must outlive the call to read.
+     *
+     * @param theScenarioCache
+     *          cache to record into, null for none
+     */
+    void setScenarioCache(ScenarioCache *theScenarioCache) noexcept;
+
     /*
      * SAX Callbacks
      */
@@ -109,9 +123,73 @@ namespace QS
     private:
 
     /**
-     * Processes a property and adds it to the SimulationEntityConfiguration
-     * on the top of myEntityConfigurations.
+     * Unevaluated definition of a simulation entity as read from the file.
+     * Properties are only evaluated when the entity is instantiated, which
+     * lets an ActorGroup create many Actors from one definition.
+     */
+    class EntityTemplate
+    {
+      public:
+
+      /** Number of instances to create (ActorGroup count). */
+      std::uint64_t myCount = 1;
+
+      /** Templates of the dependencies, in file order. */
+      std::vector<EntityTemplate> myDependencies;
+
+      /** Name of the element (Actor, Behavior, etc.). */
+      std::string myElementName;
+
+      /** Property keys and unevaluated values, in file order. */
+      std::vector<std::pair<std::string, std::string>> myProperties;
+
+      /** Entity source (plugin name). */
+      std::string mySource;
+
+      /** Entity tag. */
+      std::string myTag;
+
+      /** Entity type name. */
+      std::string myType;
+    };
+
+    /**
+     * Returns the Poisson-disk sampler for a 'poissonPosition' region,
+     * creating it if needed (keyed by the current entity number). Samplers
+     * last until the end of the current Actor or ActorGroup.
      *
+     * @param theRegion
+     *          "world", or "minX minY maxX maxY"
+     * @return sampler
+     * @throws std::logic_error
+     *          if the region is invalid
+     */
+    PoissonDiskSampler& getSampler(const std::string &theRegion);
+
+    /**
+     * Creates the configuration of one instance of an entity, evaluating
+     * its properties and those of all its dependencies.
+     *
+     * @param theTemplate
+     *          entity definition
+     * @return entity configuration
+     * @throws std::logic_error
+     *          on invalid property value
+     */
+    SimulationEntityConfiguration instantiate(
+      const EntityTemplate &theTemplate);
+
+    /**
+     * Processes a property and adds it to the given configuration. Handles
+     * the Actor pseudo-properties 'randPosition' (random position, see
+     * World::getRandomActorPosition) and 'poissonPosition' (Poisson-disk
+     * position within the region given as the value, see getSampler), which
+     * set x and y from the radius.
+     *
+     * @param theConfiguration
+     *          configuration to add the property to
+     * @param theElementName
+     *          name of the element the property belongs to
      * @param theProperty
      *          property name
      * @param theValue
@@ -119,7 +197,9 @@ namespace QS
      * @param std::logic_error
      *          on invalid property value
      */
-    void processProperty(const std::string &theProperty,
+    void processProperty(SimulationEntityConfiguration &theConfiguration,
+                         const std::string &theElementName,
+                         const std::string &theProperty,
                          const std::string &theValue);
 
     /** Name of the plugin where the Actor can be found. */
@@ -132,16 +212,19 @@ namespace QS
     const std::string myConfigFile;
 
     /**
-     * Entity configurations, as a new dependency is encountered, it will be
+     * Entity definitions, as a new dependency is encountered, it will be
      * added to the stack, and removed when finished.
      */
-    std::stack<SimulationEntityConfiguration> myEntityConfigurations;
+    std::stack<EntityTemplate> myEntityTemplates;
 
     /** Creator of plugin entities. */
     std::shared_ptr<EntityManager> myEntityManager;
 
-    /** Name of Entity element in XML */
-    std::string myCurrentEntityElementName;
+    /**
+     * Number of the Actor or Exit being created, counting both in file
+     * order. Keys its random numbers, see World::getRNG.
+     */
+    std::uint32_t myEntityNumber = 0;
 
     /**
      * Generates properties based on small language which can be embedded in
@@ -149,6 +232,12 @@ namespace QS
      */
     PropertyGenerator myPropertyGenerator;
 
+    /** Cache the simulation is recorded into, may be null. */
+    ScenarioCache *myScenarioCache;
+
+    /** Poisson-disk samplers of the current Actor(Group), by region. */
+    std::map<std::string, PoissonDiskSampler> mySamplers;
+
     /** Directory in which the schema is located. */
     const std::string mySimulationSchemaDirectory;
 
@@ -0,0 +1,130 @@
+#pragma once
+
+/**
+ * @file SweptCircles.h
+ * @brief Finds where a moving circle first touches any of a set of circles.
+ *
+ * @author Michael Albers
+ */
+
+#include <cstddef>
+#include <vector>
+#include "Eigen/Core"
+
+namespace QS
+{
+  /**
+   * Set of stationary circles (the neighbors of an Actor) a moving circle is
+   * clipped against, so that it stops where it would first touch any of
+   * them. Collision detection/resolution taken from:
+   * http://www.gamasutra.com/view/feature/131424/pool_hall_lessons_fast_accurate_.php?page=2
+   *
+   * The circles are kept as one array per value (structure of arrays) so
+   * clip can work out the distance to several circles at once (see
+   * SimdLanes), then take the smallest. clipSequential is the original one
+   * circle at a time version, kept as a reference. The two give the
+   * same result up to rounding for circles which don't overlap the moving
+   * circle to start with.
+   */
+  class SweptCircles
+  {
+    public:
+
+    /**
+     * Default constructor.
+     */
+    SweptCircles() = default;
+
+    /**
+     * Copy constructor.
+     */
+    SweptCircles(const SweptCircles&) = default;
+
+    /**
+     * Move constructor.
+     */
+    SweptCircles(SweptCircles&&) = default;
+
+    /**
+     * Destructor.
+     */
+    ~SweptCircles() = default;
+
+    /**
+     * Adds a circle.
+     *
+     * @param thePosition
+     *          circle center
+     * @param theRadius
+     *          circle radius
+     */
+    void add(Eigen::Vector2f thePosition, float theRadius);
+
+    /**
+     * Removes all circles. Memory is kept for re-use.
+     */
+    void clear() noexcept;
+
+    /**
+     * Clips the motion vector of a moving circle so that it stops where it
+     * would first touch any of the circles. The direction isn't changed,
+     * just the magnitude.
+     *
+     * @param thePosition
+     *          position of the moving circle
+     * @param theRadius
+     *          radius of the moving circle
+     * @param theMotionVector
+     *          motion vector of the moving circle
+     * @return motion vector, shortened if the circle would collide
+     */
+    Eigen::Vector2f clip(Eigen::Vector2f thePosition, float theRadius,
+                         Eigen::Vector2f theMotionVector) const noexcept;
+
+    /**
+     * Same as clip, clipping against each circle in turn.
+     *
+     * @param thePosition
+     *          position of the moving circle
+     * @param theRadius
+     *          radius of the moving circle
+     * @param theMotionVector
+     *          motion vector of the moving circle
+     * @return motion vector, shortened if the circle would collide
+     */
+    Eigen::Vector2f clipSequential(Eigen::Vector2f thePosition,
+                                   float theRadius,
+                                   Eigen::Vector2f theMotionVector) const
+      noexcept;
+
+    /**
+     * Returns the number of circles.
+     *
+     * @return number of circles
+     */
+    std::size_t size() const noexcept;
+
+    /**
+     * Copy assignment operator.
+     */
+    SweptCircles& operator=(const SweptCircles&) = default;
+
+    /**
+     * Move assignment operator.
+     */
+    SweptCircles& operator=(SweptCircles&&) = default;
+
+    protected:
+
+    private:
+
+    /** x coordinate of each circle. */
+    std::vector<float> myPositionsX;
+
+    /** y coordinate of each circle. */
+    std::vector<float> myPositionsY;
+
+    /** Radius of each circle. */
+    std::vector<float> myRadii;
+  };
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+/**
+ * @file TimeSeriesSample.h
+ * @brief Contains a single sample of the simulation time series metrics.
+ *
+ * @author Michael Albers
+ */
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace QS
+{
+  /**
+   * A single point of the time series metrics. Samples are taken every so
+   * many simulated seconds (see Metrics::setTimeSeriesSink) and handed to a
+   * MetricsSink.
+   */
+  class TimeSeriesSample
+  {
+    public:
+
+    /** Number of local density percentiles in each sample. */
+    static constexpr std::size_t NUMBER_DENSITY_PERCENTILES = 3;
+
+    /** Percentiles (0-100) reported in myDensityPercentiles, in order. */
+    static constexpr std::array<float, NUMBER_DENSITY_PERCENTILES>
+      DENSITY_PERCENTILES{{50.0, 90.0, 99.0}};
+
+    /** Simulated time of the sample, in seconds. */
+    float myTime_s = 0.0;
+
+    /** Number of Actors still in the world. */
+    std::uint32_t myNumberActorsRemaining = 0;
+
+    /** Mean speed of the Actors still in the world, in m/s. */
+    float myMeanSpeed = 0.0;
+
+    /**
+     * Local density percentiles (see DENSITY_PERCENTILES) of the Actors still
+     * in the world, in Actors per square meter.
+     */
+    std::array<float, NUMBER_DENSITY_PERCENTILES> myDensityPercentiles{};
+
+    /** Mean wall time of the updates since the previous sample, in seconds. */
+    float myMeanFrameWallTime_s = 0.0;
+
+    /** Max wall time of the updates since the previous sample, in seconds. */
+    float myMaxFrameWallTime_s = 0.0;
+
+    /** Total number of Actors which have left through each Exit. */
+    std::vector<std::uint32_t> myExitCounts;
+
+    /**
+     * Actors per second leaving through each Exit since the previous sample.
+     */
+    std::vector<float> myExitThroughputs;
+  };
+}
@@ -8,11 +8,16 @@
  */
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
-#include <random>
+#include <memory>
+#include <string>
 #include <tuple>
 #include <vector>
 #include "Eigen/Core"
+#include "CounterRNG.h"
+#include "PlacementIndex.h"
+#include "TimeSeriesSample.h"
 
 namespace QS
 {
@@ -20,7 +25,9 @@ namespace QS
   class ActorUpdateCallback;
   class Exit;
   class Metrics;
+  class MetricsSink;
   class SpatialHash;
+  class SweptCircles;
 
   /**
    * The world in the base of a simulation. It contains all of the pieces of
@@ -99,6 +106,28 @@ namespace QS
                       Eigen::Vector2f thePosition2, float theRadius2)
       const noexcept;
 
+    /**
+     * Detects if the Actor has collided with anything in the world. And, if so
+     * modifies the motion vector so that the Actor will be placed at the
+     * closest non-collision position. This function will not change the
+     * direction of the Actor, just the magnitude, possibly reducing it to zero
+     * (i.e., not moving). Public so it can be benchmarked on its own.
+     *
+     * @param theActor
+     *          Actor to check for collisions
+     * @param theMotionVector
+     *          motion vector of the Actor (velocity * time)
+     * @param theHash
+     *          spatial hash to narrow down necessary collision checks
+     * @param theNeighbors
+     *          scratch space for the possible collisions
+     * @return possibly modified motion vector based on any collisions
+     */
+    Eigen::Vector2f collisionDetection(const Actor *theActor,
+                                       Eigen::Vector2f theMotionVector,
+                                       SpatialHash &theHash,
+                                       SweptCircles &theNeighbors) const;
+
    /**
      * Converts the given point in Actor local space to world space coordinates.
      *
@@ -111,6 +140,45 @@ namespace QS
                                                const Eigen::Vector2f &thePoint)
       noexcept;
 
+    /**
+     * Disables batch evaluation, every Actor is evaluated individually.
+     */
+    static void disableBatchEvaluation() noexcept;
+
+    /**
+     * Disables parallel collision resolution, Actors are moved one after
+     * another.
+     */
+    static void disableParallelCollisions() noexcept;
+
+    /**
+     * Enables batch evaluation. At the start of each update, Actors which
+     * allow it (see Actor::canEvaluateInBatch) are grouped by the BehaviorSet
+     * they select and each group is given to BehaviorSet::evaluateBatch.
+     * Only BehaviorSets whose plugin declares batch evaluation (see
+     * EntityCapabilities) are used this way. Other Actors, or those whose
+     * BehaviorSet turns the batch down, are evaluated individually, as
+     * usual.
+     *
+     * Batched Actors are evaluated against the state of the world at the
+     * start of the update rather than after the Actors before them have
+     * moved, so results differ from those with batch evaluation disabled.
+     * Groups are per BehaviorSet object, so are largest with shared
+     * BehaviorSets (see EntityManager::enableSharedBehaviorSets).
+     */
+    static void enableBatchEvaluation() noexcept;
+
+    /**
+     * Enables parallel collision resolution. Each update, every Actor is
+     * evaluated against the state of the world at the start of the update,
+     * then all of them are moved and their collisions resolved at once, in
+     * parallel (see resolveCollisions). Actors still never overlap and the
+     * results are the same with any number of threads, but differ from those
+     * with parallel collision resolution disabled, where each Actor sees the
+     * Actors before it already moved.
+     */
+    static void enableParallelCollisions() noexcept;
+
     /**
      * Finalizes all metrics.
      */
@@ -153,10 +221,15 @@ namespace QS
      * an existing Actor. To that end, the caller can bound the number of
      * attempts.
      *
+     * Random numbers come from the CounterRNG::PLACEMENT stream of the given
+     * entity, so the position doesn't depend on other random numbers drawn.
+     *
      * @param theRadius
      *          actor radius
      * @param theMaxAttempts
      *          maximum number of tries to find a valid position
+     * @param theEntity
+     *          number of the entity being placed (see getRNG)
      * @return position
      * @throws std::invalid_argument
      *           if theRadius is larger than the world's width or length
@@ -164,19 +237,27 @@ namespace QS
      *           if the number of attempts would exceed the maximum
      */
     Eigen::Vector2f getRandomActorPosition(float theRadius,
-                                           uint32_t theMaxAttempts);
+                                           uint32_t theMaxAttempts,
+                                           uint32_t theEntity);
+
+    /**
+     * Returns the full state of the random number generator, for restoring
+     * with setRandomState.
+     *
+     * @return random number generator state
+     */
+    std::string getRandomState() const;
 
     /**
-     * Returns a random number using the given distribution. Be sure to have
-     * called setSeed before using this function. If it hasn't been called
-     * the RNG will use the RNG implementation default seed.
+     * Returns the random number generator. All random numbers are drawn from
+     * it with a RandomStream keyed by an entity number: the order of the
+     * entity in the simulation file while loading, the Actor's number (see
+     * Actor::getRandomStream) while updating. Its frame is 0 while loading
+     * and the number of the update during one.
      *
-     * @param theDistribution
-     *          distribution to use
-     * @return random number
+     * @return random number generator
      */
-    float getRandomNumber(
-      std::uniform_real_distribution<float> &theDistribution) noexcept;
+    const CounterRNG& getRNG() const noexcept;
 
     /**
      * Initializes the Actor metrics in the Metrics object. This function should
@@ -184,6 +265,19 @@ namespace QS
      */
     void initializeActorMetrics() noexcept;
 
+    /**
+     * Checks if an Actor with the given position and radius would overlap
+     * any Actor already added to the world (at its initial position).
+     *
+     * @param thePosition
+     *          Actor position
+     * @param theRadius
+     *          Actor radius
+     * @return true if there would be an overlap
+     */
+    bool overlapsActor(Eigen::Vector2f thePosition, float theRadius) const
+      noexcept;
+
     /**
      * Sets the dimensions of the world.
      *
@@ -194,6 +288,34 @@ namespace QS
      */
     void setDimensions(float theWidth_m, float theLength_m);
 
+    /**
+     * Restores the random number generator to a state from getRandomState.
+     *
+     * @param theState
+     *          random number generator state
+     * @throws std::invalid_argument
+     *          if the state is invalid
+     */
+    void setRandomState(const std::string &theState);
+
+    /**
+     * Enables time series metrics, see Metrics::setTimeSeriesSink.
+     *
+     * @param theSink
+     *          destination of time series samples
+     * @param theSampleInterval_s
+     *          simulated time between samples, in seconds
+     * @param theDensityRadius_m
+     *          radius around each Actor used to measure local density, in
+     *          meters
+     * @throws std::invalid_argument
+     *           if theSink is null, or theSampleInterval_s or
+     *           theDensityRadius_m is &le; 0
+     */
+    void setTimeSeriesSink(std::shared_ptr<MetricsSink> theSink,
+                           float theSampleInterval_s,
+                           float theDensityRadius_m);
+
     /**
      * Seeds the random number generator with the given value.
      *
@@ -229,6 +351,24 @@ namespace QS
 
     private:
 
+    /**
+     * Result of integrating the steering force of an Actor over an update.
+     */
+    struct Motion
+    {
+      /**
+       * Vector, in meters, to where the Actor will move, possibly clipped to
+       * avoid collisions.
+       */
+      Eigen::Vector2f myMotionVector;
+
+      /** New orientation, in radians. */
+      float myOrientation;
+
+      /** New velocity, in meters/second. */
+      Eigen::Vector2f myVelocity;
+    };
+
     /**
      * Checks if the initial placement of the provided Actor is valid: in world
      * bounds, Actor hasn't already been added and  not overlapping any other
@@ -242,23 +382,60 @@ namespace QS
     void checkInitialPlacement(const Actor *theActor) const;
 
     /**
-     * Detects if the Actor has collided with anything in the world. And, if so
-     * modifies the motion vector so that the Actor will be placed at the
-     * closest non-collision position. This function will not change the
-     * direction of the Actor, just the magnitude, possibly reducing it to zero
-     * (i.e., not moving).
+     * Shortens the motion vector of the Actor along each axis as needed to
+     * keep it within the world.
      *
      * @param theActor
-     *          Actor to check for collisions
+     *          Actor being moved
      * @param theMotionVector
      *          motion vector of the Actor (velocity * time)
+     * @return possibly modified motion vector
+     */
+    Eigen::Vector2f clipToWorld(const Actor *theActor,
+                                Eigen::Vector2f theMotionVector) const
+      noexcept;
+
+    /**
+     * Creates a time series sample from the current state of the world. Only
+     * the world-derived values are filled in; Metrics completes the rest.
+     *
      * @param theHash
-     *          spatial hash to narrow down necessary collision checks
-     * @return possibly modified motion vector based on any collisions
+     *          spatial hash of the Actors in the world
+     * @return time series sample
      */
-    Eigen::Vector2f collisionDetection(Actor *theActor,
-                                       Eigen::Vector2f theMotionVector,
-                                       SpatialHash &theHash) const;
+    TimeSeriesSample createTimeSeriesSample(SpatialHash &theHash) const;
+
+    /**
+     * Evaluates all Actors which can be in batches (see
+     * enableBatchEvaluation).
+     *
+     * @param theIntervalInSeconds
+     *          time since last update
+     * @param theForces
+     *          OUT parameter, steering force of each Actor in the world (by
+     *          index in myActorsInWorld)
+     * @param theEvaluated
+     *          OUT parameter, whether each Actor was evaluated
+     */
+    void evaluateBatches(float theIntervalInSeconds,
+                         std::vector<Eigen::Vector2f> &theForces,
+                         std::vector<bool> &theEvaluated);
+
+    /**
+     * Applies the steering force to the Actor's velocity, limited by its
+     * maximum force and speed, and works out the resulting orientation and
+     * (unclipped) motion vector. The Actor isn't changed.
+     *
+     * @param theActor
+     *          Actor to move
+     * @param theSteeringForce
+     *          steering force from the Actor's evaluation
+     * @param theIntervalInSeconds
+     *          time since last update
+     * @return new motion of the Actor
+     */
+    Motion integrate(const Actor *theActor, Eigen::Vector2f theSteeringForce,
+                     float theIntervalInSeconds) const noexcept;
 
     /**
      * Checks if the given entity is wholly within the world.
@@ -271,15 +448,49 @@ namespace QS
     template<class T>
     bool isInWorld(const T &theEntity) const noexcept;
 
+    /**
+     * Integrates every Actor in the world and resolves collisions between
+     * them, in parallel (see enableParallelCollisions). Each Actor is first
+     * clipped against the world and the other Actors where they started,
+     * which leaves only Actors which both moved ending up overlapping. These
+     * are resolved in a few Jacobi-style rounds, in each of which the later
+     * Actor (in myActorsInWorld) of every such pair is clipped against where
+     * the earlier one ended up in the previous round. Any Actor still
+     * overlapping after the last round doesn't move.
+     *
+     * Each Actor's result depends only on the state at the start of a round,
+     * and other Actors are always considered in index order, so it is the
+     * same whatever the number of threads.
+     *
+     * @param theForces
+     *          steering force of each Actor in the world (by index in
+     *          myActorsInWorld)
+     * @param theIntervalInSeconds
+     *          time since last update
+     * @return motion of each Actor in the world
+     */
+    std::vector<Motion> resolveCollisions(
+      const std::vector<Eigen::Vector2f> &theForces,
+      float theIntervalInSeconds) const;
+
     /** All of the Actors for the simulation. */
     std::vector<Actor*> myActors;
 
     /** Actors which are still in the world. */
     std::vector<const Actor*> myActorsInWorld;
 
+    /**
+     * Index (into myActors, which is also the Metrics Actor index) of each
+     * Actor in myActorsInWorld. Kept parallel to myActorsInWorld.
+     */
+    std::vector<std::size_t> myActorsInWorldIndexes;
+
     /** Average Actor diameter for spatial hashing. */
     float myActorAverageDiameter = 0.0;
 
+    /** Number of Actors which have left through each Exit. */
+    std::vector<std::uint32_t> myExitCounts;
+
     /** All of the Exits in the simulation. */
     std::vector<Exit*> myExits;
 
@@ -295,16 +506,22 @@ namespace QS
     /** Metrics for the simulation. */
     Metrics &myMetrics;
 
+    /**
+     * Initial position of every Actor in myActors (same order), for checking
+     * new Actors and finding random positions.
+     */
+    PlacementIndex myPlacementIndex;
+
     /** World width (x dimension), in meters.*/
     float myWidth_m = 0.0;
 
+    /** Radius used to measure local Actor density for time series. */
+    float myTimeSeriesDensityRadius_m = 1.0;
+
     /** Number Actors attempted to be added. */
     uint32_t myNumberAttemptedActorAdds = 0;
 
     /** Generator of pseudo-random numbers. */
-    std::mt19937 myRNGEngine;
-
-    /** Distribution of pseudo-random numbers. */
-    std::uniform_real_distribution<> myRNGDistribution{0, 1};
+    CounterRNG myRNG;
   };
 }
@@ -0,0 +1,131 @@
+#pragma once
+
+/**
+ * @file XMLParser.h
+ * @brief Parses configuration files against their (cached) schemas.
+ *
+ * @author Michael Albers
+ */
+
+#include <string>
+#include "xercesc/sax2/DefaultHandler.hpp"
+
+XERCES_CPP_NAMESPACE_USE
+
+namespace QS
+{
+  /**
+   * Parses simulation and plugin configuration files, validating them against
+   * a schema.
+   *
+   * Each schema is loaded (and fully checked) once into a grammar pool which
+   * is then shared by every parser using that schema, rather than being
+   * re-read for every file.
+   *
+   * When trusted input is enabled, a file which has passed validation once is
+   * afterwards parsed without validation. Files are identified by a hash of
+   * the file and schema contents (see ScenarioCache::getKey), so any change
+   * to either means the file is validated again. The hashes can be kept in a
+   * file to carry them between runs.
+   *
+   * Since the grammars are Xerces objects, releaseGrammars must be called
+   * before XMLPlatformUtils::Terminate.
+   */
+  class XMLParser
+  {
+    public:
+
+    /**
+     * Default constructor.
+     */
+    XMLParser() = delete;
+
+    /**
+     * Copy constructor.
+     */
+    XMLParser(const XMLParser&) = delete;
+
+    /**
+     * Move constructor.
+     */
+    XMLParser(XMLParser&&) = delete;
+
+    /**
+     * Destructor.
+     */
+    ~XMLParser() = delete;
+
+    /**
+     * Disables trusted input, every file is validated.
+     */
+    static void disableTrustedInput() noexcept;
+
+    /**
+     * Enables trusted input.
+     *
+     * @param theHashFile
+     *          file the hashes of validated files are read from (if it
+     *          exists) and added to, empty to keep them only in memory
+     * @throws std::runtime_error
+     *          if the hash file can't be read
+     */
+    static void enableTrustedInput(const std::string &theHashFile);
+
+    /**
+     * Parses a file. Errors are passed to the handler (as its error handler)
+     * the same as a parser created directly.
+     *
+     * @param theSchemaFile
+     *          schema to validate the file against
+     * @param theXMLFile
+     *          file to parse
+     * @param theHandler
+     *          content and error handler
+     * @throws XMLException
+     *          on Xerces error
+     * @throws std::runtime_error
+     *          if trusted input is enabled and the file can't be read, or its
+     *          hash can't be written
+     */
+    static void parse(const std::string &theSchemaFile,
+                      const std::string &theXMLFile,
+                      DefaultHandler &theHandler);
+
+    /**
+     * Parses XML held in memory without validation, for documents compiled
+     * into the executable (which can't change after the build). Errors are
+     * passed to the handler the same as parse.
+     *
+     * @param theName
+     *          name of the document, for error messages
+     * @param theXML
+     *          document to parse
+     * @param theHandler
+     *          content and error handler
+     * @throws XMLException
+     *          on Xerces error
+     */
+    static void parseMemory(const std::string &theName,
+                            const std::string &theXML,
+                            DefaultHandler &theHandler);
+
+    /**
+     * Releases the cached grammars. They are reloaded if needed.
+     */
+    static void releaseGrammars() noexcept;
+
+    /**
+     * Copy assignment operator.
+     */
+    XMLParser& operator=(const XMLParser&) = delete;
+
+    /**
+     * Move assignment operator.
+     */
+    XMLParser& operator=(XMLParser&&) = delete;
+
+    protected:
+
+    private:
+  };
+}
@@ -38,6 +38,11 @@ float QS::ActorMetrics::getGrossDistanceMeters() const noexcept
   return myGrossDistanceMeters;
 }
 
+float QS::ActorMetrics::getNetDistanceMeters() const noexcept
+{
+  return myNetDistanceMeters;
+}
+
 namespace QS
 {
   std::ostream& operator<<(std::ostream &os,
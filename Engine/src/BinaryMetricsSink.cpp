@@ -0,0 +1,92 @@
+/**
+ * @file BinaryMetricsSink.cpp
+ * @brief Definition of BinaryMetricsSink
+ *
+ * @author Michael Albers
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include "BinaryMetricsSink.h"
+#include "TimeSeriesSample.h"
+
+static_assert(sizeof(float) == sizeof(std::uint32_t),
+              "Binary time series format requires 4 byte floats.");
+
+constexpr std::uint32_t QS::BinaryMetricsSink::VERSION;
+
+QS::BinaryMetricsSink::BinaryMetricsSink(const std::string &theFileName) :
+  myFileName(theFileName),
+  myOutputFile(theFileName, std::ios_base::out | std::ios_base::trunc |
+               std::ios_base::binary)
+{
+  if (! myOutputFile.is_open())
+  {
+    auto thisErrno = errno;
+    std::string error{"Failed to open time series output file \""};
+    error += theFileName + "\": " + std::strerror(thisErrno);
+    throw std::runtime_error(error);
+  }
+}
+
+template<class T>
+void QS::BinaryMetricsSink::append(T theValue)
+{
+  const char *bytes = reinterpret_cast<const char*>(&theValue);
+  myRecord.insert(myRecord.end(), bytes, bytes + sizeof(T));
+}
+
+void QS::BinaryMetricsSink::flush()
+{
+  myOutputFile.flush();
+  if (! myOutputFile)
+  {
+    throw std::runtime_error("Error writing time series output file \"" +
+                             myFileName + "\".");
+  }
+}
+
+void QS::BinaryMetricsSink::write(const TimeSeriesSample &theSample)
+{
+  myRecord.clear();
+
+  if (! myHeaderWritten)
+  {
+    myNumberExits = theSample.myExitCounts.size();
+    myRecord.insert(myRecord.end(), MAGIC, MAGIC + std::strlen(MAGIC));
+    append<std::uint32_t>(VERSION);
+    append<std::uint32_t>(myNumberExits);
+    append<std::uint32_t>(TimeSeriesSample::NUMBER_DENSITY_PERCENTILES);
+    myHeaderWritten = true;
+  }
+
+  if (theSample.myExitCounts.size() != myNumberExits ||
+      theSample.myExitThroughputs.size() != myNumberExits)
+  {
+    throw std::runtime_error("Time series sample has a different number of "
+                             "Exits than the first sample.");
+  }
+
+  append<float>(theSample.myTime_s);
+  append<std::uint32_t>(theSample.myNumberActorsRemaining);
+  append<float>(theSample.myMeanSpeed);
+  for (auto density : theSample.myDensityPercentiles)
+  {
+    append<float>(density);
+  }
+  append<float>(theSample.myMeanFrameWallTime_s);
+  append<float>(theSample.myMaxFrameWallTime_s);
+  for (auto exit = 0u; exit < myNumberExits; ++exit)
+  {
+    append<std::uint32_t>(theSample.myExitCounts[exit]);
+    append<float>(theSample.myExitThroughputs[exit]);
+  }
+
+  myOutputFile.write(myRecord.data(), myRecord.size());
+  if (! myOutputFile)
+  {
+    throw std::runtime_error("Error writing time series output file \"" +
+                             myFileName + "\".");
+  }
+}
@@ -0,0 +1,88 @@
+/**
+ * @file CSVMetricsSink.cpp
+ * @brief Definition of CSVMetricsSink
+ *
+ * @author Michael Albers
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include "CSVMetricsSink.h"
+#include "TimeSeriesSample.h"
+
+QS::CSVMetricsSink::CSVMetricsSink(const std::string &theFileName) :
+  myFileName(theFileName),
+  myOutputFile(theFileName, std::ios_base::out | std::ios_base::trunc)
+{
+  if (! myOutputFile.is_open())
+  {
+    auto thisErrno = errno;
+    std::string error{"Failed to open time series output file \""};
+    error += theFileName + "\": " + std::strerror(thisErrno);
+    throw std::runtime_error(error);
+  }
+  myOutputFile.precision(std::numeric_limits<float>::max_digits10);
+}
+
+void QS::CSVMetricsSink::checkStream() const
+{
+  if (! myOutputFile)
+  {
+    throw std::runtime_error("Error writing time series output file \"" +
+                             myFileName + "\".");
+  }
+}
+
+void QS::CSVMetricsSink::flush()
+{
+  myOutputFile.flush();
+  checkStream();
+}
+
+void QS::CSVMetricsSink::write(const TimeSeriesSample &theSample)
+{
+  if (! myHeaderWritten)
+  {
+    myNumberExits = theSample.myExitCounts.size();
+
+    myOutputFile << "time_s,actors_remaining,mean_speed";
+    for (auto percentile : TimeSeriesSample::DENSITY_PERCENTILES)
+    {
+      myOutputFile << ",density_p" << static_cast<int>(percentile);
+    }
+    myOutputFile << ",frame_wall_mean_s,frame_wall_max_s";
+    for (auto exit = 0u; exit < myNumberExits; ++exit)
+    {
+      myOutputFile << ",exit" << exit << "_count"
+                   << ",exit" << exit << "_throughput";
+    }
+    myOutputFile << "\n";
+    myHeaderWritten = true;
+  }
+
+  if (theSample.myExitCounts.size() != myNumberExits ||
+      theSample.myExitThroughputs.size() != myNumberExits)
+  {
+    throw std::runtime_error("Time series sample has a different number of "
+                             "Exits than the first sample.");
+  }
+
+  myOutputFile << theSample.myTime_s << ","
+               << theSample.myNumberActorsRemaining << ","
+               << theSample.myMeanSpeed;
+  for (auto density : theSample.myDensityPercentiles)
+  {
+    myOutputFile << "," << density;
+  }
+  myOutputFile << "," << theSample.myMeanFrameWallTime_s
+               << "," << theSample.myMaxFrameWallTime_s;
+  for (auto exit = 0u; exit < myNumberExits; ++exit)
+  {
+    myOutputFile << "," << theSample.myExitCounts[exit]
+                 << "," << theSample.myExitThroughputs[exit];
+  }
+  myOutputFile << "\n";
+  checkStream();
+}
@@ -0,0 +1,50 @@
+/**
+ * @file EngineOptions.cpp
+ * @brief Definition of EngineOptions
+ *
+ * @author Michael Albers
+ */
+
+#include <cstdlib>
+#include "EngineOptions.h"
+#include "EntityManager.h"
+#include "ScenarioCache.h"
+#include "World.h"
+#include "XMLParser.h"
+
+void QS::EngineOptions::enableFromEnvironment()
+{
+  // Compiled simulations are cached (and reused) only when asked for.
+  auto scenarioCacheEnvVar = std::getenv("QS_SCENARIO_CACHE");
+  if (NULL != scenarioCacheEnvVar)
+  {
+    ScenarioCache::enable(scenarioCacheEnvVar);
+  }
+
+  // Files which have passed validation once are trusted afterwards only
+  // when asked for. The variable names the file to keep the hashes in.
+  auto trustedInputEnvVar = std::getenv("QS_TRUSTED_INPUT");
+  if (NULL != trustedInputEnvVar)
+  {
+    XMLParser::enableTrustedInput(trustedInputEnvVar);
+  }
+
+  // Actors with identical BehaviorSets share one (opt-in).
+  if (NULL != std::getenv("QS_SHARED_BEHAVIORS"))
+  {
+    EntityManager::enableSharedBehaviorSets();
+  }
+
+  // Evaluate Actors in batches where plugins support it (opt-in, changes
+  // results).
+  if (NULL != std::getenv("QS_BATCH_EVALUATION"))
+  {
+    World::enableBatchEvaluation();
+  }
+
+  // Resolve collisions in parallel (opt-in, changes results).
+  if (NULL != std::getenv("QS_PARALLEL_COLLISIONS"))
+  {
+    World::enableParallelCollisions();
+  }
+}
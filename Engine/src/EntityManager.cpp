@@ -5,16 +5,23 @@
  * @author Michael Albers
  */
 
-#include <algorithm>
 #include "Actor.h"
 #include "Behavior.h"
 #include "BehaviorSet.h"
 #include "EntityDependency.h"
 #include "EntityManager.h"
+#include "Exit.h"
 #include "Plugin.h"
 #include "PluginCollection.h"
+#include "Sensor.h"
 #include "SimulationEntityConfiguration.h"
 
+namespace
+{
+  /** Whether Actors with the same BehaviorSet configuration share it. */
+  bool glbSharedBehaviorSets = false;
+}
+
 QS::EntityManager::EntityManager(std::shared_ptr<PluginCollection> thePlugins) :
   myPlugins(thePlugins)
 {
@@ -54,7 +61,7 @@ QS::EntityManager::~EntityManager()
 QS::Actor* QS::EntityManager::createActor(
   const SimulationEntityConfiguration &theActorConfiguration)
 {
-  auto actorType = theActorConfiguration.getType();
+  const auto &actorType = theActorConfiguration.getType();
 
   auto actorPlugin = myPlugins->getPlugin(theActorConfiguration.getSource());
   auto actor = actorPlugin->createActor(
@@ -62,62 +69,39 @@ QS::Actor* QS::EntityManager::createActor(
     theActorConfiguration.getProperties(),
     theActorConfiguration.getTag());
   myActors.push_back({actor, actorPlugin});
+  actor->setCapabilities(actorPlugin->getCapabilities(
+    EntityCapabilities::Kind::Actor, actorType));
 
-  auto actorPluginDefinition = actorPlugin->getDefinition();
-
-  auto actorDefinitions = actorPluginDefinition->getActorDefinitions();
-  auto actorDefinition = std::find_if(actorDefinitions.begin(),
-                                      actorDefinitions.end(),
-                                      [=](ActorDefinition &theDef) {
-                                        return (theDef.getName() == actorType);
-                                      });
-
-  std::vector<SimulationEntityConfiguration> actorDependencyConfigurations =
+  const auto &actorDependencyConfigurations =
     theActorConfiguration.getDependencyConfigurations();
 
   std::vector<EntityDependency<BehaviorSet>> actorDependencies;
-  auto neededBehaviorSets = actorDefinition->getBehaviorSets();
-  for (PluginDependencySet neededBehaviorSet : neededBehaviorSets)
+  const auto &neededBehaviorSets =
+    actorPlugin->getActorDependencies(actorType);
+  actorDependencies.reserve(neededBehaviorSets.size());
+  for (const auto &neededBehaviorSet : neededBehaviorSets)
   {
-    auto dependencyConfigurationIter =
-      std::find_if(actorDependencyConfigurations.begin(),
-                   actorDependencyConfigurations.end(),
-                   [=](SimulationEntityConfiguration &theConfig){
-                     return (theConfig.getType() == neededBehaviorSet.myName &&
-                             theConfig.getTag() == neededBehaviorSet.myTag);
-                   });
-
-    // Didn't find a match with the tag, try for one without a tag.
-    if (dependencyConfigurationIter == actorDependencyConfigurations.end())
+    auto dependencyConfiguration = findDependencyConfiguration(
+      actorDependencyConfigurations, neededBehaviorSet);
+
+    BehaviorSet *behaviorSet = nullptr;
+    if (dependencyConfiguration != nullptr)
     {
-      dependencyConfigurationIter =
-        std::find_if(actorDependencyConfigurations.begin(),
-                     actorDependencyConfigurations.end(),
-                     [=](SimulationEntityConfiguration &theConfig){
-                       return (theConfig.getType() == neededBehaviorSet.myName);
-                     });
+      behaviorSet = getBehaviorSet(*dependencyConfiguration);
     }
-
-    // Start with a basic configuration that works if no configuration was
-    // found. If no configuration found for this BehaviorSet (this also means
-    // that there is no configuration for the BehaviorSet's dependencies) this
-    // will contain enough information to create the BehaviorSet.
-    SimulationEntityConfiguration dependencyConfiguration(
-      neededBehaviorSet.myName,
-      neededBehaviorSet.myTag,
-      neededBehaviorSet.mySource);
-
-    if (dependencyConfigurationIter != actorDependencyConfigurations.end())
+    else
     {
-      dependencyConfiguration = *dependencyConfigurationIter;
+      // No configuration for this BehaviorSet (this also means that there is
+      // no configuration for the BehaviorSet's dependencies), a basic one
+      // contains enough information to create the BehaviorSet.
+      behaviorSet = getBehaviorSet(SimulationEntityConfiguration(
+        neededBehaviorSet.myName,
+        neededBehaviorSet.myTag,
+        neededBehaviorSet.mySource));
     }
 
-    EntityDependency<BehaviorSet> behaviorSetDependency {
-      neededBehaviorSet.myName,
-      createBehaviorSet(dependencyConfiguration),
-      neededBehaviorSet.myTag};
-
-    actorDependencies.push_back(behaviorSetDependency);
+    actorDependencies.push_back({neededBehaviorSet.myName, behaviorSet,
+                                 neededBehaviorSet.myTag});
   }
   actor->setDependencies(actorDependencies);
   return actor;
@@ -129,69 +113,42 @@ QS::Behavior* QS::EntityManager::createBehavior(
   auto behaviorPlugin = myPlugins->getPlugin(
     theBehaviorConfiguration.getSource());
 
-  auto type = theBehaviorConfiguration.getType();
+  const auto &type = theBehaviorConfiguration.getType();
 
   auto behavior = behaviorPlugin->createBehavior(
     type,
     theBehaviorConfiguration.getProperties(),
     theBehaviorConfiguration.getTag());
   myBehaviors.push_back({behavior, behaviorPlugin});
+  behavior->setCapabilities(behaviorPlugin->getCapabilities(
+    EntityCapabilities::Kind::Behavior, type));
 
-  auto behaviorPluginDefinition = behaviorPlugin->getDefinition();
-
-  auto behaviorDefinitions =
-    behaviorPluginDefinition->getBehaviorDefinitions();
-  auto behaviorDefinition = std::find_if(behaviorDefinitions.begin(),
-                                         behaviorDefinitions.end(),
-                                         [=](BehaviorDefinition &theDef) {
-                                           return (theDef.getName() == type);
-                                         });
-
-  std::vector<SimulationEntityConfiguration> sensorDependencyConfigurations =
+  const auto &sensorDependencyConfigurations =
     theBehaviorConfiguration.getDependencyConfigurations();
 
   std::vector<EntityDependency<Sensor>> behaviorDependencies;
-  auto neededSensors = behaviorDefinition->getSensors();
-  for (PluginDependencySet neededSensor : neededSensors)
+  const auto &neededSensors = behaviorPlugin->getBehaviorDependencies(type);
+  behaviorDependencies.reserve(neededSensors.size());
+  for (const auto &neededSensor : neededSensors)
   {
-    auto dependencyConfigurationIter =
-      std::find_if(sensorDependencyConfigurations.begin(),
-                   sensorDependencyConfigurations.end(),
-                   [=](SimulationEntityConfiguration &theConfig){
-                     return (theConfig.getType() == neededSensor.myName &&
-                             theConfig.getTag() == neededSensor.myTag);
-                   });
-
-    // Didn't find a match with the tag, try for one without a tag.
-    if (dependencyConfigurationIter ==
-        sensorDependencyConfigurations.end())
+    auto dependencyConfiguration = findDependencyConfiguration(
+      sensorDependencyConfigurations, neededSensor);
+
+    Sensor *sensor = nullptr;
+    if (dependencyConfiguration != nullptr)
     {
-      dependencyConfigurationIter =
-        std::find_if(sensorDependencyConfigurations.begin(),
-                     sensorDependencyConfigurations.end(),
-                     [=](SimulationEntityConfiguration &theConfig){
-                       return (theConfig.getType() == neededSensor.myName);
-                     });
+      sensor = createSensor(*dependencyConfiguration);
     }
-
-    // Start with a basic configuration that works if no configuration was
-    // found. If no configuration found for this Sensor this will contain
-    // enough information to create the Sensor.
-    SimulationEntityConfiguration dependencyConfiguration(
-      neededSensor.myName, neededSensor.myTag, neededSensor.mySource);
-
-    if (dependencyConfigurationIter !=
-        sensorDependencyConfigurations.end())
+    else
     {
-      dependencyConfiguration = *dependencyConfigurationIter;
+      // No configuration for this Sensor, a basic one contains enough
+      // information to create the Sensor.
+      sensor = createSensor(SimulationEntityConfiguration(
+        neededSensor.myName, neededSensor.myTag, neededSensor.mySource));
     }
 
-    EntityDependency<Sensor> sensorDependency {
-      neededSensor.myName,
-      createSensor(dependencyConfiguration),
-      neededSensor.myTag};
-
-    behaviorDependencies.push_back(sensorDependency);
+    behaviorDependencies.push_back({neededSensor.myName, sensor,
+                                    neededSensor.myTag});
   }
   behavior->setDependencies(behaviorDependencies);
 
@@ -205,72 +162,43 @@ QS::BehaviorSet* QS::EntityManager::createBehaviorSet(
   auto behaviorSetPlugin = myPlugins->getPlugin(
     theBehaviorSetConfiguration.getSource());
 
-  auto type = theBehaviorSetConfiguration.getType();
+  const auto &type = theBehaviorSetConfiguration.getType();
 
   auto behaviorSet = behaviorSetPlugin->createBehaviorSet(
     type, theBehaviorSetConfiguration.getProperties(),
     theBehaviorSetConfiguration.getTag());
   myBehaviorSets.push_back({behaviorSet, behaviorSetPlugin});
+  behaviorSet->setCapabilities(behaviorSetPlugin->getCapabilities(
+    EntityCapabilities::Kind::BehaviorSet, type));
 
-  auto behaviorSetPluginDefinition = behaviorSetPlugin->getDefinition();
-
-  auto behaviorSetDefinitions =
-    behaviorSetPluginDefinition->getBehaviorSetDefinitions();
-  auto behaviorSetDefinition =
-    std::find_if(behaviorSetDefinitions.begin(),
-                 behaviorSetDefinitions.end(),
-                 [=](BehaviorSetDefinition &theDef) {
-                   return (theDef.getName() == type);
-                 });
-
-  std::vector<SimulationEntityConfiguration>
-    behaviorSetDependencyConfigurations =
+  const auto &behaviorSetDependencyConfigurations =
     theBehaviorSetConfiguration.getDependencyConfigurations();
 
   std::vector<EntityDependency<Behavior>> behaviorSetDependencies;
-  auto neededBehaviors = behaviorSetDefinition->getBehaviors();
-  for (PluginDependencySet neededBehavior : neededBehaviors)
+  const auto &neededBehaviors =
+    behaviorSetPlugin->getBehaviorSetDependencies(type);
+  behaviorSetDependencies.reserve(neededBehaviors.size());
+  for (const auto &neededBehavior : neededBehaviors)
   {
+    auto dependencyConfiguration = findDependencyConfiguration(
+      behaviorSetDependencyConfigurations, neededBehavior);
 
-    auto dependencyConfigurationIter =
-      std::find_if(behaviorSetDependencyConfigurations.begin(),
-                   behaviorSetDependencyConfigurations.end(),
-                   [=](SimulationEntityConfiguration &theConfig){
-                     return (theConfig.getType() == neededBehavior.myName &&
-                             theConfig.getTag() == neededBehavior.myTag);
-                   });
-
-    // Didn't find a match with the tag, try for one without a tag.
-    if (dependencyConfigurationIter ==
-        behaviorSetDependencyConfigurations.end())
+    Behavior *behavior = nullptr;
+    if (dependencyConfiguration != nullptr)
     {
-      dependencyConfigurationIter =
-        std::find_if(behaviorSetDependencyConfigurations.begin(),
-                     behaviorSetDependencyConfigurations.end(),
-                     [=](SimulationEntityConfiguration &theConfig){
-                       return (theConfig.getType() == neededBehavior.myName);
-                     });
+      behavior = createBehavior(*dependencyConfiguration);
     }
-
-    // Start with a basic configuration that works if no configuration was
-    // found. If no configuration found for this Behavior (this also means that
-    // there is no configuration for the Behavior's dependencies) this will
-    // contain enough information to create the Behavior.
-    SimulationEntityConfiguration dependencyConfiguration(
-      neededBehavior.myName, neededBehavior.myTag, neededBehavior.mySource);
-
-    if (dependencyConfigurationIter !=
-        behaviorSetDependencyConfigurations.end())
+    else
     {
-      dependencyConfiguration = *dependencyConfigurationIter;
+      // No configuration for this Behavior (this also means that there is no
+      // configuration for the Behavior's dependencies), a basic one contains
+      // enough information to create the Behavior.
+      behavior = createBehavior(SimulationEntityConfiguration(
+        neededBehavior.myName, neededBehavior.myTag, neededBehavior.mySource));
     }
 
-    EntityDependency<Behavior> behaviorDependency {
-      neededBehavior.myName,
-      createBehavior(dependencyConfiguration),
-      neededBehavior.myTag};
-
-    behaviorSetDependencies.push_back(behaviorDependency);
+    behaviorSetDependencies.push_back({neededBehavior.myName, behavior,
+                                       neededBehavior.myTag});
   }
   behaviorSet->setDependencies(behaviorSetDependencies);
 
@@ -287,6 +215,9 @@ QS::Exit* QS::EntityManager::createExit(
                                       theExitConfiguration.getTag());
 
   myExits.push_back({exit, exitPlugin});
+  exit->setCapabilities(
+    exitPlugin->getCapabilities(EntityCapabilities::Kind::Exit,
+                                theExitConfiguration.getType()));
 
   return exit;
 }
@@ -302,6 +233,123 @@ QS::Sensor* QS::EntityManager::createSensor(
     theSensorConfiguration.getTag());
 
   mySensors.push_back({sensor, sensorPlugin});
+  sensor->setCapabilities(
+    sensorPlugin->getCapabilities(EntityCapabilities::Kind::Sensor,
+                                  theSensorConfiguration.getType()));
 
   return sensor;
 }
+
+void QS::EntityManager::disableSharedBehaviorSets() noexcept
+{
+  glbSharedBehaviorSets = false;
+}
+
+void QS::EntityManager::enableSharedBehaviorSets() noexcept
+{
+  glbSharedBehaviorSets = true;
+}
+
+const QS::SimulationEntityConfiguration*
+QS::EntityManager::findDependencyConfiguration(
+  const std::vector<SimulationEntityConfiguration> &theConfigurations,
+  const PluginDependencySet &theDependency) noexcept
+{
+  const SimulationEntityConfiguration *typeMatch = nullptr;
+  for (const auto &configuration : theConfigurations)
+  {
+    if (configuration.getType() == theDependency.myName)
+    {
+      if (configuration.getTag() == theDependency.myTag)
+      {
+        return &configuration;
+      }
+      // Didn't match the tag, keep the first one in case no other does.
+      if (typeMatch == nullptr)
+      {
+        typeMatch = &configuration;
+      }
+    }
+  }
+  return typeMatch;
+}
+
+QS::BehaviorSet* QS::EntityManager::getBehaviorSet(
+  const SimulationEntityConfiguration &theBehaviorSetConfiguration)
+{
+  if (! glbSharedBehaviorSets)
+  {
+    return createBehaviorSet(theBehaviorSetConfiguration);
+  }
+
+  auto key = getKey(theBehaviorSetConfiguration);
+  auto behaviorSet = mySharedBehaviorSets.find(key);
+  if (behaviorSet == mySharedBehaviorSets.end())
+  {
+    auto newBehaviorSet = createBehaviorSet(theBehaviorSetConfiguration);
+    // Remember those which can't be shared (as nullptr) so they aren't
+    // checked again.
+    mySharedBehaviorSets.emplace(
+      key, isShareable(newBehaviorSet) ? newBehaviorSet : nullptr);
+    return newBehaviorSet;
+  }
+  if (behaviorSet->second == nullptr)
+  {
+    return createBehaviorSet(theBehaviorSetConfiguration);
+  }
+  return behaviorSet->second;
+}
+
+std::string QS::EntityManager::getKey(
+  const SimulationEntityConfiguration &theConfiguration)
+{
+  // Each string is prefixed with its length so no two configurations can
+  // produce the same key.
+  std::string key;
+  auto add = [&](const std::string &theString)
+  {
+    key += std::to_string(theString.size()) + ":" + theString;
+  };
+
+  add(theConfiguration.getType());
+  add(theConfiguration.getTag());
+  add(theConfiguration.getSource());
+  const auto &properties = theConfiguration.getProperties();
+  key += std::to_string(properties.size()) + "{";
+  for (const auto &property : properties)
+  {
+    add(property.first);
+    add(property.second);
+  }
+  const auto &dependencies = theConfiguration.getDependencyConfigurations();
+  key += "}" + std::to_string(dependencies.size()) + "(";
+  for (const auto &dependency : dependencies)
+  {
+    key += getKey(dependency);
+  }
+  key += ")";
+  return key;
+}
+
+bool QS::EntityManager::isShareable(const BehaviorSet *theBehaviorSet) noexcept
+{
+  if (! theBehaviorSet->getCapabilities().myShareable)
+  {
+    return false;
+  }
+  for (const auto &behavior : theBehaviorSet->getDependencies())
+  {
+    if (! behavior.myEntity->getCapabilities().myShareable)
+    {
+      return false;
+    }
+    for (const auto &sensor : behavior.myEntity->getDependencies())
+    {
+      if (! sensor.myEntity->getCapabilities().myShareable)
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
@@ -5,17 +5,106 @@
  * @author Michael Albers
  */
 
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
 #include <sstream>
 #include <stdexcept>
-#include "ActorMetrics.h"
 #include "Metrics.h"
+#include "MetricsSinkWriter.h"
+
+constexpr std::size_t QS::Metrics::NUMBER_HISTOGRAM_BUCKETS;
 
 QS::Metrics::Metrics()
 {
   myStartTime = Clock::now();
 }
 
+void QS::Metrics::addFrameWallTime(float theNumberSeconds) noexcept
+{
+  myFrameWallTimeSum += theNumberSeconds;
+  myFrameWallTimeMax = std::max(myFrameWallTimeMax, theNumberSeconds);
+  ++myFrameCount;
+}
+
+void QS::Metrics::addTimeSeriesSample(TimeSeriesSample theSample)
+{
+  if (! myTimeSeriesWriter)
+  {
+    throw std::logic_error("Cannot add time series sample, no time series "
+                           "sink has been set.");
+  }
+
+  theSample.myTime_s = myElapsedTime;
+  if (myFrameCount > 0)
+  {
+    theSample.myMeanFrameWallTime_s = myFrameWallTimeSum / myFrameCount;
+  }
+  theSample.myMaxFrameWallTime_s = myFrameWallTimeMax;
+
+  auto numberExits = theSample.myExitCounts.size();
+  myTimeSeriesExitCounts.resize(numberExits, 0);
+  theSample.myExitThroughputs.assign(numberExits, 0.0);
+  float sampleDuration = myElapsedTime - myTimeSeriesLastSampleTime;
+  if (sampleDuration > 0.0)
+  {
+    for (auto exit = 0u; exit < numberExits; ++exit)
+    {
+      theSample.myExitThroughputs[exit] =
+        (theSample.myExitCounts[exit] - myTimeSeriesExitCounts[exit]) /
+        sampleDuration;
+    }
+  }
+
+  myTimeSeriesExitCounts = theSample.myExitCounts;
+  myTimeSeriesLastSampleTime = myElapsedTime;
+  // Skip any intervals missed by a long update rather than sampling in a
+  // burst to catch up.
+  while (myTimeSeriesNextSampleTime <= myElapsedTime)
+  {
+    myTimeSeriesNextSampleTime += myTimeSeriesSampleInterval;
+  }
+  myFrameCount = 0;
+  myFrameWallTimeMax = 0.0;
+  myFrameWallTimeSum = 0.0;
+
+  myTimeSeriesWriter->push(std::move(theSample));
+}
+
+void QS::Metrics::addPhaseCounters(
+  const FrameProfiler::PhaseCounters &theCounters,
+  std::size_t theNumberActors) noexcept
+{
+  for (auto phase = 0u; phase < FrameProfiler::NUMBER_PHASES; ++phase)
+  {
+    for (auto counter = 0u; counter < PerfCounters::NUMBER_COUNTERS; ++counter)
+    {
+      myPhaseCounters[phase][counter] += theCounters[phase][counter];
+    }
+  }
+  myNumberCountedActorUpdates += theNumberActors;
+}
+
+void QS::Metrics::addPhaseTimes(const FrameProfiler::PhaseTimes &theTimes)
+  noexcept
+{
+  myLastPhaseTimes = theTimes;
+  for (auto phase = 0u; phase < FrameProfiler::NUMBER_PHASES; ++phase)
+  {
+    float time = theTimes[phase];
+    myPhaseMetrics[phase].update(time);
+
+    std::size_t bucket = 0;
+    float microseconds = time * 1.0e6;
+    if (microseconds >= 1.0)
+    {
+      bucket = static_cast<std::size_t>(std::log2(microseconds)) + 1;
+      bucket = std::min(bucket, NUMBER_HISTOGRAM_BUCKETS - 1);
+    }
+    ++myPhaseHistograms[phase][bucket];
+  }
+}
+
 void QS::Metrics::addToElapsedTime(float theNumberSeconds)
 {
   if (theNumberSeconds < 0.0)
@@ -23,6 +112,8 @@ void QS::Metrics::addToElapsedTime(float theNumberSeconds)
     throw std::invalid_argument("Cannot add negative seconds to elapsed time.");
   }
   myElapsedTime += theNumberSeconds;
+  myLastUpdateInterval = theNumberSeconds;
+  ++myNumberUpdates;
   myUpdateMetrics.update(theNumberSeconds);
 }
 
@@ -35,16 +126,31 @@ std::string QS::Metrics::asISO8601(const TimePoint &theTime) noexcept
   return timeStr.str();
 }
 
-void QS::Metrics::finalizeActorMetrics(const std::vector<Actor*> theActors)
+void QS::Metrics::addActorGrossDistance(std::size_t theActorIndex,
+                                        float theDistanceMeters)
+{
+  myActorMetrics[theActorIndex].addGrossDistance(theDistanceMeters);
+}
+
+void QS::Metrics::finalizeActorMetrics(const std::vector<Actor*> &theActors)
   noexcept
 {
-  for (const auto actor : theActors)
+  auto numActors = std::min(theActors.size(), myActorMetrics.size());
+
+  // Each Actor's metrics are independent, so the (relatively) expensive net
+  // distance calculation is done in parallel. The statistics are then
+  // gathered serially so they're identical regardless of thread count.
+#pragma omp parallel for
+  for (auto actorIndex = 0u; actorIndex < numActors; ++actorIndex)
+  {
+    myActorMetrics[actorIndex].calculateNetDistance(theActors[actorIndex]);
+  }
+
+  for (auto actorIndex = 0u; actorIndex < numActors; ++actorIndex)
   {
-    auto &actorMetrics = getActorMetrics(actor);
-    float net = actorMetrics.calculateNetDistance(actor);
-    myActorNetStats.update(net);
-    float gross = actorMetrics.getGrossDistanceMeters();
-    myActorGrossStats.update(gross);
+    const auto &actorMetrics = myActorMetrics[actorIndex];
+    myActorNetStats.update(actorMetrics.getNetDistanceMeters());
+    myActorGrossStats.update(actorMetrics.getGrossDistanceMeters());
   }
 
   myActorGrossStats.myAvg /= myActorGrossStats.myCount;
@@ -54,12 +160,28 @@ void QS::Metrics::finalizeActorMetrics(const std::vector<Actor*> theActors)
 void QS::Metrics::finalizeSimulationMetrics() noexcept
 {
   myUpdateMetrics.myAvg /= myUpdateMetrics.myCount;
+  for (auto &phaseMetrics : myPhaseMetrics)
+  {
+    if (phaseMetrics.myCount > 0)
+    {
+      phaseMetrics.myAvg /= phaseMetrics.myCount;
+    }
+  }
+  if (myTimeSeriesWriter)
+  {
+    myTimeSeriesWriter->close();
+  }
+}
+
+std::size_t QS::Metrics::getActorIndex(const Actor *theActor) const
+{
+  return myActorIndexes.at(theActor);
 }
 
 const QS::ActorMetrics& QS::Metrics::getActorMetrics(
   const Actor *theActor) const
 {
-  return *myActorMetrics.at(theActor);
+  return myActorMetrics[getActorIndex(theActor)];
 }
 
 QS::ActorMetrics& QS::Metrics::getActorMetrics(const Actor *theActor)
@@ -68,11 +190,50 @@ QS::ActorMetrics& QS::Metrics::getActorMetrics(const Actor *theActor)
     static_cast<const Metrics*>(this)->getActorMetrics(theActor));
 }
 
+const QS::ActorMetrics& QS::Metrics::getActorMetrics(
+  std::size_t theActorIndex) const
+{
+  return myActorMetrics.at(theActorIndex);
+}
+
+QS::ActorMetrics& QS::Metrics::getActorMetrics(std::size_t theActorIndex)
+{
+  return myActorMetrics.at(theActorIndex);
+}
+
 float QS::Metrics::getElapsedTimeInSeconds() const noexcept
 {
   return myElapsedTime;
 }
 
+std::uint64_t QS::Metrics::getNumberCountedActorUpdates() const noexcept
+{
+  return myNumberCountedActorUpdates;
+}
+
+QS::PerfCounters::Values QS::Metrics::getPhaseCounters(
+  FrameProfiler::Phase thePhase) const noexcept
+{
+  return myPhaseCounters[static_cast<std::size_t>(thePhase)];
+}
+
+QS::Metrics::Histogram QS::Metrics::getPhaseHistogram(
+  FrameProfiler::Phase thePhase) const noexcept
+{
+  return myPhaseHistograms[static_cast<std::size_t>(thePhase)];
+}
+
+QS::Metrics::MinMaxAvg<float> QS::Metrics::getPhaseMetrics(
+  FrameProfiler::Phase thePhase) const noexcept
+{
+  return myPhaseMetrics[static_cast<std::size_t>(thePhase)];
+}
+
+QS::Metrics::Snapshot QS::Metrics::getSnapshot() const noexcept
+{
+  return mySnapshot.load();
+}
+
 QS::Metrics::TimePoint QS::Metrics::getStartTime() const noexcept
 {
   return myStartTime;
@@ -88,13 +249,68 @@ QS::Metrics::MinMaxAvg<float> QS::Metrics::getUpdateMetrics() const noexcept
   return myUpdateMetrics;
 }
 
+bool QS::Metrics::hasTimeSeriesSink() const noexcept
+{
+  return static_cast<bool>(myTimeSeriesWriter);
+}
+
+bool QS::Metrics::isTimeSeriesSampleDue() const noexcept
+{
+  return myTimeSeriesWriter && myElapsedTime >= myTimeSeriesNextSampleTime;
+}
+
 void QS::Metrics::initializeActorMetrics(
-  const std::vector<QS::Actor*> theActors) noexcept
+  const std::vector<QS::Actor*> &theActors) noexcept
 {
-  for (Actor *actor : theActors)
+  auto numActors = theActors.size();
+  myActorMetrics.resize(numActors);
+  myActorIndexes.clear();
+
+#pragma omp parallel for
+  for (auto actorIndex = 0u; actorIndex < numActors; ++actorIndex)
   {
-    myActorMetrics[actor].reset(new ActorMetrics(actor));
+    myActorMetrics[actorIndex] = ActorMetrics(theActors[actorIndex]);
   }
+
+  for (auto actorIndex = 0u; actorIndex < numActors; ++actorIndex)
+  {
+    myActorIndexes[theActors[actorIndex]] = actorIndex;
+  }
+
+  publishSnapshot(numActors);
+}
+
+void QS::Metrics::publishSnapshot(std::size_t theNumberActorsRemaining)
+  noexcept
+{
+  Snapshot snapshot;
+  snapshot.myElapsedTime = myElapsedTime;
+  snapshot.myLastUpdateInterval = myLastUpdateInterval;
+  snapshot.myNumberActors = myActorMetrics.size();
+  snapshot.myNumberActorsRemaining = theNumberActorsRemaining;
+  if (snapshot.myNumberActors > snapshot.myNumberActorsRemaining)
+  {
+    snapshot.myNumberActorsExited =
+      snapshot.myNumberActors - snapshot.myNumberActorsRemaining;
+  }
+  snapshot.myNumberUpdates = myNumberUpdates;
+  snapshot.myPhaseTimes = myLastPhaseTimes;
+  mySnapshot.store(snapshot);
+}
+
+void QS::Metrics::setTimeSeriesSink(std::shared_ptr<MetricsSink> theSink,
+                                    float theSampleInterval_s)
+{
+  if (theSampleInterval_s <= 0.0)
+  {
+    throw std::invalid_argument("Time series sample interval must be greater "
+                                "than 0.");
+  }
+  myTimeSeriesWriter.reset(
+    new MetricsSinkWriter(theSink, TIME_SERIES_QUEUE_CAPACITY));
+  myTimeSeriesSampleInterval = theSampleInterval_s;
+  myTimeSeriesNextSampleTime = myElapsedTime;
+  myTimeSeriesLastSampleTime = myElapsedTime;
 }
 
 void QS::Metrics::setStopTime()
@@ -152,11 +368,102 @@ std::ostream& operator<<(std::ostream &os, const Metrics &theMetrics)
      << "Low Net Distance: " << std::fixed
      << theMetrics.myActorNetStats.myMin << " meters" << std::endl
      << std::endl;
+
+  // Only present if the profiler was enabled.
+  if (theMetrics.myPhaseMetrics[0].myCount > 0)
+  {
+    os << "Update Phase Timings (milliseconds)" << std::endl
+       << "-----------------------------------" << std::endl;
+    for (auto phase = 0u; phase < FrameProfiler::NUMBER_PHASES; ++phase)
+    {
+      const auto &phaseMetrics = theMetrics.myPhaseMetrics[phase];
+      os << FrameProfiler::getPhaseName(
+        static_cast<FrameProfiler::Phase>(phase)) << ": "
+         << std::fixed << std::setprecision(4)
+         << "high " << phaseMetrics.myMax * 1000.0
+         << ", average " << phaseMetrics.myAvg * 1000.0
+         << ", low " << phaseMetrics.myMin * 1000.0 << std::endl
+         << "  Histogram (microseconds):";
+      const auto &histogram = theMetrics.myPhaseHistograms[phase];
+      for (auto bucket = 0u; bucket < histogram.size(); ++bucket)
+      {
+        if (0 == histogram[bucket])
+        {
+          continue;
+        }
+        os << " ";
+        if (0 == bucket)
+        {
+          os << "<1";
+        }
+        else if (histogram.size() - 1 == bucket)
+        {
+          os << ">=" << (1u << (bucket - 1));
+        }
+        else
+        {
+          os << (1u << (bucket - 1)) << "-" << (1u << bucket);
+        }
+        os << ":" << histogram[bucket];
+      }
+      os << std::endl;
+    }
+    // Restore default precision for the remaining output.
+    os << std::setprecision(6) << std::endl;
+  }
+
+  // Only present if hardware counters were enabled and available.
+  if (theMetrics.myNumberCountedActorUpdates > 0 &&
+      theMetrics.myPhaseCounters[static_cast<std::size_t>(
+        FrameProfiler::Phase::Update)][0] > 0)
+  {
+    double actorUpdates = theMetrics.myNumberCountedActorUpdates;
+    os << "Update Phase Hardware Counters (per Actor per update)" << std::endl
+       << "-----------------------------------------------------" << std::endl
+       << std::fixed << std::setprecision(2);
+    for (auto phase = 0u; phase < FrameProfiler::NUMBER_PHASES; ++phase)
+    {
+      const auto &counters = theMetrics.myPhaseCounters[phase];
+      os << FrameProfiler::getPhaseName(
+        static_cast<FrameProfiler::Phase>(phase)) << ":";
+      for (auto counter = 0u; counter < PerfCounters::NUMBER_COUNTERS;
+           ++counter)
+      {
+        os << (0 == counter ? " " : ", ")
+           << PerfCounters::getCounterName(
+             static_cast<PerfCounters::Counter>(counter))
+           << " " << counters[counter] / actorUpdates;
+      }
+      auto cycles = counters[static_cast<std::size_t>(
+        PerfCounters::Counter::Cycles)];
+      auto instructions = counters[static_cast<std::size_t>(
+        PerfCounters::Counter::Instructions)];
+      if (cycles > 0)
+      {
+        os << ", IPC " << static_cast<double>(instructions) / cycles;
+      }
+      os << std::endl;
+    }
+    os << std::setprecision(6) << std::endl;
+  }
+
+  if (theMetrics.myTimeSeriesWriter)
+  {
+    os << "Time Series Samples Written: "
+       << theMetrics.myTimeSeriesWriter->getNumberSamplesWritten()
+       << std::endl;
+    auto error = theMetrics.myTimeSeriesWriter->getErrorMessage();
+    if (! error.empty())
+    {
+      os << "Time Series Error: " << error << std::endl;
+    }
+    os << std::endl;
+  }
   
-  for (auto actorMetrics : theMetrics.myActorMetrics)
+  for (const auto &actorMetrics : theMetrics.myActorMetrics)
   {
     os << "--Actor" << std::endl
-       << *(actorMetrics.second) << std::endl;
+       << actorMetrics << std::endl;
   }
   return os;
 }
@@ -0,0 +1,150 @@
+/**
+ * @file MetricsSinkWriter.cpp
+ * @brief Definition of MetricsSinkWriter
+ *
+ * @author Michael Albers
+ */
+
+#include <stdexcept>
+#include "MetricsSink.h"
+#include "MetricsSinkWriter.h"
+#include "Tracer.h"
+
+QS::MetricsSinkWriter::MetricsSinkWriter(std::shared_ptr<MetricsSink> theSink,
+                                         std::size_t theQueueCapacity) :
+  myQueueCapacity(theQueueCapacity),
+  mySink(theSink)
+{
+  if (! mySink)
+  {
+    throw std::invalid_argument("Metrics sink cannot be null.");
+  }
+  if (0 == myQueueCapacity)
+  {
+    throw std::invalid_argument("Metrics sink queue capacity must be greater "
+                                "than 0.");
+  }
+  myThread = std::thread(&MetricsSinkWriter::run, this);
+}
+
+QS::MetricsSinkWriter::~MetricsSinkWriter()
+{
+  close();
+}
+
+void QS::MetricsSinkWriter::close() noexcept
+{
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    myClosed = true;
+  }
+  myConsumerCondition.notify_all();
+  myProducerCondition.notify_all();
+
+  if (myThread.joinable())
+  {
+    myThread.join();
+  }
+}
+
+std::string QS::MetricsSinkWriter::getErrorMessage() const
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+  return myErrorMessage;
+}
+
+std::uint64_t QS::MetricsSinkWriter::getNumberSamplesWritten() const
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+  return myNumberSamplesWritten;
+}
+
+void QS::MetricsSinkWriter::push(TimeSeriesSample theSample)
+{
+  std::unique_lock<std::mutex> lock(myMutex);
+  myProducerCondition.wait(lock, [this]()
+  {
+    return myClosed || myQueue.size() < myQueueCapacity;
+  });
+
+  if (myClosed)
+  {
+    throw std::logic_error("Cannot write time series sample, the metrics sink "
+                           "writer has been closed.");
+  }
+
+  myQueue.push_back(std::move(theSample));
+  lock.unlock();
+  myConsumerCondition.notify_one();
+}
+
+void QS::MetricsSinkWriter::run() noexcept
+{
+  Tracer::setThreadName("Metrics Sink Writer");
+
+  bool failed = false;
+  std::unique_lock<std::mutex> lock(myMutex);
+  while (true)
+  {
+    myConsumerCondition.wait(lock, [this]()
+    {
+      return myClosed || ! myQueue.empty();
+    });
+
+    if (myQueue.empty())
+    {
+      // Closed and nothing left to write.
+      break;
+    }
+
+    TimeSeriesSample sample = std::move(myQueue.front());
+    myQueue.pop_front();
+    lock.unlock();
+    myProducerCondition.notify_one();
+
+    std::string error;
+    if (! failed)
+    {
+      try
+      {
+        QS_TRACE_SCOPE("MetricsSink::write");
+        mySink->write(sample);
+      }
+      catch (const std::exception &exception)
+      {
+        error = exception.what();
+        failed = true;
+      }
+      catch (...)
+      {
+        error = "Unknown error writing time series sample.";
+        failed = true;
+      }
+    }
+
+    lock.lock();
+    if (failed && myErrorMessage.empty())
+    {
+      myErrorMessage = error;
+    }
+    else if (! failed)
+    {
+      ++myNumberSamplesWritten;
+    }
+  }
+  lock.unlock();
+
+  if (! failed)
+  {
+    try
+    {
+      QS_TRACE_SCOPE("MetricsSink::flush");
+      mySink->flush();
+    }
+    catch (const std::exception &exception)
+    {
+      lock.lock();
+      myErrorMessage = exception.what();
+    }
+  }
+}
@@ -0,0 +1,161 @@
+/**
+ * @file PlacementIndex.cpp
+ * @brief Definition of PlacementIndex
+ *
+ * @author Michael Albers
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include "Actor.h"
+#include "PlacementIndex.h"
+
+void QS::PlacementIndex::addActor(const Actor *theActor)
+{
+  addCircle(theActor->getPosition(), theActor->getRadius());
+  myActors.insert(theActor);
+}
+
+void QS::PlacementIndex::addCircle(Eigen::Vector2f thePosition,
+                                   float theRadius)
+{
+  myMaximumRadius = std::max(myMaximumRadius, theRadius);
+  if (myMaximumRadius > myCellSize || myCellSize <= 0.0)
+  {
+    // Cells grow with the largest circle so queries only look at a few
+    // cells. Doubling the cell size each time keeps the rebuilds amortized
+    // constant per circle.
+    myCellSize = std::max(myMaximumRadius * 2.0f,
+                          std::numeric_limits<float>::min());
+    rebuild();
+  }
+
+  insert(Circle{myNumberCircles, thePosition, theRadius});
+  ++myNumberCircles;
+}
+
+void QS::PlacementIndex::clear() noexcept
+{
+  myActors.clear();
+  myCells.clear();
+  myCellSize = 0.0;
+  myMaximumRadius = 0.0;
+  myNumberCircles = 0;
+}
+
+bool QS::PlacementIndex::contains(const Actor *theActor) const noexcept
+{
+  return myActors.find(theActor) != myActors.end();
+}
+
+template<class Function>
+void QS::PlacementIndex::forEachOverlap(Eigen::Vector2f thePosition,
+                                        float theRadius,
+                                        Function theFunction) const
+{
+  if (0 == myNumberCircles)
+  {
+    return;
+  }
+
+  float range = theRadius + myMaximumRadius;
+  auto firstColumn = getCell(thePosition.x() - range);
+  auto lastColumn = getCell(thePosition.x() + range);
+  auto firstRow = getCell(thePosition.y() - range);
+  auto lastRow = getCell(thePosition.y() + range);
+
+  for (auto row = firstRow; row <= lastRow; ++row)
+  {
+    for (auto column = firstColumn; column <= lastColumn; ++column)
+    {
+      auto cell = myCells.find(getKey(column, row));
+      if (cell == myCells.end())
+      {
+        continue;
+      }
+
+      for (const auto &circle : cell->second)
+      {
+        // Same test as World::checkOverlap, without the square root.
+        Eigen::Vector2f distance = circle.myPosition - thePosition;
+        float radii = circle.myRadius + theRadius;
+        if (distance.squaredNorm() <= radii * radii)
+        {
+          if (! theFunction(circle.myIndex))
+          {
+            return;
+          }
+        }
+      }
+    }
+  }
+}
+
+std::int32_t QS::PlacementIndex::getCell(float theValue) const noexcept
+{
+  // Clamped so that nonsense positions can't overflow the cell key.
+  constexpr float limit = 1 << 30;
+  return static_cast<std::int32_t>(
+    std::max(-limit, std::min(limit, std::floor(theValue / myCellSize))));
+}
+
+std::uint64_t QS::PlacementIndex::getKey(std::int32_t theColumn,
+                                         std::int32_t theRow) noexcept
+{
+  return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(theColumn))
+          << 32) | static_cast<std::uint32_t>(theRow);
+}
+
+std::vector<std::size_t> QS::PlacementIndex::getOverlaps(
+  Eigen::Vector2f thePosition, float theRadius) const
+{
+  std::vector<std::size_t> overlaps;
+  forEachOverlap(thePosition, theRadius,
+                 [&](std::size_t theIndex)
+                 {
+                   overlaps.push_back(theIndex);
+                   return true;
+                 });
+  std::sort(overlaps.begin(), overlaps.end());
+  return overlaps;
+}
+
+void QS::PlacementIndex::insert(const Circle &theCircle)
+{
+  auto key = getKey(getCell(theCircle.myPosition.x()),
+                    getCell(theCircle.myPosition.y()));
+  myCells[key].push_back(theCircle);
+}
+
+bool QS::PlacementIndex::overlaps(Eigen::Vector2f thePosition,
+                                  float theRadius) const noexcept
+{
+  bool overlap = false;
+  forEachOverlap(thePosition, theRadius,
+                 [&](std::size_t theIndex)
+                 {
+                   overlap = true;
+                   return false;
+                 });
+  return overlap;
+}
+
+void QS::PlacementIndex::rebuild()
+{
+  auto cells = std::move(myCells);
+  myCells.clear();
+  for (const auto &cell : cells)
+  {
+    for (const auto &circle : cell.second)
+    {
+      insert(circle);
+    }
+  }
+}
+
+std::size_t QS::PlacementIndex::size() const noexcept
+{
+  return myNumberCircles;
+}
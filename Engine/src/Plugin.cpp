@@ -6,13 +6,61 @@
  */
 
 #include <dlfcn.h>
+#include <link.h>
 #include <stdexcept>
+#include <string>
 #include "Plugin.h"
+#include "PluginABI.h"
+#include "StaticPlugin.h"
+
+namespace
+{
+  /** Capabilities of types a plugin declares none for. */
+  const QS::EntityCapabilities glbNoCapabilities;
+}
 
 QS::Plugin::Plugin(std::shared_ptr<PluginDefinition> theDefinition) :
-  myDefinition(theDefinition)
+  Plugin(theDefinition, nullptr)
+{
+}
+
+QS::Plugin::Plugin(std::shared_ptr<PluginDefinition> theDefinition,
+                   const StaticPlugin &theStaticPlugin) :
+  Plugin(theDefinition, &theStaticPlugin)
 {
-  openLibrary();
+}
+
+QS::Plugin::Plugin(std::shared_ptr<PluginDefinition> theDefinition,
+                   const StaticPlugin *theStaticPlugin) :
+  myDefinition(theDefinition),
+  myStaticPlugin(theStaticPlugin)
+{
+  for (const auto &actor : myDefinition->getActorDefinitions())
+  {
+    auto behaviorSets = actor.getBehaviorSets();
+    myActorDependencies[actor.getName()].assign(behaviorSets.begin(),
+                                                behaviorSets.end());
+  }
+
+  for (const auto &behaviorSet : myDefinition->getBehaviorSetDefinitions())
+  {
+    auto behaviors = behaviorSet.getBehaviors();
+    myBehaviorSetDependencies[behaviorSet.getName()].assign(behaviors.begin(),
+                                                            behaviors.end());
+  }
+
+  for (const auto &behavior : myDefinition->getBehaviorDefinitions())
+  {
+    auto sensors = behavior.getSensors();
+    myBehaviorDependencies[behavior.getName()].assign(sensors.begin(),
+                                                      sensors.end());
+  }
+
+  if (! myStaticPlugin)
+  {
+    openLibrary();
+  }
+  loadABI();
 
   myActorCreatorDestructor = loadCreatorDestructor<Actor>(
     myDefinition->getActorCreatorDestructor(), "Actor");
@@ -32,8 +80,11 @@ QS::Plugin::Plugin(std::shared_ptr<PluginDefinition> theDefinition) :
 
 QS::Plugin::~Plugin()
 {
-  // Don't care about return status.
-  dlclose(myLibraryHandle);
+  if (myLibraryHandle)
+  {
+    // Don't care about return status.
+    dlclose(myLibraryHandle);
+  }
 }
 
 template<class T>
@@ -139,16 +190,117 @@ void QS::Plugin::destroySensor(QS::Sensor *theSensor) const
   destroy<Sensor>(theSensor, mySensorCreatorDestructor, "Sensor");
 }
 
+std::uint32_t QS::Plugin::getABIVersion() const noexcept
+{
+  return myABIVersion;
+}
+
+const QS::Plugin::Dependencies& QS::Plugin::getActorDependencies(
+  const std::string &theType) const
+{
+  return getDependencies(myActorDependencies, theType, "Actor");
+}
+
+const QS::Plugin::Dependencies& QS::Plugin::getBehaviorDependencies(
+  const std::string &theType) const
+{
+  return getDependencies(myBehaviorDependencies, theType, "Behavior");
+}
+
+const QS::Plugin::Dependencies& QS::Plugin::getBehaviorSetDependencies(
+  const std::string &theType) const
+{
+  return getDependencies(myBehaviorSetDependencies, theType, "BehaviorSet");
+}
+
+const QS::EntityCapabilities& QS::Plugin::getCapabilities(
+  EntityCapabilities::Kind theKind,
+  const std::string &theType) const noexcept
+{
+  auto capabilities = myCapabilities.find(std::make_pair(theKind, theType));
+  if (capabilities == myCapabilities.end())
+  {
+    return glbNoCapabilities;
+  }
+  return capabilities->second;
+}
+
 std::shared_ptr<QS::PluginDefinition> QS::Plugin::getDefinition() const noexcept
 {
   return myDefinition;
 }
 
+const QS::Plugin::Dependencies& QS::Plugin::getDependencies(
+  const DependencyIndex &theIndex,
+  const std::string &theType,
+  const std::string &theName) const
+{
+  auto dependencies = theIndex.find(theType);
+  if (dependencies == theIndex.end())
+  {
+    throw std::invalid_argument(
+      "No " + theName + " type '" + theType + "' in plugin " + getName() +
+      ".");
+  }
+  return dependencies->second;
+}
+
 std::string QS::Plugin::getName() const noexcept
 {
   return myDefinition->getName();
 }
 
+void QS::Plugin::loadABI()
+{
+  PluginABI::Function abiFunction = nullptr;
+  if (myStaticPlugin)
+  {
+    abiFunction = myStaticPlugin->myABI;
+  }
+  else
+  {
+    abiFunction = reinterpret_cast<PluginABI::Function>(
+      ::dlsym(myLibraryHandle, PluginABI::FUNCTION));
+
+    // dlsym also searches the libraries this one depends on (i.e., plugins
+    // built on BasicPlugin link to it), so make sure the function is this
+    // library's own.
+    Dl_info functionInfo;
+    struct link_map *library = nullptr;
+    if (NULL != abiFunction &&
+        (0 == ::dladdr(reinterpret_cast<void*>(abiFunction), &functionInfo) ||
+         0 != ::dlinfo(myLibraryHandle, RTLD_DI_LINKMAP, &library) ||
+         std::string(functionInfo.dli_fname) != library->l_name))
+    {
+      abiFunction = nullptr;
+    }
+  }
+
+  if (NULL == abiFunction)
+  {
+    // Version 1, no capabilities.
+    return;
+  }
+
+  const PluginABI &abi = abiFunction();
+  // EntityCapabilities changed layout in versions 3 and 4, so earlier versions
+  // can't be read.
+  if (abi.myVersion != PluginABI::VERSION)
+  {
+    throw std::runtime_error(
+      "Unsupported plugin ABI version " + std::to_string(abi.myVersion) +
+      " in library " + myDefinition->getLibrary() + " for plugin " +
+      getName() + ", expected " + std::to_string(PluginABI::VERSION) + ".");
+  }
+
+  myABIVersion = abi.myVersion;
+  for (const auto &capabilities : abi.myCapabilities)
+  {
+    myCapabilities[std::make_pair(capabilities.myKind, capabilities.myType)] =
+      capabilities;
+  }
+}
+
 template<class T>
 QS::Plugin::CreatorDestructor<T> QS::Plugin::loadCreatorDestructor(
   PluginDefinition::CreatorDestructorPair theCreatorDestructor,
@@ -161,35 +313,47 @@ QS::Plugin::CreatorDestructor<T> QS::Plugin::loadCreatorDestructor(
 
   if (! creatorName.empty())
   {
-    auto creatorFunction = reinterpret_cast<CreatorFunction<T>>(
-      ::dlsym(myLibraryHandle, creatorName.c_str()));
+    creatorDestructor.first = reinterpret_cast<CreatorFunction<T>>(
+      loadFunction(creatorName, theType + " creator function"));
+    creatorDestructor.second = reinterpret_cast<DestructorFunction<T>>(
+      loadFunction(destructorName, theType + " destructor function"));
+  }
+  return creatorDestructor;
+}
 
-    if (NULL == creatorFunction)
+void* QS::Plugin::loadFunction(const std::string &theName,
+                               const std::string &theDescription)
+{
+  void *function = nullptr;
+  std::string error;
+  if (myStaticPlugin)
+  {
+    auto staticFunction = myStaticPlugin->myFunctions.find(theName);
+    if (staticFunction != myStaticPlugin->myFunctions.end())
     {
-      throw std::runtime_error("Failed to load " + theType +
-                               " creator function '" +
-                               creatorName + "' from library " +
-                               myDefinition->getLibrary() + ": " +
-                               ::dlerror() + ".");
+      function = staticFunction->second;
     }
-
-    creatorDestructor.first = creatorFunction;
-
-    auto destructorFunction = reinterpret_cast<DestructorFunction<T>>(
-      ::dlsym(myLibraryHandle, destructorName.c_str()));
-
-    if (NULL == destructorFunction)
+    else
     {
-      throw std::runtime_error("Failed to load " + theType +
-                               " destructor function '" +
-                               destructorName + "' from library " +
-                               myDefinition->getLibrary() + ": " +
-                               ::dlerror() + ".");
+      error = "not linked in";
     }
+  }
+  else
+  {
+    function = ::dlsym(myLibraryHandle, theName.c_str());
+    if (NULL == function)
+    {
+      error = ::dlerror();
+    }
+  }
 
-    creatorDestructor.second = destructorFunction;
+  if (NULL == function)
+  {
+    throw std::runtime_error("Failed to load " + theDescription + " '" +
+                             theName + "' from library " +
+                             myDefinition->getLibrary() + ": " + error + ".");
   }
-  return creatorDestructor;
+  return function;
 }
 
 void QS::Plugin::openLibrary()
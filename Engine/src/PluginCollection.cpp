@@ -5,6 +5,7 @@
  * @author Michael Albers
  */
 
+#include <algorithm>
 #include <cerrno>
 #include <cstring>
 #include <dirent.h>
@@ -14,6 +15,30 @@
 #include "PluginCollection.h"
 #include "PluginDefinition.h"
 #include "PluginReader.h"
+#include "StaticPlugin.h"
+
+#ifdef QS_STATIC_PLUGINS
+namespace BasicPlugin
+{
+  const QS::StaticPlugin& qsStaticPlugin();
+}
+
+namespace QueueingPlugin
+{
+  const QS::StaticPlugin& qsStaticPlugin();
+}
+#endif
+
+namespace
+{
+  /** Plugins linked into the executable. */
+  const std::vector<QS::StaticPlugin::Function> glbStaticPlugins{
+#ifdef QS_STATIC_PLUGINS
+    &BasicPlugin::qsStaticPlugin,
+    &QueueingPlugin::qsStaticPlugin
+#endif
+  };
+}
 
 QS::PluginCollection::PluginCollection(
   const std::string &thePluginBaseDirectory)
@@ -30,6 +55,11 @@ QS::PluginCollection::PluginCollection(
 
   Finally directoryClean([=]() {::closedir(directory);});
 
+  for (auto staticPlugin : glbStaticPlugins)
+  {
+    readStaticPlugin(staticPlugin());
+  }
+
   // Directory (expected) layout:
   //  thePluginBaseDirectory
   //   |-Plugin1
@@ -44,7 +74,10 @@ QS::PluginCollection::PluginCollection(
   while ((entry = ::readdir(directory)) != NULL)
   {
     std::string fileName{entry->d_name};
-    if (entry->d_type == DT_DIR && "." != fileName && ".." != fileName)
+    // Plugins are installed in directories named after them, so those of
+    // plugins linked in can be skipped without reading them.
+    if (entry->d_type == DT_DIR && "." != fileName && ".." != fileName &&
+        myPlugins.count(fileName) == 0)
     {
       std::string pluginDirectory{thePluginBaseDirectory};
       pluginDirectory += "/" + fileName;
@@ -128,6 +161,18 @@ std::string QS::PluginCollection::checkPluginDirectory(
   return configFile;
 }
 
+std::vector<std::string> QS::PluginCollection::getConfigFiles() const
+{
+  auto configFiles = myConfigFiles;
+  std::sort(configFiles.begin(), configFiles.end());
+  return configFiles;
+}
+
+std::vector<std::string> QS::PluginCollection::getEmbeddedDefinitions() const
+{
+  return myEmbeddedDefinitions;
+}
+
 std::shared_ptr<QS::Plugin> QS::PluginCollection::getPlugin(
   const std::string &theName) const
 {
@@ -149,4 +194,14 @@ void QS::PluginCollection::readPlugin(
   auto pluginDefinition = pluginReader.read();
   std::shared_ptr<Plugin> plugin(new Plugin(pluginDefinition));
   myPlugins[pluginDefinition->getName()] = plugin;
+  myConfigFiles.push_back(thePluginDirectory + "/" + theConfigFile);
+}
+
+void QS::PluginCollection::readStaticPlugin(const StaticPlugin &thePlugin)
+{
+  PluginReader pluginReader(thePlugin.myConfigFile, thePlugin.myDefinition);
+  auto pluginDefinition = pluginReader.read();
+  std::shared_ptr<Plugin> plugin(new Plugin(pluginDefinition, thePlugin));
+  myPlugins[pluginDefinition->getName()] = plugin;
+  myEmbeddedDefinitions.push_back(thePlugin.myDefinition);
 }
@@ -6,16 +6,14 @@
  */
 
 #include <stdexcept>
-#include "xercesc/sax2/SAX2XMLReader.hpp"
-#include "xercesc/sax2/XMLReaderFactory.hpp"
 #include "xercesc/util/XMLString.hpp"
 #include "xercesc/sax2/Attributes.hpp"
 #include "ActorDefinition.h"
 #include "BehaviorSetDefinition.h"
 #include "ExitDefinition.h"
-#include "Finally.h"
 #include "PluginDefinition.h"
 #include "PluginReader.h"
+#include "XMLParser.h"
 #include "XMLUtilities.h"
 
 QS::PluginReader::PluginReader(const std::string &thePluginDirectory,
@@ -27,6 +25,13 @@ QS::PluginReader::PluginReader(const std::string &thePluginDirectory,
 {
 }
 
+QS::PluginReader::PluginReader(const std::string &theConfigFile,
+                               const std::string &theDefinition) :
+  myConfigFile(theConfigFile),
+  myDefinition(theDefinition)
+{
+}
+
 std::string QS::PluginReader::getPluginSource(const Attributes &theAttributes)
   const noexcept
 {
@@ -58,20 +63,16 @@ std::shared_ptr<QS::PluginDefinition> QS::PluginReader::read()
 {
   try
   {
-    SAX2XMLReader* parser = XMLReaderFactory::createXMLReader();
-    Finally parserCleanup([=](){delete parser;});
-    std::string schema = myPluginSchemaDirectory + "/" + SCHEMA_FILE;
-    parser->loadGrammar(schema.c_str(), Grammar::SchemaGrammarType, true);
-    parser->setFeature(XMLUni::fgXercesUseCachedGrammarInParse, true);
-    parser->setFeature(XMLUni::fgSAX2CoreValidation, true);
-    parser->setFeature(XMLUni::fgSAX2CoreNameSpaces, true);
-    parser->setFeature(XMLUni::fgXercesSchemaFullChecking, true);
-
-    parser->setContentHandler(this);
-    parser->setErrorHandler(this);
-
-    std::string xmlFile = myPluginDirectory + "/" + myConfigFile;
-    parser->parse(xmlFile.c_str());
+    if (myDefinition.empty())
+    {
+      std::string schema = myPluginSchemaDirectory + "/" + SCHEMA_FILE;
+      std::string xmlFile = myPluginDirectory + "/" + myConfigFile;
+      XMLParser::parse(schema, xmlFile, *this);
+    }
+    else
+    {
+      XMLParser::parseMemory(myConfigFile, myDefinition, *this);
+    }
   }
   catch (const XMLException &exception)
   {
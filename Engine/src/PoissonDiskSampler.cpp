@@ -0,0 +1,178 @@
+/**
+ * @file PoissonDiskSampler.cpp
+ * @brief Definition of PoissonDiskSampler
+ *
+ * @author Michael Albers
+ */
+
+#define _USE_MATH_DEFINES // For M_PI
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include "EigenHelper.h"
+#include "PoissonDiskSampler.h"
+#include "World.h"
+
+constexpr uint32_t QS::PoissonDiskSampler::ATTEMPTS_PER_POSITION;
+constexpr float QS::PoissonDiskSampler::RADIUS_CLASS_RATIO;
+
+QS::PoissonDiskSampler::PoissonDiskSampler(World &theWorld,
+                                           std::uint32_t theEntity) :
+  myMaximum(std::get<0>(theWorld.getDimensions()),
+            std::get<1>(theWorld.getDimensions())),
+  myMinimum(0.0, 0.0),
+  myRandom(theWorld.getRNG(), theEntity, CounterRNG::POISSON),
+  myWorld(theWorld)
+{
+}
+
+QS::PoissonDiskSampler::PoissonDiskSampler(World &theWorld,
+                                           Eigen::Vector2f theMinimum,
+                                           Eigen::Vector2f theMaximum,
+                                           std::uint32_t theEntity) :
+  myMaximum(theMaximum),
+  myMinimum(theMinimum),
+  myRandom(theWorld.getRNG(), theEntity, CounterRNG::POISSON),
+  myWorld(theWorld)
+{
+  float width = std::get<0>(theWorld.getDimensions());
+  float length = std::get<1>(theWorld.getDimensions());
+  if (theMinimum.x() < 0.0 || theMinimum.y() < 0.0 ||
+      theMaximum.x() > width || theMaximum.y() > length ||
+      theMinimum.x() >= theMaximum.x() || theMinimum.y() >= theMaximum.y())
+  {
+    std::ostringstream error;
+    error << "Invalid placement region from "
+          << theMinimum.format(EigenHelper::prettyPrint) << " to "
+          << theMaximum.format(EigenHelper::prettyPrint)
+          << ", it must be non-empty and within the world (" << std::fixed
+          << width << " x " << length << ").";
+    throw std::invalid_argument(error.str());
+  }
+}
+
+Eigen::Vector2f QS::PoissonDiskSampler::getPosition(float theRadius)
+{
+  if (theRadius * 2.0 > myMaximum.x() - myMinimum.x() ||
+      theRadius * 2.0 > myMaximum.y() - myMinimum.y())
+  {
+    std::ostringstream error;
+    error << "Cannot generate Actor position, the provided radius, "
+          << std::fixed << theRadius
+          << ", is too large for the placement region.";
+    throw std::invalid_argument(error.str());
+  }
+
+  // Positions are only retired for radii like the one which failed around
+  // them, smaller Actors may still fit. The first Actor of a class can try
+  // around every earlier position.
+  auto radiusClass = getRadiusClass(theRadius);
+  auto classActive = myActive.find(radiusClass);
+  if (myActive.end() == classActive)
+  {
+    std::vector<std::size_t> all(myPositions.size());
+    for (auto index = 0u; index < all.size(); ++index)
+    {
+      all[index] = index;
+    }
+    classActive = myActive.emplace(radiusClass, std::move(all)).first;
+  }
+  auto &active = classActive->second;
+
+  Eigen::Vector2f position;
+  bool foundPosition = false;
+
+  while (! foundPosition && ! active.empty())
+  {
+    auto activeIndex = std::min(
+      static_cast<std::size_t>(random() * active.size()), active.size() - 1);
+    auto activePosition = active[activeIndex];
+    float minimumDistance = myRadii[activePosition] + theRadius;
+
+    for (auto attempt = 0u;
+         ! foundPosition && attempt < ATTEMPTS_PER_POSITION; ++attempt)
+    {
+      float angle = random() * 2.0 * M_PI;
+      float distance = minimumDistance * (1.0 + random());
+      position = myPositions[activePosition] +
+        distance * Eigen::Vector2f(std::cos(angle), std::sin(angle));
+      foundPosition = isFree(position, theRadius);
+    }
+
+    if (! foundPosition)
+    {
+      active[activeIndex] = active.back();
+      active.pop_back();
+    }
+  }
+
+  // Nothing left to grow from (the first position, or the region around
+  // every earlier position is full), so try a few positions anywhere.
+  for (auto attempt = 0u;
+       ! foundPosition && attempt < ATTEMPTS_PER_POSITION; ++attempt)
+  {
+    position << myMinimum.x() + theRadius +
+      random() * (myMaximum.x() - myMinimum.x() - theRadius * 2.0),
+      myMinimum.y() + theRadius +
+      random() * (myMaximum.y() - myMinimum.y() - theRadius * 2.0);
+    foundPosition = isFree(position, theRadius);
+  }
+
+  if (! foundPosition)
+  {
+    std::ostringstream error;
+    error << "Could not generate Actor position with radius " << std::fixed
+          << theRadius << ", no room is left in the placement region after "
+          << myPositions.size() << " Actor(s).";
+    throw std::logic_error(error.str());
+  }
+
+  for (auto &classPositions : myActive)
+  {
+    classPositions.second.push_back(myPositions.size());
+  }
+  myGenerated.addCircle(position, theRadius);
+  myPositions.push_back(position);
+  myRadii.push_back(theRadius);
+  return position;
+}
+
+std::vector<Eigen::Vector2f> QS::PoissonDiskSampler::getPositions(
+  const std::vector<float> &theRadii)
+{
+  std::vector<Eigen::Vector2f> positions;
+  positions.reserve(theRadii.size());
+  for (auto radius : theRadii)
+  {
+    positions.push_back(getPosition(radius));
+  }
+  return positions;
+}
+
+int QS::PoissonDiskSampler::getRadiusClass(float theRadius) noexcept
+{
+  if (theRadius <= 0.0)
+  {
+    return std::numeric_limits<int>::min();
+  }
+  return static_cast<int>(
+    std::floor(std::log(theRadius) / std::log(RADIUS_CLASS_RATIO)));
+}
+
+bool QS::PoissonDiskSampler::isFree(Eigen::Vector2f thePosition,
+                                    float theRadius) const noexcept
+{
+  return thePosition.x() - theRadius >= myMinimum.x() &&
+    thePosition.x() + theRadius <= myMaximum.x() &&
+    thePosition.y() - theRadius >= myMinimum.y() &&
+    thePosition.y() + theRadius <= myMaximum.y() &&
+    ! myGenerated.overlaps(thePosition, theRadius) &&
+    ! myWorld.overlapsActor(thePosition, theRadius);
+}
+
+float QS::PoissonDiskSampler::random() noexcept
+{
+  return myRandom.uniform(0.0, 1.0);
+}
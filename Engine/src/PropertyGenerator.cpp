@@ -7,7 +7,6 @@
 
 #define _USE_MATH_DEFINES // For M_PI
 #include <cmath>
-#include <random>
 #include <sstream>
 #include <strings.h>
 #include "SimulationEntityConfiguration.h"
@@ -15,6 +14,8 @@
 #include "World.h"
 
 QS::PropertyGenerator::PropertyGenerator(World &theWorld) :
+  myIndex(0),
+  myRandom(theWorld.getRNG(), 0, CounterRNG::PROPERTIES),
   myWorld(theWorld)
 {
 }
@@ -66,6 +67,12 @@ void QS::PropertyGenerator::checkInput(const TokenSet &theValidSet)
   }
 }
 
+void QS::PropertyGenerator::emit(Instruction::OpCode theOpCode,
+                                 float theValue, const std::string &theName)
+{
+  myProgram.push_back({theOpCode, theValue, theName});
+}
+
 void QS::PropertyGenerator::error(const PropertyGeneratorToken &theToken,
                                   const std::string &theError)
 {
@@ -75,6 +82,123 @@ void QS::PropertyGenerator::error(const PropertyGeneratorToken &theToken,
   throw std::runtime_error(errorText.str());
 }
 
+std::string QS::PropertyGenerator::evaluate(
+  const Program &theProgram,
+  const SimulationEntityConfiguration &theEntity)
+{
+  myEvaluationStack.clear();
+
+  for (const auto &instruction : theProgram)
+  {
+    switch (instruction.myOpCode)
+    {
+      case Instruction::OpCode::Add:
+      {
+        float right = pop();
+        float left = pop();
+        myEvaluationStack.push_back(left + right);
+      }
+      break;
+
+      case Instruction::OpCode::Divide:
+      {
+        float right = pop();
+        float left = pop();
+        myEvaluationStack.push_back(left / right);
+      }
+      break;
+
+      case Instruction::OpCode::Index:
+        myEvaluationStack.push_back(static_cast<float>(myIndex));
+        break;
+
+      case Instruction::OpCode::Length:
+        myEvaluationStack.push_back(std::get<1>(myWorld.getDimensions()));
+        break;
+
+      case Instruction::OpCode::Multiply:
+      {
+        float right = pop();
+        float left = pop();
+        myEvaluationStack.push_back(left * right);
+      }
+      break;
+
+      case Instruction::OpCode::Property:
+      {
+        const auto &properties = theEntity.getProperties();
+        auto property = properties.find(instruction.myName);
+        if (property == properties.end())
+        {
+          std::string error{"Invalid entity property provided, \""};
+          error += instruction.myName +
+            "\". (It might not have been processed yet.)";
+          throw std::runtime_error(error);
+        }
+
+        try
+        {
+          myEvaluationStack.push_back(std::stof(property->second));
+        }
+        catch (const std::logic_error&)
+        {
+          // Handles out_of_range & invalid_argument that stof can throw.
+          std::string error{"Invalid entity property value for property, \""};
+          error += instruction.myName +
+            "\". Value must be convertable to a float.";
+          throw std::runtime_error(error);
+        }
+      }
+      break;
+
+      case Instruction::OpCode::Push:
+        myEvaluationStack.push_back(instruction.myValue);
+        break;
+
+      case Instruction::OpCode::Rand:
+      {
+        float highBound = pop();
+        float lowBound = pop();
+        if (lowBound > highBound)
+        {
+          std::string error{
+            "Invalid random bounds. Low is larger than high. Low: "};
+          error += std::to_string(lowBound) + ", high: " +
+            std::to_string(highBound) + ".";
+          throw std::runtime_error(error);
+        }
+
+        myEvaluationStack.push_back(myRandom.uniform(lowBound, highBound));
+      }
+      break;
+
+      case Instruction::OpCode::RandColor:
+      {
+        float r = myRandom.uniform(0.0, 1.0);
+        float g = myRandom.uniform(0.0, 1.0);
+        float b = myRandom.uniform(0.0, 1.0);
+
+        return std::to_string(r) + " " + std::to_string(g) + " " +
+          std::to_string(b);
+      }
+
+      case Instruction::OpCode::Subtract:
+      {
+        float right = pop();
+        float left = pop();
+        myEvaluationStack.push_back(left - right);
+      }
+      break;
+
+      case Instruction::OpCode::Width:
+        myEvaluationStack.push_back(std::get<0>(myWorld.getDimensions()));
+        break;
+    }
+  }
+
+  return std::to_string(myEvaluationStack.back());
+}
+
 void QS::PropertyGenerator::expression()
 {
   checkInput({PropertyGeneratorToken::Type::FloatLiteral,
@@ -97,20 +221,13 @@ void QS::PropertyGenerator::expressionTail()
 
     term();
 
-    auto right = myEvaluationStack.top();
-    myEvaluationStack.pop();
-    auto left = myEvaluationStack.top();
-    myEvaluationStack.pop();
-
     if (operatorRecord.getToken() == PropertyGeneratorToken::Type::PlusOp)
     {
-      float result = left + right;
-      myEvaluationStack.push(result);
+      emit(Instruction::OpCode::Add);
     }
     else
     {
-      float result = left - right;
-      myEvaluationStack.push(result);
+      emit(Instruction::OpCode::Subtract);
     }
 
     expressionTail();
@@ -127,7 +244,7 @@ void QS::PropertyGenerator::ident()
 
   if (::strcasecmp(ident.c_str(), "PI") == 0)
   {
-    myEvaluationStack.push(M_PI);
+    emit(Instruction::OpCode::Push, M_PI);
   }
   else if (::strncasecmp(ident.c_str(), "world", 5) == 0)
   {
@@ -147,11 +264,11 @@ void QS::PropertyGenerator::ident()
 
       if (::strcasecmp(identAttributeName.c_str(), "width") == 0)
       {
-        myEvaluationStack.push(std::get<0>(myWorld.getDimensions()));
+        emit(Instruction::OpCode::Width);
       }
       else if (::strcasecmp(identAttributeName.c_str(), "length") == 0)
       {
-        myEvaluationStack.push(std::get<1>(myWorld.getDimensions()));
+        emit(Instruction::OpCode::Length);
       }
       else
       {
@@ -167,6 +284,10 @@ void QS::PropertyGenerator::ident()
       throw std::runtime_error(error);
     }
   }
+  else if (::strcasecmp(ident.c_str(), "group.index") == 0)
+  {
+    emit(Instruction::OpCode::Index);
+  }
   else if (::strncasecmp(ident.c_str(), "this", 4) == 0)
   {
     auto dotPosition = ident.find(".");
@@ -184,31 +305,7 @@ void QS::PropertyGenerator::ident()
         throw std::runtime_error(error);
       }
 
-      auto properties = myEntity->getProperties();
-      try
-      {
-        auto property = properties.at(identAttributeName);
-
-        try
-        {
-          myEvaluationStack.push(std::stof(property));
-        }
-        catch (std::logic_error)
-        {
-          // Handles out_of_range & invalid_argument that stof can throw.
-          std::string error{"Invalid entity property value for property, \""};
-          error += identAttributeName +
-            "\". Value must be convertable to a float.";
-          throw std::runtime_error(error);
-        }
-      }
-      catch (std::out_of_range)
-      {
-        std::string error{"Invalid entity property provided, \""};
-        error += identAttributeName +
-          "\". (It might not have been processed yet.)";
-        throw std::runtime_error(error);
-      }
+      emit(Instruction::OpCode::Property, 0.0, identAttributeName);
     }
     else
     {
@@ -228,34 +325,22 @@ std::string QS::PropertyGenerator::generateProperty(
   const std::string &theValue,
   const SimulationEntityConfiguration &theCurrentEntity)
 {
-  myEntity = &theCurrentEntity;
-  std::string newValue{theValue};
-  if (theValue[0] == ':')
+  if (theValue[0] != ':')
   {
-    myOriginalProperty = theValue;
-    newValue.erase(0, 1); // Erase the ':'
-    myScanner.reset(new PropertyGeneratorScanner(newValue));
-
-    // std::stack has no clear function.
-    while (! myEvaluationStack.empty())
-    {
-      myEvaluationStack.pop();
-    }
+    return theValue;
+  }
 
+  auto program = myPrograms.find(theValue);
+  if (program == myPrograms.end())
+  {
+    myOriginalProperty = theValue;
+    myScanner.reset(new PropertyGeneratorScanner(theValue.substr(1)));
+    myProgram.clear();
     parse();
-    auto result = myEvaluationStack.top();
-    if (StackItem::Type::Float == result.myType)
-    {
-      newValue = std::to_string(result.myFloat);
-    }
-    else
-    {
-      newValue = result.myString;
-    }
-    myEvaluationStack.pop();
+    program = myPrograms.emplace(theValue, std::move(myProgram)).first;
   }
 
-  return newValue;
+  return evaluate(program->second, theCurrentEntity);
 }
 
 void QS::PropertyGenerator::match(const PropertyGeneratorToken::Type &theToken)
@@ -305,6 +390,13 @@ void QS::PropertyGenerator::parse()
   match(PropertyGeneratorToken::Type::EofSym);
 }
 
+float QS::PropertyGenerator::pop() noexcept
+{
+  float value = myEvaluationStack.back();
+  myEvaluationStack.pop_back();
+  return value;
+}
+
 void QS::PropertyGenerator::primary()
 {
   checkInput({PropertyGeneratorToken::Type::FloatLiteral,
@@ -319,7 +411,7 @@ void QS::PropertyGenerator::primary()
     {
       match(PropertyGeneratorToken::Type::FloatLiteral);
       auto literal = myScanner->getCurrentToken().getLiteral();
-      myEvaluationStack.push(std::stof(literal));
+      emit(Instruction::OpCode::Push, std::stof(literal));
     }
     break;
 
@@ -331,7 +423,7 @@ void QS::PropertyGenerator::primary()
     {
       match(PropertyGeneratorToken::Type::IntLiteral);
       auto literal = myScanner->getCurrentToken().getLiteral();
-      myEvaluationStack.push(std::stof(literal));
+      emit(Instruction::OpCode::Push, std::stof(literal));
     }
     break;
 
@@ -357,25 +449,10 @@ void QS::PropertyGenerator::rand()
   match(PropertyGeneratorToken::Type::RandSym);
   match(PropertyGeneratorToken::Type::LParen);
   expression();
-  float lowBound = myEvaluationStack.top();
-  myEvaluationStack.pop();
   match(PropertyGeneratorToken::Type::Comma);
   expression();
-  float highBound = myEvaluationStack.top();
-  myEvaluationStack.pop();
   match(PropertyGeneratorToken::Type::RParen);
-
-  if (lowBound > highBound)
-  {
-    std::string error{"Invalid random bounds. Low is larger than high. Low: "};
-    error += std::to_string(lowBound) + ", high: " + std::to_string(highBound)
-      + ".";
-    throw std::runtime_error(error);
-  }
-
-  std::uniform_real_distribution<float> distribution(lowBound, highBound);
-
-  myEvaluationStack.push(myWorld.getRandomNumber(distribution));
+  emit(Instruction::OpCode::Rand);
 }
 
 void QS::PropertyGenerator::randColor()
@@ -385,17 +462,18 @@ void QS::PropertyGenerator::randColor()
   match(PropertyGeneratorToken::Type::RandColorSym);
   match(PropertyGeneratorToken::Type::LParen);
   match(PropertyGeneratorToken::Type::RParen);
+  emit(Instruction::OpCode::RandColor);
+}
 
-  std::uniform_real_distribution<float> distribution(0.0, 1.0);
-
-  float r = myWorld.getRandomNumber(distribution);
-  float g = myWorld.getRandomNumber(distribution);
-  float b = myWorld.getRandomNumber(distribution);
-
-  std::string color = std::to_string(r) + " " + std::to_string(g) + " " +
-    std::to_string(b);
+void QS::PropertyGenerator::setEntity(std::uint32_t theEntity) noexcept
+{
+  myRandom = RandomStream(myWorld.getRNG(), theEntity,
+                          CounterRNG::PROPERTIES);
+}
 
-  myEvaluationStack.push(color);
+void QS::PropertyGenerator::setIndex(std::size_t theIndex) noexcept
+{
+  myIndex = theIndex;
 }
 
 void QS::PropertyGenerator::statement()
@@ -458,20 +536,13 @@ void QS::PropertyGenerator::termTail()
 
     primary();
 
-    auto right = myEvaluationStack.top();
-    myEvaluationStack.pop();
-    auto left = myEvaluationStack.top();
-    myEvaluationStack.pop();
-
     if (operatorRecord.getToken() == PropertyGeneratorToken::Type::MultOp)
     {
-      float result = left * right;
-      myEvaluationStack.push(result);
+      emit(Instruction::OpCode::Multiply);
     }
     else
     {
-      float result = left / right;
-      myEvaluationStack.push(result);
+      emit(Instruction::OpCode::Divide);
     }
 
     termTail();
@@ -0,0 +1,631 @@
+/**
+ * @file ScenarioCache.cpp
+ * @brief Definition of ScenarioCache
+ *
+ * @author Michael Albers
+ */
+
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include "BinaryMetricsSink.h"
+#include "CSVMetricsSink.h"
+#include "Finally.h"
+#include "ScenarioCache.h"
+#include "SimulationEntityConfiguration.h"
+#include "World.h"
+
+constexpr std::uint32_t QS::ScenarioCache::VERSION;
+
+namespace
+{
+  /** Identifies a scenario cache file. */
+  const char glbMagic[8] = {'Q', 'S', 'S', 'C', 'E', 'N', 'E', '\0'};
+
+  /**
+   * Header: magic, version (uint32), unused (uint32), key (uint64), build ID
+   * (uint64), string table offset (uint64). The offset is 0 until the cache
+   * is finished.
+   */
+  constexpr std::size_t glbHeaderSize = 40;
+
+  /** Position of the string table offset in the header. */
+  constexpr std::size_t glbStringTableOffsetPosition = 32;
+
+  /** Cache directory, empty when caching is disabled. */
+  std::string glbDirectory;
+
+  /**
+   * Record types. The records follow the header in the order the simulation
+   * was read and end with an End record.
+   */
+  enum class Record : std::uint8_t
+  {
+    Seed = 1,       // uint64 seed
+    Dimensions = 2, // float width, float length
+    Actor = 3,      // entity
+    Exit = 4,       // entity
+    TimeSeries = 5, // string file, string format, float interval,
+                    // float density radius
+    End = 6         // string random number generator state
+  };
+
+  // An entity is: uint32 type, source and tag string IDs, uint32 number of
+  // properties, each a uint32 name string ID and a string value, uint32
+  // number of dependencies, each an entity. Strings written in place are a
+  // uint32 length then the characters.
+
+  /**
+   * Bounds checked reader of a memory mapped cache file.
+   */
+  class Reader
+  {
+    public:
+
+    /**
+     * Constructor.
+     *
+     * @param theStart
+     *          first byte to read
+     * @param theEnd
+     *          one past the last byte which may be read
+     */
+    Reader(const char *theStart, const char *theEnd) :
+      myCurrent(theStart),
+      myEnd(theEnd)
+    {
+    }
+
+    /**
+     * Reads a value (as written by ScenarioCache::write).
+     *
+     * @return value
+     * @throws std::runtime_error
+     *          if there aren't enough bytes left
+     */
+    template<class T>
+    T read()
+    {
+      check(sizeof(T));
+      T value;
+      std::memcpy(&value, myCurrent, sizeof(T));
+      myCurrent += sizeof(T);
+      return value;
+    }
+
+    /**
+     * Reads a string (as written by ScenarioCache::writeString).
+     *
+     * @return string
+     * @throws std::runtime_error
+     *          if there aren't enough bytes left
+     */
+    std::string readString()
+    {
+      auto length = read<std::uint32_t>();
+      check(length);
+      std::string value(myCurrent, length);
+      myCurrent += length;
+      return value;
+    }
+
+    private:
+
+    /**
+     * Checks there are enough bytes left to read.
+     *
+     * @param theSize
+     *          number of bytes to be read
+     * @throws std::runtime_error
+     *          if there are fewer bytes left
+     */
+    void check(std::size_t theSize) const
+    {
+      if (static_cast<std::size_t>(myEnd - myCurrent) < theSize)
+      {
+        throw std::runtime_error("Scenario cache file is truncated.");
+      }
+    }
+
+    /** Next byte to read. */
+    const char *myCurrent;
+
+    /** One past the last byte which may be read. */
+    const char *myEnd;
+  };
+
+  /**
+   * Returns the string with the given ID.
+   */
+  const std::string& getString(const std::vector<std::string> &theStrings,
+                               std::uint32_t theId)
+  {
+    if (theId >= theStrings.size())
+    {
+      throw std::runtime_error("Invalid string ID in scenario cache file.");
+    }
+    return theStrings[theId];
+  }
+
+  /**
+   * Reads an entity configuration, including its dependencies.
+   */
+  QS::SimulationEntityConfiguration readEntity(
+    Reader &theReader, const std::vector<std::string> &theStrings)
+  {
+    auto &type = getString(theStrings, theReader.read<std::uint32_t>());
+    auto &source = getString(theStrings, theReader.read<std::uint32_t>());
+    auto &tag = getString(theStrings, theReader.read<std::uint32_t>());
+    QS::SimulationEntityConfiguration configuration(type, tag, source);
+
+    auto numberProperties = theReader.read<std::uint32_t>();
+    for (auto ii = 0u; ii < numberProperties; ++ii)
+    {
+      auto &name = getString(theStrings, theReader.read<std::uint32_t>());
+      configuration.addProperty(name, theReader.readString());
+    }
+
+    auto numberDependencies = theReader.read<std::uint32_t>();
+    for (auto ii = 0u; ii < numberDependencies; ++ii)
+    {
+      configuration.addDependencyConfiguration(
+        readEntity(theReader, theStrings));
+    }
+    return configuration;
+  }
+
+  /**
+   * Reads the records, up to and including the End record.
+   *
+   * @param theReader
+   *          reader positioned at the first record
+   * @param theStrings
+   *          string table
+   * @param theWorld
+   *          world to set up, nullptr to only check the records can be read
+   * @param theActorFunction
+   *          called for each Actor (unless theWorld is nullptr)
+   * @param theExitFunction
+   *          called for each Exit (unless theWorld is nullptr)
+   * @throws std::runtime_error
+   *          if a record can't be read
+   */
+  void readRecords(Reader &theReader,
+                   const std::vector<std::string> &theStrings,
+                   QS::World *theWorld,
+                   const QS::ScenarioCache::EntityFunction *theActorFunction,
+                   const QS::ScenarioCache::EntityFunction *theExitFunction)
+  {
+    bool end = false;
+    while (! end)
+    {
+      switch (theReader.read<Record>())
+      {
+        case Record::Seed:
+        {
+          auto seed = theReader.read<std::uint64_t>();
+          if (theWorld)
+          {
+            theWorld->setSeed(seed);
+          }
+          break;
+        }
+
+        case Record::Dimensions:
+        {
+          auto width = theReader.read<float>();
+          auto length = theReader.read<float>();
+          if (theWorld)
+          {
+            theWorld->setDimensions(width, length);
+          }
+          break;
+        }
+
+        case Record::Actor:
+        {
+          auto configuration = readEntity(theReader, theStrings);
+          if (theWorld)
+          {
+            (*theActorFunction)(configuration);
+          }
+          break;
+        }
+
+        case Record::Exit:
+        {
+          auto configuration = readEntity(theReader, theStrings);
+          if (theWorld)
+          {
+            (*theExitFunction)(configuration);
+          }
+          break;
+        }
+
+        case Record::TimeSeries:
+        {
+          auto file = theReader.readString();
+          auto format = theReader.readString();
+          auto interval = theReader.read<float>();
+          auto densityRadius = theReader.read<float>();
+          if (theWorld)
+          {
+            std::shared_ptr<QS::MetricsSink> sink;
+            if ("binary" == format)
+            {
+              sink.reset(new QS::BinaryMetricsSink(file));
+            }
+            else
+            {
+              sink.reset(new QS::CSVMetricsSink(file));
+            }
+            theWorld->setTimeSeriesSink(sink, interval, densityRadius);
+          }
+          break;
+        }
+
+        case Record::End:
+        {
+          auto randomState = theReader.readString();
+          if (theWorld)
+          {
+            theWorld->setRandomState(randomState);
+          }
+          end = true;
+          break;
+        }
+
+        default:
+          throw std::runtime_error("Unknown record type.");
+      }
+    }
+  }
+}
+
+QS::ScenarioCache::ScenarioCache(const std::string &theFileName,
+                                 std::uint64_t theKey) :
+  myFileName(theFileName),
+  myKey(theKey),
+  myTemporaryFileName(theFileName + ".tmp" + std::to_string(::getpid()))
+{
+  myOutput.open(myTemporaryFileName,
+                std::ios::binary | std::ios::out | std::ios::trunc);
+  if (! myOutput.is_open())
+  {
+    throw std::runtime_error("Failed to open scenario cache file '" +
+                             myTemporaryFileName + "'.");
+  }
+
+  myOutput.write(glbMagic, sizeof(glbMagic));
+  write(VERSION);
+  write(static_cast<std::uint32_t>(0));
+  write(myKey);
+  write(getBuildId());
+  write(static_cast<std::uint64_t>(0));
+}
+
+QS::ScenarioCache::~ScenarioCache()
+{
+  if (! myFinished)
+  {
+    myOutput.close();
+    std::remove(myTemporaryFileName.c_str());
+  }
+}
+
+void QS::ScenarioCache::addActor(
+  const SimulationEntityConfiguration &theConfiguration)
+{
+  write(Record::Actor);
+  writeEntity(theConfiguration);
+}
+
+void QS::ScenarioCache::addExit(
+  const SimulationEntityConfiguration &theConfiguration)
+{
+  write(Record::Exit);
+  writeEntity(theConfiguration);
+}
+
+void QS::ScenarioCache::disable() noexcept
+{
+  glbDirectory.clear();
+}
+
+void QS::ScenarioCache::enable(const std::string &theDirectory)
+{
+  glbDirectory = theDirectory;
+}
+
+void QS::ScenarioCache::finish(const World &theWorld)
+{
+  write(Record::End);
+  writeString(theWorld.getRandomState());
+
+  std::uint64_t stringTableOffset = myOutput.tellp();
+  write(static_cast<std::uint32_t>(myStrings.size()));
+  for (const auto &string : myStrings)
+  {
+    writeString(string);
+  }
+
+  myOutput.seekp(glbStringTableOffsetPosition);
+  write(stringTableOffset);
+  myOutput.close();
+  if (! myOutput)
+  {
+    throw std::runtime_error("Failed to write scenario cache file '" +
+                             myTemporaryFileName + "'.");
+  }
+
+  if (std::rename(myTemporaryFileName.c_str(), myFileName.c_str()) != 0)
+  {
+    auto thisErrno = errno;
+    throw std::runtime_error("Failed to rename scenario cache file '" +
+                             myTemporaryFileName + "' to '" + myFileName +
+                             "': " + std::strerror(thisErrno) + ".");
+  }
+  myFinished = true;
+}
+
+std::uint64_t QS::ScenarioCache::getBuildId()
+{
+  static const std::uint64_t buildId = []()
+  {
+    // The binary containing this code: the engine library if it is shared,
+    // otherwise the executable it is linked into.
+    Dl_info info;
+    std::vector<std::string> candidates;
+    if (::dladdr(reinterpret_cast<void*>(&QS::ScenarioCache::getBuildId),
+                 &info) != 0 && nullptr != info.dli_fname)
+    {
+      candidates.push_back(info.dli_fname);
+    }
+    candidates.push_back("/proc/self/exe");
+
+    for (const auto &candidate : candidates)
+    {
+      try
+      {
+        return getKey({candidate});
+      }
+      catch (const std::runtime_error&)
+      {
+        // Executables found on the PATH are named relative to it, try the
+        // next candidate.
+      }
+    }
+    return static_cast<std::uint64_t>(0);
+  }();
+  return buildId;
+}
+
+std::string QS::ScenarioCache::getDirectory()
+{
+  return glbDirectory;
+}
+
+std::string QS::ScenarioCache::getFileName(
+  const std::string &theSimulationFile, std::uint64_t theKey)
+{
+  auto slash = theSimulationFile.find_last_of('/');
+  auto name = theSimulationFile.substr(
+    std::string::npos == slash ? 0 : slash + 1);
+  if (name.size() > 4 && name.compare(name.size() - 4, 4, ".xml") == 0)
+  {
+    name.resize(name.size() - 4);
+  }
+
+  char key[17];
+  std::snprintf(key, sizeof(key), "%016llx",
+                static_cast<unsigned long long>(theKey));
+  return glbDirectory + "/" + name + "-" + key + ".qsc";
+}
+
+std::uint64_t QS::ScenarioCache::getKey(
+  const std::vector<std::string> &theFiles,
+  const std::vector<std::string> &theTexts)
+{
+  std::uint64_t hash = 14695981039346656037ull;
+  auto add = [&](const char *theData, std::size_t theSize)
+  {
+    for (std::size_t ii = 0; ii < theSize; ++ii)
+    {
+      hash ^= static_cast<unsigned char>(theData[ii]);
+      hash *= 1099511628211ull;
+    }
+  };
+
+  char buffer[65536];
+  for (const auto &fileName : theFiles)
+  {
+    // The name separates one file from the next.
+    add(fileName.c_str(), fileName.size() + 1);
+
+    std::ifstream file(fileName, std::ios::binary);
+    if (! file.is_open())
+    {
+      throw std::runtime_error("Failed to open '" + fileName +
+                               "' for scenario cache key.");
+    }
+    while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0)
+    {
+      add(buffer, file.gcount());
+    }
+    if (file.bad())
+    {
+      throw std::runtime_error("Failed to read '" + fileName +
+                               "' for scenario cache key.");
+    }
+  }
+  for (const auto &text : theTexts)
+  {
+    // Terminated, like the file names, so texts can't run into each other.
+    add(text.c_str(), text.size() + 1);
+  }
+  return hash;
+}
+
+std::uint32_t QS::ScenarioCache::getStringId(const std::string &theString)
+{
+  auto id = myStringIds.find(theString);
+  if (id == myStringIds.end())
+  {
+    id = myStringIds.emplace(theString, myStrings.size()).first;
+    myStrings.push_back(theString);
+  }
+  return id->second;
+}
+
+bool QS::ScenarioCache::load(const std::string &theFileName,
+                             std::uint64_t theKey, World &theWorld,
+                             const EntityFunction &theActorFunction,
+                             const EntityFunction &theExitFunction)
+{
+  // Any problem with the file (it is missing, was written by another
+  // version or build, or is corrupt) is a cache miss. The simulation is then
+  // read and the cache rewritten.
+  auto descriptor = ::open(theFileName.c_str(), O_RDONLY);
+  if (descriptor < 0)
+  {
+    return false;
+  }
+  Finally descriptorClose([=]() {::close(descriptor);});
+
+  struct stat status;
+  if (::fstat(descriptor, &status) != 0 ||
+      static_cast<std::size_t>(status.st_size) < glbHeaderSize)
+  {
+    return false;
+  }
+  std::size_t size = status.st_size;
+
+  void *mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+  if (MAP_FAILED == mapping)
+  {
+    return false;
+  }
+  Finally unmap([=]() {::munmap(mapping, size);});
+  const char *data = static_cast<const char*>(mapping);
+
+  Reader header(data, data + glbHeaderSize);
+  header.read<std::uint64_t>(); // Magic, compared below
+  auto version = header.read<std::uint32_t>();
+  header.read<std::uint32_t>();
+  auto key = header.read<std::uint64_t>();
+  auto buildId = header.read<std::uint64_t>();
+  auto stringTableOffset = header.read<std::uint64_t>();
+  if (std::memcmp(data, glbMagic, sizeof(glbMagic)) != 0 ||
+      version != VERSION || key != theKey || buildId != getBuildId() ||
+      stringTableOffset < glbHeaderSize || stringTableOffset > size)
+  {
+    return false;
+  }
+
+  std::vector<std::string> strings;
+  Reader stringTable(data + stringTableOffset, data + size);
+  try
+  {
+    strings.resize(stringTable.read<std::uint32_t>());
+    for (auto &string : strings)
+    {
+      string = stringTable.readString();
+    }
+  }
+  catch (const std::exception&)
+  {
+    return false;
+  }
+
+  // The records are read twice: first to check the whole file can be read,
+  // so that a corrupt one changes nothing, then to set up the World.
+  Reader records(data + glbHeaderSize, data + stringTableOffset);
+  try
+  {
+    readRecords(records, strings, nullptr, nullptr, nullptr);
+  }
+  catch (const std::exception&)
+  {
+    return false;
+  }
+
+  records = Reader(data + glbHeaderSize, data + stringTableOffset);
+  try
+  {
+    readRecords(records, strings, &theWorld, &theActorFunction,
+                &theExitFunction);
+  }
+  catch (const std::exception &exception)
+  {
+    throw std::runtime_error("Error loading scenario cache file '" +
+                             theFileName + "': " + exception.what());
+  }
+  return true;
+}
+
+void QS::ScenarioCache::setDimensions(float theWidth_m, float theLength_m)
+{
+  write(Record::Dimensions);
+  write(theWidth_m);
+  write(theLength_m);
+}
+
+void QS::ScenarioCache::setSeed(std::uint64_t theSeed)
+{
+  write(Record::Seed);
+  write(theSeed);
+}
+
+void QS::ScenarioCache::setTimeSeries(const std::string &theFile,
+                                      const std::string &theFormat,
+                                      float theInterval_s,
+                                      float theDensityRadius_m)
+{
+  write(Record::TimeSeries);
+  writeString(theFile);
+  writeString(theFormat);
+  write(theInterval_s);
+  write(theDensityRadius_m);
+}
+
+template<class T>
+void QS::ScenarioCache::write(T theValue)
+{
+  myOutput.write(reinterpret_cast<const char*>(&theValue), sizeof(theValue));
+}
+
+void QS::ScenarioCache::writeEntity(
+  const SimulationEntityConfiguration &theConfiguration)
+{
+  write(getStringId(theConfiguration.getType()));
+  write(getStringId(theConfiguration.getSource()));
+  write(getStringId(theConfiguration.getTag()));
+
+  const auto &properties = theConfiguration.getProperties();
+  write(static_cast<std::uint32_t>(properties.size()));
+  for (const auto &property : properties)
+  {
+    write(getStringId(property.first));
+    writeString(property.second);
+  }
+
+  const auto &dependencies = theConfiguration.getDependencyConfigurations();
+  write(static_cast<std::uint32_t>(dependencies.size()));
+  for (const auto &dependency : dependencies)
+  {
+    writeEntity(dependency);
+  }
+}
+
+void QS::ScenarioCache::writeString(const std::string &theString)
+{
+  write(static_cast<std::uint32_t>(theString.size()));
+  myOutput.write(theString.data(), theString.size());
+}
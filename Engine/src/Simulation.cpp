@@ -6,8 +6,12 @@
  */
 
 #include <memory>
+#include <string>
+#include <vector>
 #include "PluginCollection.h"
+#include "ScenarioCache.h"
 #include "Simulation.h"
+#include "SimulationEntityConfiguration.h"
 #include "SimulationReader.h"
 
 QS::Simulation::Simulation(const std::string &theBaseDir,
@@ -47,11 +51,68 @@ QS::World& QS::Simulation::getWorld() noexcept
 void QS::Simulation::readSimulation()
 {
   std::string simulationsDir{myBaseDir + "/simulations"};
-  std::unique_ptr<SimulationReader> simulationReader{
-    new SimulationReader(mySimulationConfigFile, simulationsDir,
-                         myEntityManager, myWorld)};
 
-  simulationReader->read();
+  // With caching enabled, a simulation which hasn't changed (nor have the
+  // schema or plugin definitions) is loaded from its compiled form rather
+  // than read. Otherwise it is recorded as it is read.
+  std::unique_ptr<ScenarioCache> scenarioCache;
+  bool loaded = false;
+  if (! ScenarioCache::getDirectory().empty())
+  {
+    std::vector<std::string> files{
+      mySimulationConfigFile,
+      simulationsDir + "/" + SimulationReader::SCHEMA_FILE};
+    auto pluginFiles = myPlugins->getConfigFiles();
+    files.insert(files.end(), pluginFiles.begin(), pluginFiles.end());
+    auto key = ScenarioCache::getKey(files,
+                                     myPlugins->getEmbeddedDefinitions());
+    auto cacheFile = ScenarioCache::getFileName(mySimulationConfigFile, key);
+
+    loaded = ScenarioCache::load(
+      cacheFile, key, myWorld,
+      [this](const SimulationEntityConfiguration &theConfiguration)
+      {
+        myWorld.addActor(myEntityManager->createActor(theConfiguration));
+      },
+      [this](const SimulationEntityConfiguration &theConfiguration)
+      {
+        myWorld.addExit(myEntityManager->createExit(theConfiguration));
+      });
+    if (! loaded)
+    {
+      try
+      {
+        scenarioCache.reset(new ScenarioCache(cacheFile, key));
+      }
+      catch (const std::runtime_error&)
+      {
+        // A cache which can't be written (i.e., the directory is missing)
+        // just means the next run reads the simulation again.
+      }
+    }
+  }
+
+  if (! loaded)
+  {
+    std::unique_ptr<SimulationReader> simulationReader{
+      new SimulationReader(mySimulationConfigFile, simulationsDir,
+                           myEntityManager, myWorld)};
+    simulationReader->setScenarioCache(scenarioCache.get());
+
+    simulationReader->read();
+
+    if (scenarioCache)
+    {
+      try
+      {
+        scenarioCache->finish(myWorld);
+      }
+      catch (const std::runtime_error&)
+      {
+        // As above, the simulation has been read regardless.
+      }
+    }
+  }
 
   myWorld.initializeActorMetrics();
   auto dimensions = myWorld.getDimensions();
@@ -24,7 +24,7 @@ void QS::SimulationEntityConfiguration::addDependencyConfiguration(
   myDependencyConfigurations.push_back(theEntityConfiguration);
 }
 
-std::vector<QS::SimulationEntityConfiguration>
+const std::vector<QS::SimulationEntityConfiguration>&
 QS::SimulationEntityConfiguration::getDependencyConfigurations() const noexcept
 {
   return myDependencyConfigurations;
@@ -37,23 +37,26 @@ void QS::SimulationEntityConfiguration::addProperty(
   myProperties[theProperty] = theValue;
 }
 
-QS::PluginEntity::Properties QS::SimulationEntityConfiguration::getProperties()
-  const noexcept
+const QS::PluginEntity::Properties&
+QS::SimulationEntityConfiguration::getProperties() const noexcept
 {
   return myProperties;
 }
 
-std::string QS::SimulationEntityConfiguration::getSource() const noexcept
+const std::string& QS::SimulationEntityConfiguration::getSource()
+  const noexcept
 {
   return mySource;
 }
 
-std::string QS::SimulationEntityConfiguration::getTag() const noexcept
+const std::string& QS::SimulationEntityConfiguration::getTag()
+  const noexcept
 {
   return myTag;
 }
 
-std::string QS::SimulationEntityConfiguration::getType() const noexcept
+const std::string& QS::SimulationEntityConfiguration::getType()
+  const noexcept
 {
   return myType;
 }
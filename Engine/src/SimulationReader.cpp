@@ -7,13 +7,15 @@
 
 #include <sstream>
 #include <stdexcept>
-#include "xercesc/sax2/SAX2XMLReader.hpp"
-#include "xercesc/sax2/XMLReaderFactory.hpp"
+#include <utility>
 #include "xercesc/util/XMLString.hpp"
 #include "xercesc/sax2/Attributes.hpp"
+#include "BinaryMetricsSink.h"
+#include "CSVMetricsSink.h"
 #include "EntityManager.h"
-#include "Finally.h"
+#include "ScenarioCache.h"
 #include "SimulationReader.h"
+#include "XMLParser.h"
 #include "XMLUtilities.h"
 #include "World.h"
 
@@ -26,6 +28,7 @@ QS::SimulationReader::SimulationReader(
   myConfigFile(theConfigFile),
   myEntityManager(theEntityManager),
   myPropertyGenerator(theWorld),
+  myScenarioCache(nullptr),
   mySimulationSchemaDirectory(theSimulationSchemaDirectory),
   myWorld(theWorld)
 {
@@ -35,19 +38,8 @@ void QS::SimulationReader::read()
 {
   try
   {
-    SAX2XMLReader* parser = XMLReaderFactory::createXMLReader();
-    Finally parserCleanup([=](){delete parser;});
     std::string schema = mySimulationSchemaDirectory + "/" + SCHEMA_FILE;
-    parser->loadGrammar(schema.c_str(), Grammar::SchemaGrammarType, true);
-    parser->setFeature(XMLUni::fgXercesUseCachedGrammarInParse, true);
-    parser->setFeature(XMLUni::fgSAX2CoreValidation, true);
-    parser->setFeature(XMLUni::fgSAX2CoreNameSpaces, true);
-    parser->setFeature(XMLUni::fgXercesSchemaFullChecking, true);
-
-    parser->setContentHandler(this);
-    parser->setErrorHandler(this);
-
-    parser->parse(myConfigFile.c_str());
+    XMLParser::parse(schema, myConfigFile, *this);
   }
   catch (const XMLException &exception)
   {
@@ -77,47 +69,104 @@ void QS::SimulationReader::read()
   }
 }
 
-void QS::SimulationReader::processProperty(const std::string &theProperty,
-                                           const std::string &theValue)
+QS::PoissonDiskSampler& QS::SimulationReader::getSampler(
+  const std::string &theRegion)
+{
+  auto sampler = mySamplers.find(theRegion);
+  if (sampler == mySamplers.end())
+  {
+    if (::strcasecmp(theRegion.c_str(), "world") == 0)
+    {
+      sampler = mySamplers.emplace(
+        theRegion, PoissonDiskSampler(myWorld, myEntityNumber)).first;
+    }
+    else
+    {
+      std::istringstream converter(theRegion);
+      Eigen::Vector2f minimum, maximum;
+      converter >> minimum.x() >> minimum.y() >> maximum.x() >> maximum.y();
+      if (! converter || ! (converter >> std::ws).eof())
+      {
+        throw std::logic_error("Invalid 'poissonPosition' region \"" +
+                               theRegion + "\", expected \"world\" or "
+                               "\"minX minY maxX maxY\".");
+      }
+      sampler = mySamplers.emplace(
+        theRegion,
+        PoissonDiskSampler(myWorld, minimum, maximum, myEntityNumber)).first;
+    }
+  }
+  return sampler->second;
+}
+
+QS::SimulationEntityConfiguration QS::SimulationReader::instantiate(
+  const EntityTemplate &theTemplate)
+{
+  SimulationEntityConfiguration configuration(
+    theTemplate.myType, theTemplate.myTag, theTemplate.mySource);
+  for (const auto &property : theTemplate.myProperties)
+  {
+    processProperty(configuration, theTemplate.myElementName,
+                    property.first, property.second);
+  }
+  for (const auto &dependency : theTemplate.myDependencies)
+  {
+    configuration.addDependencyConfiguration(instantiate(dependency));
+  }
+  return configuration;
+}
+
+void QS::SimulationReader::processProperty(
+  SimulationEntityConfiguration &theConfiguration,
+  const std::string &theElementName,
+  const std::string &theProperty,
+  const std::string &theValue)
 {
-  auto &entityConfig = myEntityConfigurations.top();
   // TODO: consider moving some of this into PropertyGenerator
-  if (::strcasecmp(theProperty.c_str(), "randPosition") == 0)
+  bool randPosition =
+    ::strcasecmp(theProperty.c_str(), "randPosition") == 0;
+  bool poissonPosition =
+    ::strcasecmp(theProperty.c_str(), "poissonPosition") == 0;
+  if (randPosition || poissonPosition)
   {
-    if ("Actor" != myCurrentEntityElementName)
+    if ("Actor" != theElementName && "ActorGroup" != theElementName)
     {
-      std::string error{"'randPosition' pseudo-property"};
+      std::string error{"'" + theProperty + "' pseudo-property"};
       error += "can only be used for Actors. Found use in " +
-        myCurrentEntityElementName + ".";
+        theElementName + ".";
       throw std::logic_error(error);
     }
 
+    float radius;
     try
     {
-      auto radiusString = entityConfig.getProperties().at("radius");
-      auto radius = std::stof(radiusString);
-      Eigen::Vector2f position = myWorld.getRandomActorPosition(radius, 10);
-      std::stringstream converter;
-      converter << std::fixed << position.x() << " "
-                << std::fixed << position.y();
-      std::string x, y;
-      converter >> x >> y;
-      entityConfig.addProperty("x", x);
-      entityConfig.addProperty("y", y);
+      auto radiusString = theConfiguration.getProperties().at("radius");
+      radius = std::stof(radiusString);
     }
     catch (const std::logic_error &e)
     {
-      std::string error{"Attempting to use 'randPosition' pseudo-property for "
-          "an Entity that does not have a radius defined, or has an invalid "
-          "radius."};
+      std::string error{"Attempting to use '" + theProperty +
+          "' pseudo-property for an Entity that does not have a radius "
+          "defined, or has an invalid radius."};
       throw std::logic_error(error);
     }
+
+    Eigen::Vector2f position = randPosition ?
+      myWorld.getRandomActorPosition(radius, 10, myEntityNumber) :
+      getSampler(theValue).getPosition(radius);
+    std::stringstream converter;
+    converter << std::fixed << position.x() << " "
+              << std::fixed << position.y();
+    std::string x, y;
+    converter >> x >> y;
+    theConfiguration.addProperty("x", x);
+    theConfiguration.addProperty("y", y);
   }
   else
   {
     std::string newValue = myPropertyGenerator.generateProperty(
-      theValue, myEntityConfigurations.top());
-    entityConfig.addProperty(theProperty, newValue);
+      theValue, theConfiguration);
+    theConfiguration.addProperty(theProperty, newValue);
   }
 }
 
@@ -127,33 +176,55 @@ void QS::SimulationReader::endElement(const XMLCh *const uri,
 {
   std::string elementName{XMLUtilities::cStr(localname).get()};
 
-  if ("Actor" == elementName)
+  if ("Actor" == elementName || "ActorGroup" == elementName)
   {
-    auto actorConfiguration = myEntityConfigurations.top();
-    auto newActor = myEntityManager->createActor(actorConfiguration);
-    myWorld.addActor(newActor);
-    myEntityConfigurations.pop();
-    myCurrentEntityElementName = "";
+    auto actorTemplate = std::move(myEntityTemplates.top());
+    myEntityTemplates.pop();
+    for (std::uint64_t index = 0; index < actorTemplate.myCount; ++index)
+    {
+      myPropertyGenerator.setEntity(myEntityNumber);
+      myPropertyGenerator.setIndex(index);
+      auto actorConfiguration = instantiate(actorTemplate);
+      auto newActor = myEntityManager->createActor(actorConfiguration);
+      myWorld.addActor(newActor);
+      if (myScenarioCache)
+      {
+        myScenarioCache->addActor(actorConfiguration);
+      }
+      ++myEntityNumber;
+    }
+    myPropertyGenerator.setIndex(0);
+    mySamplers.clear();
   }
   else if ("BehaviorSet" == elementName || "Behavior" == elementName ||
            "Sensor" == elementName)
   {
-    auto entityDependencyConfiguration = myEntityConfigurations.top();
-    myEntityConfigurations.pop();
-    myEntityConfigurations.top().addDependencyConfiguration(
-      entityDependencyConfiguration);
-    myCurrentEntityElementName = "";
+    auto dependencyTemplate = std::move(myEntityTemplates.top());
+    myEntityTemplates.pop();
+    myEntityTemplates.top().myDependencies.push_back(
+      std::move(dependencyTemplate));
   }
   else if ("Exit" == elementName)
   {
-    auto exitConfiguration = myEntityConfigurations.top();
+    myPropertyGenerator.setEntity(myEntityNumber);
+    auto exitConfiguration = instantiate(myEntityTemplates.top());
     auto newExit = myEntityManager->createExit(exitConfiguration);
     myWorld.addExit(newExit);
-    myEntityConfigurations.pop();
-    myCurrentEntityElementName = "";
+    if (myScenarioCache)
+    {
+      myScenarioCache->addExit(exitConfiguration);
+    }
+    myEntityTemplates.pop();
+    ++myEntityNumber;
   }
 }
 
+void QS::SimulationReader::setScenarioCache(
+  ScenarioCache *theScenarioCache) noexcept
+{
+  myScenarioCache = theScenarioCache;
+}
+
 void QS::SimulationReader::startElement(const XMLCh *const uri,
                                         const XMLCh *const localname,
                                         const XMLCh *const qname,
@@ -164,35 +235,85 @@ void QS::SimulationReader::startElement(const XMLCh *const uri,
   if ("Seed" == elementName)
   {
     auto seedString = XMLUtilities::getAttribute(attrs, "value");
-    myWorld.setSeed(std::stoull(seedString));
+    auto seed = std::stoull(seedString);
+    myWorld.setSeed(seed);
+    if (myScenarioCache)
+    {
+      myScenarioCache->setSeed(seed);
+    }
   }
   else if ("World" == elementName)
   {
     auto lengthString = XMLUtilities::getAttribute(attrs, "length");
     auto widthString = XMLUtilities::getAttribute(attrs, "width");
-    myWorld.setDimensions(std::stof(widthString), std::stof(lengthString));
+    auto width = std::stof(widthString);
+    auto length = std::stof(lengthString);
+    myWorld.setDimensions(width, length);
+    if (myScenarioCache)
+    {
+      myScenarioCache->setDimensions(width, length);
+    }
   }
-  else if ("Actor" == elementName || "BehaviorSet" == elementName ||
-           "Behavior" == elementName || "Sensor" == elementName ||
-           "Exit" == elementName)
+  else if ("TimeSeries" == elementName)
   {
-    myCurrentEntityElementName = elementName;
+    auto file = XMLUtilities::getAttribute(attrs, "file");
+    auto interval = std::stof(XMLUtilities::getAttribute(attrs, "interval"));
 
-    auto type = XMLUtilities::getAttribute(attrs, "type");
-    auto source = XMLUtilities::getAttribute(attrs, "source");
-    std::string tag;
+    // The schema defaults are only filled in when the file is validated (see
+    // XMLParser), so they're repeated here.
+    std::string format{"csv"};
+    float densityRadius = 1.0;
+    try
+    {
+      format = XMLUtilities::getAttribute(attrs, "format");
+    } catch (const std::invalid_argument&) {}
     try
     {
-      tag = XMLUtilities::getAttribute(attrs, "tag");
+      densityRadius = std::stof(
+        XMLUtilities::getAttribute(attrs, "densityRadius"));
+    } catch (const std::invalid_argument&) {}
+
+    std::shared_ptr<MetricsSink> sink;
+    if ("binary" == format)
+    {
+      sink.reset(new BinaryMetricsSink(file));
+    }
+    else
+    {
+      sink.reset(new CSVMetricsSink(file));
+    }
+    myWorld.setTimeSeriesSink(sink, interval, densityRadius);
+    if (myScenarioCache)
+    {
+      myScenarioCache->setTimeSeries(file, format, interval, densityRadius);
+    }
+  }
+  else if ("Actor" == elementName || "ActorGroup" == elementName ||
+           "BehaviorSet" == elementName || "Behavior" == elementName ||
+           "Sensor" == elementName || "Exit" == elementName)
+  {
+    EntityTemplate entityTemplate;
+    entityTemplate.myElementName = elementName;
+    entityTemplate.myType = XMLUtilities::getAttribute(attrs, "type");
+    entityTemplate.mySource = XMLUtilities::getAttribute(attrs, "source");
+    try
+    {
+      entityTemplate.myTag = XMLUtilities::getAttribute(attrs, "tag");
     } catch (...) {}
 
-    myEntityConfigurations.emplace(type, tag, source);
+    if ("ActorGroup" == elementName)
+    {
+      entityTemplate.myCount =
+        std::stoull(XMLUtilities::getAttribute(attrs, "count"));
+    }
+
+    myEntityTemplates.push(std::move(entityTemplate));
   }
   else if ("Property" == elementName)
   {
     std::string property = XMLUtilities::getAttribute(attrs, "key");
     std::string value = XMLUtilities::getAttribute(attrs, "value");
-    processProperty(property, value);
+    myEntityTemplates.top().myProperties.emplace_back(property, value);
   }
 }
 
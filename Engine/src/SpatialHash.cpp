@@ -5,6 +5,7 @@
  * @author Michael Albers
  */
 
+#include <algorithm>
 #include <cmath>
 #include <string>
 #include "Actor.h"
@@ -86,7 +87,10 @@ std::set<uint32_t> QS::SpatialHash::getBucketsForCircle(
   // is difficult. The trade-off is the bounding box will occasionally hash
   // the circle into a cell it doesn't actually overlap.
 
-  Eigen::Vector2f min(thePoint.x() - theRadius, thePoint.y() - theRadius);
+  // Clamped at the world origin, so the cell calculation doesn't see
+  // negative coordinates.
+  Eigen::Vector2f min(std::max(thePoint.x() - theRadius, 0.0f),
+                      std::max(thePoint.y() - theRadius, 0.0f));
   Cell cellMin = calculateCellForPoint(min);
 
   Eigen::Vector2f max(thePoint.x() + theRadius, thePoint.y() + theRadius);
@@ -97,6 +101,18 @@ std::set<uint32_t> QS::SpatialHash::getBucketsForCircle(
     // First case, circle is only in one cell.
     buckets.insert(calculateBucketForPoint(min));
   }
+  else if (cellMax.myX > cellMin.myX + 1 || cellMax.myY > cellMin.myY + 1)
+  {
+    // Circle is larger than a cell (only for queries, Actors are smaller
+    // than a cell), every cell of the bounding box is included.
+    for (auto y = cellMin.myY; y <= cellMax.myY; ++y)
+    {
+      for (auto x = cellMin.myX; x <= cellMax.myX; ++x)
+      {
+        buckets.insert(y * myNumberColumns + x);
+      }
+    }
+  }
   else if (cellMin.myX == cellMax.myX ||
            cellMin.myY == cellMax.myY)
   {
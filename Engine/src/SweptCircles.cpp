@@ -0,0 +1,219 @@
+/**
+ * @file SweptCircles.cpp
+ * @brief Definition of SweptCircles
+ *
+ * @author Michael Albers
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "SimdLanes.h"
+#include "SweptCircles.h"
+
+namespace
+{
+  /** Distance to a circle which is never touched. */
+  constexpr float glbNoContact = std::numeric_limits<float>::infinity();
+
+  /**
+   * Returns how far a circle can move along a direction before it touches
+   * another, stationary, circle.
+   *
+   * @param theX
+   *          x coordinate of the vector from the moving to the other circle
+   * @param theY
+   *          y coordinate of the vector from the moving to the other circle
+   * @param theSumRadii
+   *          sum of the radii of the circles
+   * @param theDirection
+   *          direction of motion, normalized
+   * @return distance, glbNoContact if the circle is behind or is missed
+   */
+  inline float contactDistance(float theX, float theY, float theSumRadii,
+                               Eigen::Vector2f theDirection) noexcept
+  {
+    // Distance along the direction to the point closest to the other circle.
+    float D = theX * theDirection.x() + theY * theDirection.y();
+    // Square of the sum of the radii less the square of the closest distance
+    // between the centers (F in the sequential version).
+    float T = theSumRadii * theSumRadii - (theX * theX + theY * theY - D * D);
+    return (D > 0.0 && T > 0.0) ? D - std::sqrt(T) : glbNoContact;
+  }
+
+  /**
+   * Returns the smallest contactDistance to any of the circles, several
+   * circles at a time with whichever SIMD instructions the build targets.
+   *
+   * @param theX
+   *          x coordinate of each circle
+   * @param theY
+   *          y coordinate of each circle
+   * @param theRadii
+   *          radius of each circle
+   * @param theCount
+   *          number of circles
+   * @param thePosition
+   *          position of the moving circle
+   * @param theRadius
+   *          radius of the moving circle
+   * @param theDirection
+   *          direction of motion, normalized
+   * @return distance, glbNoContact if no circle is touched
+   */
+  float minimumContactDistance(const float *theX, const float *theY,
+                               const float *theRadii, std::size_t theCount,
+                               Eigen::Vector2f thePosition, float theRadius,
+                               Eigen::Vector2f theDirection) noexcept
+  {
+    using L = QS::SimdLanes;
+    const L::Floats positionX = L::set(thePosition.x());
+    const L::Floats positionY = L::set(thePosition.y());
+    const L::Floats radius = L::set(theRadius);
+    const L::Floats directionX = L::set(theDirection.x());
+    const L::Floats directionY = L::set(theDirection.y());
+    const L::Floats zero = L::set(0.0);
+    const L::Floats noContact = L::set(glbNoContact);
+    L::Floats minimums = noContact;
+    std::size_t index = 0;
+    for (; index + L::LANES <= theCount; index += L::LANES)
+    {
+      // As contactDistance.
+      L::Floats x = L::sub(L::load(theX + index), positionX);
+      L::Floats y = L::sub(L::load(theY + index), positionY);
+      L::Floats sumRadii = L::add(L::load(theRadii + index), radius);
+      L::Floats D = L::add(L::mul(x, directionX), L::mul(y, directionY));
+      L::Floats distanceSquared = L::add(L::mul(x, x), L::mul(y, y));
+      L::Floats T = L::sub(L::mul(sumRadii, sumRadii),
+                           L::sub(distanceSquared, L::mul(D, D)));
+      L::Floats distance = L::sub(D, L::sqrt(L::max(T, zero)));
+      // No contact with circles behind (D <= 0) or missed (T <= 0).
+      L::Floats hit = L::select(L::greater(D, zero), distance, noContact);
+      minimums = L::min(minimums, L::select(L::greater(T, zero), hit,
+                                            noContact));
+    }
+    float minimum = L::minimum(minimums);
+
+    // Whatever doesn't fill a whole vector.
+    for (; index < theCount; ++index)
+    {
+      minimum = std::min(minimum, contactDistance(
+                           theX[index] - thePosition.x(),
+                           theY[index] - thePosition.y(),
+                           theRadii[index] + theRadius, theDirection));
+    }
+    return minimum;
+  }
+}
+
+void QS::SweptCircles::add(Eigen::Vector2f thePosition, float theRadius)
+{
+  myPositionsX.push_back(thePosition.x());
+  myPositionsY.push_back(thePosition.y());
+  myRadii.push_back(theRadius);
+}
+
+void QS::SweptCircles::clear() noexcept
+{
+  myPositionsX.clear();
+  myPositionsY.clear();
+  myRadii.clear();
+}
+
+Eigen::Vector2f QS::SweptCircles::clip(Eigen::Vector2f thePosition,
+                                       float theRadius,
+                                       Eigen::Vector2f theMotionVector) const
+  noexcept
+{
+  float motionVectorLength = theMotionVector.norm();
+  if (myRadii.empty() || 0.0 == motionVectorLength)
+  {
+    return theMotionVector;
+  }
+
+  // Clipping against each circle in turn only ever shortens the motion
+  // vector to the distance to that circle, so the result is the shortest
+  // of those distances.
+  Eigen::Vector2f direction = theMotionVector / motionVectorLength;
+  float distance = minimumContactDistance(
+    myPositionsX.data(), myPositionsY.data(), myRadii.data(), myRadii.size(),
+    thePosition, theRadius, direction);
+  if (motionVectorLength >= distance)
+  {
+    theMotionVector = direction * distance;
+  }
+  return theMotionVector;
+}
+
+Eigen::Vector2f QS::SweptCircles::clipSequential(
+  Eigen::Vector2f thePosition,
+  float theRadius,
+  Eigen::Vector2f theMotionVector) const noexcept
+{
+  for (auto index = 0u; index < myRadii.size(); ++index)
+  {
+    // Have to recalculate each time as it could have been clipped in the
+    // previous iteration.
+    float motionVectorLength = theMotionVector.norm();
+    Eigen::Vector2f vectorBetweenActors =
+      Eigen::Vector2f(myPositionsX[index], myPositionsY[index]) -
+      thePosition;
+
+    // First check if the length of the motion vector is enough to cause an
+    // collision.
+    float distanceBetweenActors = vectorBetweenActors.norm();
+    float sumRadii = myRadii[index] + theRadius;
+    if (motionVectorLength < distanceBetweenActors - sumRadii)
+    {
+      continue;
+    }
+
+    Eigen::Vector2f N = theMotionVector;
+    N.normalize();
+    float D = N.dot(vectorBetweenActors);
+
+    // Check if the moving circle is moving towards the other. If D <= 0, it
+    // isn't.
+    if (D <= 0.0)
+    {
+      continue;
+    }
+
+    // Check if the closest the moving circle will get to the other is enough
+    // to cause a collision.
+    float F = (distanceBetweenActors * distanceBetweenActors) -
+      (D * D);
+    float sumRadiiSquared = sumRadii * sumRadii;
+    if (F >= sumRadiiSquared)
+    {
+      continue;
+    }
+
+    // No such right triange with sides of length sumRadiiSquared and F. Avoids
+    // sqrt of a negative number.
+    float T = sumRadiiSquared - F;
+    if (T < 0)
+    {
+      continue;
+    }
+
+    float distance = D - std::sqrt(T);
+
+    // If the motion vector is less than the clipping distance, then there is
+    // no collision.
+    if (motionVectorLength < distance)
+    {
+      continue;
+    }
+
+    theMotionVector.normalize();
+    theMotionVector *= distance;
+  }
+
+  return theMotionVector;
+}
+
+std::size_t QS::SweptCircles::size() const noexcept
+{
+  return myRadii.size();
+}
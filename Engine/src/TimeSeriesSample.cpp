@@ -0,0 +1,13 @@
+/**
+ * @file TimeSeriesSample.cpp
+ * @brief Definition of TimeSeriesSample
+ *
+ * @author Michael Albers
+ */
+
+#include "TimeSeriesSample.h"
+
+constexpr std::size_t QS::TimeSeriesSample::NUMBER_DENSITY_PERCENTILES;
+
+constexpr std::array<float, QS::TimeSeriesSample::NUMBER_DENSITY_PERCENTILES>
+QS::TimeSeriesSample::DENSITY_PERCENTILES;
@@ -5,21 +5,70 @@
  * @author Michael Albers
  */
 
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
+#include <unordered_map>
 #include "Eigen/Core"
 #include "Actor.h"
+#include "ActorBatch.h"
 #include "ActorMetrics.h"
 #include "ActorUpdateCallback.h"
+#include "BehaviorSet.h"
 #include "EigenHelper.h"
 #include "Exit.h"
+#include "FrameProfiler.h"
 #include "Metrics.h"
+#include "PerfCounters.h"
+#include "RandomStream.h"
 #include "Sensable.h"
 #include "SpatialHash.h"
+#include "SweptCircles.h"
+#include "Tracer.h"
 #include "World.h"
 
+namespace
+{
+  /** Whether Actors may be evaluated in batches. */
+  bool glbBatchEvaluation = false;
+
+  /** Whether collisions are resolved in parallel. */
+  bool glbParallelCollisions = false;
+
+  /**
+   * Rounds of clipping overlapping Actors against each other in parallel
+   * collision resolution, before those still overlapping are stopped.
+   */
+  constexpr unsigned int glbCollisionRounds = 4;
+
+  /**
+   * Per Actor phases are timed for one in this many Actors (see
+   * FrameProfiler::setSampleWeight).
+   */
+  constexpr std::uint32_t glbProfileSampleInterval = 16;
+
+  /**
+   * Sets the FrameProfiler sample weight for the Actor with the given
+   * position in the update, so that one in glbProfileSampleInterval Actors
+   * is timed. The sampled Actors change from frame to frame.
+   *
+   * @param theActorNumber
+   *          position of the Actor in the update
+   * @param theFrame
+   *          update number
+   */
+  void sampleActor(std::size_t theActorNumber, std::uint32_t theFrame)
+  {
+#ifdef QS_PROFILER_ENABLED
+    QS::FrameProfiler::setSampleWeight(
+      (theActorNumber + theFrame) % glbProfileSampleInterval == 0 ?
+      glbProfileSampleInterval : 0);
+#endif
+  }
+}
+
 QS::World::World(Metrics &theMetrics) :
   myMetrics(theMetrics)
 {
@@ -29,6 +78,9 @@ void QS::World::addActor(Actor *theActor)
 {
   ++myNumberAttemptedActorAdds;
   checkInitialPlacement(theActor);
+  myPlacementIndex.addActor(theActor);
+  theActor->setRandomNumberGenerator(myRNG, myActors.size());
+  myActorsInWorldIndexes.push_back(myActors.size());
   myActors.push_back(theActor);
   myActorsInWorld.push_back(theActor);
   myActorAverageDiameter += theActor->getRadius() * 2;
@@ -63,6 +115,7 @@ void QS::World::addExit(Exit *theExit)
 
   myExits.push_back(theExit);
   myExitsForSensable.push_back(theExit);
+  myExitCounts.push_back(0);
 }
 
 void QS::World::checkInitialPlacement(const Actor *theActor) const
@@ -81,35 +134,7 @@ void QS::World::checkInitialPlacement(const Actor *theActor) const
     throw std::logic_error(error.str());
   }
 
-  int duplicateIndex = -1;
-  std::vector<std::decltype(myActors)::size_type> overlappedActorIndexes;
-  auto numActors = myActors.size();
-
-#pragma omp parallel for shared(duplicateIndex, overlappedActorIndexes)
-  for (auto actorIndex = 0u; actorIndex < numActors; ++actorIndex)
-  {
-    Actor *currentActor = myActors[actorIndex];
-
-    // Check if actor is already in the world
-    if (theActor == currentActor)
-    {
-      duplicateIndex = actorIndex;
-    }
-
-    // Check if actor overlaps another actor
-    bool overlap = checkOverlap(
-      currentActor->getPosition(), currentActor->getRadius(),
-      actorPosition, actorRadius);
-    if (overlap)
-    {
-#pragma omp critical
-      {
-        overlappedActorIndexes.push_back(actorIndex);
-      }
-    }
-  }
-
-  if (duplicateIndex >= 0)
+  if (myPlacementIndex.contains(theActor))
   {
     std::ostringstream error;
     error << "On attempted Actor add number " << myNumberAttemptedActorAdds
@@ -119,6 +144,10 @@ void QS::World::checkInitialPlacement(const Actor *theActor) const
     throw std::logic_error(error.str());
   }
 
+  // The placement index has a circle for each Actor in myActors, in the same
+  // order, so this only compares against nearby Actors.
+  auto overlappedActorIndexes = myPlacementIndex.getOverlaps(actorPosition,
+                                                             actorRadius);
   if (! overlappedActorIndexes.empty())
   {
     std::ostringstream error;
@@ -152,10 +181,9 @@ bool QS::World::checkOverlap(Eigen::Vector2f thePosition1, float theRadius1,
   return overlap;
 }
 
-Eigen::Vector2f QS::World::collisionDetection(
-  Actor *theActor,
-  Eigen::Vector2f theMotionVector,
-  SpatialHash &theHash) const
+Eigen::Vector2f QS::World::clipToWorld(const Actor *theActor,
+                                        Eigen::Vector2f theMotionVector) const
+  noexcept
 {
   float actorRadius = theActor->getRadius();
   Eigen::Vector2f actorPosition = theActor->getPosition();
@@ -181,87 +209,51 @@ Eigen::Vector2f QS::World::collisionDetection(
     theMotionVector.y() = 0.0 - (actorPosition.y() - actorRadius);
   }
 
+  return theMotionVector;
+}
+
+Eigen::Vector2f QS::World::collisionDetection(
+  const Actor *theActor,
+  Eigen::Vector2f theMotionVector,
+  SpatialHash &theHash,
+  SweptCircles &theNeighbors) const
+{
+  float actorRadius = theActor->getRadius();
+  Eigen::Vector2f actorPosition = theActor->getPosition();
+
+  theMotionVector = clipToWorld(theActor, theMotionVector);
+
   Eigen::Vector2f possibleNewPosition = actorPosition + theMotionVector;
   std::set<const Actor*> possibleCollisionActors = theHash.getActors(
     possibleNewPosition, actorRadius);
 
-  // Check for collisions with other Actors.
+  // Check for collisions with other Actors, all at once.
+  theNeighbors.clear();
   for (const Actor *collidedActor : possibleCollisionActors)
   {
     // Don't check theActor against itself.
-    if (theActor == collidedActor)
-    {
-      continue;
-    }
-
-    if (theMotionVector.x() < EigenHelper::FLOAT_TOLERANCE &&
-        theMotionVector.x() > -EigenHelper::FLOAT_TOLERANCE &&
-        theMotionVector.y() < EigenHelper::FLOAT_TOLERANCE &&
-        theMotionVector.y() > -EigenHelper::FLOAT_TOLERANCE)
-    {
-      // At this point the Actor is essentially not moving, so just skip the
-      // rest of the collision detection and return a motionless motion vector.
-      theMotionVector << 0.0, 0.0;
-      return theMotionVector;
-    }
-
-    // Collision detection/resolution taken from:
-    // http://www.gamasutra.com/view/feature/131424/pool_hall_lessons_fast_accurate_.php?page=2
-
-    // Have to recalculate each time as it could have been clipped in the
-    // previous iteration.
-    float motionVectorLength = theMotionVector.norm();
-    Eigen::Vector2f vectorBetweenActors =
-      collidedActor->getPosition() - actorPosition;
-
-    // First check if the length of the motion vector is enough to cause an
-    // collision.
-    float distanceBetweenActors = vectorBetweenActors.norm();
-    float sumRadii = collidedActor->getRadius() + actorRadius;
-    if (motionVectorLength < distanceBetweenActors - sumRadii)
-    {
-      continue;
-    }
-
-    Eigen::Vector2f N = theMotionVector;
-    N.normalize();
-    float D = N.dot(vectorBetweenActors);
-
-    // Check if theActor is moving towards collidedActor. If D <= 0, it isn't.
-    if (D <= 0.0)
+    if (theActor != collidedActor)
     {
-      continue;
+      theNeighbors.add(collidedActor->getPosition(),
+                       collidedActor->getRadius());
     }
+  }
+  if (0 == theNeighbors.size())
+  {
+    return theMotionVector;
+  }
 
-    // Check if the closest theActor will get to collidedActor is enough to
-    // cause a collision.
-    float F = (distanceBetweenActors * distanceBetweenActors) -
-      (D * D);
-    float sumRadiiSquared = sumRadii * sumRadii;
-    if (F >= sumRadiiSquared)
-    {
-      continue;
-    }
-
-    // No such right triange with sides of length sumRadiiSquared and F. Avoids
-    // sqrt of a negative number.
-    float T = sumRadiiSquared - F;
-    if (T < 0)
-    {
-      continue;
-    }
-
-    float distance = D - std::sqrt(T);
-
-    // If the motion vector is less than the clipping distance, then there is
-    // no collision.
-    if (motionVectorLength < distance)
-    {
-      continue;
-    }
+  theMotionVector = theNeighbors.clip(actorPosition, actorRadius,
+                                      theMotionVector);
 
-    theMotionVector.normalize();
-    theMotionVector *= distance;
+  if (theMotionVector.x() < EigenHelper::FLOAT_TOLERANCE &&
+      theMotionVector.x() > -EigenHelper::FLOAT_TOLERANCE &&
+      theMotionVector.y() < EigenHelper::FLOAT_TOLERANCE &&
+      theMotionVector.y() > -EigenHelper::FLOAT_TOLERANCE)
+  {
+    // At this point the Actor is essentially not moving, so return a
+    // motionless motion vector.
+    theMotionVector << 0.0, 0.0;
   }
 
   return theMotionVector;
@@ -287,6 +279,131 @@ Eigen::Vector2f QS::World::convertPointToWorld(const Actor *theActor,
   return worldPoint;
 }
 
+QS::TimeSeriesSample QS::World::createTimeSeriesSample(SpatialHash &theHash)
+  const
+{
+  TimeSeriesSample sample;
+  auto numberActors = myActorsInWorld.size();
+  sample.myNumberActorsRemaining = numberActors;
+  sample.myExitCounts = myExitCounts;
+
+  if (0 == numberActors)
+  {
+    return sample;
+  }
+
+  float radius = myTimeSeriesDensityRadius_m;
+  float radiusSquared = radius * radius;
+  float area = M_PI * radiusSquared;
+
+  float totalSpeed = 0.0;
+  std::vector<float> densities;
+  densities.reserve(numberActors);
+  for (auto actor : myActorsInWorld)
+  {
+    totalSpeed += actor->getVelocity().norm();
+
+    Eigen::Vector2f position = actor->getPosition();
+    // Count includes the Actor itself.
+    uint32_t count = 0;
+    for (auto neighbor : theHash.getActors(position, radius))
+    {
+      if ((neighbor->getPosition() - position).squaredNorm() <= radiusSquared)
+      {
+        ++count;
+      }
+    }
+    densities.push_back(count / area);
+  }
+  sample.myMeanSpeed = totalSpeed / numberActors;
+
+  std::sort(densities.begin(), densities.end());
+  for (auto ii = 0u; ii < TimeSeriesSample::NUMBER_DENSITY_PERCENTILES; ++ii)
+  {
+    // Nearest rank percentile.
+    float percentile = TimeSeriesSample::DENSITY_PERCENTILES[ii];
+    std::size_t rank = std::ceil(percentile / 100.0 * numberActors);
+    rank = std::max<std::size_t>(rank, 1);
+    sample.myDensityPercentiles[ii] = densities[rank - 1];
+  }
+
+  return sample;
+}
+
+void QS::World::disableBatchEvaluation() noexcept
+{
+  glbBatchEvaluation = false;
+}
+
+void QS::World::disableParallelCollisions() noexcept
+{
+  glbParallelCollisions = false;
+}
+
+void QS::World::enableBatchEvaluation() noexcept
+{
+  glbBatchEvaluation = true;
+}
+
+void QS::World::enableParallelCollisions() noexcept
+{
+  glbParallelCollisions = true;
+}
+
+void QS::World::evaluateBatches(float theIntervalInSeconds,
+                                std::vector<Eigen::Vector2f> &theForces,
+                                std::vector<bool> &theEvaluated)
+{
+  theForces.assign(myActorsInWorld.size(), Eigen::Vector2f::Zero());
+  theEvaluated.assign(myActorsInWorld.size(), false);
+
+  // Groups are kept in the order their BehaviorSets are first selected, so
+  // the order of evaluation doesn't depend on object addresses.
+  std::vector<BehaviorSet*> behaviorSets;
+  std::vector<std::vector<std::size_t>> groups;
+  std::unordered_map<BehaviorSet*, std::size_t> groupIndexes;
+  for (auto index = 0u; index < myActorsInWorld.size(); ++index)
+  {
+    // See update for why the cast.
+    Actor *actor = const_cast<Actor*>(myActorsInWorld[index]);
+    if (actor->canEvaluateInBatch())
+    {
+      Sensable sensable(actor, myActorsInWorld, myExitsForSensable,
+                        theIntervalInSeconds);
+      BehaviorSet *behaviorSet = actor->selectBehaviorSet(sensable);
+      if (! behaviorSet->getCapabilities().myBatchEvaluation)
+      {
+        continue;
+      }
+      auto group = groupIndexes.find(behaviorSet);
+      if (group == groupIndexes.end())
+      {
+        group = groupIndexes.emplace(behaviorSet, groups.size()).first;
+        behaviorSets.push_back(behaviorSet);
+        groups.emplace_back();
+      }
+      groups[group->second].push_back(index);
+    }
+  }
+
+  if (groups.empty())
+  {
+    return;
+  }
+
+  ActorBatch batch(myActorsInWorld);
+  for (auto ii = 0u; ii < groups.size(); ++ii)
+  {
+    if (behaviorSets[ii]->evaluateBatch(groups[ii], batch, theForces))
+    {
+      for (auto index : groups[ii])
+      {
+        theEvaluated[index] = true;
+      }
+    }
+  }
+}
+
 void QS::World::finalizeMetrics() const noexcept
 {
   myMetrics.finalizeActorMetrics(myActors);
@@ -315,7 +432,8 @@ const std::vector<QS::Exit*>& QS::World::getExits() const noexcept
 }
 
 Eigen::Vector2f QS::World::getRandomActorPosition(float theRadius,
-                                                  uint32_t theMaxAttempts)
+                                                  uint32_t theMaxAttempts,
+                                                  uint32_t theEntity)
 {
   if (theRadius > myWidth_m || theRadius > myLength_m)
   {
@@ -326,37 +444,20 @@ Eigen::Vector2f QS::World::getRandomActorPosition(float theRadius,
     throw std::invalid_argument(error.str());
   }
 
-  std::uniform_real_distribution<float> xDistribution(theRadius,
-                                                      myWidth_m - theRadius);
-  std::uniform_real_distribution<float> yDistribution(theRadius,
-                                                      myLength_m - theRadius);
+  RandomStream random(myRNG, theEntity, CounterRNG::PLACEMENT);
 
   // Distributions are guaranteed to fit within the world boundaries, so we
   // just need to check against the other actors.
   bool foundPosition = false;
   Eigen::Vector2f position;
-  auto numActors = myActors.size();
   uint32_t attempt = 0;
   while (! foundPosition && attempt < theMaxAttempts)
   {
-    float x = getRandomNumber(xDistribution);
-    float y = getRandomNumber(yDistribution);
+    float x = random.uniform(theRadius, myWidth_m - theRadius);
+    float y = random.uniform(theRadius, myLength_m - theRadius);
     position << x, y;
 
-    bool foundOverlap = false;
-#pragma omp parallel for shared(foundOverlap)
-    for (auto index = 0u; index < numActors; ++index)
-    {
-      Actor *actor = myActors[index];
-      bool overlap = checkOverlap(position, theRadius,
-                                  actor->getPosition(), actor->getRadius());
-      if (overlap)
-      {
-        foundOverlap = true;
-      }
-    }
-
-    if (! foundOverlap)
+    if (! myPlacementIndex.overlaps(position, theRadius))
     {
       foundPosition = true;
     }
@@ -378,10 +479,16 @@ Eigen::Vector2f QS::World::getRandomActorPosition(float theRadius,
   return position;
 }
 
-float QS::World::getRandomNumber(
-  std::uniform_real_distribution<float> &theDistribution) noexcept
+std::string QS::World::getRandomState() const
 {
-  return theDistribution(myRNGEngine);
+  std::ostringstream state;
+  state << myRNG.getSeed() << " " << myRNG.getFrame();
+  return state.str();
+}
+
+const QS::CounterRNG& QS::World::getRNG() const noexcept
+{
+  return myRNG;
 }
 
 void QS::World::initializeActorMetrics() noexcept
@@ -389,6 +496,58 @@ void QS::World::initializeActorMetrics() noexcept
   myMetrics.initializeActorMetrics(myActors);
 }
 
+QS::World::Motion QS::World::integrate(const Actor *theActor,
+                                      Eigen::Vector2f theSteeringForce,
+                                      float theIntervalInSeconds) const
+  noexcept
+{
+  float maxForce = theActor->getMaximumForce();
+  Eigen::Vector2f steeringForce = EigenHelper::truncate(theSteeringForce,
+                                                        maxForce);
+
+  float mass = theActor->getMass();
+  // Pretend the steering force is in (g*m)/(s*s) (almost newtons, just
+  // not kilograms). Dividing force by mass gives acceleration in m/(s*s).
+  Eigen::Vector2f acceleration = steeringForce / mass;
+
+  Eigen::Vector2f currentVelocity = theActor->getVelocity();
+  float maxSpeed = theActor->getMaximumSpeed();
+  // Multiplying acceleration by time gives m/s.
+  Eigen::Vector2f newVelocity = currentVelocity +
+    (acceleration * theIntervalInSeconds);
+  newVelocity = EigenHelper::truncate(newVelocity, maxSpeed);
+
+  float newOrientation = theActor->getOrientation();
+  // If the Actor is staying stationary, the orientation goes to -nan, and
+  // this causes the Actor to not be drawn.
+  if (newVelocity.norm() != 0.0)
+  {
+    Eigen::Vector2f base{1.0, 0.0};
+    Eigen::Vector2f normalizedVelocity = newVelocity;
+    normalizedVelocity.normalize();
+    newOrientation = std::acos(normalizedVelocity.dot(base));
+  }
+
+  // acos(Dot product) gives a value between 0 & PI. So if the Actor is
+  // oriented at, say, 270 degrees (3 * PI / 2 radians) the value is PI/2.
+  // This corrects for "downward" pointing Actors. It is a simplification of
+  // the code in the question at:
+  // http://gamedev.stackexchange.com/questions/45412/understanding-math-used-to-determine-if-vector-is-clockwise-counterclockwise-f
+  // The extra math can be removed since the 'base' value above is {1,0}.
+  if (newVelocity.y() < 0)
+  {
+    newOrientation = 2 * M_PI - newOrientation;
+  }
+
+  Motion motion;
+  // Multiplying velocity by time gives a vector, in meters, to where the
+  // Actor, ideally, will move.
+  motion.myMotionVector = newVelocity * theIntervalInSeconds;
+  motion.myOrientation = newOrientation;
+  motion.myVelocity = newVelocity;
+  return motion;
+}
+
 template<class T>
 bool QS::World::isInWorld(const T &theEntity) const noexcept
 {
@@ -406,129 +565,404 @@ bool QS::World::isInWorld(const T &theEntity) const noexcept
   return isInWorld;
 }
 
+bool QS::World::overlapsActor(Eigen::Vector2f thePosition, float theRadius)
+  const noexcept
+{
+  return myPlacementIndex.overlaps(thePosition, theRadius);
+}
+
+std::vector<QS::World::Motion> QS::World::resolveCollisions(
+  const std::vector<Eigen::Vector2f> &theForces,
+  float theIntervalInSeconds) const
+{
+  auto numberActors = myActorsInWorld.size();
+  std::vector<Motion> motions(numberActors);
+  std::vector<Eigen::Vector2f> starts(numberActors);
+  std::vector<float> radii(numberActors);
+
+  PlacementIndex startIndex;
+  for (auto ii = 0u; ii < numberActors; ++ii)
+  {
+    starts[ii] = myActorsInWorld[ii]->getPosition();
+    radii[ii] = myActorsInWorld[ii]->getRadius();
+    startIndex.addCircle(starts[ii], radii[ii]);
+  }
+
+  // Clip each Actor against every other where it started, as the serial
+  // update does with none of the other Actors moved yet. The candidates are
+  // those within a circle around the whole path, in index order, so the
+  // result doesn't depend on where the Actors are in memory.
+#pragma omp parallel
+  {
+    SweptCircles neighbors;
+#pragma omp for
+    for (auto ii = 0u; ii < numberActors; ++ii)
+    {
+      const Actor *actor = myActorsInWorld[ii];
+      Motion &motion = motions[ii];
+      motion = integrate(actor, theForces[ii], theIntervalInSeconds);
+      motion.myMotionVector = clipToWorld(actor, motion.myMotionVector);
+
+      Eigen::Vector2f pathCenter = starts[ii] + motion.myMotionVector / 2.0;
+      float pathRadius = radii[ii] + motion.myMotionVector.norm() / 2.0;
+      neighbors.clear();
+      for (auto jj : startIndex.getOverlaps(pathCenter, pathRadius))
+      {
+        if (jj != ii)
+        {
+          neighbors.add(starts[jj], radii[jj]);
+        }
+      }
+      motion.myMotionVector = neighbors.clip(starts[ii], radii[ii],
+                                             motion.myMotionVector);
+    }
+  }
+
+  // Circles closer than this (beyond touching) overlap. Clipping leaves
+  // circles just touching, give or take rounding.
+  auto overlap = [&](Eigen::Vector2f thePosition1, std::size_t theActor1,
+                     Eigen::Vector2f thePosition2, std::size_t theActor2)
+  {
+    return (thePosition1 - thePosition2).norm() <
+      radii[theActor1] + radii[theActor2] - EigenHelper::FLOAT_TOLERANCE;
+  };
+
+  std::vector<Eigen::Vector2f> ends(numberActors);
+  PlacementIndex endIndex;
+  for (auto round = 0u; round <= glbCollisionRounds; ++round)
+  {
+    endIndex.clear();
+    for (auto ii = 0u; ii < numberActors; ++ii)
+    {
+      ends[ii] = starts[ii] + motions[ii].myMotionVector;
+      endIndex.addCircle(ends[ii], radii[ii]);
+    }
+
+    // Each Actor which moved gives way to any it now overlaps where they
+    // started, and to earlier Actors which moved where they ended up. Only
+    // this round's starting state is read, and each Actor only changes its
+    // own motion.
+    bool lastRound = glbCollisionRounds == round;
+    bool overlapped = false;
+#pragma omp parallel
+    {
+      SweptCircles obstacles;
+#pragma omp for reduction(||:overlapped)
+      for (auto ii = 0u; ii < numberActors; ++ii)
+      {
+        if (ends[ii] == starts[ii])
+        {
+          continue;
+        }
+
+        obstacles.clear();
+        for (auto jj : startIndex.getOverlaps(ends[ii], radii[ii]))
+        {
+          if (jj != ii && overlap(ends[ii], ii, starts[jj], jj))
+          {
+            obstacles.add(starts[jj], radii[jj]);
+          }
+        }
+        for (auto jj : endIndex.getOverlaps(ends[ii], radii[ii]))
+        {
+          if (jj < ii && ends[jj] != starts[jj] &&
+              overlap(ends[ii], ii, ends[jj], jj))
+          {
+            obstacles.add(ends[jj], radii[jj]);
+          }
+        }
+        if (0 == obstacles.size())
+        {
+          continue;
+        }
+
+        overlapped = true;
+        Eigen::Vector2f &motionVector = motions[ii].myMotionVector;
+        if (lastRound)
+        {
+          // Staying put can't overlap anything, as nothing ends up
+          // overlapping where an Actor started.
+          motionVector << 0.0, 0.0;
+          continue;
+        }
+        Eigen::Vector2f clipped = obstacles.clip(starts[ii], radii[ii],
+                                                 motionVector);
+        // Only ever shorten the motion, never turn it around.
+        motionVector = clipped.dot(motionVector) > 0.0 ?
+          clipped : Eigen::Vector2f::Zero();
+      }
+    }
+
+    if (! overlapped)
+    {
+      break;
+    }
+  }
+
+  return motions;
+}
+
 void QS::World::setDimensions(float theWidth_m, float theLength_m)
 {
   myWidth_m = theWidth_m;
   myLength_m = theLength_m;
 }
 
+void QS::World::setRandomState(const std::string &theState)
+{
+  std::istringstream state(theState);
+  std::uint64_t seed;
+  std::uint32_t frame;
+  state >> seed >> frame;
+  if (! state || ! (state >> std::ws).eof())
+  {
+    throw std::invalid_argument("Invalid random number generator state.");
+  }
+  myRNG.setSeed(seed);
+  myRNG.setFrame(frame);
+}
+
+void QS::World::setTimeSeriesSink(std::shared_ptr<MetricsSink> theSink,
+                                  float theSampleInterval_s,
+                                  float theDensityRadius_m)
+{
+  if (theDensityRadius_m <= 0.0)
+  {
+    throw std::invalid_argument("Time series density radius must be greater "
+                                "than 0.");
+  }
+  myMetrics.setTimeSeriesSink(theSink, theSampleInterval_s);
+  myTimeSeriesDensityRadius_m = theDensityRadius_m;
+}
+
 void QS::World::setSeed(uint64_t theSeed)
 {
-  myRNGEngine.seed(theSeed);
+  myRNG.setSeed(theSeed);
 }
 
 bool QS::World::update(float theIntervalInSeconds,
                        ActorUpdateCallback &theActorUpdateCallback)
 {
+  QS_TRACE_SCOPE("World::update");
+  auto frameStart = std::chrono::steady_clock::now();
+#ifdef QS_PROFILER_ENABLED
+  auto numberActorsUpdated = myActorsInWorld.size();
+  PerfCounters::Values frameStartCounters;
+  bool frameCounted = PerfCounters::read(frameStartCounters);
+#endif
+
   if (myFirstUpdate)
   {
     myActorAverageDiameter /= myActors.size();
     myFirstUpdate = false;
   }
 
+  // Random numbers drawn during this update are keyed by its number.
+  myRNG.setFrame(myRNG.getFrame() + 1);
+
   SpatialHash hash(myWidth_m, myLength_m, myActorAverageDiameter);
-  for (auto actor : myActorsInWorld)
   {
-    hash.hashActor(actor);
+    QS_PROFILE_PHASE(Hash);
+    for (auto actor : myActorsInWorld)
+    {
+      hash.hashActor(actor);
+    }
   }
 
+  // Actors evaluated in batches are evaluated up front.
+  std::vector<Eigen::Vector2f> forces;
+  std::vector<bool> evaluated;
+  if (glbBatchEvaluation)
+  {
+    QS_PROFILE_PHASE(Evaluate);
+    evaluateBatches(theIntervalInSeconds, forces, evaluated);
+  }
+
+  // With parallel collision resolution the rest are too, against the world
+  // as it is at the start of the update, then all are moved at once.
+  std::vector<Motion> motions;
+  if (glbParallelCollisions)
+  {
+    auto numberActors = myActorsInWorld.size();
+    forces.resize(numberActors, Eigen::Vector2f::Zero());
+    evaluated.resize(numberActors, false);
+    {
+      QS_PROFILE_PHASE(Evaluate);
+      for (auto index = 0u; index < numberActors; ++index)
+      {
+        sampleActor(index, myRNG.getFrame());
+        if (! evaluated[index])
+        {
+          // See below for why the cast.
+          Actor *actor = const_cast<Actor*>(myActorsInWorld[index]);
+          Sensable sensable(actor, myActorsInWorld, myExitsForSensable,
+                            theIntervalInSeconds);
+          forces[index] = actor->evaluate(sensable);
+        }
+      }
+#ifdef QS_PROFILER_ENABLED
+      FrameProfiler::setSampleWeight(1);
+#endif
+    }
+
+    QS_PROFILE_PHASE(Collision);
+    motions = resolveCollisions(forces, theIntervalInSeconds);
+  }
+
+  // Neighbors of the Actor being moved, kept to re-use the memory.
+  SweptCircles neighbors;
+
   auto actorIter = myActorsInWorld.begin();
+  auto actorIndexIter = myActorsInWorldIndexes.begin();
+  // Position of the Actor in myActorsInWorld at the start of the update.
+  std::size_t actorNumber = 0;
 
   while (actorIter != myActorsInWorld.end())
   {
-    Sensable sensable(*actorIter, myActorsInWorld, myExitsForSensable,
-                      theIntervalInSeconds);
-
     // I don't really like the const cast, but I like the "const Actor*"
     // template type of myActorsInWorld better (to make sure the Sensable and
     // users of the Sensable don't mess with the Actor).
     Actor *actor = const_cast<Actor*>(*actorIter);
+    sampleActor(actorNumber, myRNG.getFrame());
 
-    Eigen::Vector2f steeringForce = actor->evaluate(sensable);
-
-    float maxForce = actor->getMaximumForce();
-    steeringForce = EigenHelper::truncate(steeringForce, maxForce);
-
-    float mass = actor->getMass();
-    // Pretend the steering force is in (g*m)/(s*s) (almost newtons, just
-    // not kilograms). Dividing force by mass gives acceleration in m/(s*s).
-    Eigen::Vector2f acceleration = steeringForce / mass;
-
-    Eigen::Vector2f currentVelocity = actor->getVelocity();
-    float maxSpeed = actor->getMaximumSpeed();
-    // Multiplying acceleration by time gives m/s.
-    Eigen::Vector2f newVelocity = currentVelocity +
-      (acceleration * theIntervalInSeconds);
-    newVelocity = EigenHelper::truncate(newVelocity, maxSpeed);
-
-    float newOrientation = actor->getOrientation();
-    // If the Actor is staying stationary, the orientation goes to -nan, and
-    // this causes the Actor to not be drawn.
-    if (newVelocity.norm() != 0.0)
+    Motion motion;
+    if (glbParallelCollisions)
     {
-      Eigen::Vector2f base{1.0, 0.0};
-      Eigen::Vector2f normalizedVelocity = newVelocity;
-      normalizedVelocity.normalize();
-      newOrientation = std::acos(normalizedVelocity.dot(base));
+      motion = motions[actorNumber];
     }
-
-    // acos(Dot product) gives a value between 0 & PI. So if the Actor is
-    // oriented at, say, 270 degrees (3 * PI / 2 radians) the value is PI/2.
-    // This corrects for "downward" pointing Actors. It is a simplification of
-    // the code in the question at:
-    // http://gamedev.stackexchange.com/questions/45412/understanding-math-used-to-determine-if-vector-is-clockwise-counterclockwise-f
-    // The extra math can be removed since the 'base' value above is {1,0}.
-    if (newVelocity.y() < 0)
+    else
     {
-      newOrientation = 2 * M_PI - newOrientation;
-    }
+      Eigen::Vector2f steeringForce;
+      {
+        // Sensing done by the BehaviorSet is timed separately.
+        QS_PROFILE_PHASE(Evaluate);
+        if (! evaluated.empty() && evaluated[actorNumber])
+        {
+          steeringForce = forces[actorNumber];
+        }
+        else
+        {
+          Sensable sensable(*actorIter, myActorsInWorld, myExitsForSensable,
+                            theIntervalInSeconds);
+          steeringForce = actor->evaluate(sensable);
+        }
+      }
 
-    Eigen::Vector2f currentPosition = actor->getPosition();
+      motion = integrate(actor, steeringForce, theIntervalInSeconds);
 
-    // Multiplying velocity by time gives a vector, in meters, to where the
-    // Actor, ideally, will move.
-    Eigen::Vector2f motionVector = newVelocity * theIntervalInSeconds;
+      // Make sure this motion vector doesn't cause any collisions.
+      QS_PROFILE_PHASE(Collision);
+      motion.myMotionVector = collisionDetection(actor, motion.myMotionVector,
+                                                 hash, neighbors);
+    }
+    ++actorNumber;
 
-    // Make sure this motion vector doesn't cause any collisions.
-    motionVector = collisionDetection(actor, motionVector, hash);
-    Eigen::Vector2f newPosition = currentPosition + motionVector;
+    Eigen::Vector2f currentPosition = actor->getPosition();
+    Eigen::Vector2f newPosition = currentPosition + motion.myMotionVector;
 
     float grossDistance = (currentPosition - newPosition).norm();
-    myMetrics.getActorMetrics(actor).addGrossDistance(grossDistance);
+    myMetrics.addActorGrossDistance(*actorIndexIter, grossDistance);
 
-    actor->setVelocity(newVelocity);
+    actor->setVelocity(motion.myVelocity);
     actor->setPosition(newPosition);
-    actor->setOrientation(newOrientation);
+    actor->setOrientation(motion.myOrientation);
 
     // Check if the Actor has exited.
     bool actorExited = false;
-    for (auto exit : myExits)
     {
-      exit->update(theIntervalInSeconds);
-      if (exit->canActorExit(actor))
+      QS_PROFILE_PHASE(Exit);
+      for (auto exitIndex = 0u; exitIndex < myExits.size(); ++exitIndex)
       {
-        actorExited = true;
-        break;
+        auto exit = myExits[exitIndex];
+        exit->update(theIntervalInSeconds);
+        if (exit->canActorExit(actor))
+        {
+          ++myExitCounts[exitIndex];
+          actorExited = true;
+          break;
+        }
       }
     }
 
     if (actorExited)
     {
-      hash.removeActor(*actorIter);
+      {
+        QS_PROFILE_PHASE(Hash);
+        hash.removeActor(*actorIter);
+      }
       actorIter = myActorsInWorld.erase(actorIter);
+      actorIndexIter = myActorsInWorldIndexes.erase(actorIndexIter);
     }
     else
     {
-      // Rehash Actor at new position. This could leave the Actor in two
-      // different cells, but there shouldn't be any performance degredation.
-      hash.hashActor(*actorIter);
+      {
+        // Rehash Actor at new position. This could leave the Actor in two
+        // different cells, but there shouldn't be any performance
+        // degredation.
+        QS_PROFILE_PHASE(Hash);
+        hash.hashActor(*actorIter);
+      }
 
-      theActorUpdateCallback.actorUpdate(*actorIter);
+      {
+        QS_PROFILE_PHASE(Callback);
+        theActorUpdateCallback.actorUpdate(*actorIter);
+      }
       ++actorIter;
+      ++actorIndexIter;
     }
   }
 
+#ifdef QS_PROFILER_ENABLED
+  FrameProfiler::setSampleWeight(1);
+#endif
+
   myMetrics.addToElapsedTime(theIntervalInSeconds);
 
+  std::chrono::duration<float> frameWallTime =
+    std::chrono::steady_clock::now() - frameStart;
+  myMetrics.addFrameWallTime(frameWallTime.count());
+
+#ifdef QS_PROFILER_ENABLED
+  // Whatever wasn't attributed to a specific phase is general update time.
+  FrameProfiler::PhaseTimes phaseTimes = FrameProfiler::endFrame();
+  float otherTime = frameWallTime.count();
+  for (auto phaseTime : phaseTimes)
+  {
+    otherTime -= phaseTime;
+  }
+  phaseTimes[static_cast<std::size_t>(FrameProfiler::Phase::Update)] =
+    std::max(otherTime, 0.0f);
+  myMetrics.addPhaseTimes(phaseTimes);
+
+  // Same for the hardware counters.
+  FrameProfiler::PhaseCounters phaseCounters =
+    FrameProfiler::endFrameCounters();
+  PerfCounters::Values frameEndCounters;
+  if (frameCounted && PerfCounters::read(frameEndCounters))
+  {
+    auto &otherCounters = phaseCounters[
+      static_cast<std::size_t>(FrameProfiler::Phase::Update)];
+    for (auto counter = 0u; counter < PerfCounters::NUMBER_COUNTERS; ++counter)
+    {
+      std::uint64_t otherCount =
+        frameEndCounters[counter] - frameStartCounters[counter];
+      for (const auto &counters : phaseCounters)
+      {
+        otherCount -= std::min(otherCount, counters[counter]);
+      }
+      otherCounters[counter] = otherCount;
+    }
+    myMetrics.addPhaseCounters(phaseCounters, numberActorsUpdated);
+  }
+#endif
+
+  myMetrics.publishSnapshot(myActorsInWorld.size());
+  // Always take a final sample when the last Actor leaves.
+  if (myMetrics.isTimeSeriesSampleDue() ||
+      (myActorsInWorld.empty() && myMetrics.hasTimeSeriesSink()))
+  {
+    myMetrics.addTimeSeriesSample(createTimeSeriesSample(hash));
+  }
+
   return myActorsInWorld.empty();
 }
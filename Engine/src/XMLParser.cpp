@@ -0,0 +1,162 @@
+/**
+ * @file XMLParser.cpp
+ * @brief Definition of XMLParser
+ *
+ * @author Michael Albers
+ */
+
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_set>
+#include "xercesc/framework/MemBufInputSource.hpp"
+#include "xercesc/framework/XMLGrammarPoolImpl.hpp"
+#include "xercesc/sax2/SAX2XMLReader.hpp"
+#include "xercesc/sax2/XMLReaderFactory.hpp"
+#include "xercesc/util/PlatformUtils.hpp"
+#include "Finally.h"
+#include "ScenarioCache.h"
+#include "XMLParser.h"
+
+namespace
+{
+  /**
+   * Grammar pool of each schema file. Pools are keyed by namespace and none
+   * of the schemas have a target namespace, so each needs its own pool.
+   */
+  std::map<std::string, std::unique_ptr<XMLGrammarPool>> glbGrammarPools;
+
+  /** File hashes of validated files are added to, empty if none. */
+  std::string glbHashFile;
+
+  /** Guards all of the state here. */
+  std::mutex glbMutex;
+
+  /** Whether trusted input is enabled. */
+  bool glbTrustedInput = false;
+
+  /** Hashes of files which have been validated. */
+  std::unordered_set<std::uint64_t> glbValidated;
+}
+
+void QS::XMLParser::disableTrustedInput() noexcept
+{
+  std::lock_guard<std::mutex> lock(glbMutex);
+  glbTrustedInput = false;
+  glbHashFile.clear();
+  glbValidated.clear();
+}
+
+void QS::XMLParser::enableTrustedInput(const std::string &theHashFile)
+{
+  std::lock_guard<std::mutex> lock(glbMutex);
+  glbValidated.clear();
+  if (! theHashFile.empty())
+  {
+    std::ifstream input(theHashFile);
+    std::uint64_t hash;
+    while (input >> std::hex >> hash)
+    {
+      glbValidated.insert(hash);
+    }
+    if (input.is_open() && ! input.eof())
+    {
+      throw std::runtime_error("Invalid trusted input hash file '" +
+                               theHashFile + "'.");
+    }
+  }
+  glbHashFile = theHashFile;
+  glbTrustedInput = true;
+}
+
+void QS::XMLParser::parse(const std::string &theSchemaFile,
+                          const std::string &theXMLFile,
+                          DefaultHandler &theHandler)
+{
+  std::lock_guard<std::mutex> lock(glbMutex);
+
+  bool validate = true;
+  std::uint64_t hash = 0;
+  if (glbTrustedInput)
+  {
+    hash = ScenarioCache::getKey({theSchemaFile, theXMLFile});
+    validate = (glbValidated.count(hash) == 0);
+  }
+
+  // A new pool is only kept once its grammar has loaded successfully. It is
+  // declared first so it outlives the parser.
+  std::unique_ptr<XMLGrammarPool> newPool;
+  auto pool = glbGrammarPools.find(theSchemaFile);
+  XMLGrammarPool *grammarPool = nullptr;
+  if (pool == glbGrammarPools.end())
+  {
+    newPool.reset(new XMLGrammarPoolImpl(XMLPlatformUtils::fgMemoryManager));
+    grammarPool = newPool.get();
+  }
+  else
+  {
+    grammarPool = pool->second.get();
+  }
+
+  SAX2XMLReader* parser = XMLReaderFactory::createXMLReader(
+    XMLPlatformUtils::fgMemoryManager, grammarPool);
+  Finally parserCleanup([=](){delete parser;});
+  parser->setFeature(XMLUni::fgSAX2CoreNameSpaces, true);
+  parser->setFeature(XMLUni::fgXercesSchemaFullChecking, true);
+  if (newPool)
+  {
+    parser->loadGrammar(theSchemaFile.c_str(), Grammar::SchemaGrammarType,
+                        true);
+    glbGrammarPools[theSchemaFile] = std::move(newPool);
+  }
+  parser->setFeature(XMLUni::fgXercesUseCachedGrammarInParse, true);
+  parser->setFeature(XMLUni::fgSAX2CoreValidation, validate);
+
+  parser->setContentHandler(&theHandler);
+  parser->setErrorHandler(&theHandler);
+
+  parser->parse(theXMLFile.c_str());
+
+  if (glbTrustedInput && validate)
+  {
+    glbValidated.insert(hash);
+    if (! glbHashFile.empty())
+    {
+      std::ofstream output(glbHashFile, std::ios::app);
+      output << std::hex << std::setw(16) << std::setfill('0') << hash
+             << std::endl;
+      if (! output)
+      {
+        throw std::runtime_error("Failed to write trusted input hash file '" +
+                                 glbHashFile + "'.");
+      }
+    }
+  }
+}
+
+void QS::XMLParser::parseMemory(const std::string &theName,
+                                const std::string &theXML,
+                                DefaultHandler &theHandler)
+{
+  SAX2XMLReader* parser = XMLReaderFactory::createXMLReader();
+  Finally parserCleanup([=](){delete parser;});
+  parser->setFeature(XMLUni::fgSAX2CoreNameSpaces, true);
+  parser->setFeature(XMLUni::fgSAX2CoreValidation, false);
+
+  parser->setContentHandler(&theHandler);
+  parser->setErrorHandler(&theHandler);
+
+  MemBufInputSource input(reinterpret_cast<const XMLByte*>(theXML.data()),
+                          theXML.size(), theName.c_str());
+  parser->parse(input);
+}
+
+void QS::XMLParser::releaseGrammars() noexcept
+{
+  std::lock_guard<std::mutex> lock(glbMutex);
+  glbGrammarPools.clear();
+}
@@ -7,6 +7,7 @@
 
 #include "gtest/gtest.h"
 #include "xercesc/util/PlatformUtils.hpp"
+#include "XMLParser.h"
 
 XERCES_CPP_NAMESPACE_USE
 
@@ -14,7 +15,11 @@ class XercesInit
 {
   public:
   XercesInit() {XMLPlatformUtils::Initialize();}
-  ~XercesInit() {XMLPlatformUtils::Terminate();}
+  ~XercesInit()
+  {
+    QS::XMLParser::releaseGrammars();
+    XMLPlatformUtils::Terminate();
+  }
 };
 
 int main(int argc, char **argv)
@@ -0,0 +1,139 @@
+/**
+ * @file MetricsSinkTest.cpp
+ * @brief Unit test of the CSVMetricsSink and BinaryMetricsSink classes.
+ *
+ * @author Michael Albers
+ */
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+#include "gtest/gtest.h"
+#include "BinaryMetricsSink.h"
+#include "CSVMetricsSink.h"
+#include "TimeSeriesSample.h"
+
+class MetricsSinkTest : public ::testing::Test
+{
+  public:
+  void SetUp() override
+  {
+    char *tmpFileTemplate = ::strdup("/tmp/MetricsSinkTest_XXXXXX");
+    int fd = ::mkstemp(tmpFileTemplate);
+    auto thisErrno = errno;
+    ASSERT_NE(-1, fd)
+      << "Unexpectedly failed to make temporary file from '"
+      << tmpFileTemplate << ": " << std::strerror(thisErrno);
+    ::close(fd);
+
+    myFileName = tmpFileTemplate;
+    std::free(tmpFileTemplate);
+
+    mySample.myTime_s = 1.5;
+    mySample.myNumberActorsRemaining = 7;
+    mySample.myMeanSpeed = 0.75;
+    mySample.myDensityPercentiles = {{0.25, 0.5, 1.0}};
+    mySample.myMeanFrameWallTime_s = 0.125;
+    mySample.myMaxFrameWallTime_s = 0.5;
+    mySample.myExitCounts = {3, 0};
+    mySample.myExitThroughputs = {2.0, 0.0};
+  }
+
+  void TearDown() override
+  {
+    ::unlink(myFileName.c_str());
+  }
+
+  std::string readFile()
+  {
+    std::ifstream file(myFileName, std::ios_base::in | std::ios_base::binary);
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+  }
+
+  std::string myFileName;
+
+  QS::TimeSeriesSample mySample;
+};
+
+TEST_F(MetricsSinkTest, csv)
+{
+  EXPECT_THROW(QS::CSVMetricsSink("/tmp/no/such/dir/file.csv"),
+               std::runtime_error);
+
+  {
+    QS::CSVMetricsSink sink(myFileName);
+    sink.write(mySample);
+    mySample.myTime_s = 3.0;
+    sink.write(mySample);
+
+    QS::TimeSeriesSample badSample;
+    EXPECT_THROW(sink.write(badSample), std::runtime_error);
+    sink.flush();
+  }
+
+  std::istringstream contents(readFile());
+  std::string line;
+  std::getline(contents, line);
+  EXPECT_EQ("time_s,actors_remaining,mean_speed,density_p50,density_p90,"
+            "density_p99,frame_wall_mean_s,frame_wall_max_s,exit0_count,"
+            "exit0_throughput,exit1_count,exit1_throughput", line);
+  std::getline(contents, line);
+  EXPECT_EQ("1.5,7,0.75,0.25,0.5,1,0.125,0.5,3,2,0,0", line);
+  std::getline(contents, line);
+  EXPECT_EQ("3,7,0.75,0.25,0.5,1,0.125,0.5,3,2,0,0", line);
+  EXPECT_FALSE(std::getline(contents, line));
+}
+
+TEST_F(MetricsSinkTest, binary)
+{
+  EXPECT_THROW(QS::BinaryMetricsSink("/tmp/no/such/dir/file.bin"),
+               std::runtime_error);
+
+  {
+    QS::BinaryMetricsSink sink(myFileName);
+    sink.write(mySample);
+    sink.write(mySample);
+    sink.flush();
+  }
+
+  std::string contents = readFile();
+  // Header (4 words) plus two records of 8 + 2 * 2 words.
+  ASSERT_EQ(4 * (4 + 2 * 12), contents.size());
+  EXPECT_EQ("QSTS", contents.substr(0, 4));
+
+  auto word = [&](std::size_t theIndex)
+  {
+    std::uint32_t value;
+    std::memcpy(&value, contents.data() + 4 * theIndex, sizeof(value));
+    return value;
+  };
+  auto floatWord = [&](std::size_t theIndex)
+  {
+    float value;
+    std::memcpy(&value, contents.data() + 4 * theIndex, sizeof(value));
+    return value;
+  };
+
+  EXPECT_EQ(QS::BinaryMetricsSink::VERSION, word(1));
+  EXPECT_EQ(2u, word(2));
+  EXPECT_EQ(QS::TimeSeriesSample::NUMBER_DENSITY_PERCENTILES, word(3));
+
+  EXPECT_EQ(1.5, floatWord(4));
+  EXPECT_EQ(7u, word(5));
+  EXPECT_EQ(0.75, floatWord(6));
+  EXPECT_EQ(0.25, floatWord(7));
+  EXPECT_EQ(0.5, floatWord(8));
+  EXPECT_EQ(1.0, floatWord(9));
+  EXPECT_EQ(0.125, floatWord(10));
+  EXPECT_EQ(0.5, floatWord(11));
+  EXPECT_EQ(3u, word(12));
+  EXPECT_EQ(2.0, floatWord(13));
+  EXPECT_EQ(0u, word(14));
+  EXPECT_EQ(0.0, floatWord(15));
+}
@@ -0,0 +1,92 @@
+/**
+ * @file MetricsSinkWriterTest.cpp
+ * @brief Unit test of the MetricsSinkWriter class.
+ *
+ * @author Michael Albers
+ */
+
+#include <stdexcept>
+#include <vector>
+#include "gtest/gtest.h"
+#include "MetricsSink.h"
+#include "MetricsSinkWriter.h"
+#include "TimeSeriesSample.h"
+
+namespace
+{
+  /** Sink which saves samples in memory. */
+  class TestSink : public QS::MetricsSink
+  {
+    public:
+    void flush() override
+    {
+      ++myNumberFlushes;
+    }
+
+    void write(const QS::TimeSeriesSample &theSample) override
+    {
+      if (theSample.myNumberActorsRemaining == myFailOn)
+      {
+        throw std::runtime_error("write failed");
+      }
+      mySamples.push_back(theSample);
+    }
+
+    std::uint32_t myFailOn = 0;
+    int myNumberFlushes = 0;
+    std::vector<QS::TimeSeriesSample> mySamples;
+  };
+}
+
+GTEST_TEST(MetricsSinkWriterTest, construction)
+{
+  EXPECT_THROW(QS::MetricsSinkWriter(nullptr, 1), std::invalid_argument);
+  EXPECT_THROW(QS::MetricsSinkWriter(std::make_shared<TestSink>(), 0),
+               std::invalid_argument);
+}
+
+GTEST_TEST(MetricsSinkWriterTest, write)
+{
+  auto sink = std::make_shared<TestSink>();
+  QS::MetricsSinkWriter writer(sink, 2);
+
+  // More samples than the queue holds, push should wait for room.
+  for (std::uint32_t ii = 1; ii <= 100; ++ii)
+  {
+    QS::TimeSeriesSample sample;
+    sample.myNumberActorsRemaining = ii;
+    writer.push(sample);
+  }
+  writer.close();
+  writer.close();
+
+  EXPECT_THROW(writer.push(QS::TimeSeriesSample()), std::logic_error);
+  EXPECT_EQ(100u, writer.getNumberSamplesWritten());
+  EXPECT_TRUE(writer.getErrorMessage().empty());
+  EXPECT_EQ(1, sink->myNumberFlushes);
+  ASSERT_EQ(100u, sink->mySamples.size());
+  for (std::uint32_t ii = 0; ii < 100; ++ii)
+  {
+    EXPECT_EQ(ii + 1, sink->mySamples[ii].myNumberActorsRemaining);
+  }
+}
+
+GTEST_TEST(MetricsSinkWriterTest, error)
+{
+  auto sink = std::make_shared<TestSink>();
+  sink->myFailOn = 3;
+  {
+    QS::MetricsSinkWriter writer(sink, 4);
+    for (std::uint32_t ii = 1; ii <= 5; ++ii)
+    {
+      QS::TimeSeriesSample sample;
+      sample.myNumberActorsRemaining = ii;
+      writer.push(sample);
+    }
+    writer.close();
+    EXPECT_EQ("write failed", writer.getErrorMessage());
+    EXPECT_EQ(2u, writer.getNumberSamplesWritten());
+  }
+  EXPECT_EQ(2u, sink->mySamples.size());
+  EXPECT_EQ(0, sink->myNumberFlushes);
+}
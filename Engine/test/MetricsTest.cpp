@@ -8,9 +8,28 @@
 #include <stdexcept>
 #include "gtest/gtest.h"
 #include "Actor.h"
+#include "ActorMetrics.h"
 #include "Metrics.h"
+#include "MetricsSink.h"
 #include "TestUtils.h"
 
+namespace
+{
+  /** Sink which saves samples in memory. */
+  class TestSink : public QS::MetricsSink
+  {
+    public:
+    void flush() override {}
+
+    void write(const QS::TimeSeriesSample &theSample) override
+    {
+      mySamples.push_back(theSample);
+    }
+
+    std::vector<QS::TimeSeriesSample> mySamples;
+  };
+}
+
 // Using 3000 as I believe that the duration is in microseconds or
 // nanoseconds. But it's something very small. Tried using 1 in an EXPECT_NEAR
 // and it failed due to a difference of 2304. 3000 gives some fudge room. This
@@ -49,6 +68,54 @@ GTEST_TEST(MetricsTest, actorMetrics)
   }
 }
 
+GTEST_TEST(MetricsTest, actorIndex)
+{
+  QS::PluginEntity::Properties properties{
+    QS::TestUtils::getMinimalActorProperties()};
+
+  std::vector<QS::Actor*> actors;
+
+  for (int ii = 0; ii < 10; ++ii)
+  {
+    properties["x"] = std::to_string(ii);
+    properties["y"] = std::to_string(ii);
+    actors.push_back(new QS::Actor(properties, ""));
+  }
+
+  QS::Metrics metrics;
+  metrics.initializeActorMetrics(actors);
+
+  for (auto ii = 0u; ii < actors.size(); ++ii)
+  {
+    EXPECT_EQ(ii, metrics.getActorIndex(actors[ii]));
+    EXPECT_EQ(&metrics.getActorMetrics(actors[ii]),
+              &metrics.getActorMetrics(ii));
+    metrics.addActorGrossDistance(ii, static_cast<float>(ii));
+  }
+  EXPECT_THROW(metrics.getActorIndex(nullptr), std::out_of_range);
+  EXPECT_THROW(metrics.getActorMetrics(actors.size()), std::out_of_range);
+  EXPECT_THROW(metrics.addActorGrossDistance(0, -1.0), std::invalid_argument);
+
+  for (auto ii = 0u; ii < actors.size(); ++ii)
+  {
+    actors[ii]->setPosition(Eigen::Vector2f(ii + 3.0, ii + 4.0));
+  }
+  metrics.finalizeActorMetrics(actors);
+
+  for (auto ii = 0u; ii < actors.size(); ++ii)
+  {
+    auto &actorMetrics = metrics.getActorMetrics(ii);
+    EXPECT_FLOAT_EQ(static_cast<float>(ii),
+                    actorMetrics.getGrossDistanceMeters());
+    EXPECT_FLOAT_EQ(5.0, actorMetrics.getNetDistanceMeters());
+  }
+
+  for (auto actor : actors)
+  {
+    delete actor;
+  }
+}
+
 GTEST_TEST(MetricsTest, startTime)
 {
   QS::Metrics::TimePoint now = QS::Metrics::Clock::now();
@@ -97,3 +164,181 @@ GTEST_TEST(MetricsTest, output)
   metricsOutput << metrics;
   EXPECT_FALSE(metricsOutput.str().empty());
 }
+
+GTEST_TEST(MetricsTest, snapshot)
+{
+  QS::PluginEntity::Properties properties{
+    QS::TestUtils::getMinimalActorProperties()};
+
+  std::vector<QS::Actor*> actors;
+
+  for (int ii = 0; ii < 4; ++ii)
+  {
+    properties["x"] = std::to_string(ii);
+    properties["y"] = std::to_string(ii);
+    actors.push_back(new QS::Actor(properties, ""));
+  }
+
+  QS::Metrics metrics;
+  auto snapshot = metrics.getSnapshot();
+  EXPECT_EQ(0u, snapshot.myNumberActors);
+  EXPECT_EQ(0u, snapshot.myNumberUpdates);
+
+  metrics.initializeActorMetrics(actors);
+  snapshot = metrics.getSnapshot();
+  EXPECT_EQ(4u, snapshot.myNumberActors);
+  EXPECT_EQ(4u, snapshot.myNumberActorsRemaining);
+  EXPECT_EQ(0u, snapshot.myNumberActorsExited);
+
+  metrics.addToElapsedTime(0.5);
+  metrics.addToElapsedTime(0.25);
+  // Not published yet.
+  EXPECT_EQ(0.0, metrics.getSnapshot().myElapsedTime);
+
+  metrics.publishSnapshot(1);
+  snapshot = metrics.getSnapshot();
+  EXPECT_FLOAT_EQ(0.75, snapshot.myElapsedTime);
+  EXPECT_FLOAT_EQ(0.25, snapshot.myLastUpdateInterval);
+  EXPECT_EQ(2u, snapshot.myNumberUpdates);
+  EXPECT_EQ(4u, snapshot.myNumberActors);
+  EXPECT_EQ(1u, snapshot.myNumberActorsRemaining);
+  EXPECT_EQ(3u, snapshot.myNumberActorsExited);
+
+  for (auto actor : actors)
+  {
+    delete actor;
+  }
+}
+
+GTEST_TEST(MetricsTest, timeSeries)
+{
+  QS::Metrics metrics;
+  EXPECT_FALSE(metrics.hasTimeSeriesSink());
+  EXPECT_FALSE(metrics.isTimeSeriesSampleDue());
+  EXPECT_THROW(metrics.addTimeSeriesSample(QS::TimeSeriesSample()),
+               std::logic_error);
+
+  auto sink = std::make_shared<TestSink>();
+  EXPECT_THROW(metrics.setTimeSeriesSink(sink, 0.0), std::invalid_argument);
+  EXPECT_THROW(metrics.setTimeSeriesSink(nullptr, 1.0),
+               std::invalid_argument);
+  metrics.setTimeSeriesSink(sink, 1.0);
+  EXPECT_TRUE(metrics.hasTimeSeriesSink());
+
+  QS::TimeSeriesSample sample;
+  sample.myExitCounts = {0, 0};
+  metrics.addToElapsedTime(0.5);
+  metrics.addFrameWallTime(0.25);
+  metrics.addFrameWallTime(0.75);
+  ASSERT_TRUE(metrics.isTimeSeriesSampleDue());
+  metrics.addTimeSeriesSample(sample);
+  EXPECT_FALSE(metrics.isTimeSeriesSampleDue());
+
+  metrics.addToElapsedTime(0.25);
+  metrics.addFrameWallTime(0.5);
+  EXPECT_FALSE(metrics.isTimeSeriesSampleDue());
+  metrics.addToElapsedTime(0.75);
+  metrics.addFrameWallTime(0.5);
+  ASSERT_TRUE(metrics.isTimeSeriesSampleDue());
+  sample.myExitCounts = {4, 1};
+  metrics.addTimeSeriesSample(sample);
+
+  metrics.finalizeSimulationMetrics();
+
+  ASSERT_EQ(2u, sink->mySamples.size());
+  auto &first = sink->mySamples[0];
+  EXPECT_FLOAT_EQ(0.5, first.myTime_s);
+  EXPECT_FLOAT_EQ(0.5, first.myMeanFrameWallTime_s);
+  EXPECT_FLOAT_EQ(0.75, first.myMaxFrameWallTime_s);
+  EXPECT_EQ(std::vector<float>({0.0, 0.0}), first.myExitThroughputs);
+
+  auto &second = sink->mySamples[1];
+  EXPECT_FLOAT_EQ(1.5, second.myTime_s);
+  EXPECT_FLOAT_EQ(0.5, second.myMeanFrameWallTime_s);
+  EXPECT_FLOAT_EQ(0.5, second.myMaxFrameWallTime_s);
+  ASSERT_EQ(2u, second.myExitThroughputs.size());
+  EXPECT_FLOAT_EQ(4.0, second.myExitThroughputs[0]);
+  EXPECT_FLOAT_EQ(1.0, second.myExitThroughputs[1]);
+
+  std::ostringstream metricsOutput;
+  metricsOutput << metrics;
+  EXPECT_NE(std::string::npos,
+            metricsOutput.str().find("Time Series Samples Written: 2"));
+}
+
+GTEST_TEST(MetricsTest, phaseTimes)
+{
+  using Phase = QS::FrameProfiler::Phase;
+
+  QS::Metrics metrics;
+  QS::FrameProfiler::PhaseTimes times{};
+  times[static_cast<std::size_t>(Phase::Hash)] = 0.0000005; // < 1 us
+  times[static_cast<std::size_t>(Phase::Evaluate)] = 0.000003; // [2, 4) us
+  metrics.addPhaseTimes(times);
+  times[static_cast<std::size_t>(Phase::Evaluate)] = 0.001; // [512, 1024) us
+  times[static_cast<std::size_t>(Phase::Collision)] = 1000.0; // overflow
+  metrics.addPhaseTimes(times);
+
+  auto snapshot = metrics.getSnapshot();
+  EXPECT_EQ(0.0, snapshot.myPhaseTimes[static_cast<std::size_t>(
+                   Phase::Evaluate)]);
+  metrics.publishSnapshot(0);
+  snapshot = metrics.getSnapshot();
+  EXPECT_FLOAT_EQ(0.001, snapshot.myPhaseTimes[static_cast<std::size_t>(
+                          Phase::Evaluate)]);
+
+  metrics.finalizeSimulationMetrics();
+
+  auto evaluate = metrics.getPhaseMetrics(Phase::Evaluate);
+  EXPECT_FLOAT_EQ(0.000003, evaluate.myMin);
+  EXPECT_FLOAT_EQ(0.001, evaluate.myMax);
+  EXPECT_FLOAT_EQ(0.0005015, evaluate.myAvg);
+
+  auto histogram = metrics.getPhaseHistogram(Phase::Hash);
+  EXPECT_EQ(2u, histogram[0]);
+  histogram = metrics.getPhaseHistogram(Phase::Evaluate);
+  EXPECT_EQ(1u, histogram[2]);
+  EXPECT_EQ(1u, histogram[10]);
+  histogram = metrics.getPhaseHistogram(Phase::Collision);
+  EXPECT_EQ(1u, histogram[0]);
+  EXPECT_EQ(1u, histogram[QS::Metrics::NUMBER_HISTOGRAM_BUCKETS - 1]);
+
+  std::ostringstream metricsOutput;
+  metricsOutput << metrics;
+  EXPECT_NE(std::string::npos,
+            metricsOutput.str().find("Update Phase Timings"));
+}
+
+GTEST_TEST(MetricsTest, phaseCounters)
+{
+  using Phase = QS::FrameProfiler::Phase;
+  auto cycles = static_cast<std::size_t>(QS::PerfCounters::Counter::Cycles);
+  auto instructions =
+    static_cast<std::size_t>(QS::PerfCounters::Counter::Instructions);
+
+  QS::Metrics metrics;
+  std::ostringstream noCounters;
+  noCounters << metrics;
+  EXPECT_EQ(std::string::npos, noCounters.str().find("Hardware Counters"));
+
+  QS::FrameProfiler::PhaseCounters counters{};
+  counters[static_cast<std::size_t>(Phase::Update)][cycles] = 100;
+  counters[static_cast<std::size_t>(Phase::Collision)][cycles] = 400;
+  counters[static_cast<std::size_t>(Phase::Collision)][instructions] = 800;
+  metrics.addPhaseCounters(counters, 10);
+  metrics.addPhaseCounters(counters, 10);
+
+  EXPECT_EQ(20u, metrics.getNumberCountedActorUpdates());
+  auto collision = metrics.getPhaseCounters(Phase::Collision);
+  EXPECT_EQ(800u, collision[cycles]);
+  EXPECT_EQ(1600u, collision[instructions]);
+
+  metrics.finalizeSimulationMetrics();
+  std::ostringstream metricsOutput;
+  metricsOutput << metrics;
+  auto output = metricsOutput.str();
+  EXPECT_NE(std::string::npos, output.find("Hardware Counters"));
+  EXPECT_NE(std::string::npos,
+            output.find("Collision: Cycles 40.00, Instructions 80.00, "
+                        "Cache Misses 0.00, Branch Misses 0.00, IPC 2.00"));
+}
@@ -0,0 +1,86 @@
+/**
+ * @file PlacementIndexTest.cpp
+ * @brief Unit test of PlacementIndex class
+ *
+ * @author Michael Albers
+ */
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "Actor.h"
+#include "PlacementIndex.h"
+#include "TestUtils.h"
+
+GTEST_TEST(PlacementIndexTest, actors)
+{
+  auto actorProperties = QS::TestUtils::getMinimalActorProperties();
+  actorProperties["radius"] = "1.0";
+  QS::Actor actor1(actorProperties, "");
+  QS::Actor actor2(actorProperties, "");
+  actor1.setPosition({5.0, 5.0});
+  actor2.setPosition({7.0, 5.0});
+
+  QS::PlacementIndex index;
+  EXPECT_EQ(0u, index.size());
+  EXPECT_FALSE(index.contains(&actor1));
+  EXPECT_FALSE(index.overlaps({5.0, 5.0}, 1.0));
+
+  index.addActor(&actor1);
+  EXPECT_EQ(1u, index.size());
+  EXPECT_TRUE(index.contains(&actor1));
+  EXPECT_FALSE(index.contains(&actor2));
+
+  // Touching counts as overlapping, same as World::checkOverlap.
+  EXPECT_TRUE(index.overlaps(actor2.getPosition(), 1.0));
+  EXPECT_FALSE(index.overlaps(actor2.getPosition(), 0.99));
+
+  index.addActor(&actor2);
+  std::vector<std::size_t> expected{0, 1};
+  EXPECT_EQ(expected, index.getOverlaps({6.0, 5.0}, 0.5));
+  expected = {1};
+  EXPECT_EQ(expected, index.getOverlaps({8.5, 5.0}, 0.5));
+  EXPECT_TRUE(index.getOverlaps({5.0, 7.5}, 0.4).empty());
+
+  index.clear();
+  EXPECT_EQ(0u, index.size());
+  EXPECT_FALSE(index.contains(&actor1));
+  EXPECT_FALSE(index.overlaps({5.0, 5.0}, 1.0));
+}
+
+GTEST_TEST(PlacementIndexTest, bruteForce)
+{
+  // Mixed sizes, including ones that force the grid to be rebuilt, compared
+  // against checking every circle.
+  std::mt19937 engine(7);
+  std::uniform_real_distribution<float> position(-20.0, 120.0);
+  std::uniform_real_distribution<float> radius(0.0, 1.0);
+
+  QS::PlacementIndex index;
+  std::vector<Eigen::Vector2f> positions;
+  std::vector<float> radii;
+  for (auto ii = 0; ii < 2000; ++ii)
+  {
+    Eigen::Vector2f circlePosition{position(engine), position(engine)};
+    float circleRadius = radius(engine) * (ii / 500 + 1);
+
+    std::vector<std::size_t> expected;
+    for (auto jj = 0u; jj < positions.size(); ++jj)
+    {
+      if ((positions[jj] - circlePosition).norm() <= radii[jj] + circleRadius)
+      {
+        expected.push_back(jj);
+      }
+    }
+    ASSERT_EQ(expected, index.getOverlaps(circlePosition, circleRadius))
+      << ii;
+    ASSERT_EQ(! expected.empty(),
+              index.overlaps(circlePosition, circleRadius)) << ii;
+
+    index.addCircle(circlePosition, circleRadius);
+    positions.push_back(circlePosition);
+    radii.push_back(circleRadius);
+  }
+  EXPECT_EQ(positions.size(), index.size());
+}
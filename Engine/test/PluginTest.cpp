@@ -5,11 +5,53 @@
  * @author Michael Albers
  */
 
+#include <map>
+#include <string>
 #include "Plugin.h"
+#include "PluginABI.h"
+#include "StaticPlugin.h"
 #include "gtest/gtest.h"
 
 // TODO: add more tests when I figure out how to build test plugins
 
+namespace
+{
+  int glbActorsDestroyed = 0;
+
+  QS::Actor* testActorCreator(
+    const std::string&,
+    const std::map<std::string, std::string>&,
+    const std::string&)
+  {
+    return nullptr;
+  }
+
+  void testActorDestructor(QS::Actor*)
+  {
+    ++glbActorsDestroyed;
+  }
+
+  const QS::PluginABI& testPluginABI()
+  {
+    static const QS::PluginABI abi = []()
+    {
+      QS::PluginABI abi;
+      QS::EntityCapabilities actor;
+      actor.myType = "TestActor";
+      actor.myShareable = true;
+      abi.myCapabilities.push_back(actor);
+      // Same name, different kind.
+      QS::EntityCapabilities behavior;
+      behavior.myKind = QS::EntityCapabilities::Kind::Behavior;
+      behavior.myType = "TestActor";
+      behavior.myBatchEvaluation = true;
+      abi.myCapabilities.push_back(behavior);
+      return abi;
+    }();
+    return abi;
+  }
+}
+
 GTEST_TEST(PluginTest, testConstruction)
 {
   // Test loading plugin with missing library
@@ -37,3 +79,50 @@ GTEST_TEST(PluginTest, testConstruction)
     FAIL() << "Unexpected exception type thrown.";
   }
 }
+
+GTEST_TEST(PluginTest, testStaticPlugin)
+{
+  std::shared_ptr<QS::PluginDefinition> pluginDef(
+    new QS::PluginDefinition(""));
+  pluginDef->setLibrary("libStaticPlugin.so");
+  pluginDef->setName("StaticPlugin");
+  pluginDef->setActorCreatorDestructor("actorCreator", "actorDestructor");
+
+  QS::StaticPlugin staticPlugin;
+  staticPlugin.myABI = &testPluginABI;
+  staticPlugin.myFunctions["actorCreator"] =
+    reinterpret_cast<void*>(&testActorCreator);
+  try
+  {
+    QS::Plugin plugin(pluginDef, staticPlugin);
+    FAIL() << "Unexpectedly successfully loaded plugin.";
+  }
+  catch (const std::runtime_error &exception)
+  {
+    EXPECT_EQ("Failed to load Actor destructor function 'actorDestructor' "
+              "from library libStaticPlugin.so: not linked in.",
+              std::string(exception.what()));
+  }
+  catch (...)
+  {
+    FAIL() << "Unexpected exception type thrown.";
+  }
+
+  staticPlugin.myFunctions["actorDestructor"] =
+    reinterpret_cast<void*>(&testActorDestructor);
+  QS::Plugin plugin(pluginDef, staticPlugin);
+  EXPECT_EQ(4u, plugin.getABIVersion());
+  const auto &actor = plugin.getCapabilities(
+    QS::EntityCapabilities::Kind::Actor, "TestActor");
+  EXPECT_TRUE(actor.myShareable);
+  EXPECT_FALSE(actor.myBatchEvaluation);
+  const auto &behavior = plugin.getCapabilities(
+    QS::EntityCapabilities::Kind::Behavior, "TestActor");
+  EXPECT_FALSE(behavior.myShareable);
+  EXPECT_TRUE(behavior.myBatchEvaluation);
+  EXPECT_FALSE(plugin.getCapabilities(
+    QS::EntityCapabilities::Kind::Sensor, "TestActor").myShareable);
+  EXPECT_EQ(nullptr, plugin.createActor("TestActor", {}, ""));
+  plugin.destroyActor(nullptr);
+  EXPECT_EQ(1, glbActorsDestroyed);
+}
@@ -0,0 +1,140 @@
+/**
+ * @file PoissonDiskSamplerTest.cpp
+ * @brief Unit test of PoissonDiskSampler class
+ *
+ * @author Michael Albers
+ */
+
+#include <stdexcept>
+#include <vector>
+#include "gtest/gtest.h"
+#include "Actor.h"
+#include "Metrics.h"
+#include "PoissonDiskSampler.h"
+#include "TestUtils.h"
+#include "World.h"
+
+static QS::Metrics glbMetrics;
+
+GTEST_TEST(PoissonDiskSamplerTest, construction)
+{
+  QS::World world(glbMetrics);
+  world.setDimensions(20.0, 10.0);
+
+  EXPECT_NO_THROW(QS::PoissonDiskSampler sampler(world, 0));
+  EXPECT_NO_THROW(QS::PoissonDiskSampler(world, {0.0, 0.0}, {20.0, 10.0}, 0));
+  EXPECT_THROW(QS::PoissonDiskSampler(world, {-1.0, 0.0}, {5.0, 5.0}, 0),
+               std::invalid_argument);
+  EXPECT_THROW(QS::PoissonDiskSampler(world, {0.0, 0.0}, {5.0, 10.5}, 0),
+               std::invalid_argument);
+  EXPECT_THROW(QS::PoissonDiskSampler(world, {5.0, 5.0}, {5.0, 6.0}, 0),
+               std::invalid_argument);
+}
+
+GTEST_TEST(PoissonDiskSamplerTest, positions)
+{
+  QS::World world(glbMetrics);
+  world.setDimensions(100.0, 100.0);
+  world.setSeed(7);
+
+  // Existing Actor which must be avoided.
+  auto actorProperties = QS::TestUtils::getMinimalActorProperties();
+  actorProperties["radius"] = "5.0";
+  QS::Actor actor(actorProperties, "");
+  actor.setPosition({25.0, 25.0});
+  world.addActor(&actor);
+
+  Eigen::Vector2f minimum{10.0, 10.0};
+  Eigen::Vector2f maximum{60.0, 40.0};
+  QS::PoissonDiskSampler sampler(world, minimum, maximum, 1);
+
+  std::vector<float> radii;
+  for (auto ii = 0; ii < 400; ++ii)
+  {
+    radii.push_back(0.3 + (ii % 4) * 0.1);
+  }
+  auto positions = sampler.getPositions(radii);
+  ASSERT_EQ(radii.size(), positions.size());
+
+  for (auto ii = 0u; ii < positions.size(); ++ii)
+  {
+    EXPECT_GE(positions[ii].x() - radii[ii], minimum.x());
+    EXPECT_LE(positions[ii].x() + radii[ii], maximum.x());
+    EXPECT_GE(positions[ii].y() - radii[ii], minimum.y());
+    EXPECT_LE(positions[ii].y() + radii[ii], maximum.y());
+    EXPECT_FALSE(world.checkOverlap(positions[ii], radii[ii],
+                                    actor.getPosition(), actor.getRadius()));
+    for (auto jj = ii + 1; jj < positions.size(); ++jj)
+    {
+      ASSERT_FALSE(world.checkOverlap(positions[ii], radii[ii],
+                                      positions[jj], radii[jj]))
+        << ii << " " << jj;
+    }
+  }
+
+  // Same seed and entity, same positions, whatever else has drawn random
+  // numbers in between.
+  QS::World world2(glbMetrics);
+  world2.setDimensions(100.0, 100.0);
+  world2.setSeed(7);
+  world2.addActor(&actor);
+  QS::PoissonDiskSampler other(world2, 0);
+  other.getPosition(1.0);
+  QS::PoissonDiskSampler sampler2(world2, minimum, maximum, 1);
+  EXPECT_EQ(positions, sampler2.getPositions(radii));
+}
+
+GTEST_TEST(PoissonDiskSamplerTest, full)
+{
+  QS::World world(glbMetrics);
+  world.setDimensions(10.0, 10.0);
+  world.setSeed(3);
+
+  QS::PoissonDiskSampler sampler(world, 0);
+  EXPECT_THROW(sampler.getPosition(5.1), std::invalid_argument);
+
+  // The region fills up before this many Actors fit.
+  EXPECT_THROW(
+    {
+      for (auto ii = 0; ii < 1000; ++ii)
+      {
+        sampler.getPosition(0.5);
+      }
+    }, std::logic_error);
+}
+
+GTEST_TEST(PoissonDiskSamplerTest, mixedRadii)
+{
+  QS::World world(glbMetrics);
+  world.setDimensions(10.0, 10.0);
+  world.setSeed(1);
+
+  // Large Actors soon run out of room. The positions they give up on are
+  // still grown from by the small Actors, which all fit.
+  QS::PoissonDiskSampler sampler(world, 0);
+  std::vector<Eigen::Vector2f> positions;
+  std::vector<float> radii;
+  for (auto ii = 0; ii < 150; ++ii)
+  {
+    try
+    {
+      positions.push_back(sampler.getPosition(1.0));
+      radii.push_back(1.0);
+    }
+    catch (const std::logic_error&)
+    {
+    }
+    ASSERT_NO_THROW(positions.push_back(sampler.getPosition(0.2))) << ii;
+    radii.push_back(0.2);
+  }
+
+  for (auto ii = 0u; ii < positions.size(); ++ii)
+  {
+    for (auto jj = ii + 1; jj < positions.size(); ++jj)
+    {
+      ASSERT_FALSE(world.checkOverlap(positions[ii], radii[ii],
+                                      positions[jj], radii[jj]))
+        << ii << " " << jj;
+    }
+  }
+}
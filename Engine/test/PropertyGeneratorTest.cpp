@@ -85,8 +85,8 @@ GTEST_TEST(PropertyGeneratorTest, generation)
       std::make_tuple("world.lEngTh", std::to_string(length)),
       std::make_tuple("world.lEngTh", std::to_string(length)),
       std::make_tuple("this.goodProp", std::to_string(goodPropertyValue)),
-      std::make_tuple("rAnD(1.0, 2.0)", "1.417022"),
-      std::make_tuple("rAnDColoR()", "0.997185 0.720325 0.932557"),
+      std::make_tuple("rAnD(1.0, 2.0)", "1.890259"),
+      std::make_tuple("rAnDColoR()", "0.894685 0.585726 0.711268"),
       };
 
     for (auto test : tests)
@@ -178,3 +178,71 @@ GTEST_TEST(PropertyGeneratorTest, generation)
     }
   }
 }
+
+GTEST_TEST(PropertyGeneratorTest, index)
+{
+  QS::PropertyGenerator propertyGenerator(glbWorld);
+  QS::SimulationEntityConfiguration entityConfig("", "", "");
+  entityConfig.addProperty("index", "99");
+
+  EXPECT_EQ("0.000000",
+            propertyGenerator.generateProperty(":group.index", entityConfig));
+
+  propertyGenerator.setIndex(41);
+  EXPECT_EQ("41.000000",
+            propertyGenerator.generateProperty(":group.index", entityConfig));
+  EXPECT_EQ("42.000000",
+            propertyGenerator.generateProperty(":GROUP.Index + 1",
+                                               entityConfig));
+  // A property named index is still a property.
+  EXPECT_EQ("99.000000",
+            propertyGenerator.generateProperty(":this.index", entityConfig));
+  // Pass-through values are untouched.
+  EXPECT_EQ("group.index",
+            propertyGenerator.generateProperty("group.index", entityConfig));
+}
+
+GTEST_TEST(PropertyGeneratorTest, compiled)
+{
+  glbWorld.setSeed(7);
+  QS::PropertyGenerator propertyGenerator(glbWorld);
+  QS::SimulationEntityConfiguration entityConfig("", "", "");
+  entityConfig.addProperty("radius", "1.5");
+
+  // A compiled property is re-evaluated each time, not its result re-used.
+  auto first = propertyGenerator.generateProperty(":rand(1.0, 2.0)",
+                                                  entityConfig);
+  auto second = propertyGenerator.generateProperty(":rand(1.0, 2.0)",
+                                                   entityConfig);
+  EXPECT_NE(first, second);
+
+  EXPECT_EQ("3.000000",
+            propertyGenerator.generateProperty(":this.radius * 2",
+                                               entityConfig));
+  QS::SimulationEntityConfiguration otherConfig("", "", "");
+  otherConfig.addProperty("radius", "0.25");
+  EXPECT_EQ("0.500000",
+            propertyGenerator.generateProperty(":this.radius * 2",
+                                               otherConfig));
+  QS::SimulationEntityConfiguration emptyConfig("", "", "");
+  EXPECT_THROW(propertyGenerator.generateProperty(":this.radius * 2",
+                                                  emptyConfig),
+               std::runtime_error);
+
+  // Same sequence from a new generator given the same seed.
+  glbWorld.setSeed(7);
+  QS::PropertyGenerator newGenerator(glbWorld);
+  EXPECT_EQ(first, newGenerator.generateProperty(":rand(1.0, 2.0)",
+                                                 entityConfig));
+  EXPECT_EQ(second, newGenerator.generateProperty(":rand(1.0, 2.0)",
+                                                  entityConfig));
+
+  // Each entity has its own sequence, restarted by setEntity.
+  newGenerator.setEntity(1);
+  auto otherEntity = newGenerator.generateProperty(":rand(1.0, 2.0)",
+                                                   entityConfig);
+  EXPECT_NE(first, otherEntity);
+  newGenerator.setEntity(0);
+  EXPECT_EQ(first, newGenerator.generateProperty(":rand(1.0, 2.0)",
+                                                 entityConfig));
+}
@@ -0,0 +1,219 @@
+/**
+ * @file ScenarioCacheTest.cpp
+ * @brief Unit test of ScenarioCache class
+ *
+ * @author Michael Albers
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include <vector>
+#include "gtest/gtest.h"
+#include "Metrics.h"
+#include "ScenarioCache.h"
+#include "SimulationEntityConfiguration.h"
+#include "World.h"
+
+class ScenarioCacheTest : public ::testing::Test
+{
+  public:
+  void SetUp() override
+  {
+    char directoryTemplate[] = "/tmp/ScenarioCacheTest_XXXXXX";
+    ASSERT_TRUE(nullptr != ::mkdtemp(directoryTemplate));
+    myDirectory = directoryTemplate;
+    QS::ScenarioCache::enable(myDirectory);
+  }
+
+  void TearDown() override
+  {
+    QS::ScenarioCache::disable();
+    std::string removalCmd{"/bin/rm -rf "};
+    removalCmd += myDirectory;
+    ::system(removalCmd.c_str());
+  }
+
+  std::string myDirectory;
+};
+
+namespace
+{
+  void expectEqual(const QS::SimulationEntityConfiguration &theExpected,
+                   const QS::SimulationEntityConfiguration &theActual)
+  {
+    EXPECT_EQ(theExpected.getType(), theActual.getType());
+    EXPECT_EQ(theExpected.getSource(), theActual.getSource());
+    EXPECT_EQ(theExpected.getTag(), theActual.getTag());
+    EXPECT_EQ(theExpected.getProperties(), theActual.getProperties());
+    auto expectedDependencies = theExpected.getDependencyConfigurations();
+    auto actualDependencies = theActual.getDependencyConfigurations();
+    ASSERT_EQ(expectedDependencies.size(), actualDependencies.size());
+    for (auto ii = 0u; ii < expectedDependencies.size(); ++ii)
+    {
+      expectEqual(expectedDependencies[ii], actualDependencies[ii]);
+    }
+  }
+}
+
+TEST_F(ScenarioCacheTest, key)
+{
+  std::string file1{myDirectory + "/a.xml"};
+  std::string file2{myDirectory + "/b.xml"};
+  std::ofstream(file1) << "<Simulation/>";
+  std::ofstream(file2) << "<Plugin/>";
+
+  auto key = QS::ScenarioCache::getKey({file1, file2});
+  EXPECT_EQ(key, QS::ScenarioCache::getKey({file1, file2}));
+  EXPECT_NE(key, QS::ScenarioCache::getKey({file2, file1}));
+  EXPECT_NE(key, QS::ScenarioCache::getKey({file1}));
+
+  std::ofstream(file2) << "<Plugin />";
+  EXPECT_NE(key, QS::ScenarioCache::getKey({file1, file2}));
+
+  // Plugins linked in have a definition but no file.
+  key = QS::ScenarioCache::getKey({file1}, {"<Plugin/>"});
+  EXPECT_EQ(key, QS::ScenarioCache::getKey({file1}, {"<Plugin/>"}));
+  EXPECT_NE(key, QS::ScenarioCache::getKey({file1}, {"<Plugin />"}));
+  EXPECT_NE(key, QS::ScenarioCache::getKey({file1}));
+
+  EXPECT_THROW(QS::ScenarioCache::getKey({myDirectory + "/none.xml"}),
+               std::runtime_error);
+
+  // The build ID identifies this test executable, and doesn't change.
+  EXPECT_NE(0u, QS::ScenarioCache::getBuildId());
+  EXPECT_EQ(QS::ScenarioCache::getBuildId(),
+            QS::ScenarioCache::getBuildId());
+
+  EXPECT_EQ(myDirectory + "/Big-00000000000000ff.qsc",
+            QS::ScenarioCache::getFileName("/some/where/Big.xml", 0xff));
+}
+
+TEST_F(ScenarioCacheTest, writeAndLoad)
+{
+  QS::SimulationEntityConfiguration sensor("NearestN", "", "BasicPlugin");
+  sensor.addProperty("N", "15");
+  QS::SimulationEntityConfiguration behavior("Seek", "", "BasicPlugin");
+  behavior.addDependencyConfiguration(sensor);
+  QS::SimulationEntityConfiguration behaviorSet("Set", "tag", "BasicPlugin");
+  behaviorSet.addDependencyConfiguration(behavior);
+
+  std::vector<QS::SimulationEntityConfiguration> actors;
+  for (auto ii = 0; ii < 3; ++ii)
+  {
+    actors.emplace_back("BasicActor", "", "BasicPlugin");
+    actors.back().addProperty("radius", "0.5");
+    actors.back().addProperty("x", std::to_string(ii * 2.0 + 1.0));
+    actors.back().addProperty("y", "1.000000");
+    actors.back().addDependencyConfiguration(behaviorSet);
+  }
+  QS::SimulationEntityConfiguration exit("BasicExit", "", "BasicPlugin");
+  exit.addProperty("radius", "1.0");
+
+  QS::Metrics metrics;
+  QS::World world(metrics);
+  std::string fileName = QS::ScenarioCache::getFileName("Sim.xml", 42);
+  {
+    QS::ScenarioCache cache(fileName, 42);
+    cache.setSeed(1234);
+    world.setSeed(1234);
+    cache.setDimensions(20.0, 30.0);
+    for (const auto &actor : actors)
+    {
+      cache.addActor(actor);
+    }
+    cache.addExit(exit);
+    cache.finish(world);
+  }
+
+  QS::Metrics loadedMetrics;
+  QS::World loadedWorld(loadedMetrics);
+  std::vector<QS::SimulationEntityConfiguration> loadedActors;
+  std::vector<QS::SimulationEntityConfiguration> loadedExits;
+  auto addActor = [&](const QS::SimulationEntityConfiguration &theConfig)
+  {
+    loadedActors.push_back(theConfig);
+  };
+  auto addExit = [&](const QS::SimulationEntityConfiguration &theConfig)
+  {
+    loadedExits.push_back(theConfig);
+  };
+
+  // Wrong key or no file: nothing loaded.
+  EXPECT_FALSE(QS::ScenarioCache::load(fileName, 43, loadedWorld, addActor,
+                                       addExit));
+  EXPECT_FALSE(QS::ScenarioCache::load(fileName + "x", 42, loadedWorld,
+                                       addActor, addExit));
+  EXPECT_TRUE(loadedActors.empty());
+
+  ASSERT_TRUE(QS::ScenarioCache::load(fileName, 42, loadedWorld, addActor,
+                                      addExit));
+  EXPECT_FLOAT_EQ(20.0, std::get<0>(loadedWorld.getDimensions()));
+  EXPECT_FLOAT_EQ(30.0, std::get<1>(loadedWorld.getDimensions()));
+  EXPECT_EQ(world.getRandomState(), loadedWorld.getRandomState());
+
+  ASSERT_EQ(actors.size(), loadedActors.size());
+  for (auto ii = 0u; ii < actors.size(); ++ii)
+  {
+    expectEqual(actors[ii], loadedActors[ii]);
+  }
+  ASSERT_EQ(1u, loadedExits.size());
+  expectEqual(exit, loadedExits[0]);
+
+  // A corrupt file is a cache miss and nothing is loaded, even if the
+  // corruption is after the Actors. Here the length of the random number
+  // generator state in the End record, just before the string table.
+  std::uint64_t stringTableOffset;
+  {
+    std::fstream file(fileName, std::ios::binary | std::ios::in |
+                      std::ios::out);
+    file.seekg(32);
+    file.read(reinterpret_cast<char*>(&stringTableOffset),
+              sizeof(stringTableOffset));
+    file.seekp(stringTableOffset - world.getRandomState().size() - 4);
+    std::uint32_t badLength = 0xffffffff;
+    file.write(reinterpret_cast<const char*>(&badLength), sizeof(badLength));
+  }
+  loadedActors.clear();
+  QS::Metrics corruptMetrics;
+  QS::World corruptWorld(corruptMetrics);
+  EXPECT_FALSE(QS::ScenarioCache::load(fileName, 42, corruptWorld, addActor,
+                                       addExit));
+  EXPECT_TRUE(loadedActors.empty());
+  EXPECT_FLOAT_EQ(0.0, std::get<0>(corruptWorld.getDimensions()));
+
+  // As is a truncated one.
+  ASSERT_EQ(0, ::truncate(fileName.c_str(), 60));
+  EXPECT_FALSE(QS::ScenarioCache::load(fileName, 42, corruptWorld, addActor,
+                                       addExit));
+}
+
+TEST_F(ScenarioCacheTest, missingDirectory)
+{
+  // Caches can't be written, but that isn't an error for a Simulation (see
+  // Simulation::readSimulation).
+  QS::ScenarioCache::enable(myDirectory + "/none");
+  std::string fileName = QS::ScenarioCache::getFileName("Sim.xml", 7);
+  EXPECT_THROW(QS::ScenarioCache(fileName, 7), std::runtime_error);
+
+  QS::Metrics metrics;
+  QS::World world(metrics);
+  auto ignore = [](const QS::SimulationEntityConfiguration&) {};
+  EXPECT_FALSE(QS::ScenarioCache::load(fileName, 7, world, ignore, ignore));
+}
+
+TEST_F(ScenarioCacheTest, unfinished)
+{
+  std::string fileName = QS::ScenarioCache::getFileName("Sim.xml", 7);
+  {
+    QS::ScenarioCache cache(fileName, 7);
+    cache.setSeed(1);
+  }
+  QS::Metrics metrics;
+  QS::World world(metrics);
+  auto ignore = [](const QS::SimulationEntityConfiguration&) {};
+  EXPECT_FALSE(QS::ScenarioCache::load(fileName, 7, world, ignore, ignore));
+}
@@ -202,6 +202,29 @@ GTEST_TEST(SpatialHashTest, hashing)
   }
 }
 
+GTEST_TEST(SpatialHashTest, largeRadius)
+{
+  auto actorProperties = QS::TestUtils::getMinimalActorProperties();
+  actorProperties["radius"] = "0.5";
+  QS::Actor near(actorProperties, "");
+  QS::Actor far(actorProperties, "");
+  QS::Actor outside(actorProperties, "");
+
+  // Cells are 5m; the query circle spans several of them.
+  QS::SpatialHash hash(50.0, 50.0, 1.0);
+  near.setPosition({1.0, 1.0});
+  hash.hashActor(&near);
+  far.setPosition({12.0, 1.0});
+  hash.hashActor(&far);
+  outside.setPosition({40.0, 40.0});
+  hash.hashActor(&outside);
+
+  auto actors = hash.getActors({1.0, 1.0}, 12.0);
+  EXPECT_EQ(2u, actors.size());
+  EXPECT_NE(actors.end(), actors.find(&near));
+  EXPECT_NE(actors.end(), actors.find(&far));
+}
+
 GTEST_TEST(SpatialHashTest, removeActor)
 {
   float width = 50.0;
@@ -0,0 +1,92 @@
+/**
+ * @file SweptCirclesTest.cpp
+ * @brief Unit test of SweptCircles class
+ *
+ * @author Michael Albers
+ */
+
+#define _USE_MATH_DEFINES // For M_PI
+#include <cmath>
+#include <random>
+#include "gtest/gtest.h"
+#include "SweptCircles.h"
+
+GTEST_TEST(SweptCirclesTest, clip)
+{
+  QS::SweptCircles circles;
+  Eigen::Vector2f position{0.0, 0.0};
+  Eigen::Vector2f motion{5.0, 0.0};
+
+  // Nothing in the way.
+  EXPECT_EQ(0u, circles.size());
+  EXPECT_EQ(motion, circles.clip(position, 1.0, motion));
+
+  // Behind, and missed by the path.
+  circles.add({-4.0, 0.0}, 1.0);
+  circles.add({3.0, 2.5}, 0.4);
+  EXPECT_EQ(2u, circles.size());
+  EXPECT_EQ(motion, circles.clip(position, 1.0, motion));
+  EXPECT_EQ(motion, circles.clipSequential(position, 1.0, motion));
+
+  // Head on, the nearer circle stops the motion.
+  circles.add({7.0, 0.0}, 1.0);
+  circles.add({4.0, 0.0}, 1.0);
+  Eigen::Vector2f expected{2.0, 0.0};
+  EXPECT_TRUE(expected.isApprox(circles.clip(position, 1.0, motion)));
+  EXPECT_TRUE(expected.isApprox(
+                circles.clipSequential(position, 1.0, motion)));
+
+  // Not moving.
+  EXPECT_EQ(Eigen::Vector2f::Zero(),
+            circles.clip(position, 1.0, Eigen::Vector2f::Zero()));
+
+  circles.clear();
+  EXPECT_EQ(0u, circles.size());
+  EXPECT_EQ(motion, circles.clip(position, 1.0, motion));
+}
+
+GTEST_TEST(SweptCirclesTest, sequential)
+{
+  // clip and clipSequential agree on random scenes of 0 to 28 circles, so
+  // counts both below and above the vector width, with and without a
+  // remainder, are covered.
+  std::mt19937 engine(7);
+  std::uniform_real_distribution<float> coordinate(-6.0, 6.0);
+  std::uniform_real_distribution<float> radius(0.1, 1.0);
+  std::uniform_real_distribution<float> angle(0.0, 2.0 * M_PI);
+  std::uniform_real_distribution<float> length(0.0, 8.0);
+
+  auto clipped = 0;
+  for (auto test = 0; test < 1000; ++test)
+  {
+    Eigen::Vector2f position{coordinate(engine), coordinate(engine)};
+    float movingRadius = radius(engine);
+
+    QS::SweptCircles circles;
+    auto count = test % 29;
+    while (circles.size() < static_cast<std::size_t>(count))
+    {
+      // Circles don't overlap the moving one to start with.
+      Eigen::Vector2f circlePosition{coordinate(engine), coordinate(engine)};
+      float circleRadius = radius(engine);
+      if ((circlePosition - position).norm() > circleRadius + movingRadius)
+      {
+        circles.add(circlePosition, circleRadius);
+      }
+    }
+
+    float motionAngle = angle(engine);
+    Eigen::Vector2f motion = length(engine) *
+      Eigen::Vector2f(std::cos(motionAngle), std::sin(motionAngle));
+    auto expected = circles.clipSequential(position, movingRadius, motion);
+    auto actual = circles.clip(position, movingRadius, motion);
+    EXPECT_NEAR(expected.x(), actual.x(), 1e-4) << test;
+    EXPECT_NEAR(expected.y(), actual.y(), 1e-4) << test;
+    if (expected != motion)
+    {
+      ++clipped;
+    }
+  }
+  // A good share of the cases actually hit something.
+  EXPECT_GT(clipped, 250);
+}
@@ -8,8 +8,13 @@
 #define _USE_MATH_DEFINES // For M_PI
 #include <cmath>
 #include <memory>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include "gtest/gtest.h"
 #include "Actor.h"
+#include "ActorUpdateCallback.h"
 #include "EigenHelper.h"
 #include "Metrics.h"
 #include "TestUtils.h"
@@ -17,6 +22,39 @@
 
 static QS::Metrics glbMetrics;
 
+namespace
+{
+  /** Actor heading straight for a point, without any BehaviorSet. */
+  class HomingActor : public QS::Actor
+  {
+    public:
+
+    HomingActor(const QS::PluginEntity::Properties &theProperties,
+                Eigen::Vector2f theTarget) :
+      QS::Actor(theProperties, ""),
+      myTarget(theTarget)
+    {
+    }
+
+    virtual Eigen::Vector2f evaluate(const QS::Sensable &theSensable)
+      override
+    {
+      return (myTarget - getPosition()) * 100.0;
+    }
+
+    Eigen::Vector2f myTarget;
+  };
+
+  class NoCallback : public QS::ActorUpdateCallback
+  {
+    public:
+
+    virtual void actorUpdate(const QS::Actor *theActor) noexcept override
+    {
+    }
+  };
+}
+
 GTEST_TEST(WorldTest, construction)
 {
   ASSERT_NO_THROW(QS::World world(glbMetrics));
@@ -144,13 +182,37 @@ GTEST_TEST(WorldTest, convertPointToWorld)
 GTEST_TEST(WorldTest, randomNumbers)
 {
   QS::World world(glbMetrics);
+  world.setDimensions(10.0, 10.0);
   world.setSeed(45);
-  std::uniform_real_distribution<float> distribution(3.0, 4.5);
-  float rng = world.getRandomNumber(distribution);
+  EXPECT_EQ(45u, world.getRNG().getSeed());
+  EXPECT_EQ(0u, world.getRNG().getFrame());
+  EXPECT_EQ("45 0", world.getRandomState());
 
-  // Not much to test since getRandomNumber is just a call to the RNG engine.
-  // All the real work is done by the C++ library.
-  EXPECT_FLOAT_EQ(4.4835172, rng);
+  QS::PluginEntity::Properties properties{
+    QS::TestUtils::getMinimalActorProperties()};
+  QS::Actor actor0(properties, "");
+  QS::Actor actor1(properties, "");
+  actor0.setPosition({2.0, 2.0});
+  actor1.setPosition({5.0, 5.0});
+  world.addActor(&actor0);
+  world.addActor(&actor1);
+
+  // Each Actor gets its own numbers, the same as the World's for its number.
+  auto random0 = actor0.getRandomStream(QS::CounterRNG::PLUGIN);
+  auto random1 = actor1.getRandomStream(QS::CounterRNG::PLUGIN);
+  QS::RandomStream expected0(world.getRNG(), 0, QS::CounterRNG::PLUGIN);
+  QS::RandomStream expected1(world.getRNG(), 1, QS::CounterRNG::PLUGIN);
+  auto value1 = random1();
+  EXPECT_EQ(expected0(), random0());
+  EXPECT_EQ(expected1(), value1);
+  EXPECT_NE(random0(), random1());
+
+  QS::World restored(glbMetrics);
+  restored.setRandomState("45 3");
+  EXPECT_EQ(45u, restored.getRNG().getSeed());
+  EXPECT_EQ(3u, restored.getRNG().getFrame());
+  EXPECT_THROW(restored.setRandomState("45"), std::invalid_argument);
+  EXPECT_THROW(restored.setRandomState("45 3 x"), std::invalid_argument);
 }
 
 GTEST_TEST(WorldTest, randomActorPosition)
@@ -185,13 +247,13 @@ GTEST_TEST(WorldTest, randomActorPosition)
   }
 
   // First test invalid radius
-  EXPECT_THROW(world.getRandomActorPosition(50.1, 1), std::invalid_argument);
+  EXPECT_THROW(world.getRandomActorPosition(50.1, 1, 0), std::invalid_argument);
 
   // Test valid generation
   try
   {
     float radius = 2.0;
-    Eigen::Vector2f position = world.getRandomActorPosition(radius, 10);
+    Eigen::Vector2f position = world.getRandomActorPosition(radius, 10, 0);
     for (auto actor : actors)
     {
       // checkOverlap is implicitly tested in addActor test.
@@ -212,7 +274,7 @@ GTEST_TEST(WorldTest, randomActorPosition)
   // Test passing the maximum number of attempts.
   try
   {
-    world.getRandomActorPosition(49.0, 1000);
+    world.getRandomActorPosition(49.0, 1000, 0);
     FAIL() << "Unexpectedly didn't throw.";
   }
   catch (const std::invalid_argument &e)
@@ -229,3 +291,71 @@ GTEST_TEST(WorldTest, randomActorPosition)
     FAIL() << "Threw unexpected exception.";
   }
 }
+
+GTEST_TEST(WorldTest, parallelCollisions)
+{
+  // A ring of Actors all heading for its center, with the given number of
+  // threads. Returns where they end up.
+  auto run = [](int theThreads) -> std::vector<Eigen::Vector2f>
+  {
+#ifdef _OPENMP
+    omp_set_num_threads(theThreads);
+#endif
+    QS::Metrics metrics;
+    QS::World world(metrics);
+    world.setDimensions(40, 40);
+
+    auto properties = QS::TestUtils::getMinimalActorProperties();
+    Eigen::Vector2f center{20.0, 20.0};
+    std::vector<std::shared_ptr<QS::Actor>> actors;
+    for (auto ii = 0; ii < 24; ++ii)
+    {
+      float angle = 2.0 * M_PI * ii / 24;
+      std::shared_ptr<QS::Actor> actor(new HomingActor(properties, center));
+      actor->setPosition(
+        center + 15.0 * Eigen::Vector2f(std::cos(angle), std::sin(angle)));
+      world.addActor(actor.get());
+      actors.push_back(actor);
+    }
+    world.initializeActorMetrics();
+
+    NoCallback callback;
+    for (auto step = 0; step < 60; ++step)
+    {
+      world.update(0.1, callback);
+      for (auto ii = 0u; ii < actors.size(); ++ii)
+      {
+        for (auto jj = ii + 1; jj < actors.size(); ++jj)
+        {
+          float distance =
+            (actors[ii]->getPosition() - actors[jj]->getPosition()).norm();
+          EXPECT_GT(distance, 2.0 - QS::EigenHelper::FLOAT_TOLERANCE)
+            << "Step " << step << ", Actors " << ii << " and " << jj;
+        }
+      }
+    }
+
+    std::vector<Eigen::Vector2f> positions;
+    for (auto actor : actors)
+    {
+      positions.push_back(actor->getPosition());
+    }
+    return positions;
+  };
+
+#ifdef _OPENMP
+  // Later tests run with the usual number of threads.
+  int threads = omp_get_max_threads();
+#endif
+  QS::World::enableParallelCollisions();
+  auto positions = run(1);
+  EXPECT_EQ(positions, run(4));
+  QS::World::disableParallelCollisions();
+#ifdef _OPENMP
+  omp_set_num_threads(threads);
+#endif
+
+  // Actors did actually get closer.
+  Eigen::Vector2f center{20.0, 20.0};
+  EXPECT_LT((positions[0] - center).norm(), 5.0);
+}
@@ -0,0 +1,144 @@
+/**
+ * @file XMLParserTest.cpp
+ * @brief Unit test of the XMLParser class.
+ *
+ * @author Michael Albers
+ */
+
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include "xercesc/sax/SAXParseException.hpp"
+#include "xercesc/sax2/DefaultHandler.hpp"
+#include "gtest/gtest.h"
+#include "XMLParser.h"
+
+namespace
+{
+  /**
+   * Counts elements and throws on any error, the same as the readers.
+   */
+  class CountingHandler : public DefaultHandler
+  {
+    public:
+    void error(const SAXParseException &e) override
+    {
+      throw e;
+    }
+
+    void fatalError(const SAXParseException &e) override
+    {
+      throw e;
+    }
+
+    void startElement(const XMLCh *const uri, const XMLCh *const localname,
+                      const XMLCh *const qname,
+                      const Attributes &attrs) override
+    {
+      ++myElements;
+    }
+
+    void warning(const SAXParseException &e) override
+    {
+      throw e;
+    }
+
+    int myElements = 0;
+  };
+
+  const std::string glbSchema{std::string(QS_PLUGIN_SCHEMA_DIR) +
+                              "/PluginConfig.xsd"};
+
+  const std::string glbXMLFile{"/tmp/XMLParserTest.xml"};
+
+  const std::string glbHashFile{"/tmp/XMLParserTest.hashes"};
+
+  void writeFile(const std::string &theContents)
+  {
+    std::ofstream file(glbXMLFile, std::ios::trunc);
+    ASSERT_TRUE(file.is_open());
+    file << theContents;
+  }
+
+  int countLines(const std::string &theFile)
+  {
+    std::ifstream file(theFile);
+    std::string line;
+    int lines = 0;
+    while (std::getline(file, line))
+    {
+      ++lines;
+    }
+    return lines;
+  }
+
+  // Missing the required library attribute.
+  const std::string glbInvalid{
+    "<?xml version='1.0' encoding='UTF-8'?>\n<Plugin name=\"P\"/>\n"};
+
+  const std::string glbValid{
+    "<?xml version='1.0' encoding='UTF-8'?>\n"
+    "<Plugin name=\"P\" library=\"p.so\"/>\n"};
+}
+
+GTEST_TEST(XMLParserTest, validation)
+{
+  // The grammar is loaded on the first parse and reused afterwards; files
+  // are validated either way.
+  for (auto ii = 0; ii < 2; ++ii)
+  {
+    writeFile(glbValid);
+    CountingHandler handler;
+    EXPECT_NO_THROW(QS::XMLParser::parse(glbSchema, glbXMLFile, handler));
+    EXPECT_EQ(1, handler.myElements);
+
+    writeFile(glbInvalid);
+    EXPECT_THROW(QS::XMLParser::parse(glbSchema, glbXMLFile, handler),
+                 SAXParseException);
+  }
+
+  QS::XMLParser::releaseGrammars();
+  writeFile(glbInvalid);
+  CountingHandler handler;
+  EXPECT_THROW(QS::XMLParser::parse(glbSchema, glbXMLFile, handler),
+               SAXParseException);
+  ::unlink(glbXMLFile.c_str());
+}
+
+GTEST_TEST(XMLParserTest, trustedInput)
+{
+  ::unlink(glbHashFile.c_str());
+  QS::XMLParser::enableTrustedInput(glbHashFile);
+
+  writeFile(glbValid);
+  CountingHandler handler;
+  EXPECT_NO_THROW(QS::XMLParser::parse(glbSchema, glbXMLFile, handler));
+  EXPECT_EQ(1, countLines(glbHashFile));
+
+  // Already validated, no new hash.
+  EXPECT_NO_THROW(QS::XMLParser::parse(glbSchema, glbXMLFile, handler));
+  EXPECT_EQ(1, countLines(glbHashFile));
+
+  // Changed file is validated again.
+  writeFile(glbInvalid);
+  EXPECT_THROW(QS::XMLParser::parse(glbSchema, glbXMLFile, handler),
+               SAXParseException);
+  EXPECT_EQ(1, countLines(glbHashFile));
+
+  // Hashes are carried over.
+  QS::XMLParser::enableTrustedInput(glbHashFile);
+  writeFile(glbValid);
+  EXPECT_NO_THROW(QS::XMLParser::parse(glbSchema, glbXMLFile, handler));
+  EXPECT_EQ(1, countLines(glbHashFile));
+
+  {
+    std::ofstream hashFile(glbHashFile, std::ios::app);
+    hashFile << "not a hash" << std::endl;
+  }
+  EXPECT_THROW(QS::XMLParser::enableTrustedInput(glbHashFile),
+               std::runtime_error);
+
+  QS::XMLParser::disableTrustedInput();
+  ::unlink(glbHashFile.c_str());
+  ::unlink(glbXMLFile.c_str());
+}
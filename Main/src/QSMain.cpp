@@ -10,6 +10,10 @@
 #include "xercesc/util/PlatformUtils.hpp"
 #include "xercesc/util/XMLString.hpp"
 #include "ControlGUI.h"
+#include "EngineOptions.h"
+#include "PerfCounters.h"
+#include "Tracer.h"
+#include "XMLParser.h"
 
 XERCES_CPP_NAMESPACE_USE
 
@@ -26,8 +30,38 @@ int main(int argc, char **argv)
       throw std::runtime_error("QS_BASE_DIR environment variable is not set.");
     }
 
+    // Timeline tracing is opt-in, written at shutdown in Chrome trace-event
+    // format.
+    auto traceFileEnvVar = std::getenv("QS_TRACE_FILE");
+    if (NULL != traceFileEnvVar)
+    {
+      QS::Tracer::enable();
+      QS::Tracer::setThreadName("Control");
+    }
+
+    // Hardware counters are also opt-in. They're reported with the update
+    // phase timings in the simulation metrics.
+    if (NULL != std::getenv("QS_PERF_COUNTERS"))
+    {
+      if (! QS::PerfCounters::enable())
+      {
+        std::cerr << argv[0] << ": Warning: hardware performance counters "
+                  << "are not available." << std::endl;
+      }
+    }
+
+    // Opt-in engine features (scenario cache, batch evaluation, etc.).
+    QS::EngineOptions::enableFromEnvironment();
+
     status = QS::ControlGUI::run(argc, argv, baseDirEnvVar);
 
+    if (NULL != traceFileEnvVar)
+    {
+      QS::Tracer::disable();
+      QS::Tracer::writeFile(traceFileEnvVar);
+    }
+
+    QS::XMLParser::releaseGrammars();
     XMLPlatformUtils::Terminate();
     status = 0;
   }
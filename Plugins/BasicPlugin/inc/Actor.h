@@ -7,10 +7,13 @@
  * @author Michael Albers
  */
 
+#include <array>
+#include <cstdint>
 #include <functional>
 #include "DependencyManager.h"
 #include "EntityDependency.h"
 #include "PluginEntity.h"
+#include "RandomStream.h"
 #include "Eigen/Core"
 
 namespace QS
@@ -40,6 +43,9 @@ namespace QS
     /* Unit vector in Actor's default orientation. */
     static const Eigen::Vector2f DEFAULT_ORIENTATION;
 
+    /** Number of behavior state slots in each Actor. */
+    static constexpr std::size_t NUMBER_BEHAVIOR_STATES = 4;
+
     /**
      * Default constructor.
      */
@@ -89,6 +95,33 @@ namespace QS
      */
     virtual ~Actor() = default;
 
+    /**
+     * Reserves a behavior state slot (see getBehaviorState), in every Actor.
+     * The same key always gets the same slot, so it may be called each time
+     * a Behavior is created (i.e., as its plugin is loaded and unloaded for
+     * each simulation). Not to be called from static initializers, as it may
+     * throw.
+     *
+     * @param theKey
+     *          name of the state (i.e., "NearExitArrival.atPosition")
+     * @return slot
+     * @throws std::length_error
+     *           if all NUMBER_BEHAVIOR_STATES slots are reserved for other
+     *           keys
+     */
+    static std::size_t allocateBehaviorState(const std::string &theKey);
+
+    /**
+     * Whether the engine may evaluate this Actor in a batch with others (see
+     * BehaviorSet::evaluateBatch). A batched Actor isn't given to evaluate,
+     * the engine calls selectBehaviorSet and evaluates the BehaviorSet
+     * itself, so Actors which override evaluate must return false.
+     * selectBehaviorSet may be called more than once per update.
+     *
+     * @return true (this base implementation)
+     */
+    virtual bool canEvaluateInBatch() const noexcept;
+
     /**
      * Converts the given point (which is assumed to be in world space
      * coordinates) to local space coordinates.
@@ -125,6 +158,18 @@ namespace QS
      */
     virtual Eigen::Vector2f evaluate(const Sensable &theSensable);
 
+    /**
+     * Returns a value a Behavior keeps for this Actor from one update to the
+     * next. Behaviors may be shared by many Actors (see
+     * EntityManager::enableSharedBehaviorSets), so such state is kept in the
+     * Actor rather than the Behavior. Values are 0 until set.
+     *
+     * @param theSlot
+     *          slot, from allocateBehaviorState
+     * @return value
+     */
+    float getBehaviorState(std::size_t theSlot) const noexcept;
+
     /**
      * Returns the color of the Actor. The vector elements are the R, G, B
      * values, respectively. Each is a range suitable for OpenGL (0.0-1.0).
@@ -177,6 +222,18 @@ namespace QS
      */
     float getRadius() const noexcept;
 
+    /**
+     * Returns random numbers for this Actor in the current frame. Each
+     * stream gives the same numbers however many Actors there are and in
+     * whatever order they are evaluated. Actors not in a World use a
+     * generator seeded with 0.
+     *
+     * @param theStream
+     *          stream, CounterRNG::PLUGIN or above
+     * @return random numbers
+     */
+    RandomStream getRandomStream(std::uint32_t theStream) const noexcept;
+
     /**
      * Returns the velocity vector. Origin at Actor's current location.
      * Magnitude is in meters/second.
@@ -196,6 +253,17 @@ namespace QS
     virtual BehaviorSet* selectBehaviorSet(
       const Sensable &theSensable);
 
+    /**
+     * Sets a behavior state value (see getBehaviorState). Behaviors are given
+     * const Actors, so this is const too; it changes nothing else.
+     *
+     * @param theSlot
+     *          slot, from allocateBehaviorState
+     * @param theValue
+     *          value
+     */
+    void setBehaviorState(std::size_t theSlot, float theValue) const noexcept;
+
     /**
      * Sets the Actor's orientation angle offset from (1,0) vector. This
      * function will normalize the offet to [0,2*PI) regardless of the value
@@ -215,6 +283,18 @@ namespace QS
      */
     void setPosition(const Eigen::Vector2f &thePosition) noexcept;
 
+    /**
+     * Sets the generator for getRandomStream. Done by the World when the
+     * Actor is added.
+     *
+     * @param theRNG
+     *          generator, must outlive this object
+     * @param theNumber
+     *          number of the Actor in the World
+     */
+    void setRandomNumberGenerator(const CounterRNG &theRNG,
+                                  std::uint32_t theNumber) noexcept;
+
     /**
      * Sets the Actor's velocity. Origin at Actor's current location.
      *
@@ -241,6 +321,9 @@ namespace QS
 
     private:
 
+    /** Behavior state values, by slot (see getBehaviorState). */
+    mutable std::array<float, NUMBER_BEHAVIOR_STATES> myBehaviorStates{};
+
     /** Actor color, in RGB suitable for OpenGL (each value is 0.0-1.0)*/
     Eigen::Vector3f myColor;
 
@@ -253,6 +336,9 @@ namespace QS
     /** Maximum speed of the Actor. Negative value indicates no maximum. */
     float myMaximumSpeed_ms;
 
+    /** Number of the Actor in the World, for random numbers. */
+    std::uint32_t myNumber = 0;
+
     /** Angle offset from (1,0) vector. */
     float myOrientation_radians;
 
@@ -262,6 +348,9 @@ namespace QS
     /** Actor's radius, in meters. */
     float myRadius_m;
 
+    /** Generator of random numbers, null if not in a World. */
+    const CounterRNG *myRNG = nullptr;
+
     /**
      * Velocity vector, origin at Actor's current location. Measured
      * in meters per second.
@@ -0,0 +1,176 @@
+#pragma once
+
+/**
+ * @file ActorBatch.h
+ * @brief State of a set of Actors, one array per value, for batch evaluation.
+ *
+ * @author Michael Albers
+ */
+
+#include <cstddef>
+#include <vector>
+
+namespace QS
+{
+  class Actor;
+
+  /**
+   * Snapshot of the state of a set of Actors, laid out as one array per value
+   * (structure of arrays) so Behaviors evaluating many Actors at once (see
+   * Behavior::evaluateBatch) can loop over contiguous data. Actors are
+   * referred to by their index in the batch.
+   */
+  class ActorBatch
+  {
+    public:
+
+    /**
+     * Default constructor.
+     */
+    ActorBatch() = delete;
+
+    /**
+     * Constructor. Copies the current state of each Actor.
+     *
+     * @param theActors
+     *          Actors in the batch, in index order
+     */
+    ActorBatch(const std::vector<const Actor*> &theActors);
+
+    /**
+     * Copy constructor.
+     */
+    ActorBatch(const ActorBatch&) = default;
+
+    /**
+     * Move constructor.
+     */
+    ActorBatch(ActorBatch&&) = default;
+
+    /**
+     * Destructor.
+     */
+    ~ActorBatch() = default;
+
+    /**
+     * Returns the Actors.
+     *
+     * @return Actors, in index order
+     */
+    const std::vector<const Actor*>& getActors() const noexcept;
+
+    /**
+     * Returns the mass of each Actor.
+     *
+     * @return masses, in grams
+     */
+    const std::vector<float>& getMasses() const noexcept;
+
+    /**
+     * Returns the maximum force of each Actor.
+     *
+     * @return maximum forces
+     */
+    const std::vector<float>& getMaximumForces() const noexcept;
+
+    /**
+     * Returns the maximum speed of each Actor.
+     *
+     * @return maximum speeds, in m/s
+     */
+    const std::vector<float>& getMaximumSpeeds() const noexcept;
+
+    /**
+     * Returns the orientation of each Actor.
+     *
+     * @return orientations, in radians
+     */
+    const std::vector<float>& getOrientations() const noexcept;
+
+    /**
+     * Returns the x coordinate of the position of each Actor.
+     *
+     * @return x coordinates, in meters
+     */
+    const std::vector<float>& getPositionsX() const noexcept;
+
+    /**
+     * Returns the y coordinate of the position of each Actor.
+     *
+     * @return y coordinates, in meters
+     */
+    const std::vector<float>& getPositionsY() const noexcept;
+
+    /**
+     * Returns the radius of each Actor.
+     *
+     * @return radii, in meters
+     */
+    const std::vector<float>& getRadii() const noexcept;
+
+    /**
+     * Returns the x component of the velocity of each Actor.
+     *
+     * @return x components, in m/s
+     */
+    const std::vector<float>& getVelocitiesX() const noexcept;
+
+    /**
+     * Returns the y component of the velocity of each Actor.
+     *
+     * @return y components, in m/s
+     */
+    const std::vector<float>& getVelocitiesY() const noexcept;
+
+    /**
+     * Returns the number of Actors.
+     *
+     * @return number of Actors
+     */
+    std::size_t size() const noexcept;
+
+    /**
+     * Copy assignment operator.
+     */
+    ActorBatch& operator=(const ActorBatch&) = default;
+
+    /**
+     * Move assignment operator.
+     */
+    ActorBatch& operator=(ActorBatch&&) = default;
+
+    protected:
+
+    private:
+
+    /** Actors in the batch. */
+    std::vector<const Actor*> myActors;
+
+    /** Mass of each Actor. */
+    std::vector<float> myMasses;
+
+    /** Maximum force of each Actor. */
+    std::vector<float> myMaximumForces;
+
+    /** Maximum speed of each Actor. */
+    std::vector<float> myMaximumSpeeds;
+
+    /** Orientation of each Actor. */
+    std::vector<float> myOrientations;
+
+    /** X coordinate of each Actor. */
+    std::vector<float> myPositionsX;
+
+    /** Y coordinate of each Actor. */
+    std::vector<float> myPositionsY;
+
+    /** Radius of each Actor. */
+    std::vector<float> myRadii;
+
+    /** X velocity of each Actor. */
+    std::vector<float> myVelocitiesX;
+
+    /** Y velocity of each Actor. */
+    std::vector<float> myVelocitiesY;
+  };
+}
@@ -9,12 +9,22 @@
  * @author Michael Albers
  */
 
+#include <cstddef>
+#include <vector>
 #include "Eigen/Core"
 
 namespace QS
 {
   class Actor;
 
+  /**
+   * Separation also has a version taking the positions of the other Actors
+   * as arrays, which works on several at a time (see SimdLanes). It adds the
+   * pushes of the other Actors up in a fixed order whatever the instruction
+   * set, so its forces are the same on every build, but can differ very
+   * slightly from the version taking Actors. Users choose between them with
+   * isSimdSeparationEnabled, off unless enabled.
+   */
   class BasicBehaviors
   {
     public:
@@ -37,6 +47,18 @@ namespace QS
                                    const Eigen::Vector2f &thePosition,
                                    float theSlowingRadius);
 
+    /**
+     * Disables the SIMD version of separation.
+     */
+    static void disableSimdSeparation() noexcept;
+
+    /**
+     * Enables the SIMD version of separation, for users which check
+     * isSimdSeparationEnabled. It starts enabled if the QS_SIMD_SEPARATION
+     * environment variable is set (see EngineOptions).
+     */
+    static void enableSimdSeparation() noexcept;
+
     /**
      * Generates a force to move the Actor away from another Actor.
      *
@@ -64,6 +86,13 @@ namespace QS
                                 const Eigen::Vector2f &thePosition,
                                 float theDesiredSpeed) noexcept;
 
+    /**
+     * Returns whether users should call the SIMD version of separation.
+     *
+     * @return true if enabled
+     */
+    static bool isSimdSeparationEnabled() noexcept;
+
     /**
      * Generates a force to move the Actor toward another Actor.
      *
@@ -110,6 +139,35 @@ namespace QS
       const std::vector<const Actor*> &theActors,
       float theSeparationDistance);
 
+    /**
+     * Same as separation above, with the positions of the other Actors given
+     * as one array per coordinate (as NearestN::getPositionsX and
+     * getPositionsY), which are worked on several at a time. Other Actors at
+     * exactly the Actor's position don't push it.
+     *
+     * @param thePosition
+     *          position of the Actor trying to separate from the others
+     * @param theMass
+     *          mass of the Actor
+     * @param thePositionsX
+     *          x coordinate of each of the other Actors
+     * @param thePositionsY
+     *          y coordinate of each of the other Actors
+     * @param theNumberActors
+     *          number of other Actors
+     * @param theSeparationDistance
+     *          Scalaing factor to increase or decrease the separation distance
+     * @return force to separate the Actor from the others.
+     * @throws std::invalid_argument
+     *         if theSeparationDistance is negative
+     */
+    static Eigen::Vector2f separation(const Eigen::Vector2f &thePosition,
+                                      float theMass,
+                                      const float *thePositionsX,
+                                      const float *thePositionsY,
+                                      std::size_t theNumberActors,
+                                      float theSeparationDistance);
+
     protected:
 
     /**
@@ -126,7 +184,6 @@ namespace QS
     static Eigen::Vector2f evadePursuitHelper(const Actor *theActor,
                                               const Actor *theOtherActor,
                                               bool theEvade) noexcept;
-   
 
     /**
      * Guts of the seek &amp; flee behaviors since they are identical excepting
@@ -12,6 +12,8 @@
 
 namespace QS
 {
+  class Walk;
+
   class BasicWalk : public BehaviorSet
   {
     public:
@@ -55,6 +57,16 @@ namespace QS
     virtual Eigen::Vector2f evaluate(const Actor *theActor,
                                      const Sensable &theSensable) override;
 
+    /**
+     * Returns the 'Walk' Behavior steering forces unaltered.
+     *
+     * @see BehaviorSet::evaluateBatch
+     */
+    virtual bool evaluateBatch(const std::vector<std::size_t> &theIndexes,
+                               const ActorBatch &theBatch,
+                               std::vector<Eigen::Vector2f> &theForces)
+      override;
+
     /**
      * Copy assignment operator.
      */
@@ -67,6 +79,16 @@ namespace QS
 
     protected:
 
+    /**
+     * Binds the Walk Behavior.
+     *
+     * @throws std::invalid_argument if the dependency isn't one
+     */
+    virtual void bindDependencies() override;
+
     private:
+
+    /** Walk Behavior. */
+    Walk *myWalk = nullptr;
   };
 }
@@ -7,6 +7,7 @@
  * @author Michael Albers
  */
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -17,6 +18,7 @@
 namespace QS
 {
   class Actor;
+  class ActorBatch;
   class Sensor;
 
   /**
@@ -107,6 +109,29 @@ namespace QS
      */
     virtual Eigen::Vector2f evaluate(const Actor *theActor) = 0;
 
+    /**
+     * Evaluates a batch of Actors at once, as evaluate would each of them.
+     * This is optional; it allows an implementation to loop over the state
+     * of many Actors with no per-Actor virtual calls. No Sensable is given,
+     * so it is only suitable for Behaviors which need nothing beyond the
+     * Actors' state.
+     *
+     * This base implementation does nothing and returns false, in which case
+     * the engine evaluates each Actor individually.
+     *
+     * @param theIndexes
+     *          indexes (in theBatch) of the Actors to evaluate
+     * @param theBatch
+     *          state of the Actors
+     * @param theForces
+     *          OUT parameter, the steering force of each Actor is stored at
+     *          its index; sized to theBatch
+     * @return true if the Actors were evaluated
+     */
+    virtual bool evaluateBatch(const std::vector<std::size_t> &theIndexes,
+                               const ActorBatch &theBatch,
+                               std::vector<Eigen::Vector2f> &theForces);
+
     /**
      * Copy assignment operator.
      */
@@ -0,0 +1,144 @@
+#pragma once
+
+/**
+ * @file CounterRNG.h
+ * @brief Counter-based random number generator.
+ *
+ * @author Michael Albers
+ */
+
+#include <array>
+#include <cstdint>
+
+namespace QS
+{
+  /**
+   * Counter-based random number generator (Philox4x32-10, "Parallel Random
+   * Numbers: As Easy as 1, 2, 3", J. Salmon et al.). Random numbers are a
+   * pure function of the seed and a counter made of an Actor (or other
+   * entity) number, a frame, a stream and an index, rather than of how many
+   * numbers were drawn before. So draws for one Actor don't depend on those
+   * for any other, and results are the same whatever the order (or number of
+   * threads) in which entities are loaded or evaluated.
+   *
+   * Use a RandomStream to draw a sequence of numbers for one counter.
+   */
+  class CounterRNG
+  {
+    public:
+
+    /** Four random 32-bit values, the output for one counter. */
+    using Block = std::array<std::uint32_t, 4>;
+
+    /**
+     * Streams, separating the uses of random numbers for one entity in one
+     * frame. Plugins use PLUGIN and above.
+     */
+    enum Stream : std::uint32_t
+    {
+      /** Generated properties, see PropertyGenerator. */
+      PROPERTIES = 0,
+      /** Random Actor positions, see World::getRandomActorPosition. */
+      PLACEMENT = 1,
+      /** Poisson-disk positions, see PoissonDiskSampler. */
+      POISSON = 2,
+      /** First stream for plugins. */
+      PLUGIN = 256
+    };
+
+    /**
+     * Default constructor. Seed of 0.
+     */
+    CounterRNG() = default;
+
+    /**
+     * Constructor.
+     *
+     * @param theSeed
+     *          seed (key)
+     */
+    CounterRNG(std::uint64_t theSeed) noexcept;
+
+    /**
+     * Copy constructor.
+     */
+    CounterRNG(const CounterRNG&) = default;
+
+    /**
+     * Move constructor.
+     */
+    CounterRNG(CounterRNG&&) = default;
+
+    /**
+     * Destructor.
+     */
+    ~CounterRNG() = default;
+
+    /**
+     * Returns the random values for a counter.
+     *
+     * @param theEntity
+     *          Actor (or other entity) number
+     * @param theFrame
+     *          frame, 0 while loading
+     * @param theStream
+     *          stream
+     * @param theIndex
+     *          index of the block within the stream
+     * @return random values
+     */
+    Block generate(std::uint32_t theEntity, std::uint32_t theFrame,
+                   std::uint32_t theStream, std::uint32_t theIndex) const
+      noexcept;
+
+    /**
+     * Returns the current frame, used for streams made while it is current.
+     *
+     * @return frame, 0 while loading
+     */
+    std::uint32_t getFrame() const noexcept;
+
+    /**
+     * Returns the seed.
+     *
+     * @return seed
+     */
+    std::uint64_t getSeed() const noexcept;
+
+    /**
+     * Sets the current frame.
+     *
+     * @param theFrame
+     *          frame
+     */
+    void setFrame(std::uint32_t theFrame) noexcept;
+
+    /**
+     * Sets the seed.
+     *
+     * @param theSeed
+     *          seed
+     */
+    void setSeed(std::uint64_t theSeed) noexcept;
+
+    /**
+     * Copy assignment operator.
+     */
+    CounterRNG& operator=(const CounterRNG&) = default;
+
+    /**
+     * Move assignment operator.
+     */
+    CounterRNG& operator=(CounterRNG&&) = default;
+
+    protected:
+
+    private:
+
+    /** Current frame. */
+    std::uint32_t myFrame = 0;
+
+    /** Seed. */
+    std::uint64_t mySeed = 0;
+  };
+}
@@ -7,7 +7,9 @@
  * @author Michael Albers
  */
 
+#include <cstddef>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
 #include "EntityDependency.h"
@@ -16,6 +18,11 @@ namespace QS
 {
   /**
    * This class holds a list of EntityDependency objects.
+   *
+   * Entities which need their dependencies as a specific type override
+   * bindDependencies to look them up (see getDependency) once, when they are
+   * set, and keep the typed pointers; rather than searching and casting them
+   * each time they are used.
    */
   template<class T>
   class DependencyManager
@@ -46,7 +53,8 @@ namespace QS
      *
      * @return all dependencies
      */
-    virtual std::vector<EntityDependency<T>> getDependencies() const noexcept
+    virtual const std::vector<EntityDependency<T>>& getDependencies()
+      const noexcept
     {
       return myDependencies;
     }
@@ -62,11 +70,12 @@ namespace QS
     DependencyManager& operator=(DependencyManager&&) = default;
 
     /**
-     * Sets the dependencies.
+     * Sets the dependencies, then binds them (see bindDependencies).
      *
      * @param theDependencies
      *          new list of dependencies
-     * @throws std::invalid_argument if any dependency is invalid.
+     * @throws std::invalid_argument if any dependency is invalid, including
+     *         not being of the type the entity needs.
      */
     void setDependencies(
       const std::vector<EntityDependency<T>> &theDependencies)
@@ -76,7 +85,7 @@ namespace QS
         throw std::invalid_argument("Cannot have empty set of dependencies.");
       }
 
-      for (auto dependency : theDependencies)
+      for (const auto &dependency : theDependencies)
       {
         // For the time being, having an empty name or tag is OK. The name is
         // really just a key for the author and if they don't want it, I
@@ -91,10 +100,52 @@ namespace QS
       }
 
       myDependencies = theDependencies;
+      bindDependencies();
     }
 
     protected:
 
+    /**
+     * Called by setDependencies after the dependencies are set. Derived
+     * classes override this to keep typed pointers to their dependencies.
+     * This implementation does nothing.
+     *
+     * @throws std::invalid_argument if a dependency isn't what is needed
+     */
+    virtual void bindDependencies()
+    {
+    }
+
+    /**
+     * Returns a dependency as a specific type.
+     *
+     * @param theIndex
+     *          index of the dependency
+     * @return the dependency
+     * @throws std::invalid_argument if there is no such dependency or it isn't
+     *         a D
+     */
+    template<class D>
+    D* getDependency(std::size_t theIndex) const
+    {
+      if (theIndex >= myDependencies.size())
+      {
+        throw std::invalid_argument(
+          "Missing dependency " + std::to_string(theIndex) + ", only " +
+          std::to_string(myDependencies.size()) + " given.");
+      }
+
+      const auto &dependency = myDependencies[theIndex];
+      D *entity = dynamic_cast<D*>(dependency.myEntity);
+      if (nullptr == entity)
+      {
+        throw std::invalid_argument(
+          "Dependency " + std::to_string(theIndex) + " (type name '" +
+          dependency.myTypeName + "') is not of the needed type.");
+      }
+      return entity;
+    }
+
     /** Dependencies to track. */
     std::vector<EntityDependency<T>> myDependencies;
 
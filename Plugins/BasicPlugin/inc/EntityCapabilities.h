@@ -0,0 +1,59 @@
+#pragma once
+
+/**
+ * @file EntityCapabilities.h
+ * @brief What a plugin entity type supports, so the engine can choose how to
+ *        run it.
+ *
+ * @author Michael Albers
+ */
+
+#include <cstdint>
+#include <string>
+
+namespace QS
+{
+  /**
+   * Capabilities of a single entity type, declared by its plugin (see
+   * PluginABI). Every capability defaults to off, which is how all entities
+   * of plugins without a PluginABI are run.
+   */
+  class EntityCapabilities
+  {
+    public:
+
+    /**
+     * Kinds of entity. Types of different kinds may share a name.
+     */
+    enum class Kind : std::uint32_t
+    {
+      Actor,
+      BehaviorSet,
+      Behavior,
+      Sensor,
+      Exit
+    };
+
+    /** Kind of the entity type. */
+    Kind myKind = Kind::Actor;
+
+    /** Name of the entity type, as in the plugin definition file. */
+    std::string myType;
+
+    /**
+     * Entities of this type implement evaluateBatch and may be evaluated
+     * against the state at the start of an update (see
+     * World::enableBatchEvaluation).
+     */
+    bool myBatchEvaluation = false;
+
+    /**
+     * Entities of this type keep no per-Actor state between evaluations (any
+     * such state is kept in the Actor, see Actor::getBehaviorState), so one
+     * may be used by many Actors (see
+     * EntityManager::enableSharedBehaviorSets). A Sensor still holds the
+     * results for the Actor it last sensed.
+     */
+    bool myShareable = false;
+  };
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+/**
+ * @file PluginABI.h
+ * @brief Versioned description of a plugin library.
+ *
+ * @author Michael Albers
+ */
+
+#include <cstdint>
+#include <vector>
+#include "EntityCapabilities.h"
+
+namespace QS
+{
+  /**
+   * Description of a plugin library, returned by the function named
+   * PluginABI::FUNCTION which the library exports (extern "C", a
+   * PluginABI::Function). The returned object must live as long as the
+   * library is loaded.
+   *
+   * Libraries which don't export the function are ABI version 1: just the
+   * creator/destructor functions named in the plugin definition file, with
+   * no capabilities.
+   */
+  class PluginABI
+  {
+    public:
+
+    /** Signature of the function returning the description. */
+    using Function = const PluginABI&(*)();
+
+    /** Name of the function returning the description. */
+    static constexpr const char *FUNCTION = "qsPluginABI";
+
+    /** Current version. Bump when this class changes. */
+    static constexpr std::uint32_t VERSION = 4;
+
+    /** Version the plugin was built against, set to VERSION. */
+    std::uint32_t myVersion = VERSION;
+
+    /** Capabilities of the entity types, those not listed have none. */
+    std::vector<EntityCapabilities> myCapabilities;
+  };
+}
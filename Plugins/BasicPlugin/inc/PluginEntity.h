@@ -9,6 +9,7 @@
 
 #include <map>
 #include <string>
+#include "EntityCapabilities.h"
 
 namespace QS
 {
@@ -50,6 +51,14 @@ namespace QS
      */
     virtual ~PluginEntity() = default;
 
+    /**
+     * Returns the capabilities of the entity's type, as declared by its
+     * plugin.
+     *
+     * @return capabilities (none unless set by the engine)
+     */
+    const EntityCapabilities& getCapabilities() const noexcept;
+
     /**
      * Returns the entity's properties.
      *
@@ -65,6 +74,15 @@ namespace QS
      */
     std::string getTag() const noexcept;
 
+    /**
+     * Sets the capabilities of the entity's type. Called by the engine when
+     * it creates the entity.
+     *
+     * @param theCapabilities
+     *          capabilities
+     */
+    void setCapabilities(const EntityCapabilities &theCapabilities);
+
     /**
      * Copy assignment operator
      */
@@ -77,6 +95,9 @@ namespace QS
 
     protected:
 
+    /** Capabilities of the entity's type. */
+    EntityCapabilities myCapabilities;
+
     /** Properties. */
     Properties myProperties;
 
@@ -0,0 +1,140 @@
+#pragma once
+
+/**
+ * @file RandomStream.h
+ * @brief Sequence of random numbers for one CounterRNG counter.
+ *
+ * @author Michael Albers
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include "CounterRNG.h"
+
+namespace QS
+{
+  /**
+   * Sequence of random numbers from a CounterRNG for one entity, frame and
+   * stream. Numbers are drawn in order from the blocks of consecutive
+   * indexes, so the sequence depends only on those, not on any other stream.
+   *
+   * Satisfies the standard uniform random bit generator requirements, so it
+   * can also be used with the standard distributions.
+   */
+  class RandomStream
+  {
+    public:
+
+    /** Type of the raw random values. */
+    using result_type = std::uint32_t;
+
+    /**
+     * Default constructor.
+     */
+    RandomStream() = delete;
+
+    /**
+     * Constructor, for the current frame of the generator.
+     *
+     * @param theRNG
+     *          generator, must outlive this object
+     * @param theEntity
+     *          Actor (or other entity) number
+     * @param theStream
+     *          stream (see CounterRNG::Stream)
+     */
+    RandomStream(const CounterRNG &theRNG, std::uint32_t theEntity,
+                 std::uint32_t theStream) noexcept;
+
+    /**
+     * Copy constructor.
+     */
+    RandomStream(const RandomStream&) = default;
+
+    /**
+     * Move constructor.
+     */
+    RandomStream(RandomStream&&) = default;
+
+    /**
+     * Destructor.
+     */
+    ~RandomStream() = default;
+
+    /**
+     * Returns the largest raw value.
+     *
+     * @return largest value
+     */
+    static constexpr result_type max()
+    {
+      return std::numeric_limits<result_type>::max();
+    }
+
+    /**
+     * Returns the smallest raw value.
+     *
+     * @return smallest value
+     */
+    static constexpr result_type min()
+    {
+      return 0;
+    }
+
+    /**
+     * Returns the next number, uniformly distributed in [theLow, theHigh).
+     * Unlike the standard distributions, the result is the same with any
+     * standard library.
+     *
+     * @param theLow
+     *          smallest value
+     * @param theHigh
+     *          bound on the largest value
+     * @return random number
+     */
+    float uniform(float theLow, float theHigh) noexcept;
+
+    /**
+     * Returns the next raw value.
+     *
+     * @return random value
+     */
+    result_type operator()() noexcept;
+
+    /**
+     * Copy assignment operator.
+     */
+    RandomStream& operator=(const RandomStream&) = default;
+
+    /**
+     * Move assignment operator.
+     */
+    RandomStream& operator=(RandomStream&&) = default;
+
+    protected:
+
+    private:
+
+    /** Current block of values. */
+    CounterRNG::Block myBlock;
+
+    /** Entity number. */
+    std::uint32_t myEntity;
+
+    /** Frame. */
+    std::uint32_t myFrame;
+
+    /** Index of the next block. */
+    std::uint32_t myIndex = 0;
+
+    /** Generator. */
+    const CounterRNG *myRNG;
+
+    /** Stream. */
+    std::uint32_t myStream;
+
+    /** Values of myBlock already used. */
+    std::size_t myUsed;
+  };
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+/**
+ * @file StaticPlugin.h
+ * @brief Description of a plugin linked into the executable.
+ *
+ * @author Michael Albers
+ */
+
+#include <map>
+#include <string>
+#include "PluginABI.h"
+#include "QSConfig.h"
+
+/**
+ * Opens the block of a plugin's creator/destructor (and PluginABI) functions.
+ * Loaded at run time they are found by name, so have C linkage. Linked into
+ * the executable (QS_STATIC_PLUGINS) they are put in a namespace named after
+ * the plugin instead, so the functions of different plugins don't clash.
+ */
+#ifdef QS_STATIC_PLUGINS
+#define QS_PLUGIN_FUNCTIONS(thePlugin) namespace thePlugin
+#else
+#define QS_PLUGIN_FUNCTIONS(thePlugin) extern "C"
+#endif
+
+namespace QS
+{
+  /**
+   * A plugin linked into the executable (see QS_STATIC_PLUGINS), used in
+   * place of its definition file and library. Each such plugin provides a
+   * StaticPlugin::Function, qsStaticPlugin, in its QS_PLUGIN_FUNCTIONS block,
+   * which the PluginCollection lists at compile time. The returned object
+   * must live as long as the program.
+   */
+  class StaticPlugin
+  {
+    public:
+
+    /** Signature of the function returning the description. */
+    using Function = const StaticPlugin&(*)();
+
+    /** Functions of the plugin, keyed by the name dlsym would find. */
+    using Functions = std::map<std::string, void*>;
+
+    /** Name of the plugin definition file, for error messages. */
+    std::string myConfigFile;
+
+    /** Contents of the plugin definition file. */
+    std::string myDefinition;
+
+    /** Function returning the PluginABI, null if the plugin has none. */
+    PluginABI::Function myABI = nullptr;
+
+    /** Creator/destructor functions named in the definition. */
+    Functions myFunctions;
+  };
+}
@@ -63,6 +63,16 @@ namespace QS
      */
     virtual Eigen::Vector2f evaluate(const Actor *theActor) override;
 
+    /**
+     * Batch version of evaluate.
+     *
+     * @see Behavior::evaluateBatch
+     */
+    virtual bool evaluateBatch(const std::vector<std::size_t> &theIndexes,
+                               const ActorBatch &theBatch,
+                               std::vector<Eigen::Vector2f> &theForces)
+      override;
+
     /**
      * Copy assignment operator.
      */
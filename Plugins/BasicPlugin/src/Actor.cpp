@@ -7,6 +7,7 @@
 
 #define _USE_MATH_DEFINES // For M_PI
 #include <cmath>
+#include <map>
 #include <stdexcept>
 #include "Eigen/Geometry"
 #include "Actor.h"
@@ -14,8 +15,19 @@
 #include "EigenHelper.h"
 #include "PluginHelper.h"
 
+namespace
+{
+  /** Generator of Actors not in a World. */
+  const QS::CounterRNG glbDefaultRNG;
+
+  /** Behavior state slots reserved, by key. */
+  std::map<std::string, std::size_t> glbBehaviorStates;
+}
+
 const Eigen::Vector2f QS::Actor::DEFAULT_ORIENTATION(1, 0);
 
+constexpr std::size_t QS::Actor::NUMBER_BEHAVIOR_STATES;
+
 QS::Actor::Actor(const Properties &theProperties, const std::string &theTag) :
   PluginEntity(theProperties, theTag),
   myColor(1.0, 1.0, 1.0), // Use white as OpenGL clear color is black
@@ -65,6 +77,29 @@ QS::Actor::Actor(const Properties &theProperties, const std::string &theTag) :
   setColorFromProperty();
 }
 
+std::size_t QS::Actor::allocateBehaviorState(const std::string &theKey)
+{
+  auto state = glbBehaviorStates.find(theKey);
+  if (glbBehaviorStates.end() != state)
+  {
+    return state->second;
+  }
+  if (glbBehaviorStates.size() >= NUMBER_BEHAVIOR_STATES)
+  {
+    throw std::length_error("All " + std::to_string(NUMBER_BEHAVIOR_STATES) +
+                            " Actor behavior states are in use, none left "
+                            "for \"" + theKey + "\".");
+  }
+  auto slot = glbBehaviorStates.size();
+  glbBehaviorStates[theKey] = slot;
+  return slot;
+}
+
+bool QS::Actor::canEvaluateInBatch() const noexcept
+{
+  return true;
+}
+
 Eigen::Vector2f QS::Actor::convertPointToLocal(const Eigen::Vector2f &thePoint)
   const noexcept
 {
@@ -87,6 +122,11 @@ Eigen::Vector2f QS::Actor::evaluate(const Sensable &theSensable)
   return behaviorSet->evaluate(this, theSensable);
 }
 
+float QS::Actor::getBehaviorState(std::size_t theSlot) const noexcept
+{
+  return myBehaviorStates[theSlot];
+}
+
 Eigen::Vector3f QS::Actor::getColor() const noexcept
 {
   return myColor;
@@ -122,6 +162,12 @@ float QS::Actor::getRadius() const noexcept
   return myRadius_m;
 }
 
+QS::RandomStream QS::Actor::getRandomStream(std::uint32_t theStream) const
+  noexcept
+{
+  return RandomStream(myRNG ? *myRNG : glbDefaultRNG, myNumber, theStream);
+}
+
 Eigen::Vector2f QS::Actor::getVelocity() const noexcept
 {
   return myVelocity_ms;
@@ -130,7 +176,13 @@ Eigen::Vector2f QS::Actor::getVelocity() const noexcept
 QS::BehaviorSet* QS::Actor::selectBehaviorSet(
   const Sensable &theSensable)
 {
-  return dynamic_cast<BehaviorSet*>(getDependencies()[0].myEntity);
+  return getDependencies()[0].myEntity;
+}
+
+void QS::Actor::setBehaviorState(std::size_t theSlot, float theValue) const
+  noexcept
+{
+  myBehaviorStates[theSlot] = theValue;
 }
 
 void QS::Actor::setColorFromProperty()
@@ -185,6 +237,13 @@ void QS::Actor::setPositionFromProperty()
     myProperties, "y", true, PluginHelper::toFloat);
 }
 
+void QS::Actor::setRandomNumberGenerator(const CounterRNG &theRNG,
+                                         std::uint32_t theNumber) noexcept
+{
+  myRNG = &theRNG;
+  myNumber = theNumber;
+}
+
 void QS::Actor::setVelocity(const Eigen::Vector2f &theVelocity) noexcept
 {
   myVelocity_ms = theVelocity;
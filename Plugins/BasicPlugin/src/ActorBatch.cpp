@@ -0,0 +1,94 @@
+/**
+ * @file ActorBatch.cpp
+ * @brief Definition of ActorBatch
+ *
+ * @author Michael Albers
+ */
+
+#include "Actor.h"
+#include "ActorBatch.h"
+
+QS::ActorBatch::ActorBatch(const std::vector<const Actor*> &theActors) :
+  myActors(theActors)
+{
+  auto size = myActors.size();
+  myMasses.reserve(size);
+  myMaximumForces.reserve(size);
+  myMaximumSpeeds.reserve(size);
+  myOrientations.reserve(size);
+  myPositionsX.reserve(size);
+  myPositionsY.reserve(size);
+  myRadii.reserve(size);
+  myVelocitiesX.reserve(size);
+  myVelocitiesY.reserve(size);
+
+  for (auto actor : myActors)
+  {
+    auto position = actor->getPosition();
+    auto velocity = actor->getVelocity();
+    myMasses.push_back(actor->getMass());
+    myMaximumForces.push_back(actor->getMaximumForce());
+    myMaximumSpeeds.push_back(actor->getMaximumSpeed());
+    myOrientations.push_back(actor->getOrientation());
+    myPositionsX.push_back(position.x());
+    myPositionsY.push_back(position.y());
+    myRadii.push_back(actor->getRadius());
+    myVelocitiesX.push_back(velocity.x());
+    myVelocitiesY.push_back(velocity.y());
+  }
+}
+
+const std::vector<const QS::Actor*>& QS::ActorBatch::getActors() const noexcept
+{
+  return myActors;
+}
+
+const std::vector<float>& QS::ActorBatch::getMasses() const noexcept
+{
+  return myMasses;
+}
+
+const std::vector<float>& QS::ActorBatch::getMaximumForces() const noexcept
+{
+  return myMaximumForces;
+}
+
+const std::vector<float>& QS::ActorBatch::getMaximumSpeeds() const noexcept
+{
+  return myMaximumSpeeds;
+}
+
+const std::vector<float>& QS::ActorBatch::getOrientations() const noexcept
+{
+  return myOrientations;
+}
+
+const std::vector<float>& QS::ActorBatch::getPositionsX() const noexcept
+{
+  return myPositionsX;
+}
+
+const std::vector<float>& QS::ActorBatch::getPositionsY() const noexcept
+{
+  return myPositionsY;
+}
+
+const std::vector<float>& QS::ActorBatch::getRadii() const noexcept
+{
+  return myRadii;
+}
+
+const std::vector<float>& QS::ActorBatch::getVelocitiesX() const noexcept
+{
+  return myVelocitiesX;
+}
+
+const std::vector<float>& QS::ActorBatch::getVelocitiesY() const noexcept
+{
+  return myVelocitiesY;
+}
+
+std::size_t QS::ActorBatch::size() const noexcept
+{
+  return myActors.size();
+}
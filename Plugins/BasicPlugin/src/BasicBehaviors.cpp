@@ -5,21 +5,231 @@
  * @author Michael Albers
  */
 
+#include <cstdlib>
 #include <stdexcept>
 #include <string>
 #include "Actor.h"
 #include "BasicBehaviors.h"
+#include "SimdLanes.h"
+
+namespace
+{
+  /**
+   * Whether users should call the SIMD version of separation. Set from
+   * QS_SIMD_SEPARATION here since the engine doesn't link this library, so
+   * can't enable it itself (see EngineOptions).
+   */
+  bool glbSimdSeparation = (NULL != std::getenv("QS_SIMD_SEPARATION"));
+
+  /**
+   * The SIMD separation works on SimdLanes::LANES Actors at a time.
+   */
+  using L = QS::SimdLanes;
+
+  /** LANES floats. */
+  using Floats = L::Floats;
+
+  /** Number of lanes. */
+  constexpr std::size_t LANES = L::LANES;
+
+  /**
+   * Number of partial sums the pushes are added to, the widest LANES. Each
+   * other Actor's push goes to the partial sum of its index modulo SUMS, so
+   * the additions happen in the same order whatever LANES is.
+   */
+  constexpr std::size_t SUMS = 8;
+
+  static_assert(SUMS % LANES == 0, "Partial sums must fill whole vectors.");
+
+  /** Number of vectors holding the partial sums. */
+  constexpr std::size_t SUM_VECTORS = SUMS / LANES;
+
+  /**
+   * Adds the separation pushes of LANES other Actors to the partial sums.
+   * Other Actors at the Actor's position push nothing.
+   *
+   * @param thePositionX
+   *          x coordinate of the Actor, in every lane
+   * @param thePositionY
+   *          y coordinate of the Actor, in every lane
+   * @param theOtherX
+   *          x coordinates of the other Actors
+   * @param theOtherY
+   *          y coordinates of the other Actors
+   * @param theSumX
+   *          IN/OUT parameter, partial sums of the x pushes
+   * @param theSumY
+   *          IN/OUT parameter, partial sums of the y pushes
+   */
+  inline void addSeparation(Floats thePositionX, Floats thePositionY,
+                            Floats theOtherX, Floats theOtherY,
+                            Floats &theSumX, Floats &theSumY) noexcept
+  {
+    // offset / distance^2, negated once at the end.
+    Floats offsetX = L::sub(theOtherX, thePositionX);
+    Floats offsetY = L::sub(theOtherY, thePositionY);
+    Floats distanceSquared = L::add(L::mul(offsetX, offsetX),
+                                    L::mul(offsetY, offsetY));
+    L::Mask pushes = L::greater(distanceSquared, L::set(0.0));
+    theSumX = L::add(theSumX, L::select(
+      pushes, L::div(offsetX, distanceSquared), L::set(0.0)));
+    theSumY = L::add(theSumY, L::select(
+      pushes, L::div(offsetY, distanceSquared), L::set(0.0)));
+  }
+
+  /**
+   * Does the work of the separation functions, once the sum of the pushes of
+   * the other Actors is known.
+   *
+   * @param theSum
+   *          sum of offset / distance^2 over the other Actors
+   * @param theNumberActors
+   *          number of other Actors
+   * @param theMass
+   *          mass of the Actor
+   * @param theSeparationDistance
+   *          scaling factor for the separation distance
+   * @return force to separate the Actor from the others
+   */
+  Eigen::Vector2f separationForce(Eigen::Vector2f theSum,
+                                  std::size_t theNumberActors, float theMass,
+                                  float theSeparationDistance) noexcept
+  {
+    if (0 == theNumberActors)
+    {
+      return {0.0, 0.0};
+    }
+
+    Eigen::Vector2f steeringForce = theSum / -float(theNumberActors);
+    float length = steeringForce.norm();
+    if (length > 0.0)
+    {
+      steeringForce /= length;
+    }
+    return steeringForce * theSeparationDistance * theMass;
+  }
+
+  /**
+   * Sums the separation pushes of the other Actors, LANES at a time, into
+   * SUMS partial sums which are then added in index order.
+   *
+   * @param thePosition
+   *          position of the Actor
+   * @param thePositionsX
+   *          x coordinate of each of the other Actors
+   * @param thePositionsY
+   *          y coordinate of each of the other Actors
+   * @param theNumberActors
+   *          number of other Actors
+   * @return sum of offset / distance^2 over the other Actors
+   */
+  Eigen::Vector2f separationSum(const Eigen::Vector2f &thePosition,
+                                const float *thePositionsX,
+                                const float *thePositionsY,
+                                std::size_t theNumberActors) noexcept
+  {
+    Floats positionX = L::set(thePosition.x());
+    Floats positionY = L::set(thePosition.y());
+    Floats sumX[SUM_VECTORS];
+    Floats sumY[SUM_VECTORS];
+    for (std::size_t vector = 0; vector < SUM_VECTORS; ++vector)
+    {
+      sumX[vector] = L::set(0.0);
+      sumY[vector] = L::set(0.0);
+    }
+
+    std::size_t index = 0;
+    for (; index + SUMS <= theNumberActors; index += SUMS)
+    {
+      for (std::size_t vector = 0; vector < SUM_VECTORS; ++vector)
+      {
+        auto first = index + vector * LANES;
+        addSeparation(positionX, positionY, L::load(thePositionsX + first),
+                      L::load(thePositionsY + first), sumX[vector],
+                      sumY[vector]);
+      }
+    }
+    if (index < theNumberActors)
+    {
+      // Fill out the rest with the Actor's own position, which pushes
+      // nothing.
+      for (std::size_t vector = 0; vector < SUM_VECTORS; ++vector)
+      {
+        auto first = index + vector * LANES;
+        auto x = L::make([&](std::size_t theLane)
+                         {
+                           return first + theLane < theNumberActors ?
+                             thePositionsX[first + theLane] : thePosition.x();
+                         });
+        auto y = L::make([&](std::size_t theLane)
+                         {
+                           return first + theLane < theNumberActors ?
+                             thePositionsY[first + theLane] : thePosition.y();
+                         });
+        addSeparation(positionX, positionY, x, y, sumX[vector],
+                      sumY[vector]);
+      }
+    }
+
+    float partialX[SUMS];
+    float partialY[SUMS];
+    for (std::size_t vector = 0; vector < SUM_VECTORS; ++vector)
+    {
+      L::store(partialX + vector * LANES, sumX[vector]);
+      L::store(partialY + vector * LANES, sumY[vector]);
+    }
+    Eigen::Vector2f sum(0.0, 0.0);
+    for (std::size_t partial = 0; partial < SUMS; ++partial)
+    {
+      sum.x() += partialX[partial];
+      sum.y() += partialY[partial];
+    }
+    return sum;
+  }
+
+  /**
+   * Throws if a separation distance is invalid.
+   *
+   * @param theSeparationDistance
+   *          separation distance
+   * @throws std::invalid_argument
+   *         if theSeparationDistance is negative
+   */
+  void validateSeparationDistance(float theSeparationDistance)
+  {
+    if (theSeparationDistance < 0.0)
+    {
+      std::string error{"Invalid separation distance, "};
+      error += std::to_string(theSeparationDistance) +
+        ", it cannot be negative.";
+      throw std::invalid_argument(error);
+    }
+  }
+
+  /**
+   * Throws if a slowing radius is invalid.
+   *
+   * @param theSlowingRadius
+   *          slowing radius
+   * @throws std::invalid_argument
+   *          if theSlowingRadius is negative
+   */
+  void validateSlowingRadius(float theSlowingRadius)
+  {
+    if (theSlowingRadius < 0.0)
+    {
+      std::string error{"Invalid slowing radius, "};
+      error += std::to_string(theSlowingRadius) + ", it cannot be negative.";
+      throw std::invalid_argument(error);
+    }
+  }
+}
 
 Eigen::Vector2f QS::BasicBehaviors::arrival(const Actor *theActor,
                                             const Eigen::Vector2f &thePosition,
                                             float theSlowingRadius)
 {
-  if (theSlowingRadius < 0.0)
-  {
-    std::string error{"Invalid slowing radius, "};
-    error += std::to_string(theSlowingRadius) + ", it cannot be negative.";
-    throw std::invalid_argument(error);
-  }
+  validateSlowingRadius(theSlowingRadius);
 
   Eigen::Vector2f desiredVelocity =
      thePosition - theActor->getPosition();
@@ -41,6 +251,16 @@ Eigen::Vector2f QS::BasicBehaviors::arrival(const Actor *theActor,
   return steeringForce;
 }
 
+void QS::BasicBehaviors::disableSimdSeparation() noexcept
+{
+  glbSimdSeparation = false;
+}
+
+void QS::BasicBehaviors::enableSimdSeparation() noexcept
+{
+  glbSimdSeparation = true;
+}
+
 Eigen::Vector2f QS::BasicBehaviors::evade(const Actor *theActor,
                                           const Actor *theActorToEvade)
   noexcept
@@ -80,6 +300,11 @@ Eigen::Vector2f QS::BasicBehaviors::flee(const Actor *theActor,
   return seekFleeHelper(theActor, desiredVelocity, theDesiredSpeed);
 }
 
+bool QS::BasicBehaviors::isSimdSeparationEnabled() noexcept
+{
+  return glbSimdSeparation;
+}
+
 Eigen::Vector2f QS::BasicBehaviors::pursuit(const Actor *theActor,
                                             const Actor *theActorToEvade)
   noexcept
@@ -132,12 +357,7 @@ Eigen::Vector2f QS::BasicBehaviors::separation(
   const std::vector<const Actor*> &theActors,
   float theSeparationDistance)
 {
-  if (theSeparationDistance < 0.0)
-  {
-    std::string error{"Invalid separation distance, "};
-    error += std::to_string(theSeparationDistance) + ", it cannot be negative.";
-    throw std::invalid_argument(error);
-  }
+  validateSeparationDistance(theSeparationDistance);
 
   Eigen::Vector2f steeringForce(0.0, 0.0);
 
@@ -173,3 +393,17 @@ Eigen::Vector2f QS::BasicBehaviors::separation(
   return steeringForce;
 }
 
+Eigen::Vector2f QS::BasicBehaviors::separation(
+  const Eigen::Vector2f &thePosition,
+  float theMass,
+  const float *thePositionsX,
+  const float *thePositionsY,
+  std::size_t theNumberActors,
+  float theSeparationDistance)
+{
+  validateSeparationDistance(theSeparationDistance);
+
+  return separationForce(
+    separationSum(thePosition, thePositionsX, thePositionsY, theNumberActors),
+    theNumberActors, theMass, theSeparationDistance);
+}
@@ -15,10 +15,21 @@ QS::BasicWalk::BasicWalk(const Properties &theProperties,
 {
 }
 
+void QS::BasicWalk::bindDependencies()
+{
+  myWalk = getDependency<Walk>(0);
+}
+
 Eigen::Vector2f QS::BasicWalk::evaluate(const Actor *theActor,
                                         const Sensable &theSensable)
 {
-  auto vector = dynamic_cast<Walk*>(getDependencies()[0].myEntity)->evaluate(
-    theActor);
+  auto vector = myWalk->evaluate(theActor);
   return vector;
 }
+
+bool QS::BasicWalk::evaluateBatch(const std::vector<std::size_t> &theIndexes,
+                                  const ActorBatch &theBatch,
+                                  std::vector<Eigen::Vector2f> &theForces)
+{
+  return myWalk->evaluateBatch(theIndexes, theBatch, theForces);
+}
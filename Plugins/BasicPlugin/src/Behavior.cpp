@@ -12,3 +12,10 @@ QS::Behavior::Behavior(const Properties &theProperties,
   PluginEntity(theProperties, theTag)
 {
 }
+
+bool QS::Behavior::evaluateBatch(const std::vector<std::size_t> &theIndexes,
+                                 const ActorBatch &theBatch,
+                                 std::vector<Eigen::Vector2f> &theForces)
+{
+  return false;
+}
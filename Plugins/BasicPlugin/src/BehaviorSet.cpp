@@ -8,8 +8,10 @@
 #include <stdexcept>
 #include "Behavior.h"
 #include "BehaviorSet.h"
+#include "FrameProfiler.h"
 #include "Sensable.h"
 #include "Sensor.h"
+#include "Tracer.h"
 
 QS::BehaviorSet::BehaviorSet(const Properties &theProperties,
                              const std::string &theTag) :
@@ -21,10 +23,10 @@ Eigen::Vector2f QS::BehaviorSet::evaluate(const Actor *theActor,
                                           const Sensable &theSensable)
 {
   Eigen::Vector2f average(0.0, 0.0);
-  auto dependencies = getDependencies();
   float count = 0;
-  for (auto dependency : dependencies)
+  for (const auto &dependency : getDependencies())
   {
+    QS_TRACE_SCOPE("Behavior::evaluate");
     auto steeringForce = dependency.myEntity->evaluate(theActor);
     average += steeringForce;
     count++;
@@ -34,17 +36,22 @@ Eigen::Vector2f QS::BehaviorSet::evaluate(const Actor *theActor,
   return average;
 }
 
+bool QS::BehaviorSet::evaluateBatch(
+  const std::vector<std::size_t> &theIndexes,
+  const ActorBatch &theBatch,
+  std::vector<Eigen::Vector2f> &theForces)
+{
+  return false;
+}
+
 void QS::BehaviorSet::populateSensors(const Sensable &theSensable) noexcept
 {
-  std::vector<EntityDependency<Behavior>> behaviors = getDependencies();
-  for (EntityDependency<Behavior> behavior : behaviors)
+  QS_PROFILE_PHASE(Sense);
+  for (const auto &behavior : getDependencies())
   {
-    std::vector<EntityDependency<Sensor>> sensorDependencies =
-      behavior.myEntity->getDependencies();
-    for (EntityDependency<Sensor> sensorDependency : sensorDependencies)
+    for (const auto &sensorDependency : behavior.myEntity->getDependencies())
     {
-      Sensor *sensor = sensorDependency.myEntity;
-      sensor->sense(theSensable);
+      sensorDependency.myEntity->sense(theSensable);
     }
   }
 }
@@ -0,0 +1,78 @@
+/**
+ * @file CounterRNG.cpp
+ * @brief Definition of CounterRNG
+ *
+ * @author Michael Albers
+ */
+
+#include "CounterRNG.h"
+
+namespace
+{
+  /** Philox4x32 multipliers. */
+  constexpr std::uint32_t glbMultiplier0 = 0xD2511F53;
+  constexpr std::uint32_t glbMultiplier1 = 0xCD9E8D57;
+
+  /** Philox4x32 key increments (Weyl sequence). */
+  constexpr std::uint32_t glbKeyIncrement0 = 0x9E3779B9;
+  constexpr std::uint32_t glbKeyIncrement1 = 0xBB67AE85;
+
+  /** Number of rounds. */
+  constexpr int glbRounds = 10;
+}
+
+QS::CounterRNG::CounterRNG(std::uint64_t theSeed) noexcept :
+  mySeed(theSeed)
+{
+}
+
+QS::CounterRNG::Block QS::CounterRNG::generate(std::uint32_t theEntity,
+                                               std::uint32_t theFrame,
+                                               std::uint32_t theStream,
+                                               std::uint32_t theIndex) const
+  noexcept
+{
+  Block counter{{theIndex, theStream, theFrame, theEntity}};
+  std::uint32_t key0 = static_cast<std::uint32_t>(mySeed);
+  std::uint32_t key1 = static_cast<std::uint32_t>(mySeed >> 32);
+
+  for (int round = 0; round < glbRounds; ++round)
+  {
+    if (round > 0)
+    {
+      key0 += glbKeyIncrement0;
+      key1 += glbKeyIncrement1;
+    }
+    std::uint64_t product0 =
+      static_cast<std::uint64_t>(glbMultiplier0) * counter[0];
+    std::uint64_t product1 =
+      static_cast<std::uint64_t>(glbMultiplier1) * counter[2];
+    std::uint32_t high0 = static_cast<std::uint32_t>(product0 >> 32);
+    std::uint32_t high1 = static_cast<std::uint32_t>(product1 >> 32);
+    counter = {{high1 ^ counter[1] ^ key0,
+                static_cast<std::uint32_t>(product1),
+                high0 ^ counter[3] ^ key1,
+                static_cast<std::uint32_t>(product0)}};
+  }
+  return counter;
+}
+
+std::uint32_t QS::CounterRNG::getFrame() const noexcept
+{
+  return myFrame;
+}
+
+std::uint64_t QS::CounterRNG::getSeed() const noexcept
+{
+  return mySeed;
+}
+
+void QS::CounterRNG::setFrame(std::uint32_t theFrame) noexcept
+{
+  myFrame = theFrame;
+}
+
+void QS::CounterRNG::setSeed(std::uint64_t theSeed) noexcept
+{
+  mySeed = theSeed;
+}
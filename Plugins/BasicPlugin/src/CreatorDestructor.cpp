@@ -12,9 +12,41 @@
 #include "Walk.h"
 #include "BasicWalk.h"
 #include "NullSensor.h"
+#include "PluginABI.h"
+#include "StaticPlugin.h"
 
-extern "C"
+QS_PLUGIN_FUNCTIONS(BasicPlugin)
 {
+  const QS::PluginABI& qsPluginABI()
+  {
+    // Walk and BasicWalk only depend on the Actor and their configuration.
+    static const QS::PluginABI abi = []()
+    {
+      QS::PluginABI abi;
+      QS::EntityCapabilities basicWalk;
+      basicWalk.myKind = QS::EntityCapabilities::Kind::BehaviorSet;
+      basicWalk.myType = "BasicWalk";
+      basicWalk.myBatchEvaluation = true;
+      basicWalk.myShareable = true;
+      abi.myCapabilities.push_back(basicWalk);
+
+      QS::EntityCapabilities walk;
+      walk.myKind = QS::EntityCapabilities::Kind::Behavior;
+      walk.myType = "Walk";
+      walk.myBatchEvaluation = true;
+      walk.myShareable = true;
+      abi.myCapabilities.push_back(walk);
+
+      QS::EntityCapabilities nullSensor;
+      nullSensor.myKind = QS::EntityCapabilities::Kind::Sensor;
+      nullSensor.myType = "NullSensor";
+      nullSensor.myShareable = true;
+      abi.myCapabilities.push_back(nullSensor);
+      return abi;
+    }();
+    return abi;
+  }
+
   QS::Actor* actorCreator(
     const std::string &theActorName,
     const QS::PluginEntity::Properties &theProperties,
@@ -84,4 +116,33 @@ extern "C"
   {
     delete theExit;
   }
+
+#ifdef QS_STATIC_PLUGINS
+  const QS::StaticPlugin& qsStaticPlugin()
+  {
+    static const QS::StaticPlugin plugin = []()
+    {
+      QS::StaticPlugin plugin;
+      plugin.myConfigFile = "BasicPlugin.xml";
+      plugin.myDefinition =
+        #include "BasicPlugin.xml"
+        ;
+      plugin.myABI = &qsPluginABI;
+      plugin.myFunctions = {
+        {"actorCreator", reinterpret_cast<void*>(&actorCreator)},
+        {"actorDestructor", reinterpret_cast<void*>(&actorDestructor)},
+        {"behaviorSetCreator", reinterpret_cast<void*>(&behaviorSetCreator)},
+        {"behaviorSetDestructor",
+         reinterpret_cast<void*>(&behaviorSetDestructor)},
+        {"behaviorCreator", reinterpret_cast<void*>(&behaviorCreator)},
+        {"behaviorDestructor", reinterpret_cast<void*>(&behaviorDestructor)},
+        {"sensorCreator", reinterpret_cast<void*>(&sensorCreator)},
+        {"sensorDestructor", reinterpret_cast<void*>(&sensorDestructor)},
+        {"exitCreator", reinterpret_cast<void*>(&exitCreator)},
+        {"exitDestructor", reinterpret_cast<void*>(&exitDestructor)}};
+      return plugin;
+    }();
+    return plugin;
+  }
+#endif
 }
@@ -14,6 +14,12 @@ QS::PluginEntity::PluginEntity(const Properties &theProperties,
 {
 }
 
+const QS::EntityCapabilities& QS::PluginEntity::getCapabilities()
+  const noexcept
+{
+  return myCapabilities;
+}
+
 QS::PluginEntity::Properties QS::PluginEntity::getProperties() const noexcept
 {
   return myProperties;
@@ -23,3 +29,9 @@ std::string QS::PluginEntity::getTag() const noexcept
 {
   return myTag;
 }
+
+void QS::PluginEntity::setCapabilities(
+  const EntityCapabilities &theCapabilities)
+{
+  myCapabilities = theCapabilities;
+}
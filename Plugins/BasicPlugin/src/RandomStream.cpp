@@ -0,0 +1,41 @@
+/**
+ * @file RandomStream.cpp
+ * @brief Definition of RandomStream
+ *
+ * @author Michael Albers
+ */
+
+#include <algorithm>
+#include <cmath>
+#include "RandomStream.h"
+
+QS::RandomStream::RandomStream(const CounterRNG &theRNG,
+                               std::uint32_t theEntity,
+                               std::uint32_t theStream) noexcept :
+  myEntity(theEntity),
+  myFrame(theRNG.getFrame()),
+  myRNG(&theRNG),
+  myStream(theStream),
+  myUsed(myBlock.size())
+{
+}
+
+float QS::RandomStream::uniform(float theLow, float theHigh) noexcept
+{
+  // The top 24 bits fill a float's significand exactly.
+  float fraction = ((*this)() >> 8) / 16777216.0f;
+  // Rounding can take the result up to theHigh, which is excluded.
+  return std::min(theLow + (theHigh - theLow) * fraction,
+                  std::nextafter(theHigh, theLow));
+}
+
+QS::RandomStream::result_type QS::RandomStream::operator()() noexcept
+{
+  if (myUsed == myBlock.size())
+  {
+    myBlock = myRNG->generate(myEntity, myFrame, myStream, myIndex);
+    ++myIndex;
+    myUsed = 0;
+  }
+  return myBlock[myUsed++];
+}
@@ -5,8 +5,10 @@
  * @author Michael Albers
  */
 
+#include <cmath>
 #include "Eigen/Geometry"
 #include "Actor.h"
+#include "ActorBatch.h"
 #include "Walk.h"
 
 QS::Walk::Walk(const Properties &theProperties,
@@ -36,3 +38,26 @@ Eigen::Vector2f QS::Walk::evaluate(const Actor *theActor)
   steeringForce = rotation * steeringForce;
   return steeringForce;
 }
+
+bool QS::Walk::evaluateBatch(const std::vector<std::size_t> &theIndexes,
+                             const ActorBatch &theBatch,
+                             std::vector<Eigen::Vector2f> &theForces)
+{
+  const auto &masses = theBatch.getMasses();
+  const auto &orientations = theBatch.getOrientations();
+  const auto &velocitiesX = theBatch.getVelocitiesX();
+  const auto &velocitiesY = theBatch.getVelocitiesY();
+
+  // Same as evaluate, with the rotation of (force, 0) written out.
+  for (auto index : theIndexes)
+  {
+    float velocityX = velocitiesX[index];
+    float velocityY = velocitiesY[index];
+    float speed = std::sqrt(velocityX * velocityX + velocityY * velocityY);
+    float force = (speed >= mySpeed_ms ? 0.0f : mySpeed_ms) * masses[index];
+    float orientation = orientations[index];
+    theForces[index] << force * std::cos(orientation),
+      force * std::sin(orientation);
+  }
+  return true;
+}
@@ -0,0 +1,52 @@
+/**
+ * @file ActorBatchTest.cpp
+ * @brief Unit tests for ActorBatch class
+ *
+ * @author Michael Albers
+ */
+
+#include <vector>
+#include "gtest/gtest.h"
+#include "Actor.h"
+#include "ActorBatch.h"
+#include "TestUtils.h"
+
+GTEST_TEST(ActorBatchTest, class)
+{
+  auto properties = QS::TestUtils::getMinimalActorProperties();
+  QS::Actor actor1(properties, "");
+  actor1.setPosition({1.0, 2.0});
+  actor1.setVelocity({0.5, -0.5});
+  actor1.setOrientation(1.25);
+
+  properties["radius"] = "0.75";
+  QS::Actor actor2(properties, "");
+  actor2.setPosition({3.0, 4.0});
+
+  QS::ActorBatch batch({&actor1, &actor2});
+  ASSERT_EQ(2u, batch.size());
+  EXPECT_EQ(&actor1, batch.getActors()[0]);
+  EXPECT_EQ(&actor2, batch.getActors()[1]);
+
+  EXPECT_EQ(1.0, batch.getPositionsX()[0]);
+  EXPECT_EQ(2.0, batch.getPositionsY()[0]);
+  EXPECT_EQ(3.0, batch.getPositionsX()[1]);
+  EXPECT_EQ(4.0, batch.getPositionsY()[1]);
+  EXPECT_EQ(0.5, batch.getVelocitiesX()[0]);
+  EXPECT_EQ(-0.5, batch.getVelocitiesY()[0]);
+  EXPECT_EQ(1.25, batch.getOrientations()[0]);
+  EXPECT_EQ(actor1.getRadius(), batch.getRadii()[0]);
+  EXPECT_EQ(0.75, batch.getRadii()[1]);
+
+  for (auto ii = 0u; ii < batch.size(); ++ii)
+  {
+    auto actor = batch.getActors()[ii];
+    EXPECT_EQ(actor->getMass(), batch.getMasses()[ii]);
+    EXPECT_EQ(actor->getMaximumForce(), batch.getMaximumForces()[ii]);
+    EXPECT_EQ(actor->getMaximumSpeed(), batch.getMaximumSpeeds()[ii]);
+  }
+
+  // State is a snapshot.
+  actor1.setPosition({5.0, 5.0});
+  EXPECT_EQ(1.0, batch.getPositionsX()[0]);
+}
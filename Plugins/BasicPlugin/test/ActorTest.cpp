@@ -287,3 +287,30 @@ TEST_F(ActorTestFixture, testConvertPointToLocal)
   // If everything worked to this point. There isn't much reason to think this
   // won't either (famous last words...).
 }
+
+GTEST_TEST(ActorTest, behaviorState)
+{
+  auto slot = QS::Actor::allocateBehaviorState("ActorTest.first");
+  const QS::Actor actor1(QS::TestUtils::getMinimalActorProperties(), "");
+  const QS::Actor actor2(QS::TestUtils::getMinimalActorProperties(), "");
+
+  EXPECT_EQ(0.0, actor1.getBehaviorState(slot));
+  actor1.setBehaviorState(slot, 2.5);
+  EXPECT_EQ(2.5, actor1.getBehaviorState(slot));
+  EXPECT_EQ(0.0, actor2.getBehaviorState(slot));
+
+  // A key keeps its slot, however often it is allocated (i.e., each time a
+  // plugin is reloaded), so only new keys run out of slots.
+  for (auto ii = 0u; ii < QS::Actor::NUMBER_BEHAVIOR_STATES * 2; ++ii)
+  {
+    EXPECT_EQ(slot, QS::Actor::allocateBehaviorState("ActorTest.first"));
+  }
+  EXPECT_NE(slot, QS::Actor::allocateBehaviorState("ActorTest.second"));
+  EXPECT_THROW(
+    for (auto ii = 0u; ii < QS::Actor::NUMBER_BEHAVIOR_STATES; ++ii)
+    {
+      QS::Actor::allocateBehaviorState("ActorTest." + std::to_string(ii));
+    },
+    std::length_error);
+  EXPECT_EQ(slot, QS::Actor::allocateBehaviorState("ActorTest.first"));
+}
@@ -5,6 +5,9 @@
  * @author Michael Albers
  */
 
+#include <cmath>
+#include <cstdlib>
+#include <vector>
 #include "gtest/gtest.h"
 #include "Actor.h"
 #include "BasicBehaviors.h"
@@ -216,3 +219,79 @@ GTEST_TEST(BasicBehaviorsTest, separation)
   EXPECT_EQ(expectedForce, actualForce)
     << "Actual: " << actualForce.format(QS::EigenHelper::prettyPrint);
 }
+
+GTEST_TEST(BasicBehaviorsTest, separationArrays)
+{
+  Eigen::Vector2f position(5.0, 5.0);
+  std::vector<float> x{3.0, 7.0, 5.0, 5.0, 5.0};
+  std::vector<float> y{5.0, 5.0, 3.0, 7.0, 5.0};
+
+  EXPECT_THROW(QS::BasicBehaviors::separation(position, 2.0, x.data(),
+                                              y.data(), 0, -1.0),
+               std::invalid_argument);
+
+  // No other Actors, no movement needed.
+  Eigen::Vector2f expectedForce = {0,0};
+  Eigen::Vector2f actualForce = QS::BasicBehaviors::separation(
+    position, 2.0, x.data(), y.data(), 0, 1.0);
+  EXPECT_EQ(expectedForce, actualForce)
+    << "Actual: " << actualForce.format(QS::EigenHelper::prettyPrint);
+
+  // Actor in exactly the middle (the last one at its position pushes
+  // nothing), no movement needed.
+  actualForce = QS::BasicBehaviors::separation(
+    position, 2.0, x.data(), y.data(), x.size(), 1.0);
+  EXPECT_EQ(expectedForce, actualForce)
+    << "Actual: " << actualForce.format(QS::EigenHelper::prettyPrint);
+
+  // Actor near another Actor, same as separation.
+  position << 5.0, 6.0;
+  expectedForce = {0, -6.0};
+  actualForce = QS::BasicBehaviors::separation(
+    position, 2.0, x.data(), y.data(), 4, 3.0);
+  EXPECT_TRUE(expectedForce.isApprox(actualForce, 1e-5))
+    << "Actual: " << actualForce.format(QS::EigenHelper::prettyPrint);
+
+  // Pushes are added to 8 partial sums by index, whatever the instruction
+  // set, so the force is exactly that of summing them in this order.
+  position << 0.3, -0.7;
+  x.clear();
+  y.clear();
+  float partialX[8] = {};
+  float partialY[8] = {};
+  for (auto ii = 0u; ii < 21; ++ii)
+  {
+    x.push_back(std::cos(ii * 2.4f) * (1.0f + ii * 0.37f));
+    y.push_back(std::sin(ii * 2.4f) * (1.0f + ii * 0.37f));
+    float offsetX = x.back() - position.x();
+    float offsetY = y.back() - position.y();
+    float distanceSquared = offsetX * offsetX + offsetY * offsetY;
+    partialX[ii % 8] += offsetX / distanceSquared;
+    partialY[ii % 8] += offsetY / distanceSquared;
+  }
+  Eigen::Vector2f sum(0.0, 0.0);
+  for (auto ii = 0u; ii < 8; ++ii)
+  {
+    sum.x() += partialX[ii];
+    sum.y() += partialY[ii];
+  }
+  expectedForce = sum / -float(x.size());
+  expectedForce /= expectedForce.norm();
+  expectedForce = expectedForce * 1.5 * 2.0;
+  actualForce = QS::BasicBehaviors::separation(
+    position, 2.0, x.data(), y.data(), x.size(), 1.5);
+  EXPECT_EQ(expectedForce, actualForce)
+    << "Actual: " << actualForce.format(QS::EigenHelper::prettyPrint);
+}
+
+GTEST_TEST(BasicBehaviorsTest, simdSeparation)
+{
+  // Starts enabled only with QS_SIMD_SEPARATION set.
+  EXPECT_EQ(nullptr != std::getenv("QS_SIMD_SEPARATION"),
+            QS::BasicBehaviors::isSimdSeparationEnabled());
+
+  QS::BasicBehaviors::enableSimdSeparation();
+  EXPECT_TRUE(QS::BasicBehaviors::isSimdSeparationEnabled());
+  QS::BasicBehaviors::disableSimdSeparation();
+  EXPECT_FALSE(QS::BasicBehaviors::isSimdSeparationEnabled());
+}
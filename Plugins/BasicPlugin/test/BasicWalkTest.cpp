@@ -7,6 +7,7 @@
 
 #include "gtest/gtest.h"
 #include "Actor.h"
+#include "ActorBatch.h"
 #include "BasicWalk.h"
 #include "EigenHelper.h"
 #include "Sensable.h"
@@ -35,3 +36,21 @@ GTEST_TEST(BasicWalkTest, testBasicWalk)
     << ", Actual: "
     << actualMotionVector.format(QS::EigenHelper::prettyPrint);
 }
+
+GTEST_TEST(BasicWalkTest, testBasicWalkBatch)
+{
+  // BasicWalk just returns the values of Walk.
+  QS::PluginEntity::Properties properties;
+  QS::BasicWalk basicWalk(properties, "");
+  QS::Walk walk(properties, "");
+  basicWalk.setDependencies({{"Walk", &walk, ""}});
+
+  QS::Actor actor(QS::TestUtils::getMinimalActorProperties(), "");
+  actor.setVelocity({0.0, 0.0});
+
+  QS::ActorBatch batch({&actor});
+  std::vector<Eigen::Vector2f> forces(batch.size());
+  ASSERT_TRUE(basicWalk.evaluateBatch({0}, batch, forces));
+  EXPECT_EQ(walk.evaluate(&actor), forces[0])
+    << ", Actual: " << forces[0].format(QS::EigenHelper::prettyPrint);
+}
@@ -0,0 +1,84 @@
+/**
+ * @file CounterRNGTest.cpp
+ * @brief Unit tests for CounterRNG and RandomStream classes
+ *
+ * @author Michael Albers
+ */
+
+#include <vector>
+#include "gtest/gtest.h"
+#include "CounterRNG.h"
+#include "RandomStream.h"
+
+GTEST_TEST(CounterRNGTest, knownAnswers)
+{
+  // Philox4x32-10 known answers from the Random123 distribution. The counter
+  // words are, in order, index, stream, frame and entity; the key is the
+  // seed, low word first.
+  QS::CounterRNG zero;
+  QS::CounterRNG::Block expected{{0x6627e8d5, 0xe169c58d,
+                                  0xbc57ac4c, 0x9b00dbd8}};
+  EXPECT_EQ(expected, zero.generate(0, 0, 0, 0));
+
+  QS::CounterRNG ones(0xffffffffffffffffull);
+  expected = {{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}};
+  EXPECT_EQ(expected, ones.generate(0xffffffff, 0xffffffff, 0xffffffff,
+                                    0xffffffff));
+
+  QS::CounterRNG pi(0x299f31d0a4093822ull);
+  expected = {{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}};
+  EXPECT_EQ(expected, pi.generate(0x03707344, 0x13198a2e, 0x85a308d3,
+                                  0x243f6a88));
+}
+
+GTEST_TEST(CounterRNGTest, randomStream)
+{
+  QS::CounterRNG rng(45);
+  rng.setFrame(3);
+  EXPECT_EQ(3u, rng.getFrame());
+  EXPECT_EQ(45u, rng.getSeed());
+
+  // Values come from consecutive blocks of the counter.
+  QS::RandomStream random(rng, 7, QS::CounterRNG::PLUGIN);
+  std::vector<std::uint32_t> values;
+  for (auto ii = 0; ii < 8; ++ii)
+  {
+    values.push_back(random());
+  }
+  auto block0 = rng.generate(7, 3, QS::CounterRNG::PLUGIN, 0);
+  auto block1 = rng.generate(7, 3, QS::CounterRNG::PLUGIN, 1);
+  std::vector<std::uint32_t> expected(block0.begin(), block0.end());
+  expected.insert(expected.end(), block1.begin(), block1.end());
+  EXPECT_EQ(expected, values);
+
+  // Streams keep the frame they were made in, and don't depend on draws
+  // from any other stream.
+  QS::RandomStream other(rng, 8, QS::CounterRNG::PLUGIN);
+  rng.setFrame(4);
+  QS::RandomStream again(rng, 7, QS::CounterRNG::PLUGIN);
+  rng.setFrame(3);
+  QS::RandomStream same(rng, 7, QS::CounterRNG::PLUGIN);
+  for (auto ii = 0; ii < 8; ++ii)
+  {
+    other();
+    EXPECT_EQ(values[ii], same());
+  }
+  EXPECT_NE(values[0], again());
+
+  QS::RandomStream uniform(rng, 7, QS::CounterRNG::PLUGIN);
+  for (auto ii = 0; ii < 100; ++ii)
+  {
+    float value = uniform.uniform(-2.0, 3.0);
+    EXPECT_GE(value, -2.0);
+    EXPECT_LT(value, 3.0);
+  }
+
+  // Floats are 2 apart here, so about half of the values would round up to
+  // the upper bound.
+  for (auto ii = 0; ii < 100; ++ii)
+  {
+    float value = uniform.uniform(16777216.0, 16777218.0);
+    EXPECT_GE(value, 16777216.0);
+    EXPECT_LT(value, 16777218.0);
+  }
+}
@@ -7,17 +7,20 @@
 
 #include <map>
 #include <string>
+#include <utility>
 #include "gtest/gtest.h"
 #include "Actor.h"
 #include "Behavior.h"
 #include "BehaviorSet.h"
 #include "Exit.h"
+#include "PluginABI.h"
 #include "Sensor.h"
+#include "StaticPlugin.h"
 #include "TestUtils.h"
 
 // No header for the creator/destructors since they aren't used directly in the
 // code
-extern "C"
+QS_PLUGIN_FUNCTIONS(BasicPlugin)
 {
   QS::Actor* actorCreator(
     const std::string&,
@@ -48,8 +51,18 @@ extern "C"
     const QS::PluginEntity::Properties&,
     const std::string &theTag);
   void exitDestructor(QS::Exit*);
+
+  const QS::PluginABI& qsPluginABI();
+
+#ifdef QS_STATIC_PLUGINS
+  const QS::StaticPlugin& qsStaticPlugin();
+#endif
 }
 
+#ifdef QS_STATIC_PLUGINS
+using namespace BasicPlugin;
+#endif
+
 GTEST_TEST(CreatorDestructor, testActor)
 {
   QS::Actor *actor = actorCreator(
@@ -97,3 +110,47 @@ GTEST_TEST(CreatorDestructor, testExit)
 
   EXPECT_NO_THROW(exitDestructor(exit));
 }
+
+GTEST_TEST(CreatorDestructor, testPluginABI)
+{
+  const QS::PluginABI &abi = qsPluginABI();
+  EXPECT_EQ(4u, abi.myVersion);
+
+  using Kind = QS::EntityCapabilities::Kind;
+  std::map<std::pair<Kind, std::string>, QS::EntityCapabilities> capabilities;
+  for (const auto &typeCapabilities : abi.myCapabilities)
+  {
+    capabilities[std::make_pair(typeCapabilities.myKind,
+                                typeCapabilities.myType)] = typeCapabilities;
+  }
+  auto basicWalk = std::make_pair(Kind::BehaviorSet, std::string("BasicWalk"));
+  ASSERT_EQ(1u, capabilities.count(basicWalk));
+  EXPECT_TRUE(capabilities[basicWalk].myBatchEvaluation);
+  EXPECT_TRUE(capabilities[basicWalk].myShareable);
+  auto walk = std::make_pair(Kind::Behavior, std::string("Walk"));
+  ASSERT_EQ(1u, capabilities.count(walk));
+  EXPECT_TRUE(capabilities[walk].myBatchEvaluation);
+  EXPECT_TRUE(capabilities[walk].myShareable);
+  auto nullSensor = std::make_pair(Kind::Sensor, std::string("NullSensor"));
+  ASSERT_EQ(1u, capabilities.count(nullSensor));
+  EXPECT_FALSE(capabilities[nullSensor].myBatchEvaluation);
+  EXPECT_TRUE(capabilities[nullSensor].myShareable);
+  // Actors are never shared.
+  EXPECT_EQ(0u, capabilities.count(
+              std::make_pair(Kind::Actor, std::string("Actor"))));
+}
+
+#ifdef QS_STATIC_PLUGINS
+GTEST_TEST(CreatorDestructor, testStaticPlugin)
+{
+  const QS::StaticPlugin &plugin = qsStaticPlugin();
+  EXPECT_NE(std::string::npos,
+            plugin.myDefinition.find("<Plugin name=\"BasicPlugin\""));
+  EXPECT_EQ(&qsPluginABI, plugin.myABI);
+  EXPECT_EQ(10u, plugin.myFunctions.size());
+  EXPECT_EQ(reinterpret_cast<void*>(&actorCreator),
+            plugin.myFunctions.at("actorCreator"));
+  EXPECT_EQ(reinterpret_cast<void*>(&exitDestructor),
+            plugin.myFunctions.at("exitDestructor"));
+}
+#endif
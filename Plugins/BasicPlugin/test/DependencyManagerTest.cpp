@@ -8,6 +8,40 @@
 #include "DependencyManager.h"
 #include "gtest/gtest.h"
 
+namespace
+{
+  class Base
+  {
+    public:
+    virtual ~Base() = default;
+  };
+
+  class Derived : public Base
+  {
+  };
+
+  class Other : public Base
+  {
+  };
+
+  /**
+   * Binds the first dependency as a Derived.
+   */
+  class Binder : public QS::DependencyManager<Base>
+  {
+    public:
+    Derived *myDerived = nullptr;
+
+    std::size_t myIndex = 0;
+
+    protected:
+    void bindDependencies() override
+    {
+      myDerived = getDependency<Derived>(myIndex);
+    }
+  };
+}
+
 GTEST_TEST(DependencyManagerTest, testDefaults)
 {
   // All defaulted, just make sure they exist.
@@ -65,3 +99,35 @@ GTEST_TEST(DependencyManagerTest, testGetSetDependencies)
     FAIL();
   }
 }
+
+GTEST_TEST(DependencyManagerTest, testBindDependencies)
+{
+  Derived derived;
+  Other other;
+  Binder binder;
+
+  binder.setDependencies({{"Derived", &derived, ""}});
+  EXPECT_EQ(&derived, binder.myDerived);
+
+  try
+  {
+    binder.setDependencies({{"Other", &other, ""}});
+    FAIL();
+  }
+  catch (const std::invalid_argument &e)
+  {
+    EXPECT_STREQ("Dependency 0 (type name 'Other') is not of the needed type.",
+                 e.what());
+  }
+
+  binder.myIndex = 1;
+  try
+  {
+    binder.setDependencies({{"Derived", &derived, ""}});
+    FAIL();
+  }
+  catch (const std::invalid_argument &e)
+  {
+    EXPECT_STREQ("Missing dependency 1, only 1 given.", e.what());
+  }
+}
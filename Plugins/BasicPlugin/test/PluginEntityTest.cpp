@@ -28,6 +28,17 @@ GTEST_TEST(PluginEntityTest, testAll)
   // Test tag getter
   EXPECT_EQ(tag, entity.getTag());
 
+  // Capabilities default to none.
+  EXPECT_FALSE(entity.getCapabilities().myBatchEvaluation);
+  EXPECT_FALSE(entity.getCapabilities().myShareable);
+
+  QS::EntityCapabilities capabilities;
+  capabilities.myType = "Entity";
+  capabilities.myBatchEvaluation = true;
+  entity.setCapabilities(capabilities);
+  EXPECT_EQ("Entity", entity.getCapabilities().myType);
+  EXPECT_TRUE(entity.getCapabilities().myBatchEvaluation);
+
   // Verify copy/move functions
   QS::PluginEntity entityCopy(entity);
   entityCopy = entity;
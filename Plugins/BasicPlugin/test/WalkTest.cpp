@@ -5,8 +5,11 @@
  * @author Michael Albers
  */
 
+#include <memory>
+#include <vector>
 #include "gtest/gtest.h"
 #include "Actor.h"
+#include "ActorBatch.h"
 #include "EigenHelper.h"
 #include "TestUtils.h"
 #include "Walk.h"
@@ -72,3 +75,38 @@ GTEST_TEST(WalkTest, testWalk)
   properties["speed"] = "r1.2";
   EXPECT_THROW(QS::Walk(properties, ""), std::logic_error);
 }
+
+GTEST_TEST(WalkTest, testWalkBatch)
+{
+  QS::PluginEntity::Properties properties{{"speed", "1.5"}};
+  QS::Walk walkBehavior(properties, "");
+
+  std::vector<std::shared_ptr<QS::Actor>> actors;
+  std::vector<const QS::Actor*> batchActors;
+  for (auto ii = 0; ii < 8; ++ii)
+  {
+    std::shared_ptr<QS::Actor> actor(
+      new QS::Actor(QS::TestUtils::getMinimalActorProperties(), ""));
+    actor->setVelocity({0.25f * ii, 0.1f * ii});
+    actor->setOrientation(0.7f * ii);
+    actors.push_back(actor);
+    batchActors.push_back(actor.get());
+  }
+
+  // Evaluate every other Actor, the rest must be left alone.
+  QS::ActorBatch batch(batchActors);
+  std::vector<std::size_t> indexes{0, 2, 4, 6};
+  std::vector<Eigen::Vector2f> forces(batch.size(), Eigen::Vector2f(-1, -1));
+  ASSERT_TRUE(walkBehavior.evaluateBatch(indexes, batch, forces));
+
+  for (auto ii = 0u; ii < actors.size(); ++ii)
+  {
+    Eigen::Vector2f expected(-1, -1);
+    if (ii % 2 == 0)
+    {
+      expected = walkBehavior.evaluate(actors[ii].get());
+    }
+    EXPECT_FLOAT_EQ(expected.x(), forces[ii].x()) << "ii == " << ii;
+    EXPECT_FLOAT_EQ(expected.y(), forces[ii].y()) << "ii == " << ii;
+  }
+}
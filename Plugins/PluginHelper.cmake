@@ -4,8 +4,25 @@
 # TODO: have user set target name & config name, then this will call add_library, include_directory, and install stuff below.
 
 macro(QS_PLUGIN_INSTALL lib config dir)
-  install(TARGETS ${lib}
-    LIBRARY DESTINATION ${QS_INSTALL_PLUGIN_BASE_DIR}/${dir})
-  install(FILES ../${config}
-    DESTINATION ${QS_INSTALL_PLUGIN_BASE_DIR}/${dir})
+  # Plugins linked into the executables (QS_STATIC_PLUGINS) aren't loaded from
+  # the plugin directory.
+  if(NOT QS_STATIC_PLUGINS)
+    install(TARGETS ${lib}
+      LIBRARY DESTINATION ${QS_INSTALL_PLUGIN_BASE_DIR}/${dir})
+    install(FILES ../${config}
+      DESTINATION ${QS_INSTALL_PLUGIN_BASE_DIR}/${dir})
+  endif()
+endmacro()
+
+# Wraps the plugin configuration file in a raw string literal so that
+# 'std::string = #include "SomePlugin.xml";' brings in the definition at
+# compile time, for plugins linked into the executables (see StaticPlugin.h).
+macro(QS_PLUGIN_DEFINITION lib config)
+  file(READ ../${config} pluginDefinition)
+  # Re-run CMake when the definition file changes.
+  set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS
+    ${CMAKE_CURRENT_SOURCE_DIR}/../${config})
+  configure_file(${PROJECT_SOURCE_DIR}/Plugins/PluginDefinitionTemplate.in
+                 ${CMAKE_CURRENT_BINARY_DIR}/${config} @ONLY)
+  target_include_directories(${lib} PRIVATE ${CMAKE_CURRENT_BINARY_DIR})
 endmacro()
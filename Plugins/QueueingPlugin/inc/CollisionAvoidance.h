@@ -11,6 +11,8 @@
 
 namespace QS
 {
+  class NearestN;
+
   /**
    * Attempts to prevent collisions between Actors.
    */
@@ -71,6 +73,13 @@ namespace QS
 
     protected:
 
+    /**
+     * Binds the NearestN Sensor.
+     *
+     * @throws std::invalid_argument if the dependency isn't one
+     */
+    virtual void bindDependencies() override;
+
     /**
      * Computer a steering force to avoid the given Actor.
      *
@@ -121,5 +130,8 @@ namespace QS
                                      const Actor *theOther) const;
 
     private:
+
+    /** Nearest Actors. */
+    const NearestN *myNearestN = nullptr;
   };
 }
@@ -11,6 +11,8 @@
 
 namespace QS
 {
+  class FindExitSensor;
+
   /**
    * Moves an Actor away from an Exit.
    */
@@ -69,7 +71,16 @@ namespace QS
 
     protected:
 
+    /**
+     * Binds the FindExitSensor.
+     *
+     * @throws std::invalid_argument if the dependency isn't one
+     */
+    virtual void bindDependencies() override;
+
     private:
-    
+
+    /** Exit to flee. */
+    const FindExitSensor *myExitSensor = nullptr;
   };
 }
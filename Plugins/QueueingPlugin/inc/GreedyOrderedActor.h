@@ -61,6 +61,14 @@ namespace QS
      */
     virtual ~GreedyOrderedActor() = default;
 
+    /**
+     * GreedyOrderedActors track their movement in evaluate, so can't be
+     * evaluated in a batch.
+     *
+     * @return false
+     */
+    virtual bool canEvaluateInBatch() const noexcept override;
+
     /**
      * @see Actor.h
      */
@@ -77,6 +85,13 @@ namespace QS
 
    protected:
 
+    /**
+     * Binds the BehaviorSets.
+     *
+     * @throws std::invalid_argument if the dependencies aren't what is needed
+     */
+    virtual void bindDependencies() override;
+
     private:
 
     enum class Phases
@@ -77,6 +77,13 @@ namespace QS
 
     protected:
 
+    /**
+     * Binds the Behaviors.
+     *
+     * @throws std::invalid_argument if the dependencies aren't what is needed
+     */
+    virtual void bindDependencies() override;
+
     private:
 
     /** Collision avoidance behavior */
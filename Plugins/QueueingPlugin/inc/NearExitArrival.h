@@ -11,6 +11,8 @@
 
 namespace QS
 {
+  class FindExitSensor;
+
   /**
    * Moves an Actor towards a spot near the exit along its current path, slowing
    * as the Actor nears this point.
@@ -65,11 +67,15 @@ namespace QS
 
     /**
      * Returns true if at any point the Actor has reached its position (even
-     * if the Actor later moved away from it).
+     * if the Actor later moved away from it). This is kept in the Actor (see
+     * Actor::getBehaviorState) since one NearExitArrival can be shared by
+     * many Actors.
      *
+     * @param theActor
+     *          Actor to check
      * @return true if the position has been reached
      */
-    bool getAtPosition() const noexcept;
+    bool getAtPosition(const Actor *theActor) const noexcept;
 
     /**
      * Copy assignment operator.
@@ -83,15 +89,25 @@ namespace QS
 
     protected:
 
+    /**
+     * Binds the FindExitSensor.
+     *
+     * @throws std::invalid_argument if the dependency isn't one
+     */
+    virtual void bindDependencies() override;
+
     private:
 
+    /** Actor behavior state, 1 once the Actor has reached its position. */
+    std::size_t myAtPositionState;
+
     /**
      * Distance from exit to arrive at. If not defined uses a value based on
      * the exit.
      */
     float myDesiredDistanceFromExit;
 
-    /** Has the Actor reached the position? */
-    bool myAtPosition = false;
+    /** Exit to arrive at. */
+    const FindExitSensor *myExitSensor = nullptr;
   };
 }
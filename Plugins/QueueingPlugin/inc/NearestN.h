@@ -68,6 +68,24 @@ namespace QS
      */
     const std::vector<const Actor*>& getActors() const noexcept;
 
+    /**
+     * Returns the x coordinate of the position of each found Actor, in the
+     * same order as getActors (for BasicBehaviors::separation). Empty unless
+     * BasicBehaviors::isSimdSeparationEnabled.
+     *
+     * @return x coordinates
+     */
+    const std::vector<float>& getPositionsX() const noexcept;
+
+    /**
+     * Returns the y coordinate of the position of each found Actor, in the
+     * same order as getActors. Empty unless
+     * BasicBehaviors::isSimdSeparationEnabled.
+     *
+     * @return y coordinates
+     */
+    const std::vector<float>& getPositionsY() const noexcept;
+
     /**
      * Returns the maximum number of Actors to find.
      *
@@ -108,6 +126,12 @@ namespace QS
     /**  Nearest N Actors. */
     std::vector<const Actor*> myActors;
 
+    /** X coordinate of each of myActors. */
+    std::vector<float> myPositionsX;
+
+    /** Y coordinate of each of myActors. */
+    std::vector<float> myPositionsY;
+
     /** Number of Actors to find. */
     uint32_t myN = 0;
 
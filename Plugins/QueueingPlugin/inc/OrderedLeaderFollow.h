@@ -11,6 +11,8 @@
 
 namespace QS
 {
+  class NearestN;
+
   /**
    * Generates a steering force to follow the Actor with the closest higher
    * rank. If no higher Actor is nearby then a zero force is returned.
@@ -73,6 +75,16 @@ namespace QS
 
     protected:
 
+    /**
+     * Binds the NearestN Sensor.
+     *
+     * @throws std::invalid_argument if the dependency isn't one
+     */
+    virtual void bindDependencies() override;
+
     private:
+
+    /** Nearest Actors. */
+    const NearestN *myNearestN = nullptr;
   };
 }
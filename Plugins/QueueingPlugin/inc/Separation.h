@@ -11,6 +11,8 @@
 
 namespace QS
 {
+  class NearestN;
+
   /**
    * Moves an Actor away from Actors in the neighboring area.
    */
@@ -69,6 +71,16 @@ namespace QS
 
     protected:
 
+    /**
+     * Binds the NearestN Sensor.
+     *
+     * @throws std::invalid_argument if the dependency isn't one
+     */
+    virtual void bindDependencies() override;
+
     private:
+
+    /** Nearest Actors. */
+    const NearestN *myNearestN = nullptr;
   };
 }
@@ -45,12 +45,14 @@ QS::CollisionAvoidance::CollisionAvoidance(const Properties &theProperties,
 {
 }
 
-Eigen::Vector2f QS::CollisionAvoidance::evaluate(const Actor *theActor)
+void QS::CollisionAvoidance::bindDependencies()
 {
-  const QS::NearestN *nearestN =
-    dynamic_cast<const QS::NearestN*>(getDependencies()[0].myEntity);
+  myNearestN = getDependency<const NearestN>(0);
+}
 
-  const std::vector<const Actor*> &nearestActors = nearestN->getActors();
+Eigen::Vector2f QS::CollisionAvoidance::evaluate(const Actor *theActor)
+{
+  const std::vector<const Actor*> &nearestActors = myNearestN->getActors();
 
   const Actor *actorToAvoid = nullptr;
 
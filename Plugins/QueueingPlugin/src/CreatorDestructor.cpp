@@ -6,6 +6,8 @@
  */
 
 #include <string>
+#include <utility>
+#include <vector>
 #include "CollisionAvoidance.h"
 #include "ExitFlee.h"
 #include "ExitSeek.h"
@@ -19,11 +21,45 @@
 #include "OrderedActor.h"
 #include "OrderedExit.h"
 #include "OrderedLeaderFollow.h"
+#include "PluginABI.h"
 #include "SemiRationalOrdering.h"
 #include "Separation.h"
+#include "StaticPlugin.h"
 
-extern "C"
+QS_PLUGIN_FUNCTIONS(QueueingPlugin)
 {
+  const QS::PluginABI& qsPluginABI()
+  {
+    // Per-Actor state (i.e., NearExitArrival's) is kept in the Actor, so all
+    // of these can be shared.
+    static const QS::PluginABI abi = []()
+    {
+      using Kind = QS::EntityCapabilities::Kind;
+      QS::PluginABI abi;
+      for (const auto &type : std::vector<std::pair<Kind, std::string>>{
+          {Kind::BehaviorSet, "GreedyOrdering"},
+          {Kind::BehaviorSet, "LooseOrdering"},
+          {Kind::BehaviorSet, "SemiRationalOrdering"},
+          {Kind::Behavior, "CollisionAvoidance"},
+          {Kind::Behavior, "ExitFlee"},
+          {Kind::Behavior, "ExitSeek"},
+          {Kind::Behavior, "NearExitArrival"},
+          {Kind::Behavior, "OrderedLeaderFollow"},
+          {Kind::Behavior, "Separation"},
+          {Kind::Sensor, "FindExitSensor"},
+          {Kind::Sensor, "NearestN"}})
+      {
+        QS::EntityCapabilities capabilities;
+        capabilities.myKind = type.first;
+        capabilities.myType = type.second;
+        capabilities.myShareable = true;
+        abi.myCapabilities.push_back(capabilities);
+      }
+      return abi;
+    }();
+    return abi;
+  }
+
   QS::Actor* actorCreator(
     const std::string &theActorName,
     const QS::PluginEntity::Properties &theProperties,
@@ -170,4 +206,33 @@ extern "C"
   {
     delete theExit;
   }
+
+#ifdef QS_STATIC_PLUGINS
+  const QS::StaticPlugin& qsStaticPlugin()
+  {
+    static const QS::StaticPlugin plugin = []()
+    {
+      QS::StaticPlugin plugin;
+      plugin.myConfigFile = "QueueingPlugin.xml";
+      plugin.myDefinition =
+        #include "QueueingPlugin.xml"
+        ;
+      plugin.myABI = &qsPluginABI;
+      plugin.myFunctions = {
+        {"actorCreator", reinterpret_cast<void*>(&actorCreator)},
+        {"actorDestructor", reinterpret_cast<void*>(&actorDestructor)},
+        {"behaviorSetCreator", reinterpret_cast<void*>(&behaviorSetCreator)},
+        {"behaviorSetDestructor",
+         reinterpret_cast<void*>(&behaviorSetDestructor)},
+        {"behaviorCreator", reinterpret_cast<void*>(&behaviorCreator)},
+        {"behaviorDestructor", reinterpret_cast<void*>(&behaviorDestructor)},
+        {"sensorCreator", reinterpret_cast<void*>(&sensorCreator)},
+        {"sensorDestructor", reinterpret_cast<void*>(&sensorDestructor)},
+        {"exitCreator", reinterpret_cast<void*>(&exitCreator)},
+        {"exitDestructor", reinterpret_cast<void*>(&exitDestructor)}};
+      return plugin;
+    }();
+    return plugin;
+  }
+#endif
 }
@@ -17,12 +17,14 @@ QS::ExitFlee::ExitFlee(const Properties &theProperties,
 {
 }
 
-Eigen::Vector2f QS::ExitFlee::evaluate(const Actor *theActor)
+void QS::ExitFlee::bindDependencies()
 {
-  const FindExitSensor *exitSensor =
-    dynamic_cast<const QS::FindExitSensor*>(getDependencies()[0].myEntity);
+  myExitSensor = getDependency<const FindExitSensor>(0);
+}
 
-  const Exit *exit = exitSensor->getExit();
+Eigen::Vector2f QS::ExitFlee::evaluate(const Actor *theActor)
+{
+  const Exit *exit = myExitSensor->getExit();
 
   Eigen::Vector2f steeringForce = BasicBehaviors::flee(
     theActor, exit->getPosition(), theActor->getMaximumSpeed());
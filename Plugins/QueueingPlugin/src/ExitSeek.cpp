@@ -16,12 +16,14 @@ QS::ExitSeek::ExitSeek(const Properties &theProperties,
 {
 }
 
-Eigen::Vector2f QS::ExitSeek::evaluate(const Actor *theActor)
+void QS::ExitSeek::bindDependencies()
 {
-  const FindExitSensor *exitSensor =
-    dynamic_cast<const QS::FindExitSensor*>(getDependencies()[0].myEntity);
+  myExitSensor = getDependency<const FindExitSensor>(0);
+}
 
-  const Exit *exit = exitSensor->getExit();
+Eigen::Vector2f QS::ExitSeek::evaluate(const Actor *theActor)
+{
+  const Exit *exit = myExitSensor->getExit();
 
   Eigen::Vector2f desiredVelocity =
      exit->getPosition() - theActor->getPosition();
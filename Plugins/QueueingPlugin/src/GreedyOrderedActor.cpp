@@ -35,6 +35,17 @@ QS::GreedyOrderedActor::GreedyOrderedActor(const Properties &theProperties,
   }
 }
 
+void QS::GreedyOrderedActor::bindDependencies()
+{
+  myGreedyBehaviorSet = getDependency<GreedyOrdering>(0);
+  mySemiRationalBehaviorSet = getDependency<SemiRationalOrdering>(1);
+}
+
+bool QS::GreedyOrderedActor::canEvaluateInBatch() const noexcept
+{
+  return false;
+}
+
 Eigen::Vector2f QS::GreedyOrderedActor::evaluate(const Sensable &theSensable)
 {
   Eigen::Vector2f positionDifference = getPosition() - myPreviousPosition;
@@ -52,15 +63,6 @@ Eigen::Vector2f QS::GreedyOrderedActor::evaluate(const Sensable &theSensable)
 QS::BehaviorSet* QS::GreedyOrderedActor::selectBehaviorSet(
   const Sensable &theSensable)
 {
-  if (nullptr == myGreedyBehaviorSet)
-  {
-    auto dependencies = getDependencies();
-    myGreedyBehaviorSet = dynamic_cast<QS::GreedyOrdering*>(
-      getDependencies()[0].myEntity);
-    mySemiRationalBehaviorSet = dynamic_cast<QS::SemiRationalOrdering*>(
-      getDependencies()[1].myEntity);
-  }
-
   BehaviorSet *behaviorSet = myGreedyBehaviorSet;
   if (myTimeWithoutMovement >= myPatienceTime_s)
   {
@@ -22,21 +22,18 @@ QS::GreedyOrdering::GreedyOrdering(const Properties &theProperties,
 {
 }
 
+void QS::GreedyOrdering::bindDependencies()
+{
+  myCollisionAvoidance = getDependency<CollisionAvoidance>(0);
+  myExitSeek = getDependency<ExitSeek>(1);
+  myNearExitArrival = getDependency<NearExitArrival>(2);
+}
+
 Eigen::Vector2f QS::GreedyOrdering::evaluate(const Actor *theActor,
                                              const Sensable &theSensable)
 {
   populateSensors(theSensable);
 
-  if (! myCollisionAvoidance)
-  {
-    auto dependencies = getDependencies();
-    myCollisionAvoidance = dynamic_cast<QS::CollisionAvoidance*>(
-      dependencies[0].myEntity);
-    myExitSeek = dynamic_cast<QS::ExitSeek*>(dependencies[1].myEntity);
-    myNearExitArrival = dynamic_cast<QS::NearExitArrival*>(
-      dependencies[2].myEntity);
-  }
-
   const OrderedActor *orderedActor = dynamic_cast<const OrderedActor*>(
     theActor);
   const OrderedExit *orderedExit = dynamic_cast<const OrderedExit*>(
@@ -55,7 +52,7 @@ Eigen::Vector2f QS::GreedyOrdering::evaluate(const Actor *theActor,
     Eigen::Vector2f collisionSteering =
       myCollisionAvoidance->evaluate(theActor);
     Eigen::Vector2f nearExitSteering = myNearExitArrival->evaluate(theActor);
-    if (false == myNearExitArrival->getAtPosition())
+    if (false == myNearExitArrival->getAtPosition(theActor))
     {
       if (zeroVector == collisionSteering)
       {
@@ -19,23 +19,19 @@ QS::LooseOrdering::LooseOrdering(const Properties &theProperties,
 {
 }
 
+void QS::LooseOrdering::bindDependencies()
+{
+  myCollisionAvoidance = getDependency<CollisionAvoidance>(0);
+  myExitSeek = getDependency<ExitSeek>(1);
+  myLeaderFollow = getDependency<OrderedLeaderFollow>(2);
+}
+
 Eigen::Vector2f QS::LooseOrdering::evaluate(const Actor *theActor,
                                             const Sensable &theSensable)
 {
   // TODO: move into Engine?
   populateSensors(theSensable);
 
-  if (! myCollisionAvoidance)
-  {
-    auto dependencies = getDependencies();
-    myCollisionAvoidance = dynamic_cast<QS::CollisionAvoidance*>(
-      getDependencies()[0].myEntity);
-    myExitSeek = dynamic_cast<QS::ExitSeek*>(
-      getDependencies()[1].myEntity);
-    myLeaderFollow = dynamic_cast<QS::OrderedLeaderFollow*>(
-      getDependencies()[2].myEntity);
-  }
-
   Eigen::Vector2f collisionSteering = myCollisionAvoidance->evaluate(theActor);
   Eigen::Vector2f exitSteering = myExitSeek->evaluate(theActor);
   Eigen::Vector2f leaderFollowSteering = myLeaderFollow->evaluate(theActor);
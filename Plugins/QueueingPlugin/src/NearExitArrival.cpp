@@ -15,18 +15,21 @@
 
 QS::NearExitArrival::NearExitArrival(const Properties &theProperties,
                                      const std::string &theTag) :
-  Behavior(theProperties, theTag)
+  Behavior(theProperties, theTag),
+  myAtPositionState(Actor::allocateBehaviorState("NearExitArrival.atPosition"))
 {
   myDesiredDistanceFromExit = PluginHelper::getProperty(
     theProperties, "distance", false, PluginHelper::toFloat, -1.0f);
 }
 
-Eigen::Vector2f QS::NearExitArrival::evaluate(const Actor *theActor)
+void QS::NearExitArrival::bindDependencies()
 {
-  const FindExitSensor *exitSensor =
-    dynamic_cast<const QS::FindExitSensor*>(getDependencies()[0].myEntity);
+  myExitSensor = getDependency<const FindExitSensor>(0);
+}
 
-  const Exit *exit = exitSensor->getExit();
+Eigen::Vector2f QS::NearExitArrival::evaluate(const Actor *theActor)
+{
+  const Exit *exit = myExitSensor->getExit();
 
   float desiredDistanceFromExit = myDesiredDistanceFromExit;
   if (myDesiredDistanceFromExit < 0.0)
@@ -49,7 +52,7 @@ Eigen::Vector2f QS::NearExitArrival::evaluate(const Actor *theActor)
   }
   else
   {
-    myAtPosition = true;
+    theActor->setBehaviorState(myAtPositionState, 1.0);
   }
 
   Eigen::Vector2f steeringForce = BasicBehaviors::arrival(
@@ -58,7 +61,8 @@ Eigen::Vector2f QS::NearExitArrival::evaluate(const Actor *theActor)
   return steeringForce;
 }
 
-bool QS::NearExitArrival::getAtPosition() const noexcept
+bool QS::NearExitArrival::getAtPosition(const Actor *theActor)
+  const noexcept
 {
-  return myAtPosition;
+  return theActor->getBehaviorState(myAtPositionState) != 0.0;
 }
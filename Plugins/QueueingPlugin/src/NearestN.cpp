@@ -9,6 +9,7 @@
 #include <stdexcept>
 #include "Eigen/Core"
 #include "Actor.h"
+#include "BasicBehaviors.h"
 #include "NearestN.h"
 #include "PluginHelper.h"
 #include "Sensable.h"
@@ -40,6 +41,16 @@ uint32_t QS::NearestN::getN() const noexcept
   return myN;
 }
 
+const std::vector<float>& QS::NearestN::getPositionsX() const noexcept
+{
+  return myPositionsX;
+}
+
+const std::vector<float>& QS::NearestN::getPositionsY() const noexcept
+{
+  return myPositionsY;
+}
+
 float QS::NearestN::getRadius() const noexcept
 {
   return myRadius_m;
@@ -94,4 +105,16 @@ void QS::NearestN::sense(const Sensable &theSensable)
       ++actorIter;
     }
   }
+
+  // Positions as arrays too, for the SIMD separation, only when it is used.
+  myPositionsX.clear();
+  myPositionsY.clear();
+  if (BasicBehaviors::isSimdSeparationEnabled())
+  {
+    for (auto actor : myActors)
+    {
+      myPositionsX.push_back(actor->getPosition().x());
+      myPositionsY.push_back(actor->getPosition().y());
+    }
+  }
 }
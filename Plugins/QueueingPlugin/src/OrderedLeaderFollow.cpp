@@ -20,15 +20,17 @@ QS::OrderedLeaderFollow::OrderedLeaderFollow(const Properties &theProperties,
 {
 }
 
-Eigen::Vector2f QS::OrderedLeaderFollow::evaluate(const Actor *theActor)
+void QS::OrderedLeaderFollow::bindDependencies()
 {
-  const QS::NearestN *nearestN =
-    dynamic_cast<const QS::NearestN*>(getDependencies()[0].myEntity);
+  myNearestN = getDependency<const NearestN>(0);
+}
 
+Eigen::Vector2f QS::OrderedLeaderFollow::evaluate(const Actor *theActor)
+{
   const OrderedActor *orderedActor = dynamic_cast<const OrderedActor*>(
     theActor);
 
-  const std::vector<const Actor*> &nearestActors = nearestN->getActors();
+  const std::vector<const Actor*> &nearestActors = myNearestN->getActors();
 
   // First, find the closest, higher ranked Actor
   uint32_t smallestRankDifference = std::numeric_limits<uint32_t>::max();
@@ -85,7 +87,19 @@ Eigen::Vector2f QS::OrderedLeaderFollow::evaluate(const Actor *theActor)
     }
 
     steeringForce += BasicBehaviors::arrival(theActor, behind, 2.0);
-    steeringForce += BasicBehaviors::separation(theActor, nearestActors, 0.1);
+    if (BasicBehaviors::isSimdSeparationEnabled())
+    {
+      steeringForce += BasicBehaviors::separation(
+        theActor->getPosition(), theActor->getMass(),
+        myNearestN->getPositionsX().data(),
+        myNearestN->getPositionsY().data(),
+        myNearestN->getPositionsX().size(), 0.1);
+    }
+    else
+    {
+      steeringForce += BasicBehaviors::separation(theActor, nearestActors,
+                                                  0.1);
+    }
   }
 
   //steeringForce *= theActor->getMass();
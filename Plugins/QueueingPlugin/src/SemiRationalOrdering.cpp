@@ -20,21 +20,19 @@ QS::SemiRationalOrdering::SemiRationalOrdering(const Properties &theProperties,
 {
 }
 
+void QS::SemiRationalOrdering::bindDependencies()
+{
+  myCollisionAvoidance = getDependency<CollisionAvoidance>(0);
+  myExitFlee = getDependency<ExitFlee>(1);
+  myExitSeek = getDependency<ExitSeek>(2);
+  mySeparation = getDependency<Separation>(3);
+}
+
 Eigen::Vector2f QS::SemiRationalOrdering::evaluate(const Actor *theActor,
                                                    const Sensable &theSensable)
 {
   populateSensors(theSensable);
 
-  if (! myExitFlee)
-  {
-    auto dependencies = getDependencies();
-    myCollisionAvoidance = dynamic_cast<CollisionAvoidance*>(
-      dependencies[0].myEntity);
-    myExitFlee = dynamic_cast<ExitFlee*>(dependencies[1].myEntity);
-    myExitSeek = dynamic_cast<ExitSeek*>(dependencies[2].myEntity);
-    mySeparation = dynamic_cast<Separation*>(dependencies[3].myEntity);
-  }
-
   const OrderedActor *orderedActor = dynamic_cast<const OrderedActor*>(
     theActor);
   const OrderedExit *orderedExit = dynamic_cast<const OrderedExit*>(
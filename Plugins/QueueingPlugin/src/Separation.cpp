@@ -16,12 +16,23 @@ QS::Separation::Separation(const Properties &theProperties,
 {
 }
 
+void QS::Separation::bindDependencies()
+{
+  myNearestN = getDependency<const NearestN>(0);
+}
+
 Eigen::Vector2f QS::Separation::evaluate(const Actor *theActor)
 {
-  const QS::NearestN *nearestN =
-    dynamic_cast<const QS::NearestN*>(getDependencies()[0].myEntity);
+  float separationDistance = theActor->getRadius() * 2;
+  if (BasicBehaviors::isSimdSeparationEnabled())
+  {
+    return BasicBehaviors::separation(
+      theActor->getPosition(), theActor->getMass(),
+      myNearestN->getPositionsX().data(), myNearestN->getPositionsY().data(),
+      myNearestN->getPositionsX().size(), separationDistance);
+  }
 
   Eigen::Vector2f steeringForce = BasicBehaviors::separation(
-    theActor, nearestN->getActors(), theActor->getRadius() * 2);
+    theActor, myNearestN->getActors(), separationDistance);
   return steeringForce;
 }
@@ -5,8 +5,10 @@
  * @author Michael Albers
  */
 
+#include <set>
 #include <string>
 #include <typeinfo>
+#include <utility>
 #include "gtest/gtest.h"
 #include "CollisionAvoidance.h"
 #include "ExitFlee.h"
@@ -21,13 +23,15 @@
 #include "OrderedActor.h"
 #include "OrderedExit.h"
 #include "OrderedLeaderFollow.h"
+#include "PluginABI.h"
 #include "SemiRationalOrdering.h"
 #include "Separation.h"
+#include "StaticPlugin.h"
 #include "TestUtils.h"
 
 // No header for the creator/destructors since they aren't used directly in the
 // code
-extern "C"
+QS_PLUGIN_FUNCTIONS(QueueingPlugin)
 {
   QS::Actor* actorCreator(
     const std::string&,
@@ -58,8 +62,14 @@ extern "C"
     const QS::PluginEntity::Properties&,
     const std::string &theTag);
   void exitDestructor(QS::Exit*);
+
+  const QS::PluginABI& qsPluginABI();
 }
 
+#ifdef QS_STATIC_PLUGINS
+using namespace QueueingPlugin;
+#endif
+
 GTEST_TEST(CreatorDestructor, testActor)
 {
   QS::PluginEntity::Properties properties{
@@ -171,6 +181,36 @@ GTEST_TEST(CreatorDestructor, testExit)
   EXPECT_THROW(exitCreator("", {}, ""), std::invalid_argument);
 }
 
+GTEST_TEST(CreatorDestructor, testPluginABI)
+{
+  const QS::PluginABI &abi = qsPluginABI();
+  EXPECT_EQ(4u, abi.myVersion);
+
+  using Kind = QS::EntityCapabilities::Kind;
+  std::set<std::pair<Kind, std::string>> shareable;
+  for (const auto &typeCapabilities : abi.myCapabilities)
+  {
+    EXPECT_FALSE(typeCapabilities.myBatchEvaluation);
+    if (typeCapabilities.myShareable)
+    {
+      shareable.emplace(typeCapabilities.myKind, typeCapabilities.myType);
+    }
+  }
+  std::set<std::pair<Kind, std::string>> expected{
+    {Kind::BehaviorSet, "GreedyOrdering"},
+    {Kind::BehaviorSet, "LooseOrdering"},
+    {Kind::BehaviorSet, "SemiRationalOrdering"},
+    {Kind::Behavior, "CollisionAvoidance"},
+    {Kind::Behavior, "ExitFlee"},
+    {Kind::Behavior, "ExitSeek"},
+    {Kind::Behavior, "NearExitArrival"},
+    {Kind::Behavior, "OrderedLeaderFollow"},
+    {Kind::Behavior, "Separation"},
+    {Kind::Sensor, "FindExitSensor"},
+    {Kind::Sensor, "NearestN"}};
+  EXPECT_EQ(expected, shareable);
+}
+
 GTEST_TEST(CreatorDestructor, testSensor)
 {
   QS::PluginEntity::Properties properties{{"Sensor", "Property"}};
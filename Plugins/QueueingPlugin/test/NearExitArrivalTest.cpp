@@ -17,3 +17,42 @@
 GTEST_TEST(NearExitArrivalTest, class)
 {
 }
+
+GTEST_TEST(NearExitArrivalTest, atPosition)
+{
+  QS::NearExitArrival nearExitArrival({{"distance", "2.0"}}, "");
+
+  QS::FindExitSensor findExitSensor({}, "");
+  QS::EntityDependency<QS::Sensor> findExitSensorDependency{
+    "", &findExitSensor, ""};
+  nearExitArrival.setDependencies({findExitSensorDependency});
+
+  auto exitProperties = QS::TestUtils::getMinimalExitProperties();
+  exitProperties["x"] = "5.0";
+  exitProperties["y"] = "5.0";
+  QS::Exit exit(exitProperties, "");
+  std::vector<const QS::Exit*> exits{&exit};
+
+  // One NearExitArrival used by two Actors keeps track of each separately.
+  QS::Actor nearActor(QS::TestUtils::getMinimalActorProperties(), "");
+  nearActor.setPosition({5.0, 6.0});
+  QS::Actor farActor(QS::TestUtils::getMinimalActorProperties(), "");
+  farActor.setPosition({20.0, 20.0});
+
+  QS::Sensable nearSensable(&nearActor, {}, exits, 0);
+  findExitSensor.sense(nearSensable);
+  nearExitArrival.evaluate(&nearActor);
+
+  QS::Sensable farSensable(&farActor, {}, exits, 0);
+  findExitSensor.sense(farSensable);
+  nearExitArrival.evaluate(&farActor);
+
+  EXPECT_TRUE(nearExitArrival.getAtPosition(&nearActor));
+  EXPECT_FALSE(nearExitArrival.getAtPosition(&farActor));
+
+  // Once reached, always reached.
+  nearActor.setPosition({20.0, 20.0});
+  findExitSensor.sense(nearSensable);
+  nearExitArrival.evaluate(&nearActor);
+  EXPECT_TRUE(nearExitArrival.getAtPosition(&nearActor));
+}
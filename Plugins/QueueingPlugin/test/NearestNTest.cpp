@@ -11,6 +11,7 @@
 #include "Eigen/Core"
 #include "gtest/gtest.h"
 #include "Actor.h"
+#include "BasicBehaviors.h"
 #include "EigenHelper.h"
 #include "NearestN.h"
 #include "Sensable.h"
@@ -117,10 +118,25 @@ GTEST_TEST(NearestNTest, sense)
     };
     QS::NearestN nearestN(properties, "");
 
+    QS::BasicBehaviors::disableSimdSeparation();
     nearestN.sense(sensable);
     auto actors = nearestN.getActors();
     checkActors(actors, actorPtrs.size()-1,
                 "Line: " + std::to_string(__LINE__));
+    // Positions are only kept as arrays for the SIMD separation.
+    EXPECT_TRUE(nearestN.getPositionsX().empty());
+    EXPECT_TRUE(nearestN.getPositionsY().empty());
+
+    QS::BasicBehaviors::enableSimdSeparation();
+    nearestN.sense(sensable);
+    QS::BasicBehaviors::disableSimdSeparation();
+    ASSERT_EQ(actors.size(), nearestN.getPositionsX().size());
+    ASSERT_EQ(actors.size(), nearestN.getPositionsY().size());
+    for (auto ii = 0u; ii < actors.size(); ++ii)
+    {
+      EXPECT_EQ(actors[ii]->getPosition().x(), nearestN.getPositionsX()[ii]);
+      EXPECT_EQ(actors[ii]->getPosition().y(), nearestN.getPositionsY()[ii]);
+    }
   }
 
   // Test with N < # actors, all within radius
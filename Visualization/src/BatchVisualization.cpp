@@ -8,6 +8,7 @@
 #include <cstring>
 #include <stdexcept>
 #include "BatchVisualization.h"
+#include "Tracer.h"
 
 QS::BatchVisualization::BatchVisualization(
   World &theWorld,
@@ -45,6 +46,8 @@ std::tuple<int, int> QS::BatchVisualization::getWindowDimensions() noexcept
 
 void QS::BatchVisualization::preBufferSwap() noexcept
 {
+  Tracer::begin("BatchVisualization::readback");
+
   // https://matthewarcus.wordpress.com/2013/03/10/movies-from-opengl/
   glFlush();
 
@@ -66,12 +69,16 @@ void QS::BatchVisualization::preBufferSwap() noexcept
                 &invertedBufferPointer[invertedRow * itemsPerRow],
                 itemsPerRow);
   }
+  Tracer::end("BatchVisualization::readback");
 
   // TODO: use ffmpeg directly
   // http://stackoverflow.com/questions/36687188/create-video-using-ffmpeg
   // https://www.ffmpeg.org/doxygen/0.6/output-example_8c-source.html
 
-  myOutputFile.write(bufferPointer, myBufferSize);
+  {
+    QS_TRACE_SCOPE("BatchVisualization::write");
+    myOutputFile.write(bufferPointer, myBufferSize);
+  }
   if (!myOutputFile)
   {
     std::string error{"Failed to write batch mode frame to output file \""};
@@ -19,6 +19,7 @@
 #include "Actors.h"
 #include "Exits.h"
 #include "Finally.h"
+#include "Tracer.h"
 #include "World.h"
 #include "WorldBox.h"
 
@@ -202,6 +203,7 @@ void QS::Visualization::run(Visualization *theVisualizer) noexcept
 {
   try
   {
+    Tracer::setThreadName("Simulation");
     theVisualizer->visualize();
   }
   catch (const std::exception &exception)
@@ -284,6 +286,7 @@ void QS::Visualization::visualize()
   bool worldContinue = true;
   while (myThreadControl && worldContinue)
   {
+    QS_TRACE_SCOPE("Visualization::frame");
     glfwPollEvents();
 
     if (myUserInput.size() > 0)